@@ -36,7 +36,7 @@ inline std::string base64_decode(const std::string& base64_str) {
                 break;  // Padding character
             }
             
-            int value = T[c];
+            int value = T[static_cast<unsigned char>(c)];
             if (value == -1) {
                 continue;  // Skip invalid characters
             }
@@ -50,12 +50,14 @@ inline std::string base64_decode(const std::string& base64_str) {
             continue;
         }
         
-        // Extract bytes based on how many valid characters we saw
+        // Left-align the 6-bit groups into 24 bits, then take as many whole
+        // bytes as they cover (2 chars -> 1 byte, 3 -> 2, 4 -> 3)
+        n <<= 6 * (4 - valid_chars);
         if (valid_chars >= 2) {
-            output += static_cast<char>((n >> 4) & 0xFF);
+            output += static_cast<char>((n >> 16) & 0xFF);
         }
         if (valid_chars >= 3) {
-            output += static_cast<char>((n >> 2) & 0xFF); 
+            output += static_cast<char>((n >> 8) & 0xFF);
         }
         if (valid_chars >= 4) {
             output += static_cast<char>(n & 0xFF);
@@ -0,0 +1,459 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "cache.h"
+
+// Bump when the scan or the token counting code changes what a file yields;
+// the vocabulary a build counts with is told apart by the encoder fingerprint.
+#define FILE_CACHE_VERSION 3
+
+// At most this many records are written back; the ones used by the last
+// run come first.
+#define FILE_CACHE_MAX_RECORDS (512 * 1024)
+
+static const char cache_magic[8] = {'D', 'I', 'R', 'D', 'O', 'C', 'F', 'C'};
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t encoder;       // fingerprint of the vocabulary the token counts came from
+    uint64_t count;
+} CacheHeader;
+
+// One cached file, as stored on disk
+typedef struct {
+    FileCacheKey key;
+    FileCacheValue value;
+} CacheRecord;
+
+typedef struct {
+    bool active;
+    char *path;
+    uint64_t encoder;
+    CacheRecord *records;
+    bool *touched;          // looked up or stored by this run
+    size_t count;
+    size_t capacity;
+    size_t *slots;          // open addressing by (dev, ino): record index + 1, 0 = empty
+    size_t slot_count;      // power of two
+    bool dirty;
+    size_t lookups;
+    size_t hits;
+} FileCache;
+
+static FileCache g_cache;
+static pthread_mutex_t g_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Final avalanche step of MurmurHash3.
+ *
+ * @param h Value to mix.
+ * @return uint64_t Mixed value.
+ */
+static uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief Reads 8 bytes in little-endian order.
+ *
+ * @param p Bytes to read.
+ * @return uint64_t Value.
+ */
+static uint64_t read64(const unsigned char *p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+/**
+ * @brief Hashes file contents for the cache key.
+ *
+ * Four independent lanes take 32 bytes per round, which keeps the multiplies
+ * pipelined; hashing runs far faster than the scan it lets the writer skip.
+ *
+ * @param data File contents.
+ * @param len Number of bytes.
+ * @return uint64_t Hash value.
+ */
+uint64_t file_cache_hash(const void *data, size_t len) {
+    const unsigned char *p = (const unsigned char*)data;
+    const uint64_t k1 = 0x9e3779b97f4a7c15ULL, k2 = 0xc2b2ae3d27d4eb4fULL;
+    uint64_t lane[4] = {k1, k2, k1 ^ k2, ~k1};
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        for (int l = 0; l < 4; l++) {
+            uint64_t v = lane[l] ^ read64(p + i + 8 * l);
+            v *= k2;
+            lane[l] = (v << 31) | (v >> 33);
+        }
+    }
+    uint64_t h = len * k1;
+    for (int l = 0; l < 4; l++) {
+        h = (h ^ mix64(lane[l])) * k1;
+    }
+    for (; i < len; i++) {
+        h = (h ^ p[i]) * 0x100000001b3ULL;
+    }
+    return mix64(h);
+}
+
+/**
+ * @brief Builds the default cache file path.
+ *
+ * @param buf Buffer for the path.
+ * @param size Size of buf.
+ * @return bool false if neither variable is set or the path does not fit.
+ */
+bool file_cache_default_path(char *buf, size_t size) {
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+    int n;
+    if (xdg && xdg[0] == '/') {
+        n = snprintf(buf, size, "%s/dirdoc/files.cache", xdg);
+    } else if (home && home[0]) {
+        n = snprintf(buf, size, "%s/.cache/dirdoc/files.cache", home);
+    } else {
+        return false;
+    }
+    return n > 0 && (size_t)n < size;
+}
+
+/**
+ * @brief Home slot of a file in the index.
+ *
+ * @param key File version; only device and inode are used.
+ * @return size_t Slot before masking.
+ */
+static size_t slot_of(const FileCacheKey *key) {
+    return (size_t)mix64(key->dev * 0x9e3779b97f4a7c15ULL ^ key->ino);
+}
+
+/**
+ * @brief Finds the slot holding a file, or the empty slot where it belongs.
+ *
+ * @param key File version; only device and inode are compared.
+ * @return size_t Slot index.
+ */
+static size_t find_slot(const FileCacheKey *key) {
+    size_t mask = g_cache.slot_count - 1;
+    size_t s = slot_of(key) & mask;
+    while (g_cache.slots[s] != 0) {
+        const FileCacheKey *k = &g_cache.records[g_cache.slots[s] - 1].key;
+        if (k->dev == key->dev && k->ino == key->ino) {
+            break;
+        }
+        s = (s + 1) & mask;
+    }
+    return s;
+}
+
+/**
+ * @brief Rebuilds the index with room for at least twice the records.
+ *
+ * @return bool false if out of memory.
+ */
+static bool grow_index(void) {
+    size_t slot_count = 1024;
+    while (slot_count < 2 * (g_cache.count + 1)) {
+        slot_count *= 2;
+    }
+    size_t *slots = (size_t*)calloc(slot_count, sizeof(size_t));
+    if (!slots) {
+        return false;
+    }
+    free(g_cache.slots);
+    g_cache.slots = slots;
+    g_cache.slot_count = slot_count;
+    for (size_t i = 0; i < g_cache.count; i++) {
+        g_cache.slots[find_slot(&g_cache.records[i].key)] = i + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Adds or replaces the record of a file.
+ *
+ * @param record Record to insert.
+ * @param touched Whether the record belongs to this run.
+ * @return bool false if out of memory.
+ */
+static bool insert_record(const CacheRecord *record, bool touched) {
+    if (2 * (g_cache.count + 1) > g_cache.slot_count && !grow_index()) {
+        return false;
+    }
+    size_t s = find_slot(&record->key);
+    if (g_cache.slots[s] != 0) {
+        size_t i = g_cache.slots[s] - 1;
+        g_cache.records[i] = *record;
+        g_cache.touched[i] = g_cache.touched[i] || touched;
+        return true;
+    }
+    if (g_cache.count == g_cache.capacity) {
+        size_t capacity = g_cache.capacity ? 2 * g_cache.capacity : 1024;
+        CacheRecord *records = (CacheRecord*)realloc(g_cache.records, capacity * sizeof(CacheRecord));
+        if (!records) {
+            return false;
+        }
+        g_cache.records = records;
+        bool *flags = (bool*)realloc(g_cache.touched, capacity * sizeof(bool));
+        if (!flags) {
+            return false;
+        }
+        g_cache.touched = flags;
+        g_cache.capacity = capacity;
+    }
+    g_cache.records[g_cache.count] = *record;
+    g_cache.touched[g_cache.count] = touched;
+    g_cache.count++;
+    g_cache.slots[s] = g_cache.count;
+    return true;
+}
+
+/**
+ * @brief Reads the records of a cache file, if it is one of this version
+ *        written with the same vocabulary.
+ *
+ * @param path Cache file.
+ */
+static void load_records(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        return;
+    }
+    CacheHeader header;
+    if (fread(&header, sizeof(header), 1, f) == 1 && memcmp(header.magic, cache_magic, sizeof(cache_magic)) == 0 &&
+        header.version == FILE_CACHE_VERSION && header.record_size == sizeof(CacheRecord) &&
+        header.encoder == g_cache.encoder && header.count <= FILE_CACHE_MAX_RECORDS) {
+        CacheRecord record;
+        for (uint64_t i = 0; i < header.count && fread(&record, sizeof(record), 1, f) == 1; i++) {
+            if (!insert_record(&record, false)) {
+                break;
+            }
+        }
+    }
+    fclose(f);
+}
+
+/**
+ * @brief Creates the directories leading to a file.
+ *
+ * @param path File path.
+ */
+static void make_parent_dirs(const char *path) {
+    char dir[4096];
+    snprintf(dir, sizeof(dir), "%s", path);
+    for (char *p = dir + 1; *p; p++) {
+        if (*p == '/') {
+            *p = '\0';
+            mkdir(dir, 0755);
+            *p = '/';
+        }
+    }
+}
+
+/**
+ * @brief Writes the records to the cache file, replacing it atomically.
+ *
+ * Records used by this run are written first, so they survive the size cap.
+ *
+ * @return bool true on success.
+ */
+static bool save_records(void) {
+    make_parent_dirs(g_cache.path);
+    char tmp_path[4096 + 32];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%ld.tmp", g_cache.path, (long)getpid());
+    FILE *f = fopen(tmp_path, "wb");
+    if (!f) {
+        return false;
+    }
+    CacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, cache_magic, sizeof(cache_magic));
+    header.version = FILE_CACHE_VERSION;
+    header.record_size = sizeof(CacheRecord);
+    header.encoder = g_cache.encoder;
+    header.count = g_cache.count < FILE_CACHE_MAX_RECORDS ? g_cache.count : FILE_CACHE_MAX_RECORDS;
+    bool ok = fwrite(&header, sizeof(header), 1, f) == 1;
+    size_t written = 0;
+    for (int pass = 0; pass < 2 && ok; pass++) {
+        bool touched = pass == 0;
+        for (size_t i = 0; i < g_cache.count && written < header.count && ok; i++) {
+            if (g_cache.touched[i] == touched) {
+                ok = fwrite(&g_cache.records[i], sizeof(CacheRecord), 1, f) == 1;
+                written++;
+            }
+        }
+    }
+    ok = fclose(f) == 0 && ok;
+    if (!ok || rename(tmp_path, g_cache.path) != 0) {
+        remove(tmp_path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Loads the cache from a file and makes it active.
+ *
+ * @param path Cache file, or NULL for file_cache_default_path().
+ * @param encoder Fingerprint of the vocabulary token counts are made with.
+ * @return bool true if the cache is active.
+ */
+bool file_cache_open(const char *path, uint64_t encoder) {
+    char default_path[4096];
+    if (!path) {
+        if (!file_cache_default_path(default_path, sizeof(default_path))) {
+            return false;
+        }
+        path = default_path;
+    }
+    file_cache_close();
+    pthread_mutex_lock(&g_cache_lock);
+    g_cache.path = strdup(path);
+    g_cache.encoder = encoder;
+    g_cache.active = g_cache.path != NULL && grow_index();
+    if (g_cache.active) {
+        load_records(path);
+    }
+    bool active = g_cache.active;
+    pthread_mutex_unlock(&g_cache_lock);
+    if (!active) {
+        file_cache_close();
+    }
+    return active;
+}
+
+/**
+ * @brief Writes the cache back if it changed, then deactivates and frees it.
+ */
+void file_cache_close(void) {
+    pthread_mutex_lock(&g_cache_lock);
+    if (g_cache.active && g_cache.dirty && !save_records()) {
+        fprintf(stderr, "Warning: Cannot write cache file '%s'\n", g_cache.path);
+    }
+    free(g_cache.path);
+    free(g_cache.records);
+    free(g_cache.touched);
+    free(g_cache.slots);
+    memset(&g_cache, 0, sizeof(g_cache));
+    pthread_mutex_unlock(&g_cache_lock);
+}
+
+/**
+ * @brief Whether a cache is open.
+ *
+ * @return bool true between a successful file_cache_open() and file_cache_close().
+ */
+bool file_cache_active(void) {
+    pthread_mutex_lock(&g_cache_lock);
+    bool active = g_cache.active;
+    pthread_mutex_unlock(&g_cache_lock);
+    return active;
+}
+
+/**
+ * @brief Looks up a file version.
+ *
+ * @param key File version.
+ * @param value Receives the cached results on a hit.
+ * @return bool true on a hit.
+ */
+bool file_cache_lookup(const FileCacheKey *key, FileCacheValue *value) {
+    bool hit = false;
+    pthread_mutex_lock(&g_cache_lock);
+    if (g_cache.active) {
+        g_cache.lookups++;
+        size_t s = find_slot(key);
+        if (g_cache.slots[s] != 0) {
+            size_t i = g_cache.slots[s] - 1;
+            const FileCacheKey *k = &g_cache.records[i].key;
+            hit = k->size == key->size && k->mtime_ns == key->mtime_ns && k->hash == key->hash;
+            if (hit) {
+                *value = g_cache.records[i].value;
+                g_cache.touched[i] = true;
+                g_cache.hits++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&g_cache_lock);
+    return hit;
+}
+
+/**
+ * @brief Looks up a file version by its status alone, ignoring the content hash.
+ *
+ * @param key File version; the hash is not compared, and receives the
+ *        cached one on a hit.
+ * @param value Receives the cached results on a hit.
+ * @return bool true on a hit.
+ */
+bool file_cache_lookup_stat(FileCacheKey *key, FileCacheValue *value) {
+    bool hit = false;
+    pthread_mutex_lock(&g_cache_lock);
+    if (g_cache.active) {
+        g_cache.lookups++;
+        size_t s = find_slot(key);
+        if (g_cache.slots[s] != 0) {
+            size_t i = g_cache.slots[s] - 1;
+            const FileCacheKey *k = &g_cache.records[i].key;
+            hit = k->size == key->size && k->mtime_ns == key->mtime_ns;
+            if (hit) {
+                key->hash = k->hash;
+                *value = g_cache.records[i].value;
+                g_cache.touched[i] = true;
+                g_cache.hits++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&g_cache_lock);
+    return hit;
+}
+
+/**
+ * @brief Stores the results for a file version.
+ *
+ * @param key File version.
+ * @param value Results to store.
+ */
+void file_cache_store(const FileCacheKey *key, const FileCacheValue *value) {
+    pthread_mutex_lock(&g_cache_lock);
+    if (g_cache.active) {
+        CacheRecord record;
+        memset(&record, 0, sizeof(record));
+        record.key = *key;
+        record.value = *value;
+        if (insert_record(&record, true)) {
+            g_cache.dirty = true;
+        }
+    }
+    pthread_mutex_unlock(&g_cache_lock);
+}
+
+/**
+ * @brief Lookup statistics since the cache was opened.
+ *
+ * @param lookups Receives the number of lookups.
+ * @param hits Receives the number of hits.
+ */
+void file_cache_stats(size_t *lookups, size_t *hits) {
+    pthread_mutex_lock(&g_cache_lock);
+    *lookups = g_cache.lookups;
+    *hits = g_cache.hits;
+    pthread_mutex_unlock(&g_cache_lock);
+}
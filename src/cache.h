@@ -0,0 +1,126 @@
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Persistent cache of what the writer learns about a file: the content scan
+ * results and the token count of its text. Entries are found by device and
+ * inode and only count as hits when size, modification time and a hash of
+ * the contents all match, so a file edited within one timestamp tick is not
+ * mistaken for its previous version.
+ *
+ * The cache lives in one file, loaded by file_cache_open() and written back
+ * by file_cache_close() when something changed. Lookups and stores are safe
+ * from several threads.
+ */
+
+// Identity of one version of a file
+typedef struct {
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtime_ns;
+    uint64_t hash;      // file_cache_hash() of the whole file
+} FileCacheKey;
+
+// What the writer needs to write a file without scanning or counting it
+typedef struct {
+    uint64_t length;        // bytes of text
+    uint64_t newlines;
+    uint64_t tokens;        // tokens of the text
+    uint32_t max_backticks;
+    uint8_t last;           // last byte of the text, '\n' if there is none
+    uint8_t binary;         // the binary probe rejected the file
+    uint8_t valid_utf8;
+    uint8_t reserved;
+} FileCacheValue;
+
+/**
+ * @brief Hash file contents for the cache key.
+ *
+ * @param data File contents.
+ * @param len Number of bytes.
+ * @return uint64_t Hash value.
+ */
+uint64_t file_cache_hash(const void *data, size_t len);
+
+/**
+ * @brief Build the default cache file path: $XDG_CACHE_HOME/dirdoc/files.cache,
+ *        or ~/.cache/dirdoc/files.cache.
+ *
+ * @param buf Buffer for the path.
+ * @param size Size of buf.
+ * @return bool false if neither variable is set or the path does not fit.
+ */
+bool file_cache_default_path(char *buf, size_t size);
+
+/**
+ * @brief Load the cache from a file and make it active.
+ *
+ * A missing, foreign or damaged cache file gives an empty cache, as does
+ * one written by a build that counts tokens with another vocabulary. The
+ * directory of the file is created when the cache is saved.
+ *
+ * @param path Cache file, or NULL for file_cache_default_path().
+ * @param encoder Fingerprint of the vocabulary token counts are made with,
+ *        normally tiktoken_vocab_fingerprint().
+ * @return bool true if the cache is active.
+ */
+bool file_cache_open(const char *path, uint64_t encoder);
+
+/**
+ * @brief Write the cache back if it changed, then deactivate and free it.
+ */
+void file_cache_close(void);
+
+/**
+ * @brief Whether a cache is open.
+ *
+ * @return bool true between a successful file_cache_open() and file_cache_close().
+ */
+bool file_cache_active(void);
+
+/**
+ * @brief Look up a file version.
+ *
+ * @param key File version.
+ * @param value Receives the cached results on a hit.
+ * @return bool true on a hit.
+ */
+bool file_cache_lookup(const FileCacheKey *key, FileCacheValue *value);
+
+/**
+ * @brief Look up a file version by size and modification time only.
+ *
+ * For callers that hold a copy of the contents rather than the file, such
+ * as --update deciding which sections of the old document are still
+ * current: they compare the returned hash with the hash of their copy.
+ *
+ * @param key File version; the hash is ignored, and receives the cached
+ *        one on a hit.
+ * @param value Receives the cached results on a hit.
+ * @return bool true on a hit.
+ */
+bool file_cache_lookup_stat(FileCacheKey *key, FileCacheValue *value);
+
+/**
+ * @brief Store the results for a file version, replacing any earlier
+ *        version of the same file.
+ *
+ * @param key File version.
+ * @param value Results to store.
+ */
+void file_cache_store(const FileCacheKey *key, const FileCacheValue *value);
+
+/**
+ * @brief Lookup statistics since the cache was opened.
+ *
+ * @param lookups Receives the number of lookups.
+ * @param hits Receives the number of hits.
+ */
+void file_cache_stats(size_t *lookups, size_t *hits);
+
+#endif // CACHE_H
@@ -0,0 +1,328 @@
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "content.h"
+#include "stats.h"
+
+// Bytes examined per step of the scan
+#if defined(__AVX2__)
+#define SCAN_WIDTH 32
+#else
+#define SCAN_WIDTH 16
+#endif
+
+// One bit per byte of a step, bit i for byte i
+typedef struct {
+    uint32_t newline;
+    uint32_t backtick;
+    uint32_t high;       // bytes >= 0x80
+} StepMasks;
+
+/**
+ * @brief Whether a byte counts as printable for the binary verdict.
+ *
+ * @param c Byte.
+ * @return true For tab, line feed, carriage return and ASCII 32..126.
+ */
+static inline bool is_printable(unsigned char c) {
+    return c == 9 || c == 10 || c == 13 || (c >= 32 && c <= 126);
+}
+
+/**
+ * @brief Mask with the lowest n bits set.
+ *
+ * @param n Number of bits, at most 32.
+ * @return uint32_t The mask.
+ */
+static inline uint32_t low_bits(int n) {
+    return n >= 32 ? 0xFFFFFFFFu : ((1u << n) - 1);
+}
+
+/**
+ * @brief Classify the bytes of a step one at a time.
+ *
+ * @param p Bytes.
+ * @param n Number of bytes, at most 32.
+ * @param m Receives the masks.
+ */
+static inline void step_masks_scalar(const unsigned char *p, int n, StepMasks *m) {
+    memset(m, 0, sizeof(*m));
+    for (int i = 0; i < n; i++) {
+        uint32_t bit = 1u << i;
+        if (p[i] == '\n') m->newline |= bit;
+        if (p[i] == '`') m->backtick |= bit;
+        if (p[i] >= 0x80) m->high |= bit;
+    }
+}
+
+/**
+ * @brief Count the printable bytes among the first n of a step.
+ *
+ * @param p Bytes.
+ * @param n Number of bytes.
+ * @return size_t Printable bytes.
+ */
+static inline size_t count_printable_scalar(const unsigned char *p, size_t n) {
+    size_t printable = 0;
+    for (size_t i = 0; i < n; i++) {
+        printable += is_printable(p[i]);
+    }
+    return printable;
+}
+
+#if defined(__AVX2__)
+/**
+ * @brief Classify a full step of 32 bytes with AVX2.
+ *
+ * @param p Bytes.
+ * @param m Receives the masks.
+ */
+static inline void step_masks_vector(const unsigned char *p, StepMasks *m) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)p);
+    m->newline = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+    m->backtick = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('`')));
+    m->high = (uint32_t)_mm256_movemask_epi8(v);
+}
+
+/**
+ * @brief Mask of the printable bytes of a full step.
+ *
+ * @param p Bytes.
+ * @return uint32_t One bit per printable byte.
+ */
+static inline uint32_t printable_mask_vector(const unsigned char *p) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)p);
+    // Signed compares: bytes >= 0x80 are negative and fail the first test
+    __m256i range = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(31)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8(127), v));
+    __m256i controls = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')),
+                                                       _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))),
+                                       _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')));
+    return (uint32_t)_mm256_movemask_epi8(_mm256_or_si256(range, controls));
+}
+#elif defined(__SSE2__)
+/**
+ * @brief Classify a full step of 16 bytes with SSE2.
+ *
+ * @param p Bytes.
+ * @param m Receives the masks.
+ */
+static inline void step_masks_vector(const unsigned char *p, StepMasks *m) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    m->newline = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+    m->backtick = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('`')));
+    m->high = (uint32_t)_mm_movemask_epi8(v);
+}
+
+/**
+ * @brief Mask of the printable bytes of a full step.
+ *
+ * @param p Bytes.
+ * @return uint32_t One bit per printable byte.
+ */
+static inline uint32_t printable_mask_vector(const unsigned char *p) {
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+    // Signed compares: bytes >= 0x80 are negative and fail the first test
+    __m128i range = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(31)),
+                                  _mm_cmplt_epi8(v, _mm_set1_epi8(127)));
+    __m128i controls = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')),
+                                                 _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+                                    _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+    return (uint32_t)_mm_movemask_epi8(_mm_or_si128(range, controls));
+}
+#else
+/**
+ * @brief Classify a full step without vector instructions.
+ *
+ * @param p Bytes.
+ * @param m Receives the masks.
+ */
+static inline void step_masks_vector(const unsigned char *p, StepMasks *m) {
+    step_masks_scalar(p, SCAN_WIDTH, m);
+}
+
+/**
+ * @brief Mask of the printable bytes of a full step.
+ *
+ * @param p Bytes.
+ * @return uint32_t One bit per printable byte.
+ */
+static inline uint32_t printable_mask_vector(const unsigned char *p) {
+    uint32_t mask = 0;
+    for (int i = 0; i < SCAN_WIDTH; i++) {
+        if (is_printable(p[i])) mask |= 1u << i;
+    }
+    return mask;
+}
+#endif
+
+/**
+ * @brief Extend the backtick runs over the backtick mask of a step.
+ *
+ * @param scan Scan state.
+ * @param mask Backtick bits of the step.
+ * @param n Number of bytes in the step.
+ */
+static inline void track_backticks(ContentScan *scan, uint32_t mask, int n) {
+    int run = scan->backtick_run;
+    int pos = 0;
+    while (pos < n) {
+        uint32_t rest = mask >> pos;
+        if (rest & 1) {
+            int ones = ~rest == 0 ? 32 - pos : __builtin_ctz(~rest);
+            if (ones > n - pos) ones = n - pos;
+            run += ones;
+            if (run > scan->max_backticks) scan->max_backticks = run;
+            pos += ones;
+        } else {
+            run = 0;
+            if (rest == 0) break;
+            pos += __builtin_ctz(rest);
+        }
+    }
+    scan->backtick_run = run;
+}
+
+/**
+ * @brief Validate UTF-8 byte by byte, continuing the sequence in progress.
+ *
+ * @param scan Scan state.
+ * @param p Bytes.
+ * @param n Number of bytes.
+ */
+static void validate_utf8(ContentScan *scan, const unsigned char *p, size_t n) {
+    for (size_t i = 0; i < n && scan->valid_utf8; i++) {
+        unsigned char c = p[i];
+        if (scan->utf8_need > 0) {
+            if (c < scan->utf8_low || c > scan->utf8_high) {
+                scan->valid_utf8 = false;
+            }
+            scan->utf8_need--;
+            scan->utf8_low = 0x80;
+            scan->utf8_high = 0xBF;
+            continue;
+        }
+        if (c < 0x80) continue;
+        // The first continuation byte rules out overlong forms, surrogates
+        // and code points above U+10FFFF
+        scan->utf8_low = 0x80;
+        scan->utf8_high = 0xBF;
+        if (c >= 0xC2 && c <= 0xDF) {
+            scan->utf8_need = 1;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            scan->utf8_need = 2;
+            if (c == 0xE0) scan->utf8_low = 0xA0;
+            if (c == 0xED) scan->utf8_high = 0x9F;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            scan->utf8_need = 3;
+            if (c == 0xF0) scan->utf8_low = 0x90;
+            if (c == 0xF4) scan->utf8_high = 0x8F;
+        } else {
+            scan->valid_utf8 = false;
+        }
+    }
+}
+
+/**
+ * @brief Start a scan.
+ *
+ * @param scan Scan state to initialize.
+ */
+void content_scan_init(ContentScan *scan) {
+    memset(scan, 0, sizeof(*scan));
+    scan->valid_utf8 = true;
+    scan->last = '\n';
+}
+
+/**
+ * @brief Scan the next block of a file.
+ *
+ * Each step classifies SCAN_WIDTH bytes into bit masks, with vector
+ * instructions where available, and all statistics are derived from the
+ * masks. Only steps with non-ASCII bytes or backticks look at bytes
+ * individually.
+ *
+ * @param scan Scan state.
+ * @param data Next bytes of the file.
+ * @param len Number of bytes.
+ */
+void content_scan_update(ContentScan *scan, const char *data, size_t len) {
+    const unsigned char *p = (const unsigned char *)data;
+    size_t pos = 0;
+
+    while (pos < len) {
+        int n = len - pos < SCAN_WIDTH ? (int)(len - pos) : SCAN_WIDTH;
+        StepMasks m;
+        if (n == SCAN_WIDTH) {
+            step_masks_vector(p + pos, &m);
+        } else {
+            step_masks_scalar(p + pos, n, &m);
+        }
+
+        if (scan->probed < BINARY_PROBE_SIZE) {
+            size_t k = BINARY_PROBE_SIZE - scan->probed < (size_t)n ? BINARY_PROBE_SIZE - scan->probed : (size_t)n;
+            if (n == SCAN_WIDTH) {
+                scan->printable += (size_t)__builtin_popcount(printable_mask_vector(p + pos) & low_bits((int)k));
+            } else {
+                scan->printable += count_printable_scalar(p + pos, k);
+            }
+            scan->probed += k;
+        }
+
+        scan->newlines += (size_t)__builtin_popcount(m.newline);
+        if (m.backtick || scan->backtick_run) {
+            track_backticks(scan, m.backtick, n);
+        }
+        if ((m.high || scan->utf8_need) && scan->valid_utf8) {
+            validate_utf8(scan, p + pos, (size_t)n);
+        }
+        scan->last = (char)p[pos + n - 1];
+        pos += (size_t)n;
+    }
+    scan->length += len;
+}
+
+/**
+ * @brief Whether enough bytes were scanned for the binary verdict.
+ *
+ * @param scan Scan state.
+ * @return true Once BINARY_PROBE_SIZE bytes were scanned.
+ */
+bool content_scan_probed(const ContentScan *scan) {
+    return scan->probed >= BINARY_PROBE_SIZE;
+}
+
+/**
+ * @brief Binary verdict from the printable bytes of the probe.
+ *
+ * @param scan Scan state.
+ * @return true If the bytes scanned so far make the file binary.
+ */
+bool content_scan_binary(const ContentScan *scan) {
+    return is_binary_count(scan->printable, scan->probed);
+}
+
+/**
+ * @brief End a scan.
+ *
+ * @param scan Scan state.
+ */
+void content_scan_finish(ContentScan *scan) {
+    if (scan->utf8_need > 0) {
+        scan->valid_utf8 = false;
+    }
+}
+
+/**
+ * @brief Number of lines of the scanned text.
+ *
+ * @param scan Finished scan.
+ * @return size_t Line feeds, plus one for a last line without one.
+ */
+size_t content_scan_lines(const ContentScan *scan) {
+    return scan->newlines + (scan->last != '\n' ? 1 : 0);
+}
@@ -0,0 +1,88 @@
+#ifndef CONTENT_H
+#define CONTENT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Single-pass analysis of file contents. One scan over the bytes yields
+ * everything the writer needs to know about a file before writing it: the
+ * binary verdict, the longest backtick run (for the fence), whether the text
+ * ends with a line feed, the number of line feeds and whether the text is
+ * valid UTF-8. NUL bytes are part of the text; they only count against the
+ * file in the binary verdict.
+ *
+ * The scan can be fed a whole buffer at once or consecutive blocks of one;
+ * the results are the same. It runs on AVX2 or SSE2 vectors when the
+ * compiler targets them and on plain bytes otherwise.
+ */
+typedef struct {
+    // Text statistics
+    size_t length;          // bytes of text
+    size_t newlines;        // line feeds in the text
+    int max_backticks;      // longest run of backticks
+    bool valid_utf8;        // whether the text is valid UTF-8 (final after content_scan_finish)
+    char last;              // last byte of the text, '\n' while there is none
+
+    // Printable bytes among the first BINARY_PROBE_SIZE bytes, NULs included
+    size_t probed;
+    size_t printable;
+
+    // State carried from one block to the next
+    int backtick_run;       // backticks at the end of the text so far
+    unsigned char utf8_need; // continuation bytes the last sequence still needs
+    unsigned char utf8_low;  // smallest allowed next continuation byte
+    unsigned char utf8_high; // largest allowed next continuation byte
+} ContentScan;
+
+/**
+ * @brief Start a scan.
+ *
+ * @param scan Scan state to initialize.
+ */
+void content_scan_init(ContentScan *scan);
+
+/**
+ * @brief Scan the next block of a file.
+ *
+ * @param scan Scan state.
+ * @param data Next bytes of the file.
+ * @param len Number of bytes.
+ */
+void content_scan_update(ContentScan *scan, const char *data, size_t len);
+
+/**
+ * @brief Whether enough bytes were scanned for the binary verdict.
+ *
+ * @param scan Scan state.
+ * @return true Once BINARY_PROBE_SIZE bytes were scanned.
+ */
+bool content_scan_probed(const ContentScan *scan);
+
+/**
+ * @brief Binary verdict, the same as is_binary_buffer() on the first
+ *        BINARY_PROBE_SIZE bytes.
+ *
+ * @param scan Scan state.
+ * @return true If the bytes scanned so far make the file binary.
+ */
+bool content_scan_binary(const ContentScan *scan);
+
+/**
+ * @brief End a scan: a UTF-8 sequence cut off by the end of the text makes
+ *        it invalid.
+ *
+ * @param scan Scan state.
+ */
+void content_scan_finish(ContentScan *scan);
+
+/**
+ * @brief Number of lines of the scanned text, counting a last line without
+ *        a line feed.
+ *
+ * @param scan Finished scan.
+ * @return size_t Number of lines; 0 for empty text.
+ */
+size_t content_scan_lines(const ContentScan *scan);
+
+#endif // CONTENT_H
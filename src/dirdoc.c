@@ -8,6 +8,7 @@
 #include "dirdoc.h"
 #include "writer.h"  // Include writer.h to set split options
 #include "reconstruct.h"
+#include "update.h"
 
 #if !defined(UNIT_TEST)
 /**
@@ -18,12 +19,20 @@ static void print_help() {
            "Options:\n"
            "  -h,   --help               Show this help message.\n"
            "  -o,   --output <file>      Specify output file (default: <folder>_documentation.md, where <folder> is the name of the input directory).\n"
-           "  -ngi, --no-gitignore       Ignore .gitignore file; however, extra ignore patterns provided with --ignore will still be applied.\n"
+           "  -ngi, --no-gitignore       Ignore .gitignore files; however, extra ignore patterns provided with --ignore will still be applied.\n"
            "  -s,   --structure-only     Generate structure only (skip file contents).\n"
            "  -sp,  --split              Enable split output. Optionally, use -l/--limit to specify maximum file size in MB (default: 18).\n"
-           "  -l,   --limit <limit>      Set maximum file size in MB for each split file (used with -sp).\n"
+           "  -l,   --limit <limit>      Set maximum file size in MB for each split file (used with -sp or -st).\n"
+           "  -st,  --split-tokens <N>   Split output into parts of at most N tokens each (implies -sp).\n"
+           "  -k,   --parts <K>          Distribute whole files over K parts with token totals as equal as possible.\n"
            "  -ig,  --include-git        Include .git folders in documentation (default: ignored).\n"
+           "  -t,   --threads <N>        Number of worker threads used for scanning, reading and token counting (default: 1).\n"
+           "  -nc,  --no-cache           Do not use or update the cache of per-file results (~/.cache/dirdoc).\n"
+           "  -gx,  --git-index          List tracked files from .git/index instead of walking the directory.\n"
+           "  -u,   --untracked          With --git-index, also include untracked files that are not ignored.\n"
+           "  -r,   --rev <commit-ish>   Document a git revision (branch, tag, commit) straight from the object database.\n"
            "  --ignore <pattern>         Ignore files matching the specified pattern (supports wildcards). Can be specified multiple times.\n"
+           "  -up,  --update <file>      Regenerate an existing single-part document in place, copying the sections of files unchanged since the cache saw them.\n"
            "  -rc,  --reconstruct        Reconstruct a directory from a dirdoc markdown. Use -o to specify the output directory.\n\n"
            "Examples:\n"
            "  dirdoc /path/to/dir\n"
@@ -32,7 +41,13 @@ static void print_help() {
            "  dirdoc --structure-only /path/to/dir\n"
            "  dirdoc -sp /path/to/dir\n"
            "  dirdoc -sp -l 10 /path/to/dir\n"
+           "  dirdoc --split-tokens 100000 /path/to/dir\n"
+           "  dirdoc --parts 4 /path/to/dir\n"
            "  dirdoc --include-git /path/to/dir\n"
+           "  dirdoc --threads 8 /path/to/dir\n"
+           "  dirdoc --git-index --untracked /path/to/repo\n"
+           "  dirdoc --rev v1.2.0 /path/to/repo\n"
+           "  dirdoc --update dir_documentation.md /path/to/dir\n"
            "  dirdoc --ignore \"*.tmp\" /path/to/dir\n"
            "  dirdoc --ignore \"*.log\" --ignore \"secret.txt\" /path/to/dir\n"
            "  dirdoc --ignore \"temp/\" /path/to/dir          # Ignore the entire temp directory\n");
@@ -53,7 +68,14 @@ int main(int argc, char *argv[]) {
     const char *output_file = NULL;
     int flags = 0;
     double split_limit_mb = 18.0; // Default split limit in MB
+    int limit_given = 0;          // -l seen on its own, applied once splitting is known
+    size_t split_tokens = 0;      // Per-part token budget, 0 = split by size only
+    size_t split_parts = 0;       // Fixed number of balanced parts, 0 = off
     int reconstruct_mode = 0;
+    int threads = 1;
+    const char *rev = NULL;
+    const char *update_path = NULL;
+    int use_cache = 1;
 
     #define MAX_IGNORE_PATTERNS 64
     char *ignore_patterns[MAX_IGNORE_PATTERNS];
@@ -93,14 +115,64 @@ int main(int argc, char *argv[]) {
                 }
                 i += 2;
             }
+        } else if ((strcmp(argv[i], "-st") == 0) || (strcmp(argv[i], "--split-tokens") == 0)) {
+            if (i + 1 < argc && atoll(argv[i + 1]) > 0) {
+                split_tokens = (size_t)atoll(argv[++i]);
+                flags |= SPLIT_OUTPUT;
+            } else {
+                fprintf(stderr, "Error: --split-tokens requires a positive token count.\n");
+                return 1;
+            }
+        } else if ((strcmp(argv[i], "-k") == 0) || (strcmp(argv[i], "--parts") == 0)) {
+            if (i + 1 < argc && atoll(argv[i + 1]) > 0) {
+                split_parts = (size_t)atoll(argv[++i]);
+            } else {
+                fprintf(stderr, "Error: --parts requires a positive number of parts.\n");
+                return 1;
+            }
         } else if ((strcmp(argv[i], "-l") == 0) || (strcmp(argv[i], "--limit") == 0)) {
-            // If -l is provided without -sp, warn and ignore limit
-            fprintf(stderr, "Warning: -l/--limit specified without -sp/--split. Ignoring limit.\n");
+            // -st also enables splitting, so the limit is checked after parsing
             if (i + 1 < argc) {
-                i++; // Skip the limit value
+                split_limit_mb = atof(argv[++i]);
+                if (split_limit_mb <= 0) {
+                    fprintf(stderr, "Error: Invalid split limit specified. Using default of 18 MB.\n");
+                    split_limit_mb = 18.0;
+                }
             }
+            limit_given = 1;
         } else if ((strcmp(argv[i], "-ig") == 0) || (strcmp(argv[i], "--include-git") == 0)) {
             flags |= INCLUDE_GIT;
+        } else if ((strcmp(argv[i], "-nc") == 0) || (strcmp(argv[i], "--no-cache") == 0)) {
+            use_cache = 0;
+        } else if ((strcmp(argv[i], "-gx") == 0) || (strcmp(argv[i], "--git-index") == 0)) {
+            flags |= GIT_INDEX;
+        } else if ((strcmp(argv[i], "-u") == 0) || (strcmp(argv[i], "--untracked") == 0)) {
+            flags |= INCLUDE_UNTRACKED;
+        } else if ((strcmp(argv[i], "-r") == 0) || (strcmp(argv[i], "--rev") == 0)) {
+            if (i + 1 < argc) {
+                rev = argv[++i];
+            } else {
+                fprintf(stderr, "Error: --rev requires a commit-ish argument.\n");
+                return 1;
+            }
+        } else if ((strcmp(argv[i], "-up") == 0) || (strcmp(argv[i], "--update") == 0)) {
+            if (i + 1 < argc) {
+                update_path = argv[++i];
+            } else {
+                fprintf(stderr, "Error: --update requires a document argument.\n");
+                return 1;
+            }
+        } else if ((strcmp(argv[i], "-t") == 0) || (strcmp(argv[i], "--threads") == 0)) {
+            if (i + 1 < argc) {
+                threads = atoi(argv[++i]);
+                if (threads < 1) {
+                    fprintf(stderr, "Error: --threads requires a positive integer.\n");
+                    return 1;
+                }
+            } else {
+                fprintf(stderr, "Error: --threads requires a thread count argument.\n");
+                return 1;
+            }
         } else if (strcmp(argv[i], "--ignore") == 0) {
             if (i + 1 < argc) {
                 if (ignore_patterns_count < MAX_IGNORE_PATTERNS) {
@@ -133,22 +205,54 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
+    if ((flags & INCLUDE_UNTRACKED) && !(flags & GIT_INDEX)) {
+        fprintf(stderr, "Warning: -u/--untracked has no effect without -gx/--git-index.\n");
+    }
+    if (limit_given && !(flags & SPLIT_OUTPUT)) {
+        fprintf(stderr, "Warning: -l/--limit specified without -sp/--split or -st/--split-tokens. Ignoring limit.\n");
+    }
+    if (rev && (flags & GIT_INDEX)) {
+        fprintf(stderr, "Warning: -gx/--git-index has no effect with -r/--rev.\n");
+    }
+
+    if (update_path) {
+        if (reconstruct_mode || output_file || (flags & (SPLIT_OUTPUT | STRUCTURE_ONLY)) || split_parts > 0) {
+            fprintf(stderr, "Error: --update cannot be combined with -rc, -o, -s, -sp, -st or -k.\n");
+            return 1;
+        }
+        if (!use_cache) {
+            fprintf(stderr, "Warning: with -nc/--no-cache, --update re-renders every file.\n");
+        }
+    }
+
     if (reconstruct_mode) {
         const char *out_dir = output_file ? output_file : ".";
         return reconstruct_from_markdown(input_dir, out_dir);
     }
 
+    if (split_parts > 0 && (flags & SPLIT_OUTPUT)) {
+        fprintf(stderr, "Warning: -sp/--split-tokens have no effect with -k/--parts.\n");
+        flags &= ~SPLIT_OUTPUT;
+    }
+    set_split_parts(split_parts);
+
     // Set split options in writer module if SPLIT_OUTPUT flag is enabled.
     if (flags & SPLIT_OUTPUT) {
         set_split_options(1, split_limit_mb);
+        set_split_tokens(split_tokens);
     }
 
+    set_thread_count(threads);
+    set_source_revision(rev);
+    set_file_cache(use_cache, NULL);
+
     // Set extra ignore patterns for files (if any)
     if (ignore_patterns_count > 0) {
         set_extra_ignore_patterns(ignore_patterns, ignore_patterns_count);
     }
 
-    int result = document_directory(input_dir, output_file, flags);
+    int result = update_path ? update_document(update_path, input_dir, flags)
+                             : document_directory(input_dir, output_file, flags);
 
     free_extra_ignore_patterns();
 
@@ -16,16 +16,31 @@ extern "C" {
 #define STRUCTURE_ONLY   0x02
 #define SPLIT_OUTPUT     0x04  // New flag: split output into multiple files
 #define INCLUDE_GIT      0x08  // New flag: include .git folders
+#define GIT_INDEX        0x10  // Take the file list from .git/index instead of walking the tree
+#define INCLUDE_UNTRACKED 0x20 // With GIT_INDEX: also add untracked files that are not ignored
 
 typedef struct {
     char *path;
     bool is_dir;
     int depth;
+    bool has_meta;      // size/is_binary below were collected by the prefetch stage
+    bool is_binary;     // binary verdict from the first block of the file
+    long long size;     // file size in bytes, or -1 if unknown
+    char *head;         // whole contents of a text file that fit in the probed block, or NULL
+    unsigned long long dev, ino; // file identity for the cache, set along with head
+    long long mtime_ns;
+    unsigned char oid[32]; // blob id, only set for entries listed from a git tree
 } FileEntry;
 
 typedef struct {
     size_t total_size;
     size_t total_tokens;
+    size_t contents_offset;  // output offset of the "## Contents" section, 0 if none
+    size_t split_parts;      // number of _partN files written, 0 for a single file
+    size_t total_lines;      // lines of the file contents written
+    size_t invalid_utf8_files; // text files whose contents are not valid UTF-8
+    size_t cache_lookups;    // files looked up in the cache, 0 without one
+    size_t cache_hits;       // files written from cached results
 } DocumentInfo;
 
 /**
@@ -3,100 +3,706 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
-#include <regex.h>
+#include <stdint.h>
+#include <pthread.h>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #define MAX_LINE_LENGTH 1024
 
-/**
- * @brief Escapes regex special characters in a string.
- *
- * Allocates and returns a new string where characters that have special meaning
- * in regular expressions are prefixed with a backslash.
- *
- * @param str Input string to escape.
- * @return char* Newly allocated escaped string or NULL on failure.
- */
-static char *escape_regex(const char *str) {
-    size_t len = strlen(str);
-    char *escaped = (char*)malloc(2 * len + 1); // worst-case: every character escaped
-    if (!escaped) return NULL;
-    char *dest = escaped;
-    for (size_t i = 0; i < len; i++) {
-        if (strchr(".^$+?()[]{}|\\", str[i])) {
-            *dest++ = '\\';
-        }
-        *dest++ = str[i];
-    }
-    *dest = '\0';
-    return escaped;
-}
+// Serializes lazy construction of combined matchers.
+static pthread_mutex_t g_matcher_build_lock = PTHREAD_MUTEX_INITIALIZER;
 
 /**
- * @brief Convert a gitignore pattern to a POSIX regular expression.
+ * @brief Compile a gitignore pattern into a glob program.
  *
- * This simplified translator handles `**`, `*` and `?` wildcards and optionally
- * appends a directory-only suffix when `dir_only` is true.
+ * Handles `**`, `*` and `?` wildcards; every other byte is matched literally.
+ * Unanchored patterns and a `**` followed by '/' match zero or more whole
+ * leading directories, so "build" matches "build" and "src/build" but not
+ * "mybuild", as in git. The directory-only suffix is not part of the program;
+ * the matcher adds it from the rule's dir_only flag.
  *
- * @param pattern The gitignore pattern string.
- * @param dir_only Non-zero if the pattern applies only to directories.
- * @return char* Newly allocated regex string or NULL on failure.
+ * @param pattern The gitignore pattern string (without '!' or trailing '/').
+ * @param token_count Output: number of tokens produced.
+ * @return GlobToken* Newly allocated token array or NULL on failure.
  */
-static char *translate_gitignore_pattern(const char *pattern, bool dir_only) {
+static GlobToken *compile_glob(const char *pattern, size_t *token_count) {
     size_t len = strlen(pattern);
-    // Allocate a buffer that is large enough for worst-case expansion.
-    char *regex_pattern = (char*)malloc(4 * len + 16); // Added extra space for directory pattern
-    if (!regex_pattern) return NULL;
-    char *dest = regex_pattern;
-    
-    // If the pattern is anchored (starts with '/'), then match beginning of string.
+    GlobToken *tokens = (GlobToken*)malloc((len + 2) * sizeof(GlobToken));
+    if (!tokens) return NULL;
+    size_t n = 0;
+
     if (pattern[0] == '/') {
-        *dest++ = '^';
-        pattern++; // skip leading '/'
+        pattern++; // anchored: match from the beginning of the path
     } else {
-        // Not anchored: allow match anywhere in the string.
-        *dest++ = '^';
-        *dest++ = '.';
-        *dest++ = '*';
+        // Not anchored: allow match below any directory.
+        tokens[n].op = GLOB_DIRS;
+        tokens[n++].ch = 0;
     }
-    
+
     while (*pattern) {
         if (pattern[0] == '*' && pattern[1] == '*') {
-            // Handle "**": match any sequence (including '/')
+            // Handle "**": "**/" matches whole directories, a bare "**" any sequence
             pattern += 2;
             if (*pattern == '/') {
                 pattern++;
+                tokens[n].op = GLOB_DIRS;
+            } else {
+                tokens[n].op = GLOB_DOUBLE_STAR;
             }
-            strcpy(dest, ".*");
-            dest += 2;
         } else if (*pattern == '*') {
-            pattern++;
             // Single '*' matches any sequence except '/'
-            strcpy(dest, "[^/]*");
-            dest += strlen("[^/]*");
+            pattern++;
+            tokens[n].op = GLOB_STAR;
         } else if (*pattern == '?') {
             pattern++;
-            *dest++ = '.';
+            tokens[n].op = GLOB_ANY;
         } else {
-            // Escape regex special characters if needed.
-            if (strchr(".^$+?()[]{}|\\", *pattern)) {
-                *dest++ = '\\';
+            tokens[n].op = GLOB_LITERAL;
+            tokens[n++].ch = (unsigned char)*pattern++;
+            continue;
+        }
+        tokens[n++].ch = 0;
+    }
+
+    *token_count = n;
+    return tokens;
+}
+
+/*
+ * Combined matcher.
+ *
+ * Literal rules never reach the automaton: plain names, "*.ext" suffixes and
+ * anchored literal paths are looked up in hash tables keyed by path
+ * component, extension or path prefix, each slot remembering the highest rule
+ * index for its key. The automaton holds only the remaining general rules and
+ * is skipped when none of them could outrank the best literal match.
+ *
+ * Every general rule's glob program is laid out as a run of NFA states, one
+ * per token (two for GLOB_DIRS). The final state accepts;
+ * for directory-only rules it is followed by a tail state, reached on '/',
+ * that accepts anything below the directory. The NFA over all rules is
+ * determinized lazily: each DFA state is a set of NFA states, remembers the
+ * highest-numbered rule accepting in it (the last match wins) and caches its
+ * outgoing transitions, so a path costs one table lookup per byte however
+ * many rules there are. Transitions are published with release/acquire
+ * atomics so scanner threads match without locking; only building a missing
+ * transition takes the matcher's mutex. Once the DFA reaches its size budget,
+ * matching finishes by stepping the NFA directly.
+ */
+
+enum {
+    NFA_LITERAL,
+    NFA_ANY,
+    NFA_STAR,
+    NFA_DOUBLE_STAR,
+    NFA_DIRS_START,     // start of "(.*/)?": may skip ahead, or enter a directory name
+    NFA_DIRS_INNER,     // inside a skipped directory name, waiting for its '/'
+    NFA_ACCEPT,         // end of a rule
+    NFA_ACCEPT_DIR,     // end of a directory-only rule; '/' continues into the tail
+    NFA_TAIL            // anything below a matched directory
+};
+
+typedef struct {
+    unsigned char kind;
+    unsigned char ch;
+    int rule;
+} NfaState;
+
+#define DFA_BLOCK_STATES 64
+#define DFA_MAX_STATES 4096
+#define DFA_MEMORY_BUDGET (32u * 1024u * 1024u)
+#define DFA_UNKNOWN (-1)
+
+typedef struct {
+    uint64_t *set;          // NFA states contained in this DFA state
+    int match_rule;         // highest accepting rule index, or -1
+    int next[256];          // cached transitions (DFA_UNKNOWN until built)
+} DfaState;
+
+// Hash index from a literal key to the highest rule matching it.
+typedef struct {
+    const char *key;        // points into the rule's pattern string
+    size_t len;
+    int file_rule;          // highest rule that matches the key as a final component
+    int dir_rule;           // highest directory-only rule (also matches parents)
+} RuleSlot;
+
+typedef struct {
+    RuleSlot *slots;        // NULL when empty
+    size_t size;            // power of two
+    size_t count;
+    bool has_dir_rules;     // whether non-final components need lookups
+} RuleIndex;
+
+struct GitignoreMatcher {
+    RuleIndex basenames;    // GITIGNORE_RULE_BASENAME keyed by name
+    RuleIndex suffixes;     // GITIGNORE_RULE_SUFFIX keyed by ".ext"
+    RuleIndex anchored;     // GITIGNORE_RULE_ANCHORED keyed by path
+    size_t max_suffix_len;
+    int general_max;        // highest general rule index, or -1 without any
+
+    NfaState *nfa;
+    size_t nfa_count;
+    size_t set_words;       // uint64_t words per state set
+
+    pthread_mutex_t lock;   // guards DFA construction
+    DfaState **blocks;      // DFA states in fixed blocks so they never move
+    int dfa_count;
+    int dfa_max;
+    int *table;             // open-addressing index from set hash to DFA id
+    size_t table_size;
+    int start;
+};
+
+/**
+ * @brief Add an NFA state and its epsilon closure to a state set.
+ *
+ * Star and directory-prefix states may match the empty string, so the state
+ * following them is added too.
+ *
+ * @param m The matcher.
+ * @param set State set to update.
+ * @param state NFA state index.
+ */
+static void nfa_add(const GitignoreMatcher *m, uint64_t *set, size_t state) {
+    for (;;) {
+        set[state / 64] |= (uint64_t)1 << (state % 64);
+        unsigned char kind = m->nfa[state].kind;
+        if (kind == NFA_STAR || kind == NFA_DOUBLE_STAR) {
+            state++;
+        } else if (kind == NFA_DIRS_START) {
+            state += 2;
+        } else {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Advance a set of NFA states over one input byte.
+ *
+ * @param m The matcher.
+ * @param in Current state set.
+ * @param out Output state set (overwritten).
+ * @param c Input byte.
+ */
+static void nfa_step(const GitignoreMatcher *m, const uint64_t *in, uint64_t *out, unsigned char c) {
+    memset(out, 0, m->set_words * sizeof(uint64_t));
+    for (size_t w = 0; w < m->set_words; w++) {
+        uint64_t bits = in[w];
+        while (bits) {
+            size_t state = w * 64 + (size_t)__builtin_ctzll(bits);
+            bits &= bits - 1;
+            const NfaState *ns = &m->nfa[state];
+            switch (ns->kind) {
+            case NFA_LITERAL:
+                if (c == ns->ch) nfa_add(m, out, state + 1);
+                break;
+            case NFA_ANY:
+                nfa_add(m, out, state + 1);
+                break;
+            case NFA_STAR:
+                if (c != '/') nfa_add(m, out, state);
+                break;
+            case NFA_DOUBLE_STAR:
+            case NFA_TAIL:
+                nfa_add(m, out, state);
+                break;
+            case NFA_DIRS_START:
+                nfa_add(m, out, c == '/' ? state : state + 1);
+                break;
+            case NFA_DIRS_INNER:
+                nfa_add(m, out, c == '/' ? state - 1 : state);
+                break;
+            case NFA_ACCEPT_DIR:
+                if (c == '/') nfa_add(m, out, state + 1);
+                break;
+            default:
+                break;
             }
-            *dest++ = *pattern++;
         }
     }
-    
-    // For directory patterns, append a pattern that matches paths inside the directory
+}
+
+/**
+ * @brief Find the highest-numbered rule accepting in a state set.
+ *
+ * @param m The matcher.
+ * @param set State set.
+ * @return int Rule index, or -1 if no state accepts.
+ */
+static int nfa_match_rule(const GitignoreMatcher *m, const uint64_t *set) {
+    int best = -1;
+    for (size_t w = 0; w < m->set_words; w++) {
+        uint64_t bits = set[w];
+        while (bits) {
+            size_t state = w * 64 + (size_t)__builtin_ctzll(bits);
+            bits &= bits - 1;
+            const NfaState *ns = &m->nfa[state];
+            if ((ns->kind == NFA_ACCEPT || ns->kind == NFA_ACCEPT_DIR || ns->kind == NFA_TAIL) &&
+                ns->rule > best) {
+                best = ns->rule;
+            }
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Hash a byte string.
+ *
+ * @param key Bytes to hash.
+ * @param len Number of bytes.
+ * @return uint64_t FNV-1a hash.
+ */
+static uint64_t key_hash(const char *key, size_t len) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= (unsigned char)key[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+/**
+ * @brief Record a rule under a key, keeping the highest rule index per key.
+ *
+ * @param index Index to update.
+ * @param key Key bytes (must outlive the index).
+ * @param len Key length.
+ * @param rule Rule index.
+ * @param dir_only Whether the rule is directory-only.
+ * @return int 0 on success, -1 on allocation failure.
+ */
+static int rule_index_add(RuleIndex *index, const char *key, size_t len, int rule, bool dir_only) {
+    if ((index->count + 1) * 2 > index->size) {
+        size_t new_size = index->size ? index->size * 2 : 64;
+        RuleSlot *slots = (RuleSlot*)calloc(new_size, sizeof(RuleSlot));
+        if (!slots) return -1;
+        for (size_t i = 0; i < index->size; i++) {
+            if (!index->slots[i].key) continue;
+            size_t slot = (size_t)key_hash(index->slots[i].key, index->slots[i].len) & (new_size - 1);
+            while (slots[slot].key) slot = (slot + 1) & (new_size - 1);
+            slots[slot] = index->slots[i];
+        }
+        free(index->slots);
+        index->slots = slots;
+        index->size = new_size;
+    }
+
+    size_t mask = index->size - 1;
+    size_t slot = (size_t)key_hash(key, len) & mask;
+    while (index->slots[slot].key &&
+           !(index->slots[slot].len == len && memcmp(index->slots[slot].key, key, len) == 0)) {
+        slot = (slot + 1) & mask;
+    }
+    RuleSlot *entry = &index->slots[slot];
+    if (!entry->key) {
+        entry->key = key;
+        entry->len = len;
+        entry->file_rule = -1;
+        entry->dir_rule = -1;
+        index->count++;
+    }
+    // Rules are added in order, so the latest one is always the highest.
     if (dir_only) {
-        strcpy(dest, "(/.*)?$");
-        dest += strlen("(/.*)?$");
+        entry->dir_rule = rule;
+        index->has_dir_rules = true;
     } else {
-        // Regular end of pattern marker
-        *dest++ = '$';
-        *dest = '\0';
+        entry->file_rule = rule;
     }
-    
-    return regex_pattern;
+    return 0;
+}
+
+/**
+ * @brief Look up the rules recorded for a key.
+ *
+ * @param index Index to search.
+ * @param key Key bytes.
+ * @param len Key length.
+ * @param final_component Whether the key ends the path; if not, only
+ *        directory-only rules apply.
+ * @return int Highest applicable rule index, or -1.
+ */
+static int rule_index_find(const RuleIndex *index, const char *key, size_t len, bool final_component) {
+    if (index->count == 0 || (!final_component && !index->has_dir_rules)) return -1;
+    size_t mask = index->size - 1;
+    size_t slot = (size_t)key_hash(key, len) & mask;
+    while (index->slots[slot].key) {
+        const RuleSlot *entry = &index->slots[slot];
+        if (entry->len == len && memcmp(entry->key, key, len) == 0) {
+            if (!final_component) return entry->dir_rule;
+            return entry->file_rule > entry->dir_rule ? entry->file_rule : entry->dir_rule;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+/**
+ * @brief Find the highest literal (hash-indexed) rule matching a path.
+ *
+ * @param m The matcher.
+ * @param path Relative path to test.
+ * @return int Rule index, or -1 if no literal rule matches.
+ */
+static int literal_match(const GitignoreMatcher *m, const char *path) {
+    int best = -1;
+    const char *component = path;
+    for (;;) {
+        const char *end = strchr(component, '/');
+        bool final = (end == NULL);
+        if (final) end = component + strlen(component);
+        size_t len = (size_t)(end - component);
+        int rule;
+
+        if (final || m->basenames.has_dir_rules) {
+            rule = rule_index_find(&m->basenames, component, len, final);
+            if (rule > best) best = rule;
+        }
+        if (m->suffixes.count && (final || m->suffixes.has_dir_rules)) {
+            // Try every extension of the component, e.g. ".tar.gz" and ".gz".
+            for (const char *dot = component; dot < end; dot++) {
+                if (*dot != '.' || (size_t)(end - dot) > m->max_suffix_len) continue;
+                rule = rule_index_find(&m->suffixes, dot, (size_t)(end - dot), final);
+                if (rule > best) best = rule;
+            }
+        }
+        if (final || m->anchored.has_dir_rules) {
+            rule = rule_index_find(&m->anchored, path, (size_t)(end - path), final);
+            if (rule > best) best = rule;
+        }
+
+        if (final) break;
+        component = end + 1;
+    }
+    return best;
+}
+
+/**
+ * @brief Look up a DFA state by id.
+ *
+ * @param m The matcher.
+ * @param id DFA state id.
+ * @return DfaState* The state.
+ */
+static DfaState *dfa_state(const GitignoreMatcher *m, int id) {
+    return &m->blocks[id / DFA_BLOCK_STATES][id % DFA_BLOCK_STATES];
+}
+
+/**
+ * @brief Hash a state set.
+ *
+ * @param set State set.
+ * @param words Number of words in the set.
+ * @return uint64_t FNV-1a style hash of the set.
+ */
+static uint64_t set_hash(const uint64_t *set, size_t words) {
+    uint64_t h = 1469598103934665603ULL;
+    for (size_t i = 0; i < words; i++) {
+        h ^= set[i];
+        h *= 1099511628211ULL;
+    }
+    return h ^ (h >> 29);
+}
+
+/**
+ * @brief Find or create the DFA state for a state set. Caller holds m->lock.
+ *
+ * @param m The matcher.
+ * @param set State set (copied if a new state is created).
+ * @return int DFA state id, or -1 if the DFA budget is exhausted.
+ */
+static int dfa_intern(GitignoreMatcher *m, const uint64_t *set) {
+    size_t mask = m->table_size - 1;
+    size_t slot = (size_t)set_hash(set, m->set_words) & mask;
+    while (m->table[slot] >= 0) {
+        const DfaState *candidate = dfa_state(m, m->table[slot]);
+        if (memcmp(candidate->set, set, m->set_words * sizeof(uint64_t)) == 0) {
+            return m->table[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    if (m->dfa_count >= m->dfa_max) {
+        return -1;
+    }
+
+    int id = m->dfa_count;
+    int block = id / DFA_BLOCK_STATES;
+    if (!m->blocks[block]) {
+        m->blocks[block] = (DfaState*)malloc(DFA_BLOCK_STATES * sizeof(DfaState));
+        if (!m->blocks[block]) return -1;
+    }
+    DfaState *state = dfa_state(m, id);
+    state->set = (uint64_t*)malloc(m->set_words * sizeof(uint64_t));
+    if (!state->set) return -1;
+    memcpy(state->set, set, m->set_words * sizeof(uint64_t));
+    state->match_rule = nfa_match_rule(m, set);
+    for (int c = 0; c < 256; c++) {
+        state->next[c] = DFA_UNKNOWN;
+    }
+    m->table[slot] = id;
+    m->dfa_count++;
+    return id;
+}
+
+/**
+ * @brief Free a combined matcher.
+ *
+ * @param m Matcher to free (may be NULL).
+ */
+static void matcher_free(GitignoreMatcher *m) {
+    if (!m) return;
+    free(m->basenames.slots);
+    free(m->suffixes.slots);
+    free(m->anchored.slots);
+    for (int i = 0; i < m->dfa_count; i++) {
+        free(dfa_state(m, i)->set);
+    }
+    if (m->blocks) {
+        for (int b = 0; b * DFA_BLOCK_STATES < m->dfa_max; b++) {
+            free(m->blocks[b]);
+        }
+    }
+    free(m->blocks);
+    free(m->table);
+    free(m->nfa);
+    pthread_mutex_destroy(&m->lock);
+    free(m);
+}
+
+/**
+ * @brief Number of NFA states a general rule occupies.
+ *
+ * @param rule The rule.
+ * @return size_t State count, including the accepting state(s).
+ */
+static size_t rule_nfa_size(const GitignoreRule *rule) {
+    size_t size = rule->dir_only ? 2 : 1;
+    for (size_t t = 0; t < rule->token_count; t++) {
+        size += rule->tokens[t].op == GLOB_DIRS ? 2 : 1;
+    }
+    return size;
+}
+
+/**
+ * @brief Build the combined matcher for every rule of a list.
+ *
+ * @param list Gitignore list.
+ * @return GitignoreMatcher* New matcher, or NULL on allocation failure.
+ */
+static GitignoreMatcher *matcher_build(const GitignoreList *list) {
+    GitignoreMatcher *m = (GitignoreMatcher*)calloc(1, sizeof(GitignoreMatcher));
+    if (!m) return NULL;
+    pthread_mutex_init(&m->lock, NULL);
+    m->general_max = -1;
+    m->start = -1;
+
+    // Literal rules go to the hash indexes, the rest to the automaton.
+    size_t total = 0;
+    for (size_t r = 0; r < list->count; r++) {
+        const GitignoreRule *rule = &list->rules[r];
+        const char *key = rule->anchored ? rule->pattern + 1 : rule->pattern;
+        int ret = 0;
+        switch (rule->kind) {
+        case GITIGNORE_RULE_BASENAME:
+            ret = rule_index_add(&m->basenames, key, strlen(key), (int)r, rule->dir_only);
+            break;
+        case GITIGNORE_RULE_SUFFIX:
+            key++; // skip the '*'
+            ret = rule_index_add(&m->suffixes, key, strlen(key), (int)r, rule->dir_only);
+            if (strlen(key) > m->max_suffix_len) m->max_suffix_len = strlen(key);
+            break;
+        case GITIGNORE_RULE_ANCHORED:
+            ret = rule_index_add(&m->anchored, key, strlen(key), (int)r, rule->dir_only);
+            break;
+        default:
+            total += rule_nfa_size(rule);
+            m->general_max = (int)r;
+            break;
+        }
+        if (ret != 0) {
+            matcher_free(m);
+            return NULL;
+        }
+    }
+    if (m->general_max < 0) {
+        return m;
+    }
+
+    m->nfa_count = total;
+    m->set_words = (total + 63) / 64;
+    if (m->set_words == 0) m->set_words = 1;
+    m->nfa = (NfaState*)calloc(total ? total : 1, sizeof(NfaState));
+
+    // Bound the DFA by both a state count and the memory its state sets take.
+    size_t per_state = sizeof(DfaState) + m->set_words * sizeof(uint64_t);
+    size_t max_by_memory = DFA_MEMORY_BUDGET / per_state;
+    m->dfa_max = (int)(max_by_memory < DFA_MAX_STATES ? max_by_memory : DFA_MAX_STATES);
+    if (m->dfa_max < 2) m->dfa_max = 2;
+    m->blocks = (DfaState**)calloc((m->dfa_max + DFA_BLOCK_STATES - 1) / DFA_BLOCK_STATES, sizeof(DfaState*));
+    m->table_size = 1;
+    while (m->table_size < (size_t)m->dfa_max * 2) m->table_size <<= 1;
+    m->table = (int*)malloc(m->table_size * sizeof(int));
+    uint64_t *start_set = (uint64_t*)calloc(m->set_words, sizeof(uint64_t));
+    if (!m->nfa || !m->blocks || !m->table || !start_set) {
+        free(start_set);
+        matcher_free(m);
+        return NULL;
+    }
+    for (size_t i = 0; i < m->table_size; i++) m->table[i] = -1;
+
+    size_t base = 0;
+    for (size_t r = 0; r < list->count; r++) {
+        const GitignoreRule *rule = &list->rules[r];
+        if (rule->kind != GITIGNORE_RULE_GENERAL) continue;
+        size_t state = base;
+        for (size_t t = 0; t < rule->token_count; t++) {
+            NfaState *ns = &m->nfa[state++];
+            ns->rule = (int)r;
+            switch (rule->tokens[t].op) {
+            case GLOB_LITERAL:
+                ns->kind = NFA_LITERAL;
+                ns->ch = rule->tokens[t].ch;
+                break;
+            case GLOB_ANY:
+                ns->kind = NFA_ANY;
+                break;
+            case GLOB_STAR:
+                ns->kind = NFA_STAR;
+                break;
+            case GLOB_DIRS:
+                ns->kind = NFA_DIRS_START;
+                ns[1].kind = NFA_DIRS_INNER;
+                ns[1].rule = (int)r;
+                state++;
+                break;
+            default:
+                ns->kind = NFA_DOUBLE_STAR;
+                break;
+            }
+        }
+        NfaState *end = &m->nfa[state];
+        end->kind = rule->dir_only ? NFA_ACCEPT_DIR : NFA_ACCEPT;
+        end->rule = (int)r;
+        if (rule->dir_only) {
+            end[1].kind = NFA_TAIL;
+            end[1].rule = (int)r;
+        }
+        nfa_add(m, start_set, base);
+        base += rule_nfa_size(rule);
+    }
+
+    m->start = dfa_intern(m, start_set);
+    free(start_set);
+    if (m->start < 0) {
+        matcher_free(m);
+        return NULL;
+    }
+    return m;
+}
+
+/**
+ * @brief Run the general-rule automaton over a path.
+ *
+ * @param m The matcher.
+ * @param path Relative path to test.
+ * @return int Index of the last general rule matching the whole path, or -1.
+ */
+static int automaton_run(GitignoreMatcher *m, const char *path) {
+    int cur = m->start;
+    const unsigned char *p = (const unsigned char*)path;
+    for (; *p; p++) {
+        int next = __atomic_load_n(&dfa_state(m, cur)->next[*p], __ATOMIC_ACQUIRE);
+        if (next == DFA_UNKNOWN) {
+            pthread_mutex_lock(&m->lock);
+            next = dfa_state(m, cur)->next[*p];
+            if (next == DFA_UNKNOWN) {
+                uint64_t *out = (uint64_t*)malloc(m->set_words * sizeof(uint64_t));
+                if (out) {
+                    nfa_step(m, dfa_state(m, cur)->set, out, *p);
+                    next = dfa_intern(m, out);
+                    free(out);
+                }
+                if (next >= 0) {
+                    __atomic_store_n(&dfa_state(m, cur)->next[*p], next, __ATOMIC_RELEASE);
+                }
+            }
+            pthread_mutex_unlock(&m->lock);
+            if (next < 0) break; // DFA budget exhausted: finish on the NFA below
+        }
+        cur = next;
+    }
+    if (!*p) {
+        return dfa_state(m, cur)->match_rule;
+    }
+
+    uint64_t *a = (uint64_t*)malloc(m->set_words * sizeof(uint64_t));
+    uint64_t *b = (uint64_t*)malloc(m->set_words * sizeof(uint64_t));
+    int result = -1;
+    if (a && b) {
+        memcpy(a, dfa_state(m, cur)->set, m->set_words * sizeof(uint64_t));
+        for (; *p; p++) {
+            nfa_step(m, a, b, *p);
+            uint64_t *tmp = a;
+            a = b;
+            b = tmp;
+        }
+        result = nfa_match_rule(m, a);
+    }
+    free(a);
+    free(b);
+    return result;
+}
+
+/**
+ * @brief Run the combined matcher over a path.
+ *
+ * @param m The matcher.
+ * @param path Relative path to test.
+ * @return int Index of the last rule matching the whole path, or -1.
+ */
+static int matcher_run(GitignoreMatcher *m, const char *path) {
+    int best = literal_match(m, path);
+    // The automaton can only change the outcome if a later general rule exists.
+    if (m->general_max > best) {
+        int rule = automaton_run(m, path);
+        if (rule > best) best = rule;
+    }
+    return best;
+}
+
+/**
+ * @brief Classify a rule for the matcher's fast paths.
+ *
+ * @param pattern Pattern without '!' or trailing '/'.
+ * @param anchored Whether the pattern starts with '/'.
+ * @return GitignoreRuleKind The rule's kind.
+ */
+static GitignoreRuleKind classify_rule(const char *pattern, bool anchored) {
+    const char *body = anchored ? pattern + 1 : pattern;
+    if (*body == '\0') return GITIGNORE_RULE_GENERAL;
+    if (!strpbrk(body, "*?")) {
+        if (anchored) return GITIGNORE_RULE_ANCHORED;
+        if (!strchr(body, '/')) return GITIGNORE_RULE_BASENAME;
+        return GITIGNORE_RULE_GENERAL;
+    }
+    if (!anchored && body[0] == '*' && body[1] == '.' && !strpbrk(body + 1, "*?/")) {
+        return GITIGNORE_RULE_SUFFIX;
+    }
+    return GITIGNORE_RULE_GENERAL;
+}
+
+/**
+ * @brief Drop a list's combined matcher after its rules change.
+ *
+ * @param list Gitignore list.
+ */
+static void invalidate_matcher(GitignoreList *list) {
+    matcher_free(list->matcher);
+    list->matcher = NULL;
 }
 
 /**
@@ -137,18 +743,10 @@ int parse_gitignore_pattern_string(const char *pattern_str, GitignoreList *list)
         pattern[len - 1] = '\0'; // remove trailing '/'
     }
     
-    // Generate regex pattern from gitignore pattern
-    char *regex_str = translate_gitignore_pattern(pattern, dir_only);
-    if (!regex_str) {
-        free(pattern);
-        return -1;
-    }
-    
-    // Compile the regex
-    regex_t regex;
-    int ret = regcomp(&regex, regex_str, REG_EXTENDED | REG_NOSUB);
-    free(regex_str);
-    if (ret != 0) {
+    // Compile the glob program
+    size_t token_count = 0;
+    GlobToken *tokens = compile_glob(pattern, &token_count);
+    if (!tokens) {
         free(pattern);
         return -1;
     }
@@ -158,7 +756,7 @@ int parse_gitignore_pattern_string(const char *pattern_str, GitignoreList *list)
         size_t new_capacity = list->capacity ? list->capacity * 2 : 16;
         GitignoreRule *new_rules = (GitignoreRule*)realloc(list->rules, new_capacity * sizeof(GitignoreRule));
         if (!new_rules) {
-            regfree(&regex);
+            free(tokens);
             free(pattern);
             return -1;
         }
@@ -166,17 +764,38 @@ int parse_gitignore_pattern_string(const char *pattern_str, GitignoreList *list)
         list->capacity = new_capacity;
     }
     
-    // Add the new rule
+    // Add the new rule; the combined matcher is rebuilt on the next match.
+    invalidate_matcher(list);
     GitignoreRule *rule = &list->rules[list->count++];
     rule->pattern = pattern;
     rule->negation = negation;
     rule->anchored = anchored;
     rule->dir_only = dir_only;
-    rule->regex = regex;
+    rule->exclude = false;
+    rule->kind = classify_rule(pattern, anchored);
+    rule->tokens = tokens;
+    rule->token_count = token_count;
     
     return 0;
 }
 
+/**
+ * @brief Add a command-line exclude pattern to a list.
+ *
+ * @param pattern_str The pattern text.
+ * @param list Gitignore list of the scan root.
+ * @return int 0 on success, -1 on error.
+ */
+int add_gitignore_exclude(const char *pattern_str, GitignoreList *list) {
+    size_t count = list ? list->count : 0;
+    if (parse_gitignore_pattern_string(pattern_str, list) != 0) return -1;
+    if (list->count > count) {
+        list->rules[list->count - 1].exclude = true;
+        list->exclude_count++;
+    }
+    return 0;
+}
+
 /**
  * @brief Parse a single line from a .gitignore file.
  *
@@ -204,6 +823,25 @@ static int parse_gitignore_line(const char *line, GitignoreList *list) {
     return result;
 }
 
+/**
+ * @brief Read rules from an open .gitignore stream and close it.
+ *
+ * @param f Open stream.
+ * @param gitignore Gitignore list to append to.
+ */
+static void read_gitignore_stream(FILE *f, GitignoreList *gitignore) {
+    char line[MAX_LINE_LENGTH];
+    while (fgets(line, sizeof(line), f)) {
+        // Remove newline characters.
+        line[strcspn(line, "\r\n")] = '\0';
+        if (parse_gitignore_line(line, gitignore) != 0) {
+            // On error, skip this rule.
+            continue;
+        }
+    }
+    fclose(f);
+}
+
 /**
  * @brief Load rules from a .gitignore file located in a directory.
  *
@@ -214,23 +852,41 @@ void load_gitignore(const char *dir_path, GitignoreList *gitignore) {
     gitignore->rules = NULL;
     gitignore->count = 0;
     gitignore->capacity = 0;
+    gitignore->matcher = NULL;
     
     char gitignore_path[4096];
     snprintf(gitignore_path, sizeof(gitignore_path), "%s/.gitignore", dir_path);
     
     FILE *f = fopen(gitignore_path, "r");
     if (!f) return;
+    read_gitignore_stream(f, gitignore);
+}
+
+/**
+ * @brief Find the last rule of a list matching a path.
+ *
+ * @param path Relative path to test.
+ * @param gitignore Compiled gitignore rule list (may be NULL).
+ * @return int Index of the deciding rule, or -1 if no rule matches.
+ */
+static int match_gitignore_rule(const char *path, const GitignoreList *gitignore) {
+    if (!gitignore || gitignore->count == 0) return -1;
     
-    char line[MAX_LINE_LENGTH];
-    while (fgets(line, sizeof(line), f)) {
-        // Remove newline characters.
-        line[strcspn(line, "\r\n")] = '\0';
-        if (parse_gitignore_line(line, gitignore) != 0) {
-            // On error, skip this rule.
-            continue;
+    GitignoreMatcher *m = __atomic_load_n(&gitignore->matcher, __ATOMIC_ACQUIRE);
+    if (!m) {
+        // Build on first use; the lock keeps concurrent first matches from racing.
+        pthread_mutex_lock(&g_matcher_build_lock);
+        m = gitignore->matcher;
+        if (!m) {
+            m = matcher_build(gitignore);
+            __atomic_store_n(&((GitignoreList*)gitignore)->matcher, m, __ATOMIC_RELEASE);
         }
+        pthread_mutex_unlock(&g_matcher_build_lock);
+        if (!m) return -1;
     }
-    fclose(f);
+    
+    // The last matching rule decides whether the path is ignored.
+    return matcher_run(m, path);
 }
 
 /**
@@ -241,18 +897,8 @@ void load_gitignore(const char *dir_path, GitignoreList *gitignore) {
  * @return true if the path is ignored, false otherwise.
  */
 bool match_gitignore(const char *path, const GitignoreList *gitignore) {
-    if (!gitignore || gitignore->count == 0) return false;
-    
-    bool ignored = false;
-    for (size_t i = 0; i < gitignore->count; i++) {
-        const GitignoreRule *rule = &gitignore->rules[i];
-        int ret = regexec(&rule->regex, path, 0, NULL, 0);
-        if (ret == 0) {
-            // If the rule matches, update the ignored state based on whether it is a negation.
-            ignored = !rule->negation;
-        }
-    }
-    return ignored;
+    int rule = match_gitignore_rule(path, gitignore);
+    return rule >= 0 && !gitignore->rules[rule].negation;
 }
 
 /**
@@ -262,11 +908,87 @@ void free_gitignore(GitignoreList *gitignore) {
     if (!gitignore) return;
     for (size_t i = 0; i < gitignore->count; i++) {
         GitignoreRule *rule = &gitignore->rules[i];
-        regfree(&rule->regex);
+        free(rule->tokens);
         free(rule->pattern);
     }
+    invalidate_matcher(gitignore);
     free(gitignore->rules);
     gitignore->rules = NULL;
     gitignore->count = 0;
     gitignore->capacity = 0;
+    gitignore->exclude_count = 0;
+}
+
+/**
+ * @brief Open a nested scope for a directory that has its own .gitignore.
+ *
+ * @param parent Scope of the enclosing directory.
+ * @param dirfd Open descriptor of the directory.
+ * @param rel_dir Relative path of the directory from the scan root.
+ * @return GitignoreScope* New scope, or NULL if the directory has no rules.
+ */
+GitignoreScope *gitignore_scope_enter(const GitignoreScope *parent, int dirfd, const char *rel_dir) {
+    int fd = openat(dirfd, ".gitignore", O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+    FILE *f = fdopen(fd, "r");
+    if (!f) {
+        close(fd);
+        return NULL;
+    }
+    
+    GitignoreScope *scope = (GitignoreScope*)calloc(1, sizeof(GitignoreScope));
+    if (!scope) {
+        fclose(f);
+        return NULL;
+    }
+    read_gitignore_stream(f, &scope->owned);
+    if (scope->owned.count == 0) {
+        free_gitignore(&scope->owned);
+        free(scope);
+        return NULL;
+    }
+    scope->parent = parent;
+    scope->rules = &scope->owned;
+    scope->base_len = strlen(rel_dir);
+    return scope;
+}
+
+/**
+ * @brief Free a scope returned by gitignore_scope_enter().
+ */
+void gitignore_scope_free(GitignoreScope *scope) {
+    if (!scope) return;
+    free_gitignore(&scope->owned);
+    free(scope);
+}
+
+/**
+ * @brief Check a path against a chain of scopes, innermost first.
+ *
+ * @param path Relative path from the scan root.
+ * @param scope Innermost scope containing the path (may be NULL).
+ * @return true if the path should be ignored.
+ */
+bool match_gitignore_scoped(const char *path, const GitignoreScope *scope) {
+    // Command-line excludes live in the outermost scope, but a nested
+    // negation must not re-include what they ignore, so they are checked first.
+    const GitignoreScope *root = scope;
+    while (root && root->parent) root = root->parent;
+    if (root != scope && root->rules && root->rules->exclude_count > 0) {
+        const char *rel = root->base_len ? path + root->base_len + 1 : path;
+        int rule = match_gitignore_rule(rel, root->rules);
+        if (rule >= 0 && root->rules->rules[rule].exclude && !root->rules->rules[rule].negation) {
+            return true;
+        }
+    }
+    
+    for (; scope; scope = scope->parent) {
+        // Rules are relative to the directory holding the .gitignore.
+        const char *rel = scope->base_len ? path + scope->base_len + 1 : path;
+        int rule = match_gitignore_rule(rel, scope->rules);
+        if (rule >= 0) {
+            return !scope->rules->rules[rule].negation;
+        }
+    }
+    return false;
 }
@@ -3,24 +3,65 @@
 
 #include <stdbool.h>
 #include <stddef.h>
-#include <regex.h>
 
-// A single gitignore rule, including its original pattern and compiled regex.
+// Glob program instructions a gitignore pattern is compiled to.
+typedef enum {
+    GLOB_LITERAL,       // matches one specific byte
+    GLOB_ANY,           // '?'  - matches any single byte
+    GLOB_STAR,          // '*'  - matches any run of bytes except '/'
+    GLOB_DOUBLE_STAR,   // '**' - matches any run of bytes, including '/'
+    GLOB_DIRS           // leading or '**/' - matches zero or more whole directories
+} GlobOp;
+
+typedef struct {
+    unsigned char op;   // GlobOp
+    unsigned char ch;   // byte for GLOB_LITERAL
+} GlobToken;
+
+// How a rule is matched: the first three kinds are served by hash lookups,
+// only general rules go through the glob automaton.
+typedef enum {
+    GITIGNORE_RULE_GENERAL,     // wildcards or slashes: glob automaton
+    GITIGNORE_RULE_BASENAME,    // plain name such as "build" or "node_modules/"
+    GITIGNORE_RULE_SUFFIX,      // "*.ext" style extension glob
+    GITIGNORE_RULE_ANCHORED     // anchored literal path such as "/config/"
+} GitignoreRuleKind;
+
+// A single gitignore rule, including its original pattern and compiled glob program.
 typedef struct {
     char *pattern;      // original gitignore pattern (e.g. "**/*.log")
     bool negation;      // true if the rule is a negation (starts with '!')
     bool anchored;      // true if the pattern is anchored (starts with '/')
     bool dir_only;      // true if the rule applies only to directories (ends with '/')
-    regex_t regex;      // compiled regular expression for matching paths
+    bool exclude;       // true for command-line excludes, which no .gitignore can re-include
+    GitignoreRuleKind kind;
+    GlobToken *tokens;  // compiled glob program matched against the whole path
+    size_t token_count;
 } GitignoreRule;
 
+// Combined automaton over every rule of a list (opaque, see gitignore.c).
+typedef struct GitignoreMatcher GitignoreMatcher;
+
 // A collection of gitignore rules.
 typedef struct {
     GitignoreRule *rules;
     size_t count;
     size_t capacity;
+    size_t exclude_count;       // rules added by add_gitignore_exclude()
+    GitignoreMatcher *matcher;  // built lazily on the first match, freed on change
 } GitignoreList;
 
+// Rules of one .gitignore file, applied to paths below the directory holding it.
+// Scopes form an immutable chain from a directory up to the scan root, so a
+// subtree sees exactly the ignore files of its ancestors.
+typedef struct GitignoreScope GitignoreScope;
+struct GitignoreScope {
+    const GitignoreScope *parent;   // enclosing scope, NULL at the root
+    const GitignoreList *rules;     // rules of this scope (may be NULL)
+    size_t base_len;                // length of the directory's relative path, 0 at the root
+    GitignoreList owned;            // storage for rules loaded by gitignore_scope_enter()
+};
+
 /**
  * @brief Load gitignore rules from a directory.
  *
@@ -38,9 +79,25 @@ void load_gitignore(const char *dir_path, GitignoreList *gitignore);
  */
 int parse_gitignore_pattern_string(const char *pattern, GitignoreList *list);
 
+/**
+ * @brief Add a command-line exclude pattern to a list.
+ *
+ * Parsed like a .gitignore line, but when the rule ignores a path, negations
+ * in nested scopes cannot re-include it.
+ *
+ * @param pattern Pattern text.
+ * @param list Gitignore list of the scan root.
+ * @return int 0 on success, -1 on error.
+ */
+int add_gitignore_exclude(const char *pattern, GitignoreList *list);
+
 /**
  * @brief Check if a path matches gitignore rules.
  *
+ * Literal, extension and anchored rules are answered by hash lookups and the
+ * remaining rules by a single automaton in one pass over the path; the last
+ * matching rule decides. Safe to call concurrently.
+ *
  * @param path Relative path to test.
  * @param gitignore Compiled gitignore list.
  * @return true if the path should be ignored.
@@ -52,4 +109,33 @@ bool match_gitignore(const char *path, const GitignoreList *gitignore);
  */
 void free_gitignore(GitignoreList *gitignore);
 
+/**
+ * @brief Open a nested scope for a directory that has its own .gitignore.
+ *
+ * @param parent Scope of the enclosing directory.
+ * @param dirfd Open descriptor of the directory.
+ * @param rel_dir Relative path of the directory from the scan root.
+ * @return GitignoreScope* New scope, or NULL if the directory has no rules
+ *         (callers then keep using the parent scope).
+ */
+GitignoreScope *gitignore_scope_enter(const GitignoreScope *parent, int dirfd, const char *rel_dir);
+
+/**
+ * @brief Free a scope returned by gitignore_scope_enter().
+ */
+void gitignore_scope_free(GitignoreScope *scope);
+
+/**
+ * @brief Check a path against a chain of scopes.
+ *
+ * The innermost scope with a matching rule decides, so deeper .gitignore
+ * files override their ancestors as in git. Command-line excludes of the
+ * outermost scope are checked first and win over every .gitignore.
+ *
+ * @param path Relative path from the scan root.
+ * @param scope Innermost scope containing the path (may be NULL).
+ * @return true if the path should be ignored.
+ */
+bool match_gitignore_scoped(const char *path, const GitignoreScope *scope);
+
 #endif
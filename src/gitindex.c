@@ -0,0 +1,312 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <sys/stat.h>
+
+#include "gitindex.h"
+#include "scanner.h"
+#include "gitignore.h"
+#include "dirdoc.h"
+
+// Fixed part of an on-disk index entry: ctime, mtime, dev, ino, mode, uid,
+// gid and size (4 bytes each) followed by the object id and the flags word.
+#define INDEX_STAT_SIZE 40
+#define INDEX_FLAG_EXTENDED 0x4000
+#define INDEX_FLAG_STAGE_MASK 0x3000
+#define INDEX_FLAG_NAME_MASK 0x0fff
+#define INDEX_EXT_SKIP_WORKTREE 0x4000
+#define INDEX_MODE_TYPE_MASK 0170000
+#define INDEX_MODE_GITLINK 0160000
+#define INDEX_MODE_DIR 0040000
+
+/**
+ * @brief Reads a big-endian 32-bit value.
+ *
+ * @param p Pointer to four bytes.
+ * @return uint32_t Decoded value.
+ */
+static uint32_t get_be32(const unsigned char *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief Reads a big-endian 16-bit value.
+ *
+ * @param p Pointer to two bytes.
+ * @return uint16_t Decoded value.
+ */
+static uint16_t get_be16(const unsigned char *p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+/**
+ * @brief Reads a whole file into memory.
+ *
+ * @param path File to read.
+ * @param len Output: number of bytes read.
+ * @return unsigned char* Newly allocated contents with room for a trailing
+ *         NUL, or NULL on failure.
+ */
+unsigned char *read_git_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    struct stat st;
+    if (fstat(fileno(f), &st) != 0 || st.st_size < 0) {
+        fclose(f);
+        return NULL;
+    }
+    unsigned char *data = (unsigned char*)malloc((size_t)st.st_size + 1);
+    if (!data) {
+        fclose(f);
+        return NULL;
+    }
+    *len = fread(data, 1, (size_t)st.st_size, f);
+    fclose(f);
+    return data;
+}
+
+/**
+ * @brief Find the git directory of a worktree.
+ *
+ * @param worktree Root directory of the checkout.
+ * @param git_dir Output buffer for the git directory path.
+ * @param size Size of the output buffer.
+ * @return true if a git directory was found.
+ */
+bool find_git_dir(const char *worktree, char *git_dir, size_t size) {
+    char dot_git[MAX_PATH_LEN];
+    snprintf(dot_git, sizeof(dot_git), "%s/.git", worktree);
+    struct stat st;
+    if (stat(dot_git, &st) != 0) return false;
+    if (S_ISDIR(st.st_mode)) {
+        snprintf(git_dir, size, "%s", dot_git);
+        return true;
+    }
+
+    // A .git file holds "gitdir: <path>", relative to the worktree if not absolute.
+    size_t len = 0;
+    char *text = (char*)read_git_file(dot_git, &len);
+    if (!text) return false;
+    text[len] = '\0';
+    bool found = false;
+    if (strncmp(text, "gitdir:", 7) == 0) {
+        char *target = text + 7;
+        while (*target == ' ') target++;
+        target[strcspn(target, "\r\n")] = '\0';
+        if (target[0] == '/') {
+            snprintf(git_dir, size, "%s", target);
+        } else {
+            snprintf(git_dir, size, "%s/%s", worktree, target);
+        }
+        found = true;
+    }
+    free(text);
+    return found;
+}
+
+/**
+ * @brief Determines the object id size used by a repository.
+ *
+ * @param git_dir Path of the git directory.
+ * @return size_t 32 for SHA-256 repositories, 20 otherwise.
+ */
+size_t git_hash_size(const char *git_dir) {
+    char config_path[MAX_PATH_LEN + 16];
+    snprintf(config_path, sizeof(config_path), "%s/config", git_dir);
+    size_t len = 0;
+    char *config = (char*)read_git_file(config_path, &len);
+    if (!config) return 20;
+    config[len] = '\0';
+    for (size_t i = 0; i < len; i++) config[i] = (char)tolower((unsigned char)config[i]);
+    size_t hash_size = 20;
+    char *line = strstr(config, "objectformat");
+    if (line && strstr(line, "sha256") && strstr(line, "sha256") < line + strcspn(line, "\n")) {
+        hash_size = 32;
+    }
+    free(config);
+    return hash_size;
+}
+
+/**
+ * @brief Checks whether a path lies beneath a directory prefix.
+ *
+ * @param path Path to test.
+ * @param dir Directory path (without trailing '/').
+ * @param dir_len Length of dir.
+ * @return true if path is inside dir.
+ */
+static bool path_is_below(const char *path, const char *dir, size_t dir_len) {
+    return dir_len > 0 && strncmp(path, dir, dir_len) == 0 && path[dir_len] == '/';
+}
+
+/**
+ * @brief Adds a tracked path and any parent directories not yet emitted.
+ *
+ * Index entries are sorted bytewise, so all paths below a directory are
+ * contiguous and parents only need to be compared with the previous path.
+ * When exclude rules reject a directory, it is remembered in pruned and
+ * the following paths inside it are dropped without further matching.
+ *
+ * @param list Output list.
+ * @param path Tracked path.
+ * @param prev Previous tracked path ("" for the first one).
+ * @param exclude Optional ignore rules.
+ * @param pruned In/out: last excluded directory ("" if none).
+ */
+static void add_index_path(FileList *list, const char *path, const char *prev,
+                           const GitignoreList *exclude, char *pruned) {
+    size_t pruned_len = strlen(pruned);
+    if (path_is_below(path, pruned, pruned_len)) {
+        return;
+    }
+
+    // Directories shared with the previous path have already been handled.
+    size_t common = 0;
+    for (size_t i = 0; path[i] && path[i] == prev[i]; i++) {
+        if (path[i] == '/') common = i + 1;
+    }
+
+    char dir[MAX_PATH_LEN];
+    int depth = 0;
+    for (size_t i = 0; path[i]; i++) {
+        if (path[i] != '/') continue;
+        if (i >= common) {
+            memcpy(dir, path, i);
+            dir[i] = '\0';
+            if (exclude && match_gitignore(dir, exclude)) {
+                memcpy(pruned, dir, i + 1);
+                return;
+            }
+            add_file_entry(list, dir, true, depth);
+        }
+        depth++;
+    }
+    if (exclude && match_gitignore(path, exclude)) {
+        return;
+    }
+    add_file_entry(list, path, false, depth);
+}
+
+/**
+ * @brief Populate a FileList with the files tracked in a worktree's index.
+ *
+ * @param worktree Root directory of the checkout.
+ * @param list Output FileList.
+ * @param exclude Optional extra ignore rules.
+ * @return true if the index was read, false if it is missing or malformed.
+ */
+bool read_git_index(const char *worktree, FileList *list, const GitignoreList *exclude) {
+    char git_dir[MAX_PATH_LEN];
+    if (!find_git_dir(worktree, git_dir, sizeof(git_dir))) {
+        fprintf(stderr, "Error: '%s' is not the root of a git checkout\n", worktree);
+        return false;
+    }
+    char index_path[MAX_PATH_LEN + 16];
+    snprintf(index_path, sizeof(index_path), "%s/index", git_dir);
+    size_t len = 0;
+    unsigned char *data = read_git_file(index_path, &len);
+    if (!data) {
+        fprintf(stderr, "Error: Cannot read git index '%s'\n", index_path);
+        return false;
+    }
+
+    size_t hash_size = git_hash_size(git_dir);
+    uint32_t version = len >= 12 ? get_be32(data + 4) : 0;
+    if (len < 12 + hash_size || memcmp(data, "DIRC", 4) != 0 || version < 2 || version > 4) {
+        fprintf(stderr, "Error: Unsupported or corrupt git index '%s'\n", index_path);
+        free(data);
+        return false;
+    }
+    uint32_t entry_count = get_be32(data + 8);
+    size_t end = len - hash_size;   // the trailing checksum is not part of the entries
+    size_t pos = 12;
+
+    char path[MAX_PATH_LEN] = "";
+    char prev[MAX_PATH_LEN] = "";
+    char pruned[MAX_PATH_LEN] = "";
+    bool ok = true;
+    for (uint32_t n = 0; n < entry_count; n++) {
+        size_t start = pos;
+        size_t fixed = INDEX_STAT_SIZE + hash_size + 2;
+        if (pos + fixed > end) {
+            ok = false;
+            break;
+        }
+        uint32_t mode = get_be32(data + pos + 24);
+        uint16_t flags = get_be16(data + pos + INDEX_STAT_SIZE + hash_size);
+        uint16_t ext_flags = 0;
+        pos += fixed;
+        if (flags & INDEX_FLAG_EXTENDED) {
+            if (version < 3 || pos + 2 > end) {
+                ok = false;
+                break;
+            }
+            ext_flags = get_be16(data + pos);
+            pos += 2;
+        }
+
+        if (version == 4) {
+            // Prefix compression: drop N bytes from the previous name, then append a suffix.
+            size_t strip = data[pos] & 127;
+            while (data[pos++] & 128) {
+                if (pos >= end) break;
+                strip = ((strip + 1) << 7) | (data[pos] & 127);
+            }
+            size_t prev_len = strlen(path);
+            const unsigned char *suffix = data + pos;
+            size_t suffix_len = strnlen((const char*)suffix, end - pos);
+            if (strip > prev_len || pos + suffix_len >= end ||
+                prev_len - strip + suffix_len >= sizeof(path)) {
+                ok = false;
+                break;
+            }
+            memcpy(path + prev_len - strip, suffix, suffix_len);
+            path[prev_len - strip + suffix_len] = '\0';
+            pos += suffix_len + 1;
+        } else {
+            size_t name_len = flags & INDEX_FLAG_NAME_MASK;
+            if (name_len == INDEX_FLAG_NAME_MASK) {
+                name_len = strnlen((const char*)data + pos, end - pos);
+            }
+            if (pos + name_len >= end || name_len >= sizeof(path)) {
+                ok = false;
+                break;
+            }
+            memcpy(path, data + pos, name_len);
+            path[name_len] = '\0';
+            // Entries are NUL-padded to a multiple of eight bytes.
+            pos = start + ((pos - start + name_len + 8) & ~(size_t)7);
+        }
+
+        // Merge conflicts list one entry per stage (1-3) for the same path; keep the first.
+        if ((flags & INDEX_FLAG_STAGE_MASK) != 0 && strcmp(path, prev) == 0) continue;
+        uint32_t type = mode & INDEX_MODE_TYPE_MASK;
+        if (type == INDEX_MODE_GITLINK || type == INDEX_MODE_DIR || (ext_flags & INDEX_EXT_SKIP_WORKTREE)) {
+            continue;
+        }
+        add_index_path(list, path, prev, exclude, pruned);
+        memcpy(prev, path, strlen(path) + 1);
+    }
+    if (!ok) {
+        fprintf(stderr, "Error: Corrupt git index '%s'\n", index_path);
+    }
+
+    // A split index keeps most entries in a shared file, which is not supported.
+    while (ok && pos + 8 <= end) {
+        if (memcmp(data + pos, "link", 4) == 0) {
+            fprintf(stderr, "Error: Split git indexes are not supported ('%s')\n", index_path);
+            ok = false;
+            break;
+        }
+        pos += 8 + (size_t)get_be32(data + pos + 4);
+    }
+    free(data);
+    if (!ok) return false;
+
+    // Index order is bytewise ("a.txt" before "a/b"), the tree needs component order.
+    qsort(list->entries, list->count, sizeof(FileEntry), compare_entries);
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef GITINDEX_H
+#define GITINDEX_H
+
+#include <stdbool.h>
+#include "scanner.h"
+#include "gitignore.h"
+
+/**
+ * @brief Find the git directory of a worktree.
+ *
+ * Handles both a `.git` directory and a `.git` file pointing elsewhere
+ * ("gitdir: ..."), as used by linked worktrees and submodules.
+ *
+ * @param worktree Root directory of the checkout.
+ * @param git_dir Output buffer for the git directory path.
+ * @param size Size of the output buffer.
+ * @return true if a git directory was found.
+ */
+bool find_git_dir(const char *worktree, char *git_dir, size_t size);
+
+/**
+ * @brief Determines the object id size used by a repository.
+ *
+ * Reads extensions.objectFormat from the repository config.
+ *
+ * @param git_dir Path of the git directory.
+ * @return size_t 32 for SHA-256 repositories, 20 otherwise.
+ */
+size_t git_hash_size(const char *git_dir);
+
+/**
+ * @brief Reads a whole file from a git directory into memory.
+ *
+ * @param path File to read.
+ * @param len Output: number of bytes read.
+ * @return unsigned char* Newly allocated contents with room for a trailing
+ *         NUL, or NULL on failure.
+ */
+unsigned char *read_git_file(const char *path, size_t *len);
+
+/**
+ * @brief Populate a FileList with the files tracked in a worktree's index.
+ *
+ * Parses `.git/index` (versions 2 to 4) instead of walking the filesystem.
+ * Parent directories are synthesized so the tree view is complete, and the
+ * list comes back in the hierarchical order produced by compare_entries().
+ * Submodules, sparse directory entries and skip-worktree files are left out.
+ *
+ * @param worktree Root directory of the checkout.
+ * @param list Output FileList.
+ * @param exclude Optional extra ignore rules; an excluded directory drops
+ *        everything beneath it without matching each path.
+ * @return true if the index was read, false if it is missing or malformed.
+ */
+bool read_git_index(const char *worktree, FileList *list, const GitignoreList *exclude);
+
+#endif // GITINDEX_H
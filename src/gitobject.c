@@ -0,0 +1,1086 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "gitobject.h"
+#include "gitindex.h"
+#include "inflate.h"
+#include "scanner.h"
+#include "dirdoc.h"
+
+// Packfile entry types (the four object types plus the two delta encodings).
+#define PACK_OFS_DELTA 6
+#define PACK_REF_DELTA 7
+
+#define PACK_IDX_MAGIC 0xff744f63  // "\377tOc"
+#define PACK_IDX_LARGE_OFFSET 0x80000000u
+
+// Delta bases are cached in a direct-mapped table keyed by pack position.
+#define BASE_CACHE_SLOTS 256
+#define BASE_CACHE_MAX_OBJECT (4 * 1024 * 1024)
+#define BASE_CACHE_MAX_BYTES (64 * 1024 * 1024)
+
+// Guards against cycles in corrupt packs; git itself stops far earlier.
+#define MAX_DELTA_CHAIN 10000
+#define MAX_REF_DEPTH 8
+
+typedef struct {
+    const unsigned char *idx;
+    size_t idx_len;
+    const unsigned char *pack;
+    size_t pack_len;
+    uint32_t count;
+    const unsigned char *fanout;        // 256 cumulative big-endian counts
+    const unsigned char *oids;          // count sorted object ids
+    const unsigned char *offsets;       // count 32-bit offsets
+    const unsigned char *large_offsets; // 64-bit offsets referenced by the high bit
+    size_t large_count;
+} GitPack;
+
+typedef struct {
+    size_t pack;
+    size_t offset;
+    unsigned char *data;    // NULL if the slot is empty
+    size_t size;
+    GitObjectType type;
+} CachedBase;
+
+struct GitObjectStore {
+    char git_dir[MAX_PATH_LEN];     // per-worktree directory holding HEAD
+    char common_dir[2 * MAX_PATH_LEN];  // shared directory holding refs and objects
+    size_t hash_size;
+    char **object_dirs;
+    size_t object_dir_count;
+    GitPack *packs;
+    size_t pack_count;
+    CachedBase cache[BASE_CACHE_SLOTS];
+    size_t cache_bytes;
+};
+
+typedef struct {
+    size_t pack;
+    size_t offset;
+    size_t data_offset;     // start of the compressed delta data
+    size_t size;            // inflated size of the delta
+} DeltaLink;
+
+/**
+ * @brief Reads a big-endian 32-bit value.
+ *
+ * @param p Pointer to four bytes.
+ * @return uint32_t Decoded value.
+ */
+static uint32_t get_be32(const unsigned char *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief Parses a hexadecimal object id.
+ *
+ * @param hex Hex digits (at least 2 * hash_size of them).
+ * @param hash_size Object id size in bytes.
+ * @param oid Output: binary id.
+ * @return true if all digits were valid.
+ */
+static bool hex_to_oid(const char *hex, size_t hash_size, unsigned char *oid) {
+    for (size_t i = 0; i < hash_size; i++) {
+        int value = 0;
+        for (int k = 0; k < 2; k++) {
+            char c = hex[2 * i + k];
+            int digit = (c >= '0' && c <= '9') ? c - '0' :
+                        (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+                        (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            if (digit < 0) return false;
+            value = (value << 4) | digit;
+        }
+        oid[i] = (unsigned char)value;
+    }
+    return true;
+}
+
+/**
+ * @brief Formats a binary object id as lowercase hex.
+ *
+ * @param oid Binary id.
+ * @param hash_size Object id size in bytes.
+ * @param hex Output buffer of at least 2 * hash_size + 1 bytes.
+ */
+static void oid_to_hex(const unsigned char *oid, size_t hash_size, char *hex) {
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < hash_size; i++) {
+        hex[2 * i] = digits[oid[i] >> 4];
+        hex[2 * i + 1] = digits[oid[i] & 15];
+    }
+    hex[2 * hash_size] = '\0';
+}
+
+/**
+ * @brief Memory-maps a whole file read-only.
+ *
+ * @param path File to map.
+ * @param len Output: file size.
+ * @return const unsigned char* Mapping, or NULL on failure or for empty files.
+ */
+static const unsigned char *map_file(const char *path, size_t *len) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return NULL;
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        *len = (size_t)st.st_size;
+    }
+    close(fd);
+    return map == MAP_FAILED ? NULL : (const unsigned char*)map;
+}
+
+/**
+ * @brief Maps a pack and its version 2 index and adds them to the store.
+ *
+ * @param store Object store.
+ * @param idx_path Path of the .idx file.
+ */
+static void add_pack(GitObjectStore *store, const char *idx_path) {
+    char pack_path[MAX_PATH_LEN + 256];
+    size_t stem = strlen(idx_path) - 4;
+    snprintf(pack_path, sizeof(pack_path), "%.*s.pack", (int)stem, idx_path);
+
+    GitPack pack = {0};
+    pack.idx = map_file(idx_path, &pack.idx_len);
+    pack.pack = pack.idx ? map_file(pack_path, &pack.pack_len) : NULL;
+    size_t hs = store->hash_size;
+    size_t min_len = 8 + 256 * 4 + 2 * hs;
+    bool ok = pack.pack && pack.idx_len >= min_len && pack.pack_len >= 12 + hs &&
+              get_be32(pack.idx) == PACK_IDX_MAGIC && get_be32(pack.idx + 4) == 2 &&
+              memcmp(pack.pack, "PACK", 4) == 0;
+    if (ok) {
+        pack.fanout = pack.idx + 8;
+        pack.count = get_be32(pack.fanout + 255 * 4);
+        size_t tables = (size_t)pack.count * (hs + 8);
+        ok = min_len + tables <= pack.idx_len;
+        // The fanout bounds the binary search in find_packed(), so it must
+        // not decrease and must stay within the object count
+        uint32_t prev = 0;
+        for (int i = 0; ok && i < 256; i++) {
+            uint32_t n = get_be32(pack.fanout + i * 4);
+            ok = n >= prev && n <= pack.count;
+            prev = n;
+        }
+        if (ok) {
+            pack.oids = pack.fanout + 256 * 4;
+            pack.offsets = pack.oids + (size_t)pack.count * (hs + 4);   // skip the CRC table
+            pack.large_offsets = pack.offsets + (size_t)pack.count * 4;
+            pack.large_count = (pack.idx_len - min_len - tables) / 8;
+        }
+    }
+    if (!ok) {
+        // Version 1 indexes predate git 1.5.2 and are not read.
+        fprintf(stderr, "Warning: Skipping unreadable pack index '%s'\n", idx_path);
+        if (pack.idx) munmap((void*)pack.idx, pack.idx_len);
+        if (pack.pack) munmap((void*)pack.pack, pack.pack_len);
+        return;
+    }
+    GitPack *grown = (GitPack*)realloc(store->packs, (store->pack_count + 1) * sizeof(GitPack));
+    if (!grown) {
+        munmap((void*)pack.idx, pack.idx_len);
+        munmap((void*)pack.pack, pack.pack_len);
+        return;
+    }
+    store->packs = grown;
+    store->packs[store->pack_count++] = pack;
+}
+
+/**
+ * @brief Registers an objects directory and the packs inside it.
+ *
+ * @param store Object store.
+ * @param objects_dir Path of the objects directory.
+ */
+static void add_object_dir(GitObjectStore *store, const char *objects_dir) {
+    char **grown = (char**)realloc(store->object_dirs, (store->object_dir_count + 1) * sizeof(char*));
+    if (!grown) return;
+    store->object_dirs = grown;
+    store->object_dirs[store->object_dir_count++] = strdup(objects_dir);
+
+    char pack_dir[MAX_PATH_LEN];
+    snprintf(pack_dir, sizeof(pack_dir), "%s/pack", objects_dir);
+    DIR *dir = opendir(pack_dir);
+    if (!dir) return;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        size_t len = strlen(entry->d_name);
+        if (len > 4 && strcmp(entry->d_name + len - 4, ".idx") == 0) {
+            char idx_path[MAX_PATH_LEN + 256];
+            snprintf(idx_path, sizeof(idx_path), "%s/%s", pack_dir, entry->d_name);
+            add_pack(store, idx_path);
+        }
+    }
+    closedir(dir);
+}
+
+/**
+ * @brief Open the object database of a git checkout.
+ *
+ * @param worktree Root directory of the checkout.
+ * @return GitObjectStore* Store handle, or NULL if no repository was found.
+ */
+GitObjectStore *git_store_open(const char *worktree) {
+    GitObjectStore *store = (GitObjectStore*)calloc(1, sizeof(GitObjectStore));
+    if (!store) return NULL;
+    if (!find_git_dir(worktree, store->git_dir, sizeof(store->git_dir))) {
+        fprintf(stderr, "Error: '%s' is not the root of a git checkout\n", worktree);
+        free(store);
+        return NULL;
+    }
+
+    // Linked worktrees keep refs and objects in the main repository, named by "commondir".
+    char path[3 * MAX_PATH_LEN];
+    snprintf(path, sizeof(path), "%s/commondir", store->git_dir);
+    size_t len = 0;
+    char *common = (char*)read_git_file(path, &len);
+    if (common) {
+        common[len] = '\0';
+        common[strcspn(common, "\r\n")] = '\0';
+        if (common[0] == '/') {
+            snprintf(store->common_dir, sizeof(store->common_dir), "%s", common);
+        } else {
+            snprintf(store->common_dir, sizeof(store->common_dir), "%s/%s", store->git_dir, common);
+        }
+        free(common);
+    } else {
+        snprintf(store->common_dir, sizeof(store->common_dir), "%s", store->git_dir);
+    }
+    store->hash_size = git_hash_size(store->common_dir);
+
+    char objects_dir[2 * MAX_PATH_LEN + 16];
+    snprintf(objects_dir, sizeof(objects_dir), "%s/objects", store->common_dir);
+    add_object_dir(store, objects_dir);
+
+    // Alternates (from "git clone --shared") list further object directories.
+    snprintf(path, sizeof(path), "%s/info/alternates", objects_dir);
+    char *alternates = (char*)read_git_file(path, &len);
+    if (alternates) {
+        alternates[len] = '\0';
+        for (char *line = strtok(alternates, "\r\n"); line; line = strtok(NULL, "\r\n")) {
+            if (line[0] == '\0' || line[0] == '#') continue;
+            char alt[4 * MAX_PATH_LEN];
+            if (line[0] == '/') {
+                snprintf(alt, sizeof(alt), "%s", line);
+            } else {
+                snprintf(alt, sizeof(alt), "%s/%s", objects_dir, line);
+            }
+            add_object_dir(store, alt);
+        }
+        free(alternates);
+    }
+    return store;
+}
+
+/**
+ * @brief Release a store and everything it mapped or cached.
+ *
+ * @param store Store to close (may be NULL).
+ */
+void git_store_close(GitObjectStore *store) {
+    if (!store) return;
+    for (size_t i = 0; i < store->pack_count; i++) {
+        munmap((void*)store->packs[i].idx, store->packs[i].idx_len);
+        munmap((void*)store->packs[i].pack, store->packs[i].pack_len);
+    }
+    free(store->packs);
+    for (size_t i = 0; i < store->object_dir_count; i++) {
+        free(store->object_dirs[i]);
+    }
+    free(store->object_dirs);
+    for (size_t i = 0; i < BASE_CACHE_SLOTS; i++) {
+        free(store->cache[i].data);
+    }
+    free(store);
+}
+
+/**
+ * @brief Looks up an object id in the pack indexes.
+ *
+ * @param store Object store.
+ * @param oid Binary object id.
+ * @param pack_index Output: index of the pack holding the object.
+ * @param offset Output: offset of the object within that pack.
+ * @return true if the object is packed.
+ */
+static bool find_packed(const GitObjectStore *store, const unsigned char *oid, size_t *pack_index, size_t *offset) {
+    size_t hs = store->hash_size;
+    for (size_t p = 0; p < store->pack_count; p++) {
+        const GitPack *pack = &store->packs[p];
+        size_t lo = oid[0] ? get_be32(pack->fanout + (oid[0] - 1) * 4) : 0;
+        size_t hi = get_be32(pack->fanout + oid[0] * 4);
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            int cmp = memcmp(pack->oids + mid * hs, oid, hs);
+            if (cmp < 0) {
+                lo = mid + 1;
+            } else if (cmp > 0) {
+                hi = mid;
+            } else {
+                uint32_t off = get_be32(pack->offsets + mid * 4);
+                if (off & PACK_IDX_LARGE_OFFSET) {
+                    size_t large = off & ~PACK_IDX_LARGE_OFFSET;
+                    if (large >= pack->large_count) return false;
+                    const unsigned char *q = pack->large_offsets + large * 8;
+                    *offset = ((size_t)get_be32(q) << 32) | get_be32(q + 4);
+                } else {
+                    *offset = off;
+                }
+                *pack_index = p;
+                return *offset < pack->pack_len;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Maps an object type name from a loose object header.
+ *
+ * @param name Type name.
+ * @param len Length of the name.
+ * @return GitObjectType The type, or GIT_OBJ_NONE if unknown.
+ */
+static GitObjectType type_from_name(const char *name, size_t len) {
+    if (len == 4 && memcmp(name, "blob", 4) == 0) return GIT_OBJ_BLOB;
+    if (len == 4 && memcmp(name, "tree", 4) == 0) return GIT_OBJ_TREE;
+    if (len == 6 && memcmp(name, "commit", 6) == 0) return GIT_OBJ_COMMIT;
+    if (len == 3 && memcmp(name, "tag", 3) == 0) return GIT_OBJ_TAG;
+    return GIT_OBJ_NONE;
+}
+
+/**
+ * @brief Reads a loose object ("<type> <size>\0<data>", zlib-compressed).
+ *
+ * @param store Object store.
+ * @param oid Binary object id.
+ * @param type Output: object type.
+ * @param size Output: object size.
+ * @return unsigned char* Newly allocated data, or NULL if there is no such loose object.
+ */
+static unsigned char *read_loose(const GitObjectStore *store, const unsigned char *oid, GitObjectType *type, size_t *size) {
+    char hex[2 * GIT_MAX_OID_SIZE + 1];
+    oid_to_hex(oid, store->hash_size, hex);
+    for (size_t d = 0; d < store->object_dir_count; d++) {
+        char path[MAX_PATH_LEN];
+        snprintf(path, sizeof(path), "%s/%.2s/%s", store->object_dirs[d], hex, hex + 2);
+        size_t len = 0;
+        unsigned char *raw = read_git_file(path, &len);
+        if (!raw) continue;
+        unsigned char *data = NULL;
+        size_t data_len = 0;
+        bool ok = zlib_inflate(raw, len, 0, &data, &data_len);
+        free(raw);
+        if (!ok) return NULL;
+
+        unsigned char *space = memchr(data, ' ', data_len);
+        unsigned char *nul = memchr(data, '\0', data_len);
+        *type = space ? type_from_name((const char*)data, (size_t)(space - data)) : GIT_OBJ_NONE;
+        if (*type == GIT_OBJ_NONE || !nul || nul < space ||
+            strtoull((const char*)space + 1, NULL, 10) != data_len - (size_t)(nul + 1 - data)) {
+            free(data);
+            return NULL;
+        }
+        *size = data_len - (size_t)(nul + 1 - data);
+        memmove(data, nul + 1, *size + 1);  // keep the trailing NUL
+        return data;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Decodes the header of a pack entry.
+ *
+ * @param pack Pack to read.
+ * @param offset Offset of the entry.
+ * @param type Output: entry type (1-4, or a delta type).
+ * @param size Output: inflated size of the entry data.
+ * @param data_offset Output: offset just past the header.
+ * @return true if the header lies within the pack.
+ */
+static bool read_pack_header(const GitPack *pack, size_t offset, int *type, size_t *size, size_t *data_offset) {
+    size_t end = pack->pack_len;
+    if (offset >= end) return false;
+    unsigned char c = pack->pack[offset++];
+    *type = (c >> 4) & 7;
+    size_t value = c & 15;
+    int shift = 4;
+    while (c & 0x80) {
+        if (offset >= end || shift > 57) return false;
+        c = pack->pack[offset++];
+        value |= (size_t)(c & 0x7f) << shift;
+        shift += 7;
+    }
+    *size = value;
+    *data_offset = offset;
+    return true;
+}
+
+/**
+ * @brief Inflates the zlib data of a pack entry.
+ *
+ * @param pack Pack to read.
+ * @param data_offset Start of the compressed data.
+ * @param size Expected inflated size.
+ * @return unsigned char* Newly allocated data, or NULL on corruption.
+ */
+static unsigned char *inflate_pack_data(const GitPack *pack, size_t data_offset, size_t size) {
+    unsigned char *out = NULL;
+    size_t out_len = 0;
+    if (!zlib_inflate(pack->pack + data_offset, pack->pack_len - data_offset, size, &out, &out_len)) {
+        return NULL;
+    }
+    if (out_len != size) {
+        free(out);
+        return NULL;
+    }
+    return out;
+}
+
+/**
+ * @brief Reads a size varint from a delta header.
+ *
+ * @param p In/out: read position.
+ * @param end End of the delta.
+ * @param value Output: decoded size.
+ * @return true on success.
+ */
+static bool read_delta_size(const unsigned char **p, const unsigned char *end, size_t *value) {
+    size_t v = 0;
+    int shift = 0;
+    unsigned char c;
+    do {
+        if (*p >= end || shift > 57) return false;
+        c = *(*p)++;
+        v |= (size_t)(c & 0x7f) << shift;
+        shift += 7;
+    } while (c & 0x80);
+    *value = v;
+    return true;
+}
+
+/**
+ * @brief Rebuilds an object from its base and a git delta.
+ *
+ * @param base Base object data.
+ * @param base_len Size of the base.
+ * @param delta Delta instructions.
+ * @param delta_len Size of the delta.
+ * @param out_len Output: size of the result.
+ * @return unsigned char* Newly allocated, NUL-terminated result, or NULL on corruption.
+ */
+static unsigned char *apply_delta(const unsigned char *base, size_t base_len,
+                                  const unsigned char *delta, size_t delta_len, size_t *out_len) {
+    const unsigned char *p = delta;
+    const unsigned char *end = delta + delta_len;
+    size_t src_size, dst_size;
+    if (!read_delta_size(&p, end, &src_size) || !read_delta_size(&p, end, &dst_size) || src_size != base_len) {
+        return NULL;
+    }
+    unsigned char *out = (unsigned char*)malloc(dst_size + 1);
+    if (!out) return NULL;
+    size_t pos = 0;
+    while (p < end) {
+        unsigned char op = *p++;
+        if (op & 0x80) {
+            // Copy from the base: bits 0-3 select offset bytes, bits 4-6 size bytes.
+            size_t off = 0, len = 0;
+            for (int i = 0; i < 4; i++) {
+                if (op & (1 << i)) {
+                    if (p >= end) goto corrupt;
+                    off |= (size_t)*p++ << (8 * i);
+                }
+            }
+            for (int i = 0; i < 3; i++) {
+                if (op & (0x10 << i)) {
+                    if (p >= end) goto corrupt;
+                    len |= (size_t)*p++ << (8 * i);
+                }
+            }
+            if (len == 0) len = 0x10000;
+            if (off > base_len || len > base_len - off || len > dst_size - pos) goto corrupt;
+            memcpy(out + pos, base + off, len);
+            pos += len;
+        } else if (op != 0) {
+            // Insert the next op bytes literally.
+            if ((size_t)(end - p) < op || op > dst_size - pos) goto corrupt;
+            memcpy(out + pos, p, op);
+            p += op;
+            pos += op;
+        } else {
+            goto corrupt;
+        }
+    }
+    if (pos != dst_size) goto corrupt;
+    out[dst_size] = '\0';
+    *out_len = dst_size;
+    return out;
+
+corrupt:
+    free(out);
+    return NULL;
+}
+
+/**
+ * @brief Selects the cache slot for a pack position.
+ *
+ * @param pack Pack index.
+ * @param offset Offset within the pack.
+ * @return size_t Slot number.
+ */
+static size_t cache_slot(size_t pack, size_t offset) {
+    return (offset * 2654435761u + pack) % BASE_CACHE_SLOTS;
+}
+
+/**
+ * @brief Returns a copy of a cached delta base.
+ *
+ * @param store Object store.
+ * @param pack Pack index.
+ * @param offset Offset within the pack.
+ * @param type Output: object type.
+ * @param size Output: object size.
+ * @return unsigned char* Newly allocated copy, or NULL on a cache miss.
+ */
+static unsigned char *cache_lookup(GitObjectStore *store, size_t pack, size_t offset, GitObjectType *type, size_t *size) {
+    CachedBase *slot = &store->cache[cache_slot(pack, offset)];
+    if (!slot->data || slot->pack != pack || slot->offset != offset) return NULL;
+    unsigned char *copy = (unsigned char*)malloc(slot->size + 1);
+    if (!copy) return NULL;
+    memcpy(copy, slot->data, slot->size + 1);
+    *type = slot->type;
+    *size = slot->size;
+    return copy;
+}
+
+/**
+ * @brief Remembers an object that served as a delta base.
+ *
+ * Large objects and objects that would push the cache over its byte budget
+ * are not kept; a colliding entry is replaced.
+ *
+ * @param store Object store.
+ * @param pack Pack index.
+ * @param offset Offset within the pack.
+ * @param type Object type.
+ * @param data Object data (copied).
+ * @param size Object size.
+ */
+static void cache_store(GitObjectStore *store, size_t pack, size_t offset, GitObjectType type,
+                        const unsigned char *data, size_t size) {
+    if (size > BASE_CACHE_MAX_OBJECT) return;
+    CachedBase *slot = &store->cache[cache_slot(pack, offset)];
+    size_t freed = slot->data ? slot->size : 0;
+    if (store->cache_bytes - freed + size > BASE_CACHE_MAX_BYTES) return;
+    unsigned char *copy = (unsigned char*)malloc(size + 1);
+    if (!copy) return;
+    memcpy(copy, data, size + 1);
+    free(slot->data);
+    store->cache_bytes = store->cache_bytes - freed + size;
+    slot->pack = pack;
+    slot->offset = offset;
+    slot->data = copy;
+    slot->size = size;
+    slot->type = type;
+}
+
+/**
+ * @brief Reads a packed object, resolving its delta chain.
+ *
+ * The chain is followed down to a full object (or a cached base) first, and
+ * the deltas are then applied from the bottom up, so long chains do not
+ * recurse.
+ *
+ * @param store Object store.
+ * @param pack_index Pack holding the object.
+ * @param offset Offset of the object.
+ * @param type Output: object type.
+ * @param size Output: object size.
+ * @return unsigned char* Newly allocated data, or NULL on corruption.
+ */
+static unsigned char *read_packed(GitObjectStore *store, size_t pack_index, size_t offset,
+                                  GitObjectType *type, size_t *size) {
+    DeltaLink *links = NULL;
+    size_t link_count = 0, link_capacity = 0;
+    unsigned char *data = NULL;
+    GitObjectType base_type = GIT_OBJ_NONE;
+    size_t data_size = 0;
+    size_t hs = store->hash_size;
+
+    for (;;) {
+        data = cache_lookup(store, pack_index, offset, &base_type, &data_size);
+        if (data) break;
+
+        const GitPack *pack = &store->packs[pack_index];
+        int entry_type;
+        size_t entry_size, data_offset;
+        if (!read_pack_header(pack, offset, &entry_type, &entry_size, &data_offset)) break;
+
+        if (entry_type >= GIT_OBJ_COMMIT && entry_type <= GIT_OBJ_TAG) {
+            data = inflate_pack_data(pack, data_offset, entry_size);
+            base_type = (GitObjectType)entry_type;
+            data_size = entry_size;
+            if (data && link_count > 0) {
+                cache_store(store, pack_index, offset, base_type, data, data_size);
+            }
+            break;
+        }
+        if ((entry_type != PACK_OFS_DELTA && entry_type != PACK_REF_DELTA) || link_count >= MAX_DELTA_CHAIN) break;
+
+        size_t base_pack = pack_index, base_offset = 0;
+        const unsigned char *base_oid = NULL;
+        if (entry_type == PACK_OFS_DELTA) {
+            // Offset of the base, counted backwards, in a varint where each continuation adds one.
+            size_t p = data_offset;
+            if (p >= pack->pack_len) break;
+            unsigned char c = pack->pack[p++];
+            size_t back = c & 0x7f;
+            while ((c & 0x80) && p < pack->pack_len) {
+                c = pack->pack[p++];
+                back = ((back + 1) << 7) | (c & 0x7f);
+            }
+            if ((c & 0x80) || back == 0 || back > offset) break;
+            base_offset = offset - back;
+            data_offset = p;
+        } else {
+            if (data_offset + hs > pack->pack_len) break;
+            base_oid = pack->pack + data_offset;
+            data_offset += hs;
+        }
+
+        if (link_count == link_capacity) {
+            link_capacity = link_capacity ? link_capacity * 2 : 16;
+            DeltaLink *grown = (DeltaLink*)realloc(links, link_capacity * sizeof(DeltaLink));
+            if (!grown) break;
+            links = grown;
+        }
+        links[link_count].pack = pack_index;
+        links[link_count].offset = offset;
+        links[link_count].data_offset = data_offset;
+        links[link_count].size = entry_size;
+        link_count++;
+
+        if (base_oid && !find_packed(store, base_oid, &base_pack, &base_offset)) {
+            // A REF_DELTA base may also live outside the packs.
+            data = read_loose(store, base_oid, &base_type, &data_size);
+            break;
+        }
+        pack_index = base_pack;
+        offset = base_offset;
+    }
+
+    while (data && link_count > 0) {
+        DeltaLink *link = &links[--link_count];
+        const GitPack *pack = &store->packs[link->pack];
+        unsigned char *delta = inflate_pack_data(pack, link->data_offset, link->size);
+        unsigned char *result = NULL;
+        size_t result_size = 0;
+        if (delta) {
+            result = apply_delta(data, data_size, delta, link->size, &result_size);
+            free(delta);
+        }
+        free(data);
+        data = result;
+        data_size = result_size;
+        if (data && link_count > 0) {
+            cache_store(store, link->pack, link->offset, base_type, data, data_size);
+        }
+    }
+    free(links);
+    if (!data) return NULL;
+    *type = base_type;
+    *size = data_size;
+    return data;
+}
+
+/**
+ * @brief Read and fully resolve an object.
+ *
+ * @param store Object store.
+ * @param oid Binary object id.
+ * @param type Output: object type.
+ * @param size Output: object size in bytes.
+ * @return unsigned char* Newly allocated object data, or NULL if missing or corrupt.
+ */
+unsigned char *git_read_object(GitObjectStore *store, const unsigned char *oid, GitObjectType *type, size_t *size) {
+    size_t pack_index, offset;
+    if (find_packed(store, oid, &pack_index, &offset)) {
+        unsigned char *data = read_packed(store, pack_index, offset, type, size);
+        if (data) return data;
+    }
+    return read_loose(store, oid, type, size);
+}
+
+/**
+ * @brief Reads a ref, following symbolic refs.
+ *
+ * HEAD is read from the worktree's own git directory, everything else from
+ * the common directory: first as a loose ref file, then from packed-refs.
+ *
+ * @param store Object store.
+ * @param name Full ref name (e.g. "refs/heads/main" or "HEAD").
+ * @param oid Output: binary object id.
+ * @param depth Current symbolic ref depth.
+ * @return true if the ref exists.
+ */
+static bool read_ref(const GitObjectStore *store, const char *name, unsigned char *oid, int depth) {
+    if (depth > MAX_REF_DEPTH || strstr(name, "..")) return false;
+    char path[3 * MAX_PATH_LEN];
+    snprintf(path, sizeof(path), "%s/%s", strcmp(name, "HEAD") == 0 ? store->git_dir : store->common_dir, name);
+    size_t hex_len = 2 * store->hash_size;
+    size_t len = 0;
+    char *text = (char*)read_git_file(path, &len);
+    if (text) {
+        text[len] = '\0';
+        text[strcspn(text, "\r\n")] = '\0';
+        bool found;
+        if (strncmp(text, "ref:", 4) == 0) {
+            char *target = text + 4;
+            while (*target == ' ') target++;
+            found = read_ref(store, target, oid, depth + 1);
+        } else {
+            found = strlen(text) == hex_len && hex_to_oid(text, store->hash_size, oid);
+        }
+        free(text);
+        return found;
+    }
+
+    snprintf(path, sizeof(path), "%s/packed-refs", store->common_dir);
+    text = (char*)read_git_file(path, &len);
+    if (!text) return false;
+    text[len] = '\0';
+    bool found = false;
+    for (char *line = strtok(text, "\n"); line && !found; line = strtok(NULL, "\n")) {
+        // "<hex> <refname>"; comment lines start with '#', peeled tag lines with '^'.
+        if (line[0] == '#' || line[0] == '^' || strlen(line) < hex_len + 2 || line[hex_len] != ' ') continue;
+        char *ref = line + hex_len + 1;
+        ref[strcspn(ref, "\r")] = '\0';
+        if (strcmp(ref, name) == 0) {
+            found = hex_to_oid(line, store->hash_size, oid);
+        }
+    }
+    free(text);
+    return found;
+}
+
+/**
+ * @brief Records a candidate for an abbreviated object id.
+ *
+ * @param oid Candidate id.
+ * @param hash_size Object id size.
+ * @param match In/out: first candidate found.
+ * @param matches In/out: number of distinct candidates.
+ */
+static void note_candidate(const unsigned char *oid, size_t hash_size, unsigned char *match, int *matches) {
+    if (*matches == 0) {
+        memcpy(match, oid, hash_size);
+        *matches = 1;
+    } else if (memcmp(match, oid, hash_size) != 0) {
+        *matches = 2;
+    }
+}
+
+/**
+ * @brief Expands an abbreviated hex object id.
+ *
+ * Searches the loose object fan-out directory and the matching fan-out
+ * bucket of every pack index.
+ *
+ * @param store Object store.
+ * @param prefix Lowercase hex prefix (at least four digits).
+ * @param oid Output: the unique matching id.
+ * @return int Number of distinct matches (0, 1, or 2 for "ambiguous").
+ */
+static int expand_abbrev(const GitObjectStore *store, const char *prefix, unsigned char *oid) {
+    size_t hs = store->hash_size;
+    size_t prefix_len = strlen(prefix);
+    int matches = 0;
+    char hex[2 * GIT_MAX_OID_SIZE + 1];
+    unsigned char candidate[GIT_MAX_OID_SIZE];
+
+    for (size_t d = 0; d < store->object_dir_count; d++) {
+        char path[MAX_PATH_LEN];
+        snprintf(path, sizeof(path), "%s/%.2s", store->object_dirs[d], prefix);
+        DIR *dir = opendir(path);
+        if (!dir) continue;
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (strlen(entry->d_name) != 2 * hs - 2) continue;
+            memcpy(hex, prefix, 2);
+            memcpy(hex + 2, entry->d_name, 2 * hs - 1);
+            if (strncmp(hex, prefix, prefix_len) == 0 && hex_to_oid(hex, hs, candidate)) {
+                note_candidate(candidate, hs, oid, &matches);
+            }
+        }
+        closedir(dir);
+    }
+
+    unsigned char first_byte;
+    if (!hex_to_oid(prefix, 1, &first_byte)) return 0;
+    for (size_t p = 0; p < store->pack_count; p++) {
+        const GitPack *pack = &store->packs[p];
+        size_t lo = first_byte ? get_be32(pack->fanout + (first_byte - 1) * 4) : 0;
+        size_t hi = get_be32(pack->fanout + first_byte * 4);
+        for (size_t i = lo; i < hi && i < pack->count; i++) {
+            oid_to_hex(pack->oids + i * hs, hs, hex);
+            if (strncmp(hex, prefix, prefix_len) == 0) {
+                note_candidate(pack->oids + i * hs, hs, oid, &matches);
+            }
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Resolves a revision name without suffixes to an object id.
+ *
+ * Tries the ref lookup order of git rev-parse, then a full or abbreviated hex id.
+ *
+ * @param store Object store.
+ * @param name Revision name.
+ * @param oid Output: binary object id.
+ * @return true on success; an error is printed otherwise.
+ */
+static bool resolve_name(const GitObjectStore *store, const char *name, unsigned char *oid) {
+    static const char *ref_formats[] = {
+        "%s", "refs/%s", "refs/tags/%s", "refs/heads/%s", "refs/remotes/%s", "refs/remotes/%s/HEAD"
+    };
+    size_t hs = store->hash_size;
+    size_t len = strlen(name);
+    if (len == 0 || strcmp(name, "@") == 0) name = "HEAD";
+
+    if (len == 2 * hs && hex_to_oid(name, hs, oid)) return true;
+    for (size_t i = 0; i < sizeof(ref_formats) / sizeof(ref_formats[0]); i++) {
+        char ref[MAX_PATH_LEN];
+        snprintf(ref, sizeof(ref), ref_formats[i], name);
+        if (read_ref(store, ref, oid, 0)) return true;
+    }
+
+    bool is_hex = len >= 4 && len < 2 * hs;
+    char prefix[2 * GIT_MAX_OID_SIZE + 1];
+    for (size_t i = 0; is_hex && i < len; i++) {
+        is_hex = isxdigit((unsigned char)name[i]);
+        prefix[i] = (char)tolower((unsigned char)name[i]);
+    }
+    if (is_hex) {
+        prefix[len] = '\0';
+        int matches = expand_abbrev(store, prefix, oid);
+        if (matches == 1) return true;
+        if (matches > 1) {
+            fprintf(stderr, "Error: Short object id '%s' is ambiguous\n", name);
+            return false;
+        }
+    }
+    fprintf(stderr, "Error: Unknown revision '%s'\n", name);
+    return false;
+}
+
+/**
+ * @brief Finds a "<key> <hex>" header line in a commit or tag object.
+ *
+ * Only the header (up to the first blank line) is searched.
+ *
+ * @param store Object store.
+ * @param data Object data.
+ * @param key Header name, e.g. "tree" or "parent".
+ * @param nth Which occurrence to return (1-based).
+ * @param oid Output: the id on that line.
+ * @return true if the line was found.
+ */
+static bool find_header_oid(const GitObjectStore *store, const char *data, const char *key, int nth, unsigned char *oid) {
+    size_t key_len = strlen(key);
+    for (const char *line = data; *line && *line != '\n'; ) {
+        if (strncmp(line, key, key_len) == 0 && line[key_len] == ' ' && --nth == 0) {
+            return hex_to_oid(line + key_len + 1, store->hash_size, oid);
+        }
+        const char *next = strchr(line, '\n');
+        if (!next) break;
+        line = next + 1;
+    }
+    return false;
+}
+
+/**
+ * @brief Peels tags until an object of the wanted kind is reached.
+ *
+ * @param store Object store.
+ * @param oid In/out: object id.
+ * @param want GIT_OBJ_COMMIT to stop at a commit, GIT_OBJ_TREE to continue to its tree.
+ * @return true if an object of the wanted kind was reached.
+ */
+static bool peel_object(GitObjectStore *store, unsigned char *oid, GitObjectType want) {
+    for (int depth = 0; depth <= MAX_REF_DEPTH; depth++) {
+        GitObjectType type;
+        size_t size;
+        unsigned char *data = git_read_object(store, oid, &type, &size);
+        if (!data) return false;
+        bool done = type == want;
+        bool ok = done;
+        if (type == GIT_OBJ_TAG) {
+            ok = find_header_oid(store, (const char*)data, "object", 1, oid);
+        } else if (type == GIT_OBJ_COMMIT && want == GIT_OBJ_TREE) {
+            ok = find_header_oid(store, (const char*)data, "tree", 1, oid);
+        }
+        free(data);
+        if (done || !ok) return done;
+    }
+    return false;
+}
+
+/**
+ * @brief Resolve a commit-ish to the id of the tree it names.
+ *
+ * @param store Object store.
+ * @param rev Revision expression.
+ * @param tree_oid Output: binary id of the root tree.
+ * @return true on success; an error is printed otherwise.
+ */
+bool git_resolve_tree(GitObjectStore *store, const char *rev, unsigned char *tree_oid) {
+    char name[MAX_PATH_LEN];
+    size_t name_len = strcspn(rev, "^~");
+    if (name_len >= sizeof(name)) return false;
+    memcpy(name, rev, name_len);
+    name[name_len] = '\0';
+    if (!resolve_name(store, name, tree_oid)) return false;
+
+    // Apply "^N" (Nth parent), "~N" (N first-parent steps) and "^{...}" (peel) in order.
+    const char *p = rev + name_len;
+    while (*p) {
+        char op = *p++;
+        if (op == '^' && *p == '{') {
+            const char *close = strchr(p, '}');
+            if (!close) break;
+            p = close + 1;
+            continue;
+        }
+        if (op != '^' && op != '~') break;
+        char *end;
+        long n = isdigit((unsigned char)*p) ? strtol(p, &end, 10) : 1;
+        if (isdigit((unsigned char)*p)) p = end;
+
+        int steps = op == '~' ? (int)n : (n == 0 ? 0 : 1);
+        int parent = op == '~' ? 1 : (int)n;
+        for (int i = 0; i < steps; i++) {
+            if (!peel_object(store, tree_oid, GIT_OBJ_COMMIT)) {
+                fprintf(stderr, "Error: '%s' does not name a commit\n", rev);
+                return false;
+            }
+            GitObjectType type;
+            size_t size;
+            unsigned char *commit = git_read_object(store, tree_oid, &type, &size);
+            bool found = commit && find_header_oid(store, (const char*)commit, "parent", parent, tree_oid);
+            free(commit);
+            if (!found) {
+                fprintf(stderr, "Error: Revision '%s' does not exist (no such parent)\n", rev);
+                return false;
+            }
+        }
+    }
+    if (*p) {
+        fprintf(stderr, "Error: Unsupported revision syntax '%s'\n", rev);
+        return false;
+    }
+    if (!peel_object(store, tree_oid, GIT_OBJ_TREE)) {
+        fprintf(stderr, "Error: Revision '%s' does not name a tree\n", rev);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Recursively adds the entries of a tree object to a FileList.
+ *
+ * Tree entries are "<octal mode> <name>\0<binary id>".
+ *
+ * @param store Object store.
+ * @param oid Tree id.
+ * @param path Path buffer holding the tree's path (MAX_PATH_LEN bytes).
+ * @param path_len Length of the tree's path (0 for the root).
+ * @param depth Depth of the tree's entries.
+ * @param list Output list.
+ * @param exclude Optional ignore rules.
+ * @return true on success.
+ */
+static bool walk_tree(GitObjectStore *store, const unsigned char *oid, char *path, size_t path_len,
+                      int depth, FileList *list, const GitignoreList *exclude) {
+    GitObjectType type;
+    size_t size;
+    unsigned char *data = git_read_object(store, oid, &type, &size);
+    if (!data || type != GIT_OBJ_TREE) {
+        char hex[2 * GIT_MAX_OID_SIZE + 1];
+        oid_to_hex(oid, store->hash_size, hex);
+        fprintf(stderr, "Error: Cannot read tree %s\n", hex);
+        free(data);
+        return false;
+    }
+
+    size_t hs = store->hash_size;
+    bool ok = true;
+    const unsigned char *p = data;
+    const unsigned char *end = data + size;
+    while (ok && p < end) {
+        const unsigned char *space = memchr(p, ' ', (size_t)(end - p));
+        const unsigned char *nul = space ? memchr(space, '\0', (size_t)(end - space)) : NULL;
+        if (!nul || (size_t)(end - nul - 1) < hs) {
+            fprintf(stderr, "Error: Corrupt tree object\n");
+            ok = false;
+            break;
+        }
+        unsigned long mode = strtoul((const char*)p, NULL, 8);
+        const char *name = (const char*)space + 1;
+        const unsigned char *entry_oid = nul + 1;
+        p = entry_oid + hs;
+
+        size_t name_len = (size_t)(nul - space - 1);
+        if (path_len + name_len + 2 > MAX_PATH_LEN) continue;
+        size_t child_len = path_len;
+        if (path_len > 0) path[child_len++] = '/';
+        memcpy(path + child_len, name, name_len + 1);
+        child_len += name_len;
+
+        unsigned long kind = mode & 0170000;
+        if (kind == 0160000) {
+            // Submodule commits live in another repository.
+        } else if (exclude && match_gitignore(path, exclude)) {
+            // Excluded; for a directory nothing below it is read.
+        } else if (kind == 0040000) {
+            add_file_entry(list, path, true, depth);
+            ok = walk_tree(store, entry_oid, path, child_len, depth + 1, list, exclude);
+        } else {
+            add_file_entry(list, path, false, depth);
+            memcpy(list->entries[list->count - 1].oid, entry_oid, hs);
+        }
+        path[path_len] = '\0';
+    }
+    free(data);
+    return ok;
+}
+
+/**
+ * @brief Populate a FileList with the files of a tree object.
+ *
+ * @param store Object store.
+ * @param tree_oid Root tree id.
+ * @param list Output FileList.
+ * @param exclude Optional ignore rules.
+ * @return true on success, false if a tree object is missing or corrupt.
+ */
+bool git_list_tree(GitObjectStore *store, const unsigned char *tree_oid, FileList *list, const GitignoreList *exclude) {
+    char path[MAX_PATH_LEN] = "";
+    if (!walk_tree(store, tree_oid, path, 0, 0, list, exclude)) return false;
+    // Trees order a directory as if its name ended in '/', which is not the structure order.
+    qsort(list->entries, list->count, sizeof(FileEntry), compare_entries);
+    return true;
+}
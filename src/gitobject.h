@@ -0,0 +1,88 @@
+#ifndef GITOBJECT_H
+#define GITOBJECT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "scanner.h"
+#include "gitignore.h"
+
+// Largest object id (SHA-256); SHA-1 repositories use the first 20 bytes.
+#define GIT_MAX_OID_SIZE 32
+
+typedef enum {
+    GIT_OBJ_NONE = 0,
+    GIT_OBJ_COMMIT = 1,
+    GIT_OBJ_TREE = 2,
+    GIT_OBJ_BLOB = 3,
+    GIT_OBJ_TAG = 4
+} GitObjectType;
+
+// Opaque handle on a repository's object database (loose objects and packs).
+typedef struct GitObjectStore GitObjectStore;
+
+/**
+ * @brief Open the object database of a git checkout.
+ *
+ * Locates the git directory (including linked worktrees), memory-maps every
+ * packfile index and pack under objects/pack, and follows
+ * objects/info/alternates one level deep.
+ *
+ * @param worktree Root directory of the checkout.
+ * @return GitObjectStore* Store handle, or NULL if no repository was found.
+ */
+GitObjectStore *git_store_open(const char *worktree);
+
+/**
+ * @brief Release a store and everything it mapped or cached.
+ *
+ * @param store Store to close (may be NULL).
+ */
+void git_store_close(GitObjectStore *store);
+
+/**
+ * @brief Read and fully resolve an object.
+ *
+ * Loose objects are inflated directly; packed objects are inflated and their
+ * delta chains (OFS_DELTA and REF_DELTA) applied. Recently used delta bases
+ * are cached, so walking many objects of one pack does not rebuild shared
+ * bases over and over.
+ *
+ * @param store Object store.
+ * @param oid Binary object id.
+ * @param type Output: object type.
+ * @param size Output: object size in bytes.
+ * @return unsigned char* Newly allocated object data (NUL-terminated one byte
+ *         past the end), or NULL if the object is missing or corrupt.
+ */
+unsigned char *git_read_object(GitObjectStore *store, const unsigned char *oid, GitObjectType *type, size_t *size);
+
+/**
+ * @brief Resolve a commit-ish to the id of the tree it names.
+ *
+ * Accepts full or abbreviated hex ids, HEAD, branch, tag and remote names
+ * (loose or in packed-refs), followed by any number of `^`, `^N` and `~N`
+ * suffixes. Annotated tags are peeled, and a tree id is accepted as is.
+ *
+ * @param store Object store.
+ * @param rev Revision expression.
+ * @param tree_oid Output: binary id of the root tree.
+ * @return true on success; an error is printed otherwise.
+ */
+bool git_resolve_tree(GitObjectStore *store, const char *rev, unsigned char *tree_oid);
+
+/**
+ * @brief Populate a FileList with the files of a tree object.
+ *
+ * Walks the tree recursively; each file entry carries its blob id in
+ * FileEntry.oid. Submodules are left out. The list comes back in the
+ * hierarchical order produced by compare_entries().
+ *
+ * @param store Object store.
+ * @param tree_oid Root tree id.
+ * @param list Output FileList.
+ * @param exclude Optional ignore rules; an excluded directory is not read.
+ * @return true on success, false if a tree object is missing or corrupt.
+ */
+bool git_list_tree(GitObjectStore *store, const unsigned char *tree_oid, FileList *list, const GitignoreList *exclude);
+
+#endif // GITOBJECT_H
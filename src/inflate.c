@@ -0,0 +1,425 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "inflate.h"
+
+// Deflate limits from RFC 1951.
+#define MAX_CODE_BITS 15
+#define LITLEN_CODES 288
+#define DIST_CODES 32
+#define CODELEN_CODES 19
+
+// Codes up to FAST_BITS long are decoded with one table lookup on the next
+// input bits (least significant bit first); each entry is (symbol << 4) |
+// length. A zero entry means the code is longer (or unused), and decoding
+// falls back to walking the canonical code one bit at a time.
+#define FAST_BITS 10
+
+typedef struct {
+    uint16_t fast[1 << FAST_BITS];
+    uint16_t count[MAX_CODE_BITS + 1];   // number of codes of each length
+    uint16_t symbol[LITLEN_CODES];       // symbols ordered by code
+} HuffmanTable;
+
+typedef struct {
+    const unsigned char *in;
+    size_t in_len;
+    size_t in_pos;
+    uint64_t bitbuf;        // pending input bits, next bit in the lowest position
+    int bitcnt;
+    unsigned char *out;
+    size_t out_len;
+    size_t out_cap;
+    HuffmanTable litlen;
+    HuffmanTable dist;
+} InflateState;
+
+static const uint16_t length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+// Order in which code length code lengths are stored in a dynamic block header.
+static const uint8_t codelen_order[CODELEN_CODES] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+/**
+ * @brief Tops up the bit buffer from the input.
+ *
+ * Past the end of the input the buffer is simply left short; callers check
+ * bitcnt before consuming bits.
+ *
+ * @param s Decoder state.
+ */
+static void refill(InflateState *s) {
+    while (s->bitcnt <= 56 && s->in_pos < s->in_len) {
+        s->bitbuf |= (uint64_t)s->in[s->in_pos++] << s->bitcnt;
+        s->bitcnt += 8;
+    }
+}
+
+/**
+ * @brief Reads up to 32 bits from the input.
+ *
+ * @param s Decoder state.
+ * @param n Number of bits (0-32).
+ * @param value Output: the bits, first bit in the lowest position.
+ * @return true on success, false if the input is exhausted.
+ */
+static bool get_bits(InflateState *s, int n, uint32_t *value) {
+    if (s->bitcnt < n) {
+        refill(s);
+        if (s->bitcnt < n) return false;
+    }
+    *value = (uint32_t)(s->bitbuf & ((n == 32) ? 0xffffffffu : ((1u << n) - 1)));
+    s->bitbuf >>= n;
+    s->bitcnt -= n;
+    return true;
+}
+
+/**
+ * @brief Builds a decode table from a list of canonical code lengths.
+ *
+ * @param table Table to fill.
+ * @param lengths Code length for each symbol (0 = unused).
+ * @param count Number of symbols.
+ * @return true on success, false if the lengths describe an over-subscribed code.
+ */
+static bool build_table(HuffmanTable *table, const uint8_t *lengths, int count) {
+    int bl_count[MAX_CODE_BITS + 1] = {0};
+    for (int i = 0; i < count; i++) {
+        bl_count[lengths[i]]++;
+    }
+    bl_count[0] = 0;
+
+    // Incomplete codes are legal (e.g. a single distance code); over-subscribed ones are not.
+    int left = 1;
+    for (int len = 1; len <= MAX_CODE_BITS; len++) {
+        left <<= 1;
+        left -= bl_count[len];
+        if (left < 0) return false;
+    }
+
+    for (int len = 0; len <= MAX_CODE_BITS; len++) table->count[len] = (uint16_t)bl_count[len];
+    memset(table->fast, 0, sizeof(table->fast));
+
+    int offsets[MAX_CODE_BITS + 2];
+    offsets[1] = 0;
+    for (int len = 1; len <= MAX_CODE_BITS; len++) offsets[len + 1] = offsets[len] + bl_count[len];
+    unsigned next_code[MAX_CODE_BITS + 1];
+    unsigned code = 0;
+    for (int len = 1; len <= MAX_CODE_BITS; len++) {
+        code = (code + bl_count[len - 1]) << 1;
+        next_code[len] = code;
+    }
+    for (int sym = 0; sym < count; sym++) {
+        int len = lengths[sym];
+        if (len == 0) continue;
+        table->symbol[offsets[len]++] = (uint16_t)sym;
+        unsigned c = next_code[len]++;
+        if (len > FAST_BITS) continue;
+        // Codes are stored most significant bit first, the table is indexed by the raw input bits.
+        unsigned reversed = 0;
+        for (int b = 0; b < len; b++) {
+            reversed = (reversed << 1) | (c & 1);
+            c >>= 1;
+        }
+        uint16_t entry = (uint16_t)((sym << 4) | len);
+        for (unsigned i = reversed; i < (1u << FAST_BITS); i += 1u << len) {
+            table->fast[i] = entry;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes one symbol using a decode table.
+ *
+ * @param s Decoder state.
+ * @param table Table for the current alphabet.
+ * @return int The symbol, or -1 on invalid or truncated input.
+ */
+static int decode_symbol(InflateState *s, const HuffmanTable *table) {
+    if (s->bitcnt < MAX_CODE_BITS) refill(s);
+    uint16_t entry = table->fast[s->bitbuf & ((1u << FAST_BITS) - 1)];
+    int len = entry & 15;
+    if (len != 0) {
+        if (len > s->bitcnt) return -1;
+        s->bitbuf >>= len;
+        s->bitcnt -= len;
+        return entry >> 4;
+    }
+
+    // Long code: compare against the first canonical code of each length in turn.
+    int code = 0, first = 0, index = 0;
+    for (len = 1; len <= MAX_CODE_BITS && len <= s->bitcnt; len++) {
+        code |= (int)((s->bitbuf >> (len - 1)) & 1);
+        int n = table->count[len];
+        if (code - n < first) {
+            s->bitbuf >>= len;
+            s->bitcnt -= len;
+            return table->symbol[index + (code - first)];
+        }
+        index += n;
+        first = (first + n) << 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+/**
+ * @brief Makes room for more output bytes.
+ *
+ * @param s Decoder state.
+ * @param extra Number of bytes about to be written.
+ * @return true on success, false on allocation failure.
+ */
+static bool reserve_output(InflateState *s, size_t extra) {
+    if (s->out_len + extra + 1 <= s->out_cap) return true;
+    size_t cap = s->out_cap ? s->out_cap : 256;
+    while (s->out_len + extra + 1 > cap) cap *= 2;
+    unsigned char *grown = (unsigned char*)realloc(s->out, cap);
+    if (!grown) return false;
+    s->out = grown;
+    s->out_cap = cap;
+    return true;
+}
+
+/**
+ * @brief Copies a stored (uncompressed) block to the output.
+ *
+ * @param s Decoder state.
+ * @return true on success.
+ */
+static bool inflate_stored(InflateState *s) {
+    // Drop the rest of the current byte, then hand whole buffered bytes back to the input.
+    s->bitbuf >>= s->bitcnt & 7;
+    s->bitcnt -= s->bitcnt & 7;
+    s->in_pos -= (size_t)(s->bitcnt / 8);
+    s->bitbuf = 0;
+    s->bitcnt = 0;
+
+    if (s->in_len - s->in_pos < 4) return false;
+    const unsigned char *p = s->in + s->in_pos;
+    unsigned len = p[0] | (p[1] << 8);
+    unsigned nlen = p[2] | (p[3] << 8);
+    if ((len ^ 0xffff) != nlen) return false;
+    s->in_pos += 4;
+    if (s->in_len - s->in_pos < len || !reserve_output(s, len)) return false;
+    memcpy(s->out + s->out_len, s->in + s->in_pos, len);
+    s->out_len += len;
+    s->in_pos += len;
+    return true;
+}
+
+/**
+ * @brief Decodes the compressed data of a block with the current tables.
+ *
+ * @param s Decoder state.
+ * @return true when the end-of-block symbol is reached.
+ */
+static bool inflate_codes(InflateState *s) {
+    for (;;) {
+        int sym = decode_symbol(s, &s->litlen);
+        if (sym < 0) return false;
+        if (sym < 256) {
+            if (!reserve_output(s, 1)) return false;
+            s->out[s->out_len++] = (unsigned char)sym;
+            continue;
+        }
+        if (sym == 256) return true;
+
+        sym -= 257;
+        if (sym >= 29) return false;
+        uint32_t extra;
+        if (!get_bits(s, length_extra[sym], &extra)) return false;
+        size_t length = length_base[sym] + extra;
+
+        int dsym = decode_symbol(s, &s->dist);
+        if (dsym < 0 || dsym >= 30) return false;
+        if (!get_bits(s, dist_extra[dsym], &extra)) return false;
+        size_t distance = dist_base[dsym] + extra;
+        if (distance > s->out_len || !reserve_output(s, length)) return false;
+
+        // Byte by byte: the source may overlap the bytes being written.
+        unsigned char *dst = s->out + s->out_len;
+        const unsigned char *src = dst - distance;
+        for (size_t i = 0; i < length; i++) dst[i] = src[i];
+        s->out_len += length;
+    }
+}
+
+/**
+ * @brief Sets up the fixed Huffman tables of block type 1.
+ *
+ * @param s Decoder state.
+ */
+static void build_fixed_tables(InflateState *s) {
+    uint8_t lengths[LITLEN_CODES];
+    int i = 0;
+    for (; i < 144; i++) lengths[i] = 8;
+    for (; i < 256; i++) lengths[i] = 9;
+    for (; i < 280; i++) lengths[i] = 7;
+    for (; i < LITLEN_CODES; i++) lengths[i] = 8;
+    build_table(&s->litlen, lengths, LITLEN_CODES);
+    for (i = 0; i < DIST_CODES; i++) lengths[i] = 5;
+    build_table(&s->dist, lengths, DIST_CODES);
+}
+
+/**
+ * @brief Reads the code length header of a dynamic block and builds its tables.
+ *
+ * @param s Decoder state.
+ * @return true on success.
+ */
+static bool build_dynamic_tables(InflateState *s) {
+    uint32_t hlit, hdist, hclen;
+    if (!get_bits(s, 5, &hlit) || !get_bits(s, 5, &hdist) || !get_bits(s, 4, &hclen)) return false;
+    hlit += 257;
+    hdist += 1;
+    hclen += 4;
+    if (hlit > 286 || hdist > 30) return false;
+
+    uint8_t codelen_lengths[CODELEN_CODES] = {0};
+    for (uint32_t i = 0; i < hclen; i++) {
+        uint32_t len;
+        if (!get_bits(s, 3, &len)) return false;
+        codelen_lengths[codelen_order[i]] = (uint8_t)len;
+    }
+    // The code length alphabet is decoded with the dist table, which is rebuilt below.
+    if (!build_table(&s->dist, codelen_lengths, CODELEN_CODES)) return false;
+
+    uint8_t lengths[LITLEN_CODES + DIST_CODES];
+    uint32_t n = 0;
+    while (n < hlit + hdist) {
+        int sym = decode_symbol(s, &s->dist);
+        if (sym < 0) return false;
+        if (sym < 16) {
+            lengths[n++] = (uint8_t)sym;
+            continue;
+        }
+        uint32_t repeat;
+        uint8_t value = 0;
+        if (sym == 16) {
+            if (n == 0 || !get_bits(s, 2, &repeat)) return false;
+            value = lengths[n - 1];
+            repeat += 3;
+        } else if (sym == 17) {
+            if (!get_bits(s, 3, &repeat)) return false;
+            repeat += 3;
+        } else {
+            if (!get_bits(s, 7, &repeat)) return false;
+            repeat += 11;
+        }
+        if (n + repeat > hlit + hdist) return false;
+        while (repeat--) lengths[n++] = value;
+    }
+    if (lengths[256] == 0) return false;   // a block without end-of-block code cannot terminate
+    return build_table(&s->litlen, lengths, (int)hlit) &&
+           build_table(&s->dist, lengths + hlit, (int)hdist);
+}
+
+/**
+ * @brief Computes the Adler-32 checksum used by the zlib trailer.
+ *
+ * @param data Input bytes.
+ * @param len Number of bytes.
+ * @return uint32_t Checksum.
+ */
+static uint32_t adler32(const unsigned char *data, size_t len) {
+    uint32_t a = 1, b = 0;
+    while (len > 0) {
+        // 5552 bytes is the largest run that cannot overflow before the modulo.
+        size_t run = len < 5552 ? len : 5552;
+        len -= run;
+        while (run--) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+/**
+ * @brief Decompress a zlib stream.
+ *
+ * @param src Compressed input.
+ * @param src_len Number of bytes available at src.
+ * @param size_hint Expected decompressed size (0 if unknown).
+ * @param out Output: newly allocated, NUL-terminated buffer.
+ * @param out_len Output: number of decompressed bytes.
+ * @return true on success, false on malformed input or allocation failure.
+ */
+bool zlib_inflate(const unsigned char *src, size_t src_len, size_t size_hint,
+                  unsigned char **out, size_t *out_len) {
+    // CMF/FLG: deflate method, check bits, and no preset dictionary.
+    if (src_len < 6 || (src[0] & 0x0f) != 8 || ((src[0] << 8) | src[1]) % 31 != 0 || (src[1] & 0x20)) {
+        return false;
+    }
+
+    InflateState state;
+    InflateState *s = &state;
+    s->in = src;
+    s->in_len = src_len;
+    s->in_pos = 2;
+    s->bitbuf = 0;
+    s->bitcnt = 0;
+    s->out = NULL;
+    s->out_len = 0;
+    s->out_cap = 0;
+
+    bool ok = reserve_output(s, size_hint);
+    uint32_t final_block = 0;
+    while (ok && !final_block) {
+        uint32_t type;
+        if (!get_bits(s, 1, &final_block) || !get_bits(s, 2, &type)) {
+            ok = false;
+        } else if (type == 0) {
+            ok = inflate_stored(s);
+        } else if (type == 1) {
+            build_fixed_tables(s);
+            ok = inflate_codes(s);
+        } else if (type == 2) {
+            ok = build_dynamic_tables(s) && inflate_codes(s);
+        } else {
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        // The checksum starts at the next byte boundary.
+        s->bitbuf >>= s->bitcnt & 7;
+        s->bitcnt -= s->bitcnt & 7;
+        uint32_t check = 0;
+        for (int i = 0; ok && i < 4; i++) {
+            uint32_t byte;
+            ok = get_bits(s, 8, &byte);
+            check = (check << 8) | byte;
+        }
+        ok = ok && check == adler32(s->out, s->out_len);
+    }
+
+    if (ok) {
+        s->out[s->out_len] = '\0';
+        *out = s->out;
+        *out_len = s->out_len;
+    } else {
+        free(s->out);
+    }
+    return ok;
+}
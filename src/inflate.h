@@ -0,0 +1,26 @@
+#ifndef INFLATE_H
+#define INFLATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Decompress a zlib stream (RFC 1950 wrapping RFC 1951 deflate data).
+ *
+ * Git stores loose objects and packfile entries in this format. Only the
+ * data up to the end of the first zlib stream is consumed; trailing bytes
+ * (the next packfile entry) are ignored. The Adler-32 checksum is verified.
+ *
+ * @param src Compressed input.
+ * @param src_len Number of bytes available at src.
+ * @param size_hint Expected decompressed size, used for the initial
+ *        allocation (0 if unknown).
+ * @param out Output: newly allocated buffer, NUL-terminated one byte past
+ *        the data so text can be used as a C string.
+ * @param out_len Output: number of decompressed bytes.
+ * @return true on success, false on malformed input or allocation failure.
+ */
+bool zlib_inflate(const unsigned char *src, size_t src_len, size_t size_hint,
+                  unsigned char **out, size_t *out_len);
+
+#endif // INFLATE_H
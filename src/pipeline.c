@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#include "pipeline.h"
+
+// One item in flight between a worker and the writer.
+typedef struct {
+    bool done;          // rendered (or declined) and waiting for the writer
+    bool rendered;      // false if the render step left the item to the writer
+    char *data;         // buffer behind the memory stream
+    size_t len;
+    DocumentInfo info;
+} PipelineSlot;
+
+typedef struct {
+    size_t count;
+    size_t window;
+    PipelineRender render;
+    void *ctx;
+    PipelineSlot *slots;    // item i lives in slots[i % window]
+
+    pthread_mutex_t lock;
+    pthread_cond_t space;   // the writer freed a slot
+    pthread_cond_t ready;   // a worker finished an item
+    size_t next;            // next item to claim
+    size_t written;         // items the writer is done with
+} Pipeline;
+
+/**
+ * @brief Renders one item into its slot.
+ *
+ * @param p Pipeline.
+ * @param index Item to render.
+ * @param slot Slot of the item.
+ */
+static void render_item(Pipeline *p, size_t index, PipelineSlot *slot) {
+    memset(&slot->info, 0, sizeof(slot->info));
+    slot->data = NULL;
+    slot->len = 0;
+    FILE *ms = open_memstream(&slot->data, &slot->len);
+    slot->rendered = ms && p->render(p->ctx, index, ms, &slot->info);
+    if (ms) {
+        fclose(ms);
+    }
+    if (!slot->rendered) {
+        free(slot->data);
+        slot->data = NULL;
+        slot->len = 0;
+    }
+}
+
+/**
+ * @brief Worker loop: claim the next item once its slot is free and render it.
+ *
+ * @param arg Pointer to the shared Pipeline.
+ * @return void* Always NULL.
+ */
+static void *pipeline_worker(void *arg) {
+    Pipeline *p = (Pipeline*)arg;
+    pthread_mutex_lock(&p->lock);
+    for (;;) {
+        while (p->next < p->count && p->next >= p->written + p->window) {
+            pthread_cond_wait(&p->space, &p->lock);
+        }
+        if (p->next >= p->count) {
+            break;
+        }
+        size_t index = p->next++;
+        PipelineSlot *slot = &p->slots[index % p->window];
+        pthread_mutex_unlock(&p->lock);
+
+        render_item(p, index, slot);
+
+        pthread_mutex_lock(&p->lock);
+        slot->done = true;
+        pthread_cond_broadcast(&p->ready);
+    }
+    pthread_mutex_unlock(&p->lock);
+    return NULL;
+}
+
+/**
+ * @brief Renders items on worker threads and writes them in order.
+ *
+ * @param count Number of items.
+ * @param threads Number of worker threads; below 1 every item goes straight
+ *        to the writer unrendered.
+ * @param window Maximum number of items rendered ahead of the writer.
+ * @param render Render step.
+ * @param write Write step.
+ * @param ctx Context passed to both steps.
+ */
+void pipeline_run(size_t count, int threads, size_t window,
+                  PipelineRender render, PipelineWrite write, void *ctx) {
+    Pipeline p;
+    memset(&p, 0, sizeof(p));
+    p.count = count;
+    p.window = window < 1 ? 1 : window;
+    p.render = render;
+    p.ctx = ctx;
+    p.slots = threads > 0 ? (PipelineSlot*)calloc(p.window, sizeof(PipelineSlot)) : NULL;
+
+    pthread_t *tids = p.slots ? (pthread_t*)malloc((size_t)threads * sizeof(pthread_t)) : NULL;
+    int started = 0;
+    if (tids) {
+        pthread_mutex_init(&p.lock, NULL);
+        pthread_cond_init(&p.space, NULL);
+        pthread_cond_init(&p.ready, NULL);
+        for (int i = 0; i < threads; i++) {
+            if (pthread_create(&tids[i], NULL, pipeline_worker, &p) != 0) break;
+            started++;
+        }
+    }
+    if (started == 0) {
+        // No workers: the writer handles every item itself
+        for (size_t i = 0; i < count; i++) {
+            write(ctx, i, NULL, 0, NULL);
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            PipelineSlot *slot = &p.slots[i % p.window];
+            pthread_mutex_lock(&p.lock);
+            while (!slot->done) {
+                pthread_cond_wait(&p.ready, &p.lock);
+            }
+            pthread_mutex_unlock(&p.lock);
+
+            if (slot->rendered) {
+                write(ctx, i, slot->data, slot->len, &slot->info);
+            } else {
+                write(ctx, i, NULL, 0, NULL);
+            }
+            free(slot->data);
+
+            pthread_mutex_lock(&p.lock);
+            slot->done = false;
+            slot->data = NULL;
+            p.written = i + 1;
+            pthread_cond_broadcast(&p.space);
+            pthread_mutex_unlock(&p.lock);
+        }
+    }
+    for (int i = 0; i < started; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    if (tids) {
+        pthread_cond_destroy(&p.ready);
+        pthread_cond_destroy(&p.space);
+        pthread_mutex_destroy(&p.lock);
+    }
+    free(tids);
+    free(p.slots);
+}
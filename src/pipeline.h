@@ -0,0 +1,54 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "dirdoc.h"
+
+/*
+ * Ordered parallel rendering. Items 0..count-1 are rendered by a pool of
+ * worker threads, each into its own memory buffer with its own statistics,
+ * and handed to a single writer on the calling thread strictly in index
+ * order. Workers run at most `window` items ahead of the writer, so at most
+ * that many rendered buffers exist at any time.
+ */
+
+/**
+ * @brief Render one item. Runs on a worker thread.
+ *
+ * @param ctx Caller context.
+ * @param index Item to render.
+ * @param out Memory stream to render into.
+ * @param info Statistics of the rendered text, zeroed beforehand.
+ * @return true If the item was rendered; false leaves it to the writer.
+ */
+typedef bool (*PipelineRender)(void *ctx, size_t index, FILE *out, DocumentInfo *info);
+
+/**
+ * @brief Write one item. Runs on the calling thread, in index order.
+ *
+ * @param ctx Caller context.
+ * @param index Item to write.
+ * @param data Rendered text, or NULL if the render step declined the item.
+ * @param len Length of the rendered text.
+ * @param info Statistics of the rendered text, or NULL with data.
+ */
+typedef void (*PipelineWrite)(void *ctx, size_t index, const char *data, size_t len, const DocumentInfo *info);
+
+/**
+ * @brief Render items on worker threads and write them in order.
+ *
+ * @param count Number of items.
+ * @param threads Number of worker threads; below 1 every item goes straight
+ *        to the writer unrendered.
+ * @param window Maximum number of items rendered ahead of the writer.
+ * @param render Render step.
+ * @param write Write step.
+ * @param ctx Context passed to both steps.
+ */
+void pipeline_run(size_t count, int threads, size_t window,
+                  PipelineRender render, PipelineWrite write, void *ctx);
+
+#endif // PIPELINE_H
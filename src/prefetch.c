@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "prefetch.h"
+#include "stats.h"
+
+// Number of entries a worker claims at a time.
+#define PREFETCH_BATCH 64
+
+// Most bytes of file contents kept for the writer at once; the writer
+// releases each file's copy once its section is written.
+#define PREFETCH_HEAD_BUDGET (32 * 1024 * 1024)
+
+typedef struct {
+    FileList *list;
+    int root_fd;
+    atomic_size_t next;     // index of the next unclaimed entry
+    atomic_size_t kept;     // bytes of contents kept in FileEntry.head
+} PrefetchJob;
+
+/**
+ * @brief Collects metadata for a single file entry.
+ *
+ * Opens the file relative to the root descriptor, records its size and
+ * decides whether it is binary from its first BINARY_PROBE_SIZE bytes.
+ * When that block holds the whole of a text file and the budget allows, it
+ * is kept for the writer together with the file's identity, so the file is
+ * not opened again.
+ * Files that cannot be opened are treated as binary, as is_binary_file() does.
+ *
+ * @param root_fd Descriptor of the documented directory.
+ * @param kept Bytes of contents kept so far, shared by all workers.
+ * @param entry Entry to annotate.
+ */
+static void prefetch_entry(int root_fd, atomic_size_t *kept, FileEntry *entry) {
+    int fd = openat(root_fd, entry->path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        struct stat st;
+        entry->size = (fstatat(root_fd, entry->path, &st, 0) == 0) ? (long long)st.st_size : -1;
+        entry->is_binary = true;
+        entry->has_meta = true;
+        return;
+    }
+
+    struct stat st;
+    entry->size = (fstat(fd, &st) == 0) ? (long long)st.st_size : -1;
+
+    unsigned char buf[BINARY_PROBE_SIZE];
+    size_t len = 0;
+    while (len < sizeof(buf)) {
+        ssize_t n = read(fd, buf + len, sizeof(buf) - len);
+        if (n <= 0) break;
+        len += (size_t)n;
+    }
+    close(fd);
+
+    entry->is_binary = is_binary_buffer(buf, len);
+    entry->has_meta = true;
+    if (!entry->is_binary && entry->size == (long long)len && S_ISREG(st.st_mode)) {
+        if (atomic_fetch_add(kept, len) + len > PREFETCH_HEAD_BUDGET) {
+            atomic_fetch_sub(kept, len);
+            return;
+        }
+        entry->head = malloc(len ? len : 1);
+        if (entry->head) {
+            memcpy(entry->head, buf, len);
+            entry->dev = (unsigned long long)st.st_dev;
+            entry->ino = (unsigned long long)st.st_ino;
+            entry->mtime_ns = (long long)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+        }
+    }
+}
+
+/**
+ * @brief Worker loop: claim batches of entries until the list is exhausted.
+ *
+ * @param arg Pointer to the shared PrefetchJob.
+ * @return void* Always NULL.
+ */
+static void *prefetch_worker(void *arg) {
+    PrefetchJob *job = (PrefetchJob*)arg;
+    size_t count = job->list->count;
+    for (;;) {
+        size_t start = atomic_fetch_add(&job->next, PREFETCH_BATCH);
+        if (start >= count) break;
+        size_t end = start + PREFETCH_BATCH < count ? start + PREFETCH_BATCH : count;
+        for (size_t i = start; i < end; i++) {
+            FileEntry *entry = &job->list->entries[i];
+            if (!entry->is_dir) {
+                prefetch_entry(job->root_fd, &job->kept, entry);
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Collects size and binary verdicts for every file in a FileList.
+ *
+ * @param root_dir Directory the entry paths are relative to.
+ * @param list File list to annotate; directory entries are left untouched.
+ * @param threads Number of worker threads (1 runs on the calling thread).
+ */
+void prefetch_file_metadata(const char *root_dir, FileList *list, int threads) {
+    int root_fd = open(root_dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (root_fd < 0) {
+        return; // The writer falls back to per-file probing.
+    }
+
+    PrefetchJob job;
+    job.list = list;
+    job.root_fd = root_fd;
+    atomic_init(&job.next, 0);
+    atomic_init(&job.kept, 0);
+
+    if (threads < 1) threads = 1;
+    pthread_t *tids = NULL;
+    int started = 0;
+    if (threads > 1) {
+        tids = (pthread_t*)malloc((threads - 1) * sizeof(pthread_t));
+        for (int i = 0; tids && i < threads - 1; i++) {
+            if (pthread_create(&tids[i], NULL, prefetch_worker, &job) != 0) break;
+            started++;
+        }
+    }
+    prefetch_worker(&job);
+    for (int i = 0; i < started; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    free(tids);
+    close(root_fd);
+}
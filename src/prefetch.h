@@ -0,0 +1,23 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include "scanner.h"
+
+/**
+ * @brief Collect size and binary verdicts for every file in a FileList.
+ *
+ * Each file is opened once, fstat()ed and its first block read. Files are
+ * handed out to a pool of worker threads in batches so that slow metadata
+ * round trips overlap. The results are stored in the FileEntry fields
+ * (has_meta, is_binary, size) and consumed by the writer; text files that
+ * fit in the first block also keep their contents and identity (head, dev,
+ * ino, mtime_ns), up to a fixed total, so the writer does not open them
+ * again. The writer frees head once the file is written.
+ *
+ * @param root_dir Directory the entry paths are relative to.
+ * @param list File list to annotate; directory entries are left untouched.
+ * @param threads Number of worker threads (1 runs on the calling thread).
+ */
+void prefetch_file_metadata(const char *root_dir, FileList *list, int threads);
+
+#endif // PREFETCH_H
@@ -0,0 +1,387 @@
+#include "pretokenize.h"
+#include "unicode_classes.h"
+#include <stdbool.h>
+#include <string.h>
+
+// Class sets used by the split patterns
+#define CLASS_LETTER  (UC_UPPER | UC_LOWER | UC_LETTER)     // \p{L}
+#define CLASS_SPACE   (UC_SPACE | UC_NEWLINE)               // \s
+#define CLASS_PREFIX  (UC_OTHER | UC_MARK | UC_SPACE)       // [^\r\n\p{L}\p{N}]
+#define CLASS_PUNCT   (UC_OTHER | UC_MARK)                  // [^\s\p{L}\p{N}]
+#define CLASS_CASED_UPPER (UC_UPPER | UC_LETTER | UC_MARK)  // [\p{Lu}\p{Lt}\p{Lm}\p{Lo}\p{M}]
+#define CLASS_CASED_LOWER (UC_LOWER | UC_LETTER | UC_MARK)  // [\p{Ll}\p{Lm}\p{Lo}\p{M}]
+
+/**
+ * @brief Look up the class of a non-ASCII code point.
+ *
+ * @param cp Code point.
+ * @return unsigned char One of the UC_* classes.
+ */
+static unsigned char class_of_code_point(unsigned int cp) {
+    size_t lo = 0, hi = UNICODE_CLASS_RANGE_COUNT;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (unicode_class_ranges[mid].first <= cp) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return unicode_class_ranges[lo].cls;
+}
+
+/**
+ * @brief Decode the symbol at pos and return its class.
+ *
+ * A symbol is one UTF-8 encoded code point, or a single byte where the text
+ * is not valid UTF-8 (such bytes are classed UC_OTHER).
+ *
+ * @param s Text.
+ * @param len Length of the text.
+ * @param pos Offset of the symbol, less than len.
+ * @param width Output: length of the symbol in bytes.
+ * @return unsigned char One of the UC_* classes.
+ */
+static inline unsigned char class_at(const unsigned char *s, size_t len, size_t pos, size_t *width) {
+    unsigned char c = s[pos];
+    if (c < 0x80) {
+        *width = 1;
+        return unicode_ascii_class[c];
+    }
+
+    unsigned int cp;
+    size_t n;
+    if (c >= 0xC2 && c <= 0xDF) {
+        n = 2;
+        cp = c & 0x1F;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        n = 3;
+        cp = c & 0x0F;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        n = 4;
+        cp = c & 0x07;
+    } else {
+        *width = 1;
+        return UC_OTHER;
+    }
+    if (len - pos < n) {
+        *width = 1;
+        return UC_OTHER;
+    }
+    for (size_t i = 1; i < n; i++) {
+        unsigned char cc = s[pos + i];
+        if ((cc & 0xC0) != 0x80) {
+            *width = 1;
+            return UC_OTHER;
+        }
+        cp = (cp << 6) | (cc & 0x3F);
+    }
+    // Overlong forms, surrogates and code points past U+10FFFF
+    if ((n == 3 && cp < 0x800) || (n == 4 && (cp < 0x10000 || cp > 0x10FFFF)) ||
+        (cp >= 0xD800 && cp <= 0xDFFF)) {
+        *width = 1;
+        return UC_OTHER;
+    }
+    *width = n;
+    return class_of_code_point(cp);
+}
+
+/**
+ * @brief Skip the symbols whose class is in mask.
+ *
+ * @param s Text.
+ * @param len Length of the text.
+ * @param pos Where to start.
+ * @param mask Set of UC_* classes to skip.
+ * @return size_t Offset of the first symbol not in mask, or len.
+ */
+static inline size_t skip_run(const unsigned char *s, size_t len, size_t pos, unsigned char mask) {
+    while (pos < len) {
+        // Most text is ASCII: skip it without decoding
+        if (s[pos] < 0x80) {
+            if (!(unicode_ascii_class[s[pos]] & mask)) break;
+            pos++;
+            continue;
+        }
+        size_t width;
+        if (!(class_at(s, len, pos, &width) & mask)) break;
+        pos += width;
+    }
+    return pos;
+}
+
+/**
+ * @brief Match (?i:'s|'t|'re|'ve|'m|'ll|'d) at pos.
+ *
+ * Case-insensitive matching is Unicode aware in the reference engines, so
+ * 's also matches U+017F LATIN SMALL LETTER LONG S.
+ *
+ * @param s Text.
+ * @param len Length of the text.
+ * @param pos Where the apostrophe would be.
+ * @return size_t Length of the match in bytes, 0 if there is none.
+ */
+static inline size_t contraction_at(const unsigned char *s, size_t len, size_t pos) {
+    if (len - pos < 2 || s[pos] != '\'') return 0;
+    unsigned char c = s[pos + 1];
+    if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    if (c == 's' || c == 't' || c == 'm' || c == 'd') return 2;
+    if (len - pos < 3) return 0;
+    unsigned char c2 = s[pos + 2];
+    if (c2 >= 'A' && c2 <= 'Z') c2 += 'a' - 'A';
+    if ((c == 'r' && c2 == 'e') || (c == 'v' && c2 == 'e') || (c == 'l' && c2 == 'l')) return 3;
+    if (c == 0xC5 && c2 == 0xBF) return 3;
+    return 0;
+}
+
+/**
+ * @brief Match [\p{Lu}\p{Lt}\p{Lm}\p{Lo}\p{M}]*[\p{Ll}\p{Lm}\p{Lo}\p{M}]+ and
+ *        an optional contraction at pos.
+ *
+ * The regex engine backtracks the greedy upper case run until a lower case
+ * run can start, so the lower case run begins at the last position in or
+ * just after the upper case run that holds a symbol of the lower set.
+ *
+ * @param s Text.
+ * @param len Length of the text.
+ * @param pos Where the word would start.
+ * @return size_t End of the match, or 0 if there is none.
+ */
+static inline size_t cased_word_lower(const unsigned char *s, size_t len, size_t pos) {
+    size_t lower_start = (size_t)-1;
+    while (pos < len) {
+        size_t width;
+        unsigned char cls = class_at(s, len, pos, &width);
+        if (cls & CLASS_CASED_LOWER) lower_start = pos;
+        if (!(cls & CLASS_CASED_UPPER)) break;
+        pos += width;
+    }
+    if (lower_start == (size_t)-1) return 0;
+    size_t end = skip_run(s, len, lower_start, CLASS_CASED_LOWER);
+    return end + contraction_at(s, len, end);
+}
+
+/**
+ * @brief Match [\p{Lu}\p{Lt}\p{Lm}\p{Lo}\p{M}]+[\p{Ll}\p{Lm}\p{Lo}\p{M}]* and
+ *        an optional contraction at pos.
+ *
+ * @param s Text.
+ * @param len Length of the text.
+ * @param pos Where the word would start.
+ * @return size_t End of the match, or 0 if there is none.
+ */
+static inline size_t cased_word_upper(const unsigned char *s, size_t len, size_t pos) {
+    size_t end = skip_run(s, len, pos, CLASS_CASED_UPPER);
+    if (end == pos) return 0;
+    end = skip_run(s, len, end, CLASS_CASED_LOWER);
+    return end + contraction_at(s, len, end);
+}
+
+/**
+ * @brief Find the end of an ASCII piece without decoding.
+ *
+ * Takes the common case of source code and English prose, where the piece
+ * and the symbols around it are ASCII, with a single pass per alternative.
+ * It gives up as soon as a non-ASCII byte could extend or change the match.
+ *
+ * @param s Text.
+ * @param len Length of the text.
+ * @param pos Start of the piece, less than len.
+ * @param pattern Split pattern to apply.
+ * @return size_t End of the piece, or 0 to fall back to the general scanner.
+ */
+static inline size_t ascii_piece(const unsigned char *s, size_t len, size_t pos, PretokenizePattern pattern) {
+    size_t next = pos + 1;
+    if (s[pos] >= 0x80 || (next < len && s[next] >= 0x80)) return 0;
+    unsigned char cls = unicode_ascii_class[s[pos]];
+    unsigned char next_cls = next < len ? unicode_ascii_class[s[next]] : 0;
+    size_t end;
+
+    if (pattern == PRETOKENIZE_CL100K && s[pos] == '\'' && (end = contraction_at(s, len, pos))) {
+        return pos + end;
+    }
+
+    // A letter run, possibly after one prefix symbol. ASCII has no Lm, Lo or
+    // M, so an o200k word is [A-Z]*[a-z]* and the lower case alternative wins
+    // whenever the lower case run is not empty.
+    size_t word = (size_t)-1;
+    if (cls & CLASS_LETTER) {
+        word = pos;
+    } else if ((cls & CLASS_PREFIX) && (next_cls & CLASS_LETTER)) {
+        word = next;
+    }
+    if (word != (size_t)-1) {
+        end = word;
+        if (pattern == PRETOKENIZE_O200K) {
+            while (end < len && s[end] < 0x80 && (unicode_ascii_class[s[end]] & UC_UPPER)) end++;
+            while (end < len && s[end] < 0x80 && (unicode_ascii_class[s[end]] & UC_LOWER)) end++;
+            if (end < len && s[end] >= 0x80) return 0;
+            return end + contraction_at(s, len, end);
+        }
+        while (end < len && s[end] < 0x80 && (unicode_ascii_class[s[end]] & CLASS_LETTER)) end++;
+        return end < len && s[end] >= 0x80 ? 0 : end;
+    }
+
+    if (cls & UC_NUMBER) {
+        end = next;
+        while (end < len && end - pos < 3 && s[end] < 0x80 && (unicode_ascii_class[s[end]] & UC_NUMBER)) end++;
+        return end < len && end - pos < 3 && s[end] >= 0x80 ? 0 : end;
+    }
+
+    size_t start = s[pos] == ' ' ? next : pos;
+    if ((start == pos ? cls : next_cls) & CLASS_PUNCT) {
+        end = start;
+        while (end < len && s[end] < 0x80 && (unicode_ascii_class[s[end]] & CLASS_PUNCT)) end++;
+        if (end < len && s[end] >= 0x80) return 0;
+        while (end < len && (s[end] == '\r' || s[end] == '\n' ||
+                             (pattern == PRETOKENIZE_O200K && s[end] == '/'))) {
+            end++;
+        }
+        return end;
+    }
+
+    if (cls & CLASS_SPACE) {
+        size_t last = pos, newline_end = 0;
+        for (end = pos; end < len && s[end] < 0x80 && (unicode_ascii_class[s[end]] & CLASS_SPACE); end++) {
+            if (unicode_ascii_class[s[end]] & UC_NEWLINE) newline_end = end + 1;
+            last = end;
+        }
+        if (end < len && s[end] >= 0x80) return 0;
+        if (newline_end) return newline_end;
+        if (end == len || last == pos) return end;
+        return last;
+    }
+    return 0;
+}
+
+/**
+ * @brief Select the split pattern of a tiktoken encoding.
+ *
+ * @param encoder_name Encoding name, e.g. "o200k_base" or "cl100k_base".
+ * @return PretokenizePattern PRETOKENIZE_O200K for the o200k encodings,
+ *         PRETOKENIZE_CL100K otherwise.
+ */
+PretokenizePattern pretokenize_pattern(const char *encoder_name) {
+    if (encoder_name && strncmp(encoder_name, "o200k", 5) == 0) {
+        return PRETOKENIZE_O200K;
+    }
+    return PRETOKENIZE_CL100K;
+}
+
+/**
+ * @brief Find the end of the piece that starts at pos.
+ *
+ * The alternatives of the pattern are tried in order and the first one that
+ * matches wins, as in the regex. Within the letter alternatives the variant
+ * with the optional prefix symbol is tried before the one without.
+ *
+ * @param text Text to split.
+ * @param len Length of text in bytes.
+ * @param pos Start of the piece, less than len.
+ * @param pattern Split pattern to apply.
+ * @return size_t Offset one past the last byte of the piece.
+ */
+size_t pretokenize_next(const char *text, size_t len, size_t pos, PretokenizePattern pattern) {
+    const unsigned char *s = (const unsigned char *)text;
+    size_t end = ascii_piece(s, len, pos, pattern);
+    if (end) return end;
+
+    size_t width;
+    unsigned char cls = class_at(s, len, pos, &width);
+    bool has_prefix = (cls & CLASS_PREFIX) && pos + width < len;
+
+    // Words
+    if (pattern == PRETOKENIZE_O200K) {
+        if (has_prefix && (end = cased_word_lower(s, len, pos + width))) return end;
+        if ((end = cased_word_lower(s, len, pos))) return end;
+        if (has_prefix && (end = cased_word_upper(s, len, pos + width))) return end;
+        if ((end = cased_word_upper(s, len, pos))) return end;
+    } else {
+        if ((end = contraction_at(s, len, pos))) return pos + end;
+        if (has_prefix) {
+            size_t next_width;
+            if (class_at(s, len, pos + width, &next_width) & CLASS_LETTER) {
+                return skip_run(s, len, pos + width, CLASS_LETTER);
+            }
+        }
+        if (cls & CLASS_LETTER) return skip_run(s, len, pos, CLASS_LETTER);
+    }
+
+    // \p{N}{1,3}
+    if (cls & UC_NUMBER) {
+        end = pos + width;
+        for (int i = 1; i < 3 && end < len; i++) {
+            size_t next_width;
+            if (!(class_at(s, len, end, &next_width) & UC_NUMBER)) break;
+            end += next_width;
+        }
+        return end;
+    }
+
+    //  ?[^\s\p{L}\p{N}]+ followed by [\r\n]* (cl100k) or [\r\n/]* (o200k)
+    size_t start = pos;
+    unsigned char start_cls = cls;
+    if (s[pos] == ' ' && pos + 1 < len) {
+        size_t start_width;
+        start = pos + 1;
+        start_cls = class_at(s, len, start, &start_width);
+    }
+    if (start_cls & CLASS_PUNCT) {
+        end = skip_run(s, len, start, CLASS_PUNCT);
+        while (end < len && (s[end] == '\r' || s[end] == '\n' ||
+                             (pattern == PRETOKENIZE_O200K && s[end] == '/'))) {
+            end++;
+        }
+        return end;
+    }
+
+    // \s*[\r\n]+ ends after the last line break of the white space run;
+    // otherwise \s+(?!\S) leaves the last white space symbol for the next
+    // piece unless the run reaches the end, and \s+ takes a single symbol.
+    if (cls & CLASS_SPACE) {
+        size_t last = pos, newline_end = 0;
+        end = pos;
+        while (end < len) {
+            size_t space_width;
+            unsigned char c = class_at(s, len, end, &space_width);
+            if (!(c & CLASS_SPACE)) break;
+            if (c & UC_NEWLINE) newline_end = end + space_width;
+            last = end;
+            end += space_width;
+        }
+        if (newline_end) return newline_end;
+        if (end == len || last == pos) return end;
+        return last;
+    }
+
+    return pos + width;
+}
+
+/**
+ * @brief Find the next position where pieces restart whatever surrounds it.
+ *
+ * A line feed ends every piece it is in unless a following '/' (o200k),
+ * line break or other white space extends it, and the scanner never looks
+ * past the first symbol of the next piece. An ASCII character other than
+ * those therefore starts a piece that nothing before it depends on.
+ *
+ * @param text Text to search.
+ * @param len Length of text in bytes.
+ * @param from First position to consider; position 0 never qualifies.
+ * @return size_t The first restart position at or after from, or len if none.
+ */
+size_t pretokenize_next_boundary(const char *text, size_t len, size_t from) {
+    const unsigned char *s = (const unsigned char *)text;
+    size_t pos = from > 0 ? from - 1 : 0;
+    while (pos + 1 < len) {
+        const unsigned char *lf = memchr(s + pos, '\n', len - 1 - pos);
+        if (lf == NULL) break;
+        size_t next = (size_t)(lf - s) + 1;
+        unsigned char c = s[next];
+        if (c < 0x80 && c != '/' && !(unicode_ascii_class[c] & CLASS_SPACE)) {
+            return next;
+        }
+        pos = next;
+    }
+    return len;
+}
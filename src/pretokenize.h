@@ -0,0 +1,71 @@
+#ifndef PRETOKENIZE_H
+#define PRETOKENIZE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Pre-tokenization splits text into the pieces that BPE merges run on. The
+ * split patterns of the tiktoken encodings are regular expressions; this
+ * module implements them as a hand-written scanner over UTF-8 that yields the
+ * same pieces as the regex, leftmost alternative first, without a regex
+ * engine. Bytes that are not valid UTF-8 are treated as single symbols that
+ * are neither letters, numbers nor white space.
+ */
+typedef enum {
+    // (?i:'s|'t|'re|'ve|'m|'ll|'d)|[^\r\n\p{L}\p{N}]?\p{L}+|\p{N}{1,3}|
+    //  ?[^\s\p{L}\p{N}]+[\r\n]*|\s*[\r\n]+|\s+(?!\S)|\s+
+    PRETOKENIZE_CL100K,
+    // [^\r\n\p{L}\p{N}]?[\p{Lu}\p{Lt}\p{Lm}\p{Lo}\p{M}]*[\p{Ll}\p{Lm}\p{Lo}\p{M}]+(?i:'s|'t|'re|'ve|'m|'ll|'d)?|
+    // [^\r\n\p{L}\p{N}]?[\p{Lu}\p{Lt}\p{Lm}\p{Lo}\p{M}]+[\p{Ll}\p{Lm}\p{Lo}\p{M}]*(?i:'s|'t|'re|'ve|'m|'ll|'d)?|
+    // \p{N}{1,3}| ?[^\s\p{L}\p{N}]+[\r\n/]*|\s*[\r\n]+|\s+(?!\S)|\s+
+    PRETOKENIZE_O200K
+} PretokenizePattern;
+
+/**
+ * @brief Select the split pattern of a tiktoken encoding.
+ *
+ * @param encoder_name Encoding name, e.g. "o200k_base" or "cl100k_base".
+ * @return PretokenizePattern PRETOKENIZE_O200K for the o200k encodings,
+ *         PRETOKENIZE_CL100K otherwise.
+ */
+PretokenizePattern pretokenize_pattern(const char *encoder_name);
+
+/**
+ * @brief Find the end of the piece that starts at pos.
+ *
+ * Calling this repeatedly with the returned offset walks the text piece by
+ * piece; every piece is at least one byte long.
+ *
+ * @param text Text to split.
+ * @param len Length of text in bytes.
+ * @param pos Start of the piece, less than len.
+ * @param pattern Split pattern to apply.
+ * @return size_t Offset one past the last byte of the piece.
+ */
+size_t pretokenize_next(const char *text, size_t len, size_t pos, PretokenizePattern pattern);
+
+/**
+ * @brief Find the next position where pieces restart whatever surrounds it.
+ *
+ * A restart position directly follows a line feed and holds an ASCII
+ * character other than white space and '/'. Under both patterns a piece
+ * always ends there and no piece before it depends on the bytes after it, so
+ * the text on each side splits into the same pieces with or without the
+ * other side. Text can be cut at these positions and counted in parts.
+ *
+ * @param text Text to search.
+ * @param len Length of text in bytes.
+ * @param from First position to consider; position 0 never qualifies.
+ * @return size_t The first restart position at or after from, or len if none.
+ */
+size_t pretokenize_next_boundary(const char *text, size_t len, size_t from);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PRETOKENIZE_H
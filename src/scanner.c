@@ -3,7 +3,11 @@
 #include <string.h>
 #include <stdbool.h>
 #include <dirent.h>
+#include <pthread.h>
+#include <stdatomic.h>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "scanner.h"
 #include "gitignore.h"
@@ -42,18 +46,23 @@ void add_file_entry(FileList *list, const char *path, bool is_dir, int depth) {
     entry->path = strdup(path);
     entry->is_dir = is_dir;
     entry->depth = depth;
+    entry->has_meta = false;
+    entry->is_binary = false;
+    entry->size = -1;
+    entry->head = NULL;
 }
 
 /**
  * @brief Frees all memory associated with the FileList.
  *
- * Releases the memory for each file path and the entries array.
+ * Releases the memory for each file path, prefetched contents and the entries array.
  *
  * @param list Pointer to the FileList.
  */
 void free_file_list(FileList *list) {
     for (size_t i = 0; i < list->count; i++) {
         free(list->entries[i].path);
+        free(list->entries[i].head);
     }
     free(list->entries);
 }
@@ -120,10 +129,127 @@ int compare_entries(const void *a, const void *b) {
     return compare_paths(fa->path, fb->path);
 }
 
+/**
+ * @brief Determines whether a directory entry is a subdirectory.
+ *
+ * Trusts d_type when the filesystem reports it and only falls back to
+ * fstatat() relative to the open directory for DT_UNKNOWN entries and
+ * symlinks (which are followed, matching stat() semantics).
+ *
+ * @param dirfd File descriptor of the directory containing the entry.
+ * @param entry The directory entry.
+ * @param is_dir Output: true if the entry is (or points to) a directory.
+ * @return true if the type could be determined, false if the entry should be skipped.
+ */
+static bool resolve_entry_type(int dirfd, const struct dirent *entry, bool *is_dir) {
+#ifdef DT_UNKNOWN
+    if (entry->d_type != DT_UNKNOWN && entry->d_type != DT_LNK) {
+        *is_dir = (entry->d_type == DT_DIR);
+        return true;
+    }
+#endif
+    struct stat st;
+    if (fstatat(dirfd, entry->d_name, &st, 0) != 0) {
+        return false;
+    }
+    *is_dir = S_ISDIR(st.st_mode);
+    return true;
+}
+
+/**
+ * @brief Opens a directory relative to another directory descriptor.
+ *
+ * @param dirfd Parent directory descriptor (or AT_FDCWD).
+ * @param path Path relative to dirfd.
+ * @return DIR* Directory stream owning the new descriptor, or NULL on failure.
+ */
+static DIR *open_dir_at(int dirfd, const char *path) {
+    int fd = openat(dirfd, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    DIR *dir = fdopendir(fd);
+    if (!dir) {
+        close(fd);
+    }
+    return dir;
+}
+
+/**
+ * @brief Recursive worker for scan_directory() operating on an open directory.
+ *
+ * The relative path is built in place in a shared buffer, so no absolute
+ * paths are formatted while descending. A .gitignore found in a subdirectory
+ * is loaded on entry and pushed as a scope that only lives while the
+ * subtree is scanned.
+ *
+ * @param dir Open directory stream (closed by this function).
+ * @param rel_buf Buffer holding the relative path of this directory.
+ * @param rel_len Length of the relative path in rel_buf (0 for the root).
+ * @param list Pointer to the FileList to populate.
+ * @param depth Current depth level.
+ * @param scope Innermost gitignore scope for this directory.
+ * @param flags Flags controlling scanning behavior.
+ */
+static void scan_directory_stream(DIR *dir, char *rel_buf, size_t rel_len, FileList *list, int depth, const GitignoreScope *scope, int flags) {
+    int dirfd_ = dirfd(dir);
+    GitignoreScope *nested = NULL;
+    if (rel_len > 0 && !(flags & IGNORE_GITIGNORE)) {
+        nested = gitignore_scope_enter(scope, dirfd_, rel_buf);
+        if (nested) scope = nested;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        // By default, ignore .git folders unless INCLUDE_GIT flag is set.
+        if (!(flags & INCLUDE_GIT) && strcmp(entry->d_name, ".git") == 0) {
+            continue;
+        }
+
+        size_t name_len = strlen(entry->d_name);
+        size_t sep = rel_len ? 1 : 0;
+        if (rel_len + sep + name_len >= MAX_PATH_LEN) {
+            continue;
+        }
+        if (sep) rel_buf[rel_len] = '/';
+        memcpy(rel_buf + rel_len + sep, entry->d_name, name_len + 1);
+        size_t entry_len = rel_len + sep + name_len;
+
+        // Ignored directories are pruned here, so nothing below them is ever matched.
+        if (match_gitignore_scoped(rel_buf, scope)) {
+            rel_buf[rel_len] = '\0';
+            continue;
+        }
+
+        bool is_subdir;
+        if (resolve_entry_type(dirfd_, entry, &is_subdir)) {
+            add_file_entry(list, rel_buf, is_subdir, depth);
+            if (is_subdir) {
+                DIR *sub = open_dir_at(dirfd_, entry->d_name);
+                if (sub) {
+                    scan_directory_stream(sub, rel_buf, entry_len, list, depth + 1, scope, flags);
+                } else {
+                    fprintf(stderr, "Error: Directory '%s' does not exist or cannot be opened\n", rel_buf);
+                }
+            }
+        }
+        rel_buf[rel_len] = '\0';
+    }
+    closedir(dir);
+    gitignore_scope_free(nested);
+}
+
 /**
  * @brief Recursively scans a directory and populates the FileList with file and subdirectory entries.
  *
  * Optionally uses the provided GitignoreList to skip ignored files/directories and respects the flags.
+ * Unless IGNORE_GITIGNORE is set, .gitignore files in subdirectories are honored as well; their
+ * rules apply only beneath their own directory and take precedence over the outer lists.
+ * Subdirectories are opened with openat() relative to their parent and entry types come from
+ * d_type where available, so most entries cost no stat() call at all.
  *
  * @param dir_path The absolute path of the directory to scan.
  * @param rel_path The relative path from the root directory (can be NULL).
@@ -138,46 +264,384 @@ bool scan_directory(const char *dir_path, const char *rel_path, FileList *list,
         return false;
     }
 
-    DIR *dir = opendir(dir_path);
+    DIR *dir = open_dir_at(AT_FDCWD, dir_path);
     if (!dir) {
         fprintf(stderr, "Error: Directory '%s' does not exist or cannot be opened\n", dir_path);
         return false;
     }
 
-    bool has_entries = false;
+    char rel_buf[MAX_PATH_LEN];
+    size_t rel_len = 0;
+    if (rel_path) {
+        snprintf(rel_buf, sizeof(rel_buf), "%s", rel_path);
+        rel_len = strlen(rel_buf);
+    } else {
+        rel_buf[0] = '\0';
+    }
+    GitignoreScope root = {0};
+    root.rules = gitignore;
+    scan_directory_stream(dir, rel_buf, rel_len, list, depth, &root, flags);
+
+    return list->count > 0;
+}
+
+/*
+ * Parallel scanner.
+ *
+ * Every directory becomes a ScanNode task. Workers own a deque of pending
+ * nodes: they push and pop at the tail (depth-first, cache friendly) and
+ * steal from the head of other workers' deques when their own runs dry.
+ * Each node keeps its own sorted result vector plus a pointer to the child
+ * node for every subdirectory, so the final merge is a pre-order walk that
+ * yields exactly the order qsort(compare_entries) would produce.
+ */
+typedef struct ScanNode ScanNode;
+struct ScanNode {
+    char *rel_path;        // path relative to the scan root (NULL for the root)
+    int depth;             // depth assigned to entries of this directory
+    FileEntry *entries;    // entries found directly inside this directory
+    size_t count;
+    size_t capacity;
+    ScanNode **children;   // children[i] is the node for entries[i] if it is a directory
+    const GitignoreScope *scope;   // innermost gitignore scope for this directory
+    GitignoreScope *own_scope;     // scope loaded from this directory's .gitignore, if any
+};
+
+typedef struct {
+    pthread_mutex_t lock;
+    ScanNode **items;
+    size_t head;
+    size_t tail;
+    size_t capacity;
+} ScanDeque;
+
+typedef struct {
+    ScanDeque *deques;
+    int worker_count;
+    int root_fd;             // descriptor of the scan root; nodes are opened relative to it
+    GitignoreScope root_scope;
+    int flags;
+    atomic_size_t pending;   // nodes pushed but not yet fully processed
+    atomic_size_t queued;    // nodes currently sitting in a deque
+    pthread_mutex_t idle_lock;
+    pthread_cond_t idle_cond;
+} ScanPool;
+
+typedef struct {
+    ScanPool *pool;
+    int id;
+} ScanWorker;
+
+/**
+ * @brief Allocates a ScanNode for a directory.
+ *
+ * @param rel_path Relative path from the scan root, or NULL for the root.
+ * @param depth Depth assigned to the entries of this directory.
+ * @return ScanNode* Newly allocated node, or NULL on allocation failure.
+ */
+static ScanNode *scan_node_new(const char *rel_path, int depth) {
+    ScanNode *node = (ScanNode*)calloc(1, sizeof(ScanNode));
+    if (!node) return NULL;
+    node->rel_path = rel_path ? strdup(rel_path) : NULL;
+    node->depth = depth;
+    return node;
+}
+
+/**
+ * @brief Appends an entry to a ScanNode's result vector.
+ *
+ * @param node Node to update.
+ * @param path Relative path of the entry.
+ * @param is_dir Whether the entry is a directory.
+ */
+static void scan_node_add(ScanNode *node, const char *path, bool is_dir) {
+    if (node->count >= node->capacity) {
+        node->capacity = node->capacity ? node->capacity * 2 : 16;
+        node->entries = (FileEntry*)realloc(node->entries, node->capacity * sizeof(FileEntry));
+    }
+    FileEntry *entry = &node->entries[node->count++];
+    entry->path = strdup(path);
+    entry->is_dir = is_dir;
+    entry->depth = node->depth;
+    entry->has_meta = false;
+    entry->is_binary = false;
+    entry->size = -1;
+    entry->head = NULL;
+}
+
+/**
+ * @brief Pushes a node onto the tail of a deque.
+ *
+ * @param dq Deque owned by the pushing worker.
+ * @param node Node to push.
+ */
+static void scan_deque_push(ScanDeque *dq, ScanNode *node) {
+    pthread_mutex_lock(&dq->lock);
+    if (dq->tail >= dq->capacity) {
+        // Compact before growing so long-lived deques do not creep forward.
+        size_t live = dq->tail - dq->head;
+        if (dq->head > 0 && live < dq->capacity / 2) {
+            memmove(dq->items, dq->items + dq->head, live * sizeof(ScanNode*));
+        } else {
+            dq->capacity = dq->capacity ? dq->capacity * 2 : 64;
+            ScanNode **grown = (ScanNode**)malloc(dq->capacity * sizeof(ScanNode*));
+            memcpy(grown, dq->items + dq->head, live * sizeof(ScanNode*));
+            free(dq->items);
+            dq->items = grown;
+        }
+        dq->head = 0;
+        dq->tail = live;
+    }
+    dq->items[dq->tail++] = node;
+    pthread_mutex_unlock(&dq->lock);
+}
+
+/**
+ * @brief Pops a node from the tail (owner side) or head (thief side) of a deque.
+ *
+ * @param dq Deque to take from.
+ * @param steal true to take from the head as a thief, false to pop as the owner.
+ * @return ScanNode* The node taken, or NULL if the deque is empty.
+ */
+static ScanNode *scan_deque_take(ScanDeque *dq, bool steal) {
+    ScanNode *node = NULL;
+    pthread_mutex_lock(&dq->lock);
+    if (dq->head < dq->tail) {
+        node = steal ? dq->items[dq->head++] : dq->items[--dq->tail];
+        if (dq->head == dq->tail) {
+            dq->head = dq->tail = 0;
+        }
+    }
+    pthread_mutex_unlock(&dq->lock);
+    return node;
+}
+
+/**
+ * @brief Makes a node available to the pool from a given worker.
+ *
+ * @param pool Scan pool.
+ * @param worker_id Worker whose deque receives the node.
+ * @param node Node to schedule.
+ */
+static void scan_pool_submit(ScanPool *pool, int worker_id, ScanNode *node) {
+    atomic_fetch_add(&pool->pending, 1);
+    scan_deque_push(&pool->deques[worker_id], node);
+    atomic_fetch_add(&pool->queued, 1);
+    pthread_mutex_lock(&pool->idle_lock);
+    pthread_cond_signal(&pool->idle_cond);
+    pthread_mutex_unlock(&pool->idle_lock);
+}
+
+/**
+ * @brief Reads one directory into its node and schedules its subdirectories.
+ *
+ * Applies the same filtering rules as scan_directory().
+ *
+ * @param pool Scan pool.
+ * @param worker_id Id of the worker processing the node.
+ * @param node Node to fill.
+ */
+static void scan_node_process(ScanPool *pool, int worker_id, ScanNode *node) {
+    DIR *dir = open_dir_at(pool->root_fd, node->rel_path ? node->rel_path : ".");
+    if (!dir) {
+        fprintf(stderr, "Error: Directory '%s' does not exist or cannot be opened\n",
+                node->rel_path ? node->rel_path : ".");
+        return;
+    }
+
+    int dir_fd = dirfd(dir);
+    if (node->rel_path && !(pool->flags & IGNORE_GITIGNORE)) {
+        node->own_scope = gitignore_scope_enter(node->scope, dir_fd, node->rel_path);
+        if (node->own_scope) node->scope = node->own_scope;
+    }
+
     struct dirent *entry;
     while ((entry = readdir(dir)) != NULL) {
         if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
             continue;
         }
-
-        // By default, ignore .git folders unless INCLUDE_GIT flag is set.
-        if (!(flags & INCLUDE_GIT) && strcmp(entry->d_name, ".git") == 0) {
+        if (!(pool->flags & INCLUDE_GIT) && strcmp(entry->d_name, ".git") == 0) {
             continue;
         }
 
-        char full_path[MAX_PATH_LEN];
         char rel_entry_path[MAX_PATH_LEN];
-        snprintf(full_path, sizeof(full_path), "%s/%s", dir_path, entry->d_name);
         snprintf(rel_entry_path, sizeof(rel_entry_path), "%s%s%s",
-                 rel_path ? rel_path : "",
-                 rel_path ? "/" : "",
+                 node->rel_path ? node->rel_path : "",
+                 node->rel_path ? "/" : "",
                  entry->d_name);
 
-        if (gitignore && match_gitignore(rel_entry_path, gitignore)) {
+        if (match_gitignore_scoped(rel_entry_path, node->scope)) {
             continue;
         }
 
-        struct stat st;
-        if (stat(full_path, &st) == 0) {
-            bool is_subdir = S_ISDIR(st.st_mode);
-            add_file_entry(list, rel_entry_path, is_subdir, depth);
-            if (is_subdir) {
-                has_entries |= scan_directory(full_path, rel_entry_path, list, depth + 1, gitignore, flags);
-            }
+        bool is_subdir;
+        if (resolve_entry_type(dir_fd, entry, &is_subdir)) {
+            scan_node_add(node, rel_entry_path, is_subdir);
         }
     }
     closedir(dir);
 
-    return has_entries || (list->count > 0);
+    if (node->count == 0) {
+        return;
+    }
+    qsort(node->entries, node->count, sizeof(FileEntry), compare_entries);
+    node->children = (ScanNode**)calloc(node->count, sizeof(ScanNode*));
+    for (size_t i = 0; i < node->count; i++) {
+        if (!node->entries[i].is_dir) continue;
+        ScanNode *child = scan_node_new(node->entries[i].path, node->depth + 1);
+        if (!child) continue;
+        child->scope = node->scope;
+        node->children[i] = child;
+        scan_pool_submit(pool, worker_id, child);
+    }
+}
+
+/**
+ * @brief Finds the next node for a worker, stealing from other workers if needed.
+ *
+ * @param pool Scan pool.
+ * @param worker_id Id of the calling worker.
+ * @return ScanNode* A node to process, or NULL if none is currently available.
+ */
+static ScanNode *scan_pool_next(ScanPool *pool, int worker_id) {
+    ScanNode *node = scan_deque_take(&pool->deques[worker_id], false);
+    for (int i = 1; !node && i < pool->worker_count; i++) {
+        node = scan_deque_take(&pool->deques[(worker_id + i) % pool->worker_count], true);
+    }
+    if (node) {
+        atomic_fetch_sub(&pool->queued, 1);
+    }
+    return node;
+}
+
+/**
+ * @brief Worker thread body: process nodes until the whole tree has been scanned.
+ *
+ * @param arg Pointer to the worker's ScanWorker.
+ * @return void* Always NULL.
+ */
+static void *scan_worker_main(void *arg) {
+    ScanWorker *worker = (ScanWorker*)arg;
+    ScanPool *pool = worker->pool;
+    for (;;) {
+        ScanNode *node = scan_pool_next(pool, worker->id);
+        if (node) {
+            scan_node_process(pool, worker->id, node);
+            if (atomic_fetch_sub(&pool->pending, 1) == 1) {
+                pthread_mutex_lock(&pool->idle_lock);
+                pthread_cond_broadcast(&pool->idle_cond);
+                pthread_mutex_unlock(&pool->idle_lock);
+            }
+            continue;
+        }
+        pthread_mutex_lock(&pool->idle_lock);
+        while (atomic_load(&pool->queued) == 0 && atomic_load(&pool->pending) > 0) {
+            pthread_cond_wait(&pool->idle_cond, &pool->idle_lock);
+        }
+        bool done = atomic_load(&pool->pending) == 0;
+        pthread_mutex_unlock(&pool->idle_lock);
+        if (done) break;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Moves a node's entries into a FileList in pre-order and frees the node.
+ *
+ * @param node Node to flatten.
+ * @param list Destination list.
+ */
+static void scan_node_flatten(ScanNode *node, FileList *list) {
+    for (size_t i = 0; i < node->count; i++) {
+        if (list->count >= list->capacity) {
+            list->capacity *= 2;
+            list->entries = (FileEntry*)realloc(list->entries, list->capacity * sizeof(FileEntry));
+        }
+        list->entries[list->count++] = node->entries[i];
+        if (node->children && node->children[i]) {
+            scan_node_flatten(node->children[i], list);
+        }
+    }
+    free(node->children);
+    free(node->entries);
+    free(node->rel_path);
+    gitignore_scope_free(node->own_scope);
+    free(node);
+}
+
+/**
+ * @brief Scans a directory tree using a pool of work-stealing threads.
+ *
+ * Produces the same entries as scan_directory(), already in the order that
+ * qsort(compare_entries) yields.
+ *
+ * @param dir_path Path of the directory to scan.
+ * @param list Pointer to the FileList to populate.
+ * @param gitignore Pointer to a GitignoreList (can be NULL).
+ * @param flags Flags controlling scanning behavior (e.g., INCLUDE_GIT).
+ * @param threads Number of worker threads (values below 1 are treated as 1).
+ * @return true if entries were found, false otherwise.
+ */
+bool scan_directory_parallel(const char *dir_path, FileList *list, const GitignoreList *gitignore, int flags, int threads) {
+    if (threads < 1) threads = 1;
+
+    int root_fd = open(dir_path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (root_fd < 0) {
+        fprintf(stderr, "Error: Directory '%s' does not exist or cannot be opened\n", dir_path);
+        return false;
+    }
+
+    ScanPool pool;
+    pool.worker_count = threads;
+    pool.root_fd = root_fd;
+    memset(&pool.root_scope, 0, sizeof(pool.root_scope));
+    pool.root_scope.rules = gitignore;
+    pool.flags = flags;
+    atomic_init(&pool.pending, 0);
+    atomic_init(&pool.queued, 0);
+    pthread_mutex_init(&pool.idle_lock, NULL);
+    pthread_cond_init(&pool.idle_cond, NULL);
+    pool.deques = (ScanDeque*)calloc(threads, sizeof(ScanDeque));
+    for (int i = 0; i < threads; i++) {
+        pthread_mutex_init(&pool.deques[i].lock, NULL);
+    }
+
+    ScanNode *root = scan_node_new(NULL, 0);
+    root->scope = &pool.root_scope;
+    scan_pool_submit(&pool, 0, root);
+
+    pthread_t *tids = (pthread_t*)malloc(threads * sizeof(pthread_t));
+    ScanWorker *workers = (ScanWorker*)malloc(threads * sizeof(ScanWorker));
+    int started = 0;
+    for (int i = 1; i < threads; i++) {
+        workers[i].pool = &pool;
+        workers[i].id = i;
+        if (pthread_create(&tids[i], NULL, scan_worker_main, &workers[i]) == 0) {
+            started++;
+        } else {
+            break;
+        }
+    }
+    // The calling thread acts as worker 0.
+    workers[0].pool = &pool;
+    workers[0].id = 0;
+    scan_worker_main(&workers[0]);
+    for (int i = 1; i <= started; i++) {
+        pthread_join(tids[i], NULL);
+    }
+
+    scan_node_flatten(root, list);
+
+    for (int i = 0; i < threads; i++) {
+        pthread_mutex_destroy(&pool.deques[i].lock);
+        free(pool.deques[i].items);
+    }
+    free(pool.deques);
+    free(tids);
+    free(workers);
+    pthread_mutex_destroy(&pool.idle_lock);
+    pthread_cond_destroy(&pool.idle_cond);
+    close(root_fd);
+
+    return list->count > 0;
 }
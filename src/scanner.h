@@ -44,6 +44,21 @@ void free_file_list(FileList *list);
  */
 bool scan_directory(const char *dir_path, const char *rel_path, FileList *list, int depth, const GitignoreList *gitignore, int flags);
 
+/**
+ * @brief Scan a directory tree in parallel using work-stealing threads.
+ *
+ * Produces the same entries as scan_directory(), already ordered as
+ * qsort(compare_entries) would order them.
+ *
+ * @param dir_path Path of the directory to scan.
+ * @param list Output FileList.
+ * @param gitignore Optional gitignore rule list.
+ * @param flags Flags controlling scanning behavior.
+ * @param threads Number of worker threads.
+ * @return true if entries were found, otherwise false.
+ */
+bool scan_directory_parallel(const char *dir_path, FileList *list, const GitignoreList *gitignore, int flags, int threads);
+
 /**
  * @brief Comparison function for ordering FileEntry items.
  *
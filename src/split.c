@@ -0,0 +1,421 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "split.h"
+
+/**
+ * @brief Open the next part, with a "Continued from" notice after the first.
+ *
+ * @param sink Sink whose current part has already been closed.
+ * @return true on success, false if the file cannot be created.
+ */
+static bool open_next_part(SplitSink *sink) {
+    sink->part_number++;
+    sink->part_bytes = 0;
+    sink->part_tokens = 0;
+    sink->part_token_offset = -1;
+    char *part_path = get_split_filename(sink->out_path, sink->part_number);
+    sink->part = part_path ? fopen(part_path, "w") : NULL;
+    if (!sink->part) {
+        fprintf(stderr, "Error: Cannot create split file '%s'\n", part_path ? part_path : sink->out_path);
+        free(part_path);
+        sink->failed = true;
+        return false;
+    }
+    free(part_path);
+    if (sink->part_number > 1) {
+        fprintf(sink->part, "---\n**Continued from part %zu**\n\n", sink->part_number - 1);
+        if (sink->token_limit > 0) {
+            sink->part_token_offset = ftell(sink->part) + (long)strlen(SPLIT_PART_TOKEN_LABEL);
+            fprintf(sink->part, "%s%*s\n\n", SPLIT_PART_TOKEN_LABEL, SPLIT_PART_TOKEN_WIDTH, "");
+        }
+    } else if (sink->token_limit > 0) {
+        sink->part_token_offset = sink->first_token_offset;
+    }
+    return true;
+}
+
+/**
+ * @brief Fill in the current part's token count and close it.
+ *
+ * @param sink Sink with an open part.
+ * @return true on success, false on a write error.
+ */
+static bool close_part(SplitSink *sink) {
+    bool ok = true;
+    if (sink->part_token_offset >= 0) {
+        ok = fseek(sink->part, sink->part_token_offset, SEEK_SET) == 0 &&
+             fprintf(sink->part, "%-*zu", SPLIT_PART_TOKEN_WIDTH, sink->part_tokens) == SPLIT_PART_TOKEN_WIDTH;
+    }
+    if (fclose(sink->part) != 0) {
+        ok = false;
+    }
+    sink->part = NULL;
+    if (!ok) {
+        sink->failed = true;
+    }
+    return ok;
+}
+
+/**
+ * @brief Close the current part with a "Continued in" notice and open the next.
+ *
+ * @param sink Sink with an open part.
+ * @return true on success, false on a write error.
+ */
+static bool roll_over(SplitSink *sink) {
+    fprintf(sink->part, "\n\n---\n**Continued in part %zu**\n", sink->part_number + 1);
+    return close_part(sink) && open_next_part(sink);
+}
+
+/**
+ * @brief Whether adding a section of the given size overflows the current part.
+ *
+ * @param sink Sink with an open part.
+ * @param len Section length in bytes.
+ * @param tokens Section token count.
+ * @return true if the section does not fit.
+ */
+static bool overflows(const SplitSink *sink, size_t len, size_t tokens) {
+    return sink->part_bytes + len > sink->limit ||
+           (sink->token_limit > 0 && sink->part_tokens + tokens > sink->token_limit);
+}
+
+/**
+ * @brief Place one section into the parts.
+ *
+ * @param sink Destination sink.
+ * @param data Section text.
+ * @param len Section length in bytes.
+ * @param tokens Section token count.
+ * @return true on success, false on a write error.
+ */
+static bool commit_section(SplitSink *sink, const char *data, size_t len, size_t tokens) {
+    if (sink->part && (sink->part_bytes > 0 || sink->part_tokens > 0) && overflows(sink, len, tokens)) {
+        if (!roll_over(sink)) return false;
+    }
+    if (!sink->part && !open_next_part(sink)) return false;
+
+    // Only a section larger than a whole part gets cut.
+    while (len > 0 && overflows(sink, len, tokens)) {
+        size_t room = sink->limit - sink->part_bytes;
+        if (sink->token_limit > 0 && tokens > 0) {
+            // Assume the tokens are spread evenly over the section's bytes.
+            size_t token_room = sink->token_limit - sink->part_tokens;
+            size_t byte_room = (size_t)((double)len * token_room / tokens);
+            if (byte_room < room) {
+                room = byte_room > 0 ? byte_room : 1;
+            }
+        }
+        size_t cut = room;
+        while (cut > 0 && data[cut - 1] != '\n') {
+            cut--;
+        }
+        if (cut == 0) {
+            cut = room;  // no line break that fits: hard cut at the limit
+        }
+        size_t share = (size_t)(((double)tokens * cut + len - 1) / len);
+        if (share > tokens) {
+            share = tokens;
+        }
+        if (fwrite(data, 1, cut, sink->part) != cut) {
+            sink->failed = true;
+            return false;
+        }
+        sink->part_bytes += cut;
+        sink->part_tokens += share;
+        data += cut;
+        len -= cut;
+        tokens -= share;
+        if (!roll_over(sink)) return false;
+    }
+    if (len > 0 && fwrite(data, 1, len, sink->part) != len) {
+        sink->failed = true;
+        return false;
+    }
+    sink->part_bytes += len;
+    sink->part_tokens += tokens;
+    return true;
+}
+
+/**
+ * @brief Prepare a sink that writes parts of out_path.
+ *
+ * @param sink Sink to initialize.
+ * @param out_path Unsplit output path; parts are named by get_split_filename().
+ * @param limit Maximum number of content bytes per part.
+ * @param token_limit Maximum number of tokens per part, or 0 for no budget.
+ * @return true on success, false if the section buffer cannot be created.
+ */
+bool split_sink_open(SplitSink *sink, const char *out_path, size_t limit, size_t token_limit) {
+    memset(sink, 0, sizeof(*sink));
+    sink->out_path = out_path;
+    sink->limit = limit > 0 ? limit : 1;
+    sink->token_limit = token_limit;
+    sink->part_token_offset = -1;
+    sink->first_token_offset = -1;
+    sink->stream = open_memstream(&sink->section, &sink->section_size);
+    if (!sink->stream) {
+        fprintf(stderr, "Error: Cannot allocate the split output buffer\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Hand everything written since the previous boundary to the parts.
+ *
+ * @param sink Sink to flush.
+ * @param tokens Number of tokens in the text written since the last boundary.
+ * @return true on success, false if a part could not be written.
+ */
+bool split_sink_boundary(SplitSink *sink, size_t tokens) {
+    if (sink->failed || fflush(sink->stream) != 0) {
+        sink->failed = true;
+        return false;
+    }
+    if (sink->section_size == 0) {
+        return true;
+    }
+    bool ok = commit_section(sink, sink->section, sink->section_size, tokens);
+    // The memstream size follows the write position, so rewinding empties it.
+    fseek(sink->stream, 0, SEEK_SET);
+    return ok;
+}
+
+/**
+ * @brief Copy a finished document into the sink, section by section.
+ *
+ * @param sink Destination sink.
+ * @param in Document stream, positioned where copying should start.
+ * @return true on success, false on a read or write error.
+ */
+bool split_sink_copy_sections(SplitSink *sink, FILE *in) {
+    size_t marker_len = strlen(SPLIT_SECTION_MARKER);
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t n;
+    bool ok = true;
+    while (ok && (n = getline(&line, &cap, in)) > 0) {
+        if ((size_t)n >= marker_len && memcmp(line, SPLIT_SECTION_MARKER, marker_len) == 0) {
+            ok = split_sink_boundary(sink, 0);
+        }
+        if (ok && fwrite(line, 1, (size_t)n, sink->stream) != (size_t)n) {
+            ok = false;
+        }
+    }
+    free(line);
+    return ok && !ferror(in);
+}
+
+/**
+ * @brief Flush the last section and close the sink.
+ *
+ * @param sink Sink to close.
+ * @param tokens Number of tokens in the text written since the last boundary.
+ * @return size_t Number of parts written, or 0 on failure.
+ */
+size_t split_sink_close(SplitSink *sink, size_t tokens) {
+    bool ok = split_sink_boundary(sink, tokens);
+    fclose(sink->stream);
+    free(sink->section);
+    sink->stream = NULL;
+    sink->section = NULL;
+    if (sink->part && !close_part(sink)) {
+        ok = false;
+    }
+    return ok && !sink->failed ? sink->part_number : 0;
+}
+
+/**
+ * @brief Assign sections to consecutive parts so no part exceeds max_load.
+ *
+ * A new part is also started early when the remaining sections are just
+ * enough to give every remaining part one, so no part stays empty.
+ *
+ * @param tokens Section token counts.
+ * @param count Number of sections.
+ * @param parts Number of parts available (at most count).
+ * @param max_load Largest allowed part total.
+ * @param part_of Output: part index per section (may be NULL).
+ * @return size_t Number of parts needed; more than parts if max_load is too small.
+ */
+static size_t fill_contiguous(const size_t *tokens, size_t count, size_t parts, size_t max_load, size_t *part_of) {
+    size_t part = 0;
+    size_t load = 0;
+    for (size_t i = 0; i < count; i++) {
+        bool must_advance = part + 1 < parts && count - i == parts - part - 1;
+        if (i > 0 && (load + tokens[i] > max_load || must_advance)) {
+            part++;
+            load = 0;
+        }
+        load += tokens[i];
+        if (part_of) part_of[i] = part;
+    }
+    return part + 1;
+}
+
+/**
+ * @brief Restore the heap property downwards from slot i of a part min-heap.
+ *
+ * Parts are ordered by load, then by number of sections.
+ *
+ * @param heap Part indices.
+ * @param n Heap size.
+ * @param i Slot to sift.
+ * @param load Part loads.
+ * @param items Section count per part.
+ */
+static void sift_down(size_t *heap, size_t n, size_t i, const size_t *load, const size_t *items) {
+    for (;;) {
+        size_t smallest = i;
+        for (size_t c = 2 * i + 1; c <= 2 * i + 2 && c < n; c++) {
+            size_t a = heap[c], b = heap[smallest];
+            if (load[a] < load[b] || (load[a] == load[b] && items[a] < items[b])) {
+                smallest = c;
+            }
+        }
+        if (smallest == i) return;
+        size_t tmp = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = tmp;
+        i = smallest;
+    }
+}
+
+// Section token counts for the qsort comparator below.
+static const size_t *g_sort_tokens;
+
+/**
+ * @brief qsort comparator: larger sections first, document order on ties.
+ *
+ * @param a Pointer to a section index.
+ * @param b Pointer to a section index.
+ * @return int Comparison result.
+ */
+static int compare_by_tokens_desc(const void *a, const void *b) {
+    size_t x = *(const size_t *)a, y = *(const size_t *)b;
+    if (g_sort_tokens[x] != g_sort_tokens[y]) {
+        return g_sort_tokens[x] > g_sort_tokens[y] ? -1 : 1;
+    }
+    return x < y ? -1 : (x > y);
+}
+
+/**
+ * @brief Longest-processing-time packing with section 0 pinned to part 0.
+ *
+ * @param tokens Section token counts.
+ * @param count Number of sections.
+ * @param parts Number of parts (at most count).
+ * @param part_of Output: part index per section.
+ * @return size_t Largest part total, or SIZE_MAX if out of memory.
+ */
+static size_t pack_lpt(const size_t *tokens, size_t count, size_t parts, size_t *part_of) {
+    size_t *order = malloc(count * sizeof(size_t));
+    size_t *heap = malloc(parts * sizeof(size_t));
+    size_t *load = calloc(parts, sizeof(size_t));
+    size_t *items = calloc(parts, sizeof(size_t));
+    if (!order || !heap || !load || !items) {
+        free(order); free(heap); free(load); free(items);
+        return SIZE_MAX;
+    }
+    for (size_t i = 1; i < count; i++) {
+        order[i - 1] = i;
+    }
+    g_sort_tokens = tokens;
+    qsort(order, count - 1, sizeof(size_t), compare_by_tokens_desc);
+
+    part_of[0] = 0;
+    load[0] = tokens[0];
+    items[0] = 1;
+    for (size_t p = 0; p < parts; p++) {
+        heap[p] = p;
+    }
+    for (size_t i = parts / 2; i-- > 0; ) {
+        sift_down(heap, parts, i, load, items);
+    }
+    for (size_t k = 0; k < count - 1; k++) {
+        size_t p = heap[0];
+        part_of[order[k]] = p;
+        load[p] += tokens[order[k]];
+        items[p]++;
+        sift_down(heap, parts, 0, load, items);
+    }
+
+    size_t max_load = 0;
+    for (size_t p = 0; p < parts; p++) {
+        if (load[p] > max_load) max_load = load[p];
+    }
+    free(order); free(heap); free(load); free(items);
+    return max_load;
+}
+
+/**
+ * @brief Distribute document sections over a fixed number of parts.
+ *
+ * @param tokens Token count of every section, in document order.
+ * @param count Number of sections (at least 1).
+ * @param parts Requested number of parts.
+ * @param part_of Output: part index of every section.
+ * @return size_t Number of parts used, min(parts, count); each is non-empty.
+ */
+size_t split_pack_sections(const size_t *tokens, size_t count, size_t parts, size_t *part_of) {
+    if (parts > count) parts = count;
+    if (parts <= 1) {
+        for (size_t i = 0; i < count; i++) part_of[i] = 0;
+        return count > 0 ? 1 : 0;
+    }
+
+    // Smallest feasible largest-part total for a contiguous partition.
+    size_t lo = 0, hi = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (tokens[i] > lo) lo = tokens[i];
+        hi += tokens[i];
+    }
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (fill_contiguous(tokens, count, parts, mid, NULL) <= parts) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    size_t contiguous_max = lo;
+
+    size_t lpt_max = pack_lpt(tokens, count, parts, part_of);
+    if (lpt_max == SIZE_MAX || (double)contiguous_max <= lpt_max * SPLIT_LOCALITY_SLACK) {
+        fill_contiguous(tokens, count, parts, contiguous_max, part_of);
+    }
+    return parts;
+}
+
+/**
+ * @brief Generates a split filename based on the original output path and part number.
+ *
+ * @param original_path The original output file path.
+ * @param part_number The part number for the split file.
+ * @return char* The generated split filename. The caller is responsible for freeing the memory.
+ */
+char *get_split_filename(const char *original_path, size_t part_number) {
+    char *dot = strrchr(original_path, '.');
+    size_t basename_length = dot ? (size_t)(dot - original_path) : strlen(original_path);
+    size_t ext_length = dot ? strlen(dot) : 0;
+
+    char part_suffix[32];
+    snprintf(part_suffix, sizeof(part_suffix), "_part%zu", part_number);
+
+    size_t new_length = basename_length + strlen(part_suffix) + ext_length + 1;
+    char *new_filename = malloc(new_length);
+    if (!new_filename) return NULL;
+
+    if (dot) {
+        snprintf(new_filename, new_length, "%.*s%s%s", (int)basename_length, original_path, part_suffix, dot);
+    } else {
+        snprintf(new_filename, new_length, "%s%s", original_path, part_suffix);
+    }
+
+    return new_filename;
+}
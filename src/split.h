@@ -0,0 +1,121 @@
+#ifndef SPLIT_H
+#define SPLIT_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Marker that starts the section of every documented file.
+#define SPLIT_SECTION_MARKER "### 📄"
+
+// Per-part token count written at the top of every part when splitting by
+// tokens; the count is filled in when the part is closed.
+#define SPLIT_PART_TOKEN_LABEL "Part Token Size: "
+#define SPLIT_PART_TOKEN_WIDTH 20
+
+// split_pack_sections() keeps sections in document order as long as that
+// costs at most this factor on the largest part.
+#define SPLIT_LOCALITY_SLACK 1.05
+
+/*
+ * Output sink that cuts a document into _partN files while it is written.
+ * Text goes to `stream`; split_sink_boundary() marks the points where a new
+ * part may begin. Whole sections are packed into the current part until the
+ * next one would push it over the byte or token limit.
+ */
+typedef struct {
+    FILE *stream;         // where the document text is written
+    char *section;        // buffer behind stream: text since the last boundary
+    size_t section_size;
+    const char *out_path; // unsplit output path the part names derive from
+    size_t limit;         // maximum number of content bytes per part
+    size_t token_limit;   // maximum number of tokens per part, 0 = no budget
+    FILE *part;           // part being filled, NULL before the first boundary
+    size_t part_number;
+    size_t part_bytes;
+    size_t part_tokens;
+    long part_token_offset; // offset of the part's token field, -1 if none
+    long first_token_offset; // token field offset inside the first section
+    bool failed;
+} SplitSink;
+
+/**
+ * @brief Prepare a sink that writes parts of out_path.
+ *
+ * With a token budget every part after the first starts with a
+ * SPLIT_PART_TOKEN_LABEL line. The first part shows the count only if the
+ * caller writes that line into its header and stores the offset of the
+ * blank field in first_token_offset.
+ *
+ * @param sink Sink to initialize.
+ * @param out_path Unsplit output path; parts are named by get_split_filename().
+ * @param limit Maximum number of content bytes per part.
+ * @param token_limit Maximum number of tokens per part, or 0 for no budget.
+ * @return true on success, false if the section buffer cannot be created.
+ */
+bool split_sink_open(SplitSink *sink, const char *out_path, size_t limit, size_t token_limit);
+
+/**
+ * @brief Hand everything written since the previous boundary to the parts.
+ *
+ * The section is appended to the current part if it fits, otherwise the part
+ * is closed with a "Continued in part" notice and a new one started. Only a
+ * section that is larger than a whole part is cut, at the last newline that
+ * fits; its tokens are then shared out in proportion to the bytes, since the
+ * text is not tokenized again.
+ *
+ * @param sink Sink to flush.
+ * @param tokens Number of tokens in the text written since the last boundary.
+ * @return true on success, false if a part could not be written.
+ */
+bool split_sink_boundary(SplitSink *sink, size_t tokens);
+
+/**
+ * @brief Copy a finished document into the sink, section by section.
+ *
+ * A boundary is placed before every line that starts with
+ * SPLIT_SECTION_MARKER. Token counts are not known here, so only the byte
+ * limit applies.
+ *
+ * @param sink Destination sink.
+ * @param in Document stream, positioned where copying should start.
+ * @return true on success, false on a read or write error.
+ */
+bool split_sink_copy_sections(SplitSink *sink, FILE *in);
+
+/**
+ * @brief Flush the last section and close the sink.
+ *
+ * @param sink Sink to close.
+ * @param tokens Number of tokens in the text written since the last boundary.
+ * @return size_t Number of parts written, or 0 on failure.
+ */
+size_t split_sink_close(SplitSink *sink, size_t tokens);
+
+/**
+ * @brief Distribute document sections over a fixed number of parts.
+ *
+ * Section 0 (the summary and structure) always goes to part 0. The rest are
+ * balanced by token count: the best contiguous partition is used when its
+ * largest part is within SPLIT_LOCALITY_SLACK of the longest-processing-time
+ * packing, so files of one directory stay together; otherwise the sections
+ * are packed largest first into the lightest part.
+ *
+ * @param tokens Token count of every section, in document order.
+ * @param count Number of sections (at least 1).
+ * @param parts Requested number of parts.
+ * @param part_of Output: part index of every section.
+ * @return size_t Number of parts used, min(parts, count); each is non-empty.
+ */
+size_t split_pack_sections(const size_t *tokens, size_t count, size_t parts, size_t *part_of);
+
+/**
+ * @brief Generates a split filename based on the original output path and part number.
+ *
+ * @param original_path The original output file path.
+ * @param part_number The part number for the split file.
+ * @return char* The generated split filename. The caller is responsible for freeing the memory.
+ */
+char *get_split_filename(const char *original_path, size_t part_number);
+
+#endif // SPLIT_H
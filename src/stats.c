@@ -6,8 +6,31 @@
 #include "stats.h"
 #include "tiktoken.h"
 
-// Global tiktoken encoder instance
-static tiktoken_t encoder = NULL;
+// Threads that count a single large text (1 = count on the calling thread).
+static int token_threads = 1;
+
+/**
+ * @brief Sets how many threads may count the tokens of one large text.
+ *
+ * @param threads Number of threads; values below 1 mean 1.
+ */
+void set_token_threads(int threads) {
+    token_threads = threads < 1 ? 1 : threads;
+}
+
+/**
+ * @brief Returns the shared tiktoken encoder, creating it on first use.
+ *
+ * The encoder is immutable and tiktoken creates it only once, so any thread
+ * may call this and count with the result concurrently.
+ *
+ * @return tiktoken_t The encoder, or NULL if tiktoken is unavailable.
+ */
+static tiktoken_t shared_encoder(void) {
+    // The name is only a label: the vocabulary is always the one the build
+    // generated tiktoken_data.h from (TIKTOKEN_ENCODER_NAME, o200k_base by default)
+    return tiktoken_get_encoding("cl100k_base");
+}
 
 /**
  * @brief Initializes the tiktoken encoder
@@ -16,26 +39,61 @@ static tiktoken_t encoder = NULL;
  * @return false if initialization failed
  */
 bool init_tiktoken() {
-    if (encoder == NULL) {
-        // Initialize the tiktoken library first
-        if (!tiktoken_init()) {
-            return false;
-        }
-        // Initialize with cl100k_base encoding (GPT-4/3.5-turbo encoding)
-        encoder = tiktoken_get_encoding("cl100k_base");
-        return (encoder != NULL);
-    }
-    return true;
+    return shared_encoder() != NULL;
 }
 
 /**
- * @brief Frees the tiktoken encoder resources
+ * @brief Releases the tiktoken encoder.
+ *
+ * The shared encoder is static data that lives until exit, where tiktoken
+ * frees its own bookkeeping, so there is nothing to release here.
  */
 void cleanup_tiktoken() {
-    if (encoder != NULL) {
-        tiktoken_free(encoder);
-        encoder = NULL;
+}
+
+/**
+ * @brief Counts words and punctuation for the approximate token count.
+ *
+ * Used when tiktoken is unavailable. Every run of letters, digits and
+ * underscores is one word and every other non-space character is one more.
+ *
+ * @param str The text.
+ * @param len Length of the text.
+ * @param in_word Whether the text continues a word; updated for the next call.
+ * @return size_t Number of words that start in the text.
+ */
+static size_t count_words(const char *str, size_t len, bool *in_word) {
+    size_t word_count = 0;
+    bool word = *in_word;
+    
+    for (size_t i = 0; i < len; i++) {
+        unsigned char c = (unsigned char)str[i];
+        if (isalnum(c) || c == '_') {
+            if (!word) {
+                word_count++;
+                word = true;
+            }
+            continue;
+        }
+        word = false;
+        if (!isspace(c)) {
+            word_count++;  // Count punctuation as separate tokens
+        }
     }
+    *in_word = word;
+    return word_count;
+}
+
+/**
+ * @brief Converts a word count into an approximate token count.
+ *
+ * @param word_count Words counted by count_words().
+ * @return size_t Approximate number of tokens.
+ */
+static size_t approximate_tokens(size_t word_count) {
+    // GPT tokenizers typically produce more tokens than words
+    // This is a conservative approximation that should match real tokenizers
+    return (size_t)(word_count * 1.3);
 }
 
 /**
@@ -51,72 +109,81 @@ void calculate_token_stats(const char *str, DocumentInfo *info) {
     size_t len = strlen(str);
     info->total_size += len;
     
-    // Ensure the encoder is initialized
-    if (!init_tiktoken()) {
-        // Fallback to approximate calculation if tiktoken fails
-        size_t i = 0;
-        size_t word_count = 0;
-        
-        // Count words and punctuation separately
-        while (i < len) {
-            if (isspace((unsigned char)str[i])) {
-                i++;
-                continue;
-            }
-            if (isalnum((unsigned char)str[i]) || str[i] == '_') {
-                word_count++;
-                while (i < len && (isalnum((unsigned char)str[i]) || str[i] == '_')) {
-                    i++;
-                }
-            } else {
-                word_count++;  // Count punctuation as separate tokens
-                i++;
-            }
-        }
-        
-        // GPT tokenizers typically produce more tokens than words
-        // This is a conservative approximation that should match real tokenizers
-        info->total_tokens += (size_t)(word_count * 1.3);
-        return;
-    }
-    
-    // Tokenize the string using tiktoken
-    tiktoken_token_t* tokens = NULL;
-    int count = tiktoken_encode(encoder, str, len, &tokens);
+    // Count tokens with tiktoken; the token IDs themselves are not needed
+    tiktoken_t encoder = shared_encoder();
+    int count = encoder ? tiktoken_count_parallel(encoder, str, len, token_threads) : -1;
     
     // Update token count
     if (count >= 0) {
         info->total_tokens += (size_t)count;
     } else {
-        // Fallback if encoding failed - use same approximation as above
-        size_t i = 0;
-        size_t word_count = 0;
-        
-        while (i < len) {
-            if (isspace((unsigned char)str[i])) {
-                i++;
-                continue;
-            }
-            if (isalnum((unsigned char)str[i]) || str[i] == '_') {
-                word_count++;
-                while (i < len && (isalnum((unsigned char)str[i]) || str[i] == '_')) {
-                    i++;
-                }
-            } else {
-                word_count++;
-                i++;
-            }
-        }
-        
-        info->total_tokens += (size_t)(word_count * 1.3);
+        // Fallback to approximate calculation if tiktoken fails
+        bool in_word = false;
+        info->total_tokens += approximate_tokens(count_words(str, len, &in_word));
     }
-    
-    // Free memory
-    if (tokens != NULL) {
-        free(tokens);
+}
+
+/**
+ * @brief Starts token statistics for text that arrives in chunks.
+ *
+ * @param ts The stream to initialize.
+ */
+void token_stream_begin(TokenStream *ts) {
+    memset(ts, 0, sizeof(*ts));
+    tiktoken_t encoder = shared_encoder();
+    if (encoder) {
+        ts->stream = tiktoken_stream_begin(encoder);
+        tiktoken_stream_set_threads(ts->stream, token_threads);
+    }
+}
+
+/**
+ * @brief Adds the next chunk of text to a token stream.
+ *
+ * If tiktoken fails partway, the tokens counted so far are kept and the rest
+ * of the text is approximated.
+ *
+ * @param ts The stream.
+ * @param text The next chunk; it may cut the text anywhere.
+ * @param len Length of the chunk.
+ */
+void token_stream_feed(TokenStream *ts, const char *text, size_t len) {
+    ts->size += len;
+    if (ts->stream != NULL && tiktoken_stream_feed(ts->stream, text, len) < 0) {
+        int count = tiktoken_stream_finish(ts->stream);
+        ts->stream = NULL;
+        ts->tokens = count > 0 ? (size_t)count : 0;
+    }
+    if (ts->stream == NULL) {
+        ts->words += count_words(text, len, &ts->in_word);
     }
 }
 
+/**
+ * @brief Finishes a token stream and adds its statistics to info.
+ *
+ * The result is the same as calculate_token_stats() on the whole text.
+ *
+ * @param ts The stream.
+ * @param info Pointer to the DocumentInfo structure to update.
+ * @return bool true if tiktoken counted all of the text.
+ */
+bool token_stream_finish(TokenStream *ts, DocumentInfo *info) {
+    bool exact = ts->stream != NULL;
+    if (ts->stream != NULL) {
+        int count = tiktoken_stream_finish(ts->stream);
+        ts->stream = NULL;
+        if (count >= 0) {
+            ts->tokens += (size_t)count;
+        } else {
+            exact = false;
+        }
+    }
+    info->total_size += ts->size;
+    info->total_tokens += ts->tokens + approximate_tokens(ts->words);
+    return exact;
+}
+
 /**
  * @brief Counts the maximum number of consecutive backticks in the given content.
  *
@@ -189,20 +256,21 @@ const char *get_language_from_extension(const char *filename) {
 }
 
 /**
- * @brief Returns a human-readable file size for the given file path.
+ * @brief Formats a byte count as a human-readable size.
  *
- * Converts the file size into a more understandable unit (B, KB, MB, etc.).
+ * Converts the size into a more understandable unit (B, KB, MB, etc.).
  *
- * @param path The file path.
- * @return const char* A string representing the file size, or "unknown" if the file cannot be accessed.
+ * @param bytes The size in bytes, or a negative value if unknown.
+ * @param buf Destination buffer.
+ * @param buf_size Size of the destination buffer.
+ * @return const char* buf, containing the formatted size or "unknown".
  */
-const char *get_file_size(const char *path) {
-    static char size[32]; // Note: Using static buffer is not thread-safe
-    struct stat st;
-    if (stat(path, &st) != 0) {
-        return "unknown"; // Returning const char* is fine
+const char *format_file_size(long long bytes, char *buf, size_t buf_size) {
+    if (bytes < 0) {
+        snprintf(buf, buf_size, "unknown");
+        return buf;
     }
-    double size_bytes = st.st_size;
+    double size_bytes = (double)bytes;
     const char *units[] = {"B", "KB", "MB", "GB", "TB"};
     int unit = 0;
     
@@ -211,30 +279,36 @@ const char *get_file_size(const char *path) {
         unit++;
     }
     
-    snprintf(size, sizeof(size), "%.2f %s", size_bytes, units[unit]);
-    return size;
+    snprintf(buf, buf_size, "%.2f %s", size_bytes, units[unit]);
+    return buf;
 }
 
 /**
- * @brief Determines if a file is binary by checking its printable character ratio.
- *
- * Reads up to 1024 bytes and calculates the ratio of printable characters.
- * If the ratio is below 85%, the file is considered binary.
+ * @brief Returns a human-readable file size for the given file path.
  *
  * @param path The file path.
- * @return true If the file is binary.
+ * @return const char* A string representing the file size, or "unknown" if the file cannot be accessed.
+ */
+const char *get_file_size(const char *path) {
+    static char size[32]; // Note: Using static buffer is not thread-safe
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        return "unknown"; // Returning const char* is fine
+    }
+    return format_file_size((long long)st.st_size, size, sizeof(size));
+}
+
+/**
+ * @brief Determines if a block of data is binary by checking its printable character ratio.
+ *
+ * If fewer than 85% of the bytes are printable, the data is considered binary.
+ *
+ * @param buf The data to inspect.
+ * @param len Number of bytes in buf.
+ * @return true If the data is binary.
  * @return false Otherwise.
  */
-bool is_binary_file(const char *path) {
-    FILE *f = fopen(path, "rb");
-    if (!f) return true;
-    
-    unsigned char buf[1024];
-    size_t len = fread(buf, 1, sizeof(buf), f);
-    fclose(f);
-    
-    if (len == 0) return false; // Empty file considered text
-    
+bool is_binary_buffer(const unsigned char *buf, size_t len) {
     size_t printable = 0;
     for (size_t i = 0; i < len; i++) {
         unsigned char c = buf[i];
@@ -242,6 +316,20 @@ bool is_binary_file(const char *path) {
             printable++;
         }
     }
+    return is_binary_count(printable, len);
+}
+
+/**
+ * @brief Decides whether data is binary from its count of printable bytes.
+ *
+ * @param printable Number of printable bytes (tab, LF, CR, ASCII 32..126).
+ * @param len Number of bytes examined.
+ * @return true If less than 85% of the bytes are printable.
+ * @return false Otherwise, and for empty data.
+ */
+bool is_binary_count(size_t printable, size_t len) {
+    if (len == 0) return false; // Empty file considered text
+    
     double ratio = (double)printable / len;
     if (ratio < 0.85) {
         return true;
@@ -249,6 +337,26 @@ bool is_binary_file(const char *path) {
     return false;
 }
 
+/**
+ * @brief Determines if a file is binary by checking its printable character ratio.
+ *
+ * Reads up to BINARY_PROBE_SIZE bytes and applies is_binary_buffer().
+ *
+ * @param path The file path.
+ * @return true If the file is binary.
+ * @return false Otherwise.
+ */
+bool is_binary_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return true;
+    
+    unsigned char buf[BINARY_PROBE_SIZE];
+    size_t len = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    
+    return is_binary_buffer(buf, len);
+}
+
 /**
  * @brief Determines if a file should be treated as a text file based on its extension.
  *
@@ -3,6 +3,10 @@
 
 #include <stdbool.h>
 #include "dirdoc.h"
+#include "tiktoken.h"
+
+// Number of leading bytes inspected when deciding whether a file is binary.
+#define BINARY_PROBE_SIZE 1024
 
 /* Initializes the tiktoken library for token counting.
  * @return: true if initialization was successful, false otherwise.
@@ -14,6 +18,12 @@ bool init_tiktoken(void);
  */
 void cleanup_tiktoken(void);
 
+/* Sets how many threads may count the tokens of one large text.
+ * Applies to calculate_token_stats() and to token streams begun afterwards.
+ * @param threads: Number of threads; 1 counts on the calling thread.
+ */
+void set_token_threads(int threads);
+
 /* Calculates token and size statistics for the given string and updates DocumentInfo.
  * Uses tiktoken for more accurate token count that matches LLM behavior.
  * @param str: Input string.
@@ -21,6 +31,37 @@ void cleanup_tiktoken(void);
  */
 void calculate_token_stats(const char *str, DocumentInfo *info);
 
+/* Token statistics of text that arrives in chunks, such as a file read in
+ * fixed-size blocks. The totals match calculate_token_stats() on the whole
+ * text, without the text ever being held in memory at once.
+ */
+typedef struct {
+    tiktoken_stream_t stream; // NULL when counting approximately
+    size_t size;              // bytes fed
+    size_t tokens;            // tokens counted before a tiktoken failure
+    size_t words;             // words for the approximate count
+    bool in_word;             // whether the last chunk ended inside a word
+} TokenStream;
+
+/* Starts token statistics for text that arrives in chunks.
+ * @param ts: The stream to initialize.
+ */
+void token_stream_begin(TokenStream *ts);
+
+/* Adds the next chunk of text to a token stream.
+ * @param ts: The stream.
+ * @param text: The next chunk; it may cut the text anywhere.
+ * @param len: Length of the chunk.
+ */
+void token_stream_feed(TokenStream *ts, const char *text, size_t len);
+
+/* Finishes a token stream and adds its size and token count to info.
+ * @param ts: The stream.
+ * @param info: Pointer to DocumentInfo to update.
+ * @return: true if tiktoken counted all of the text, false if any of it was approximated.
+ */
+bool token_stream_finish(TokenStream *ts, DocumentInfo *info);
+
 /* Counts the maximum consecutive backticks in the given content.
  * @param content: The string to analyze.
  * @return: The maximum count of consecutive backticks.
@@ -39,6 +80,30 @@ const char *get_language_from_extension(const char *filename);
  */
 const char *get_file_size(const char *path);
 
+/* Formats a byte count as a human-readable size (B, KB, MB, ...).
+ * @param bytes: The size in bytes, or a negative value if unknown.
+ * @param buf: Destination buffer.
+ * @param buf_size: Size of the destination buffer.
+ * @return: buf, containing the formatted size or "unknown".
+ */
+const char *format_file_size(long long bytes, char *buf, size_t buf_size);
+
+/* Checks whether a block of file data looks binary.
+ * Uses the same printable-character ratio as is_binary_file().
+ * @param buf: The data, typically the first BINARY_PROBE_SIZE bytes of a file.
+ * @param len: Number of bytes in buf.
+ * @return: true if binary, false otherwise.
+ */
+bool is_binary_buffer(const unsigned char *buf, size_t len);
+
+/* Decides whether data is binary from its count of printable bytes.
+ * This is the rule behind is_binary_buffer().
+ * @param printable: Number of printable bytes.
+ * @param len: Number of bytes examined.
+ * @return: true if binary, false otherwise.
+ */
+bool is_binary_count(size_t printable, size_t len);
+
 /* Checks if the file at the given path is binary.
  * @param path: The file path.
  * @return: true if binary, false otherwise.
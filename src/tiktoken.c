@@ -1,14 +1,24 @@
 #include "tiktoken.h"
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 // Define a C-compatible struct for wrapper
 typedef struct TiktokenWrapper TiktokenWrapper;
+typedef struct TiktokenStream TiktokenStream;
 
 // External functions implemented in tiktoken_cpp.cpp
 extern TiktokenWrapper* tiktoken_cpp_get_encoding(const char* encoding_name);
 extern int tiktoken_cpp_encode(TiktokenWrapper* wrapper, const char* text, size_t text_len, tiktoken_token_t** tokens_out);
 extern int tiktoken_cpp_count(TiktokenWrapper* wrapper, const char* text, size_t text_len);
+extern int tiktoken_cpp_count_parallel(TiktokenWrapper* wrapper, const char* text, size_t text_len, int threads);
+extern TiktokenStream* tiktoken_cpp_stream_begin(TiktokenWrapper* wrapper);
+extern int tiktoken_cpp_stream_feed(TiktokenStream* stream, const char* text, size_t text_len);
+extern void tiktoken_cpp_stream_set_threads(TiktokenStream* stream, int threads);
+extern int tiktoken_cpp_stream_finish(TiktokenStream* stream);
+extern int tiktoken_cpp_cache_stats(TiktokenWrapper* wrapper, size_t* lookups, size_t* hits);
+extern uint64_t tiktoken_cpp_vocab_fingerprint(void);
 extern void tiktoken_cpp_free(TiktokenWrapper* wrapper);
 extern void tiktoken_cleanup(void);
 
@@ -25,9 +35,10 @@ bool tiktoken_init(void) {
 }
 
 /**
- * @brief Obtain a tiktoken encoding by name.
+ * @brief Obtain the built-in tiktoken encoding.
  *
- * @param encoding_name Encoding identifier, e.g. "cl100k_base".
+ * @param encoding_name Encoding identifier, e.g. "cl100k_base". Only a label:
+ *        the vocabulary is always the one built into tiktoken_data.h.
  * @return tiktoken_t Encoding handle or NULL on error.
  */
 tiktoken_t tiktoken_get_encoding(const char* encoding_name) {
@@ -67,6 +78,182 @@ int tiktoken_count(tiktoken_t encoding, const char* text, size_t text_len) {
     return tiktoken_cpp_count((TiktokenWrapper*)encoding, text, text_len);
 }
 
+/**
+ * @brief Count tokens in one large string on several threads.
+ *
+ * @param encoding Encoding handle.
+ * @param text Text to count.
+ * @param text_len Length of text.
+ * @param threads Maximum number of threads.
+ * @return int Number of tokens or -1 on error.
+ */
+int tiktoken_count_parallel(tiktoken_t encoding, const char* text, size_t text_len, int threads) {
+    if (encoding == NULL || text == NULL) {
+        return -1;
+    }
+    
+    return tiktoken_cpp_count_parallel((TiktokenWrapper*)encoding, text, text_len, threads);
+}
+
+typedef struct {
+    tiktoken_t encoding;
+    const char* const* texts;
+    const size_t* text_lens;
+    size_t count;
+    int* counts_out;
+    atomic_size_t next;     // index of the next unclaimed string
+    atomic_bool failed;
+} CountBatchJob;
+
+/**
+ * @brief Worker loop: claim strings one at a time until the batch is done.
+ *
+ * Strings are claimed singly because their sizes vary widely; a large one
+ * then delays only the thread that took it.
+ *
+ * @param arg Pointer to the shared CountBatchJob.
+ * @return void* Always NULL.
+ */
+static void* count_batch_worker(void* arg) {
+    CountBatchJob* job = (CountBatchJob*)arg;
+    for (;;) {
+        size_t i = atomic_fetch_add(&job->next, 1);
+        if (i >= job->count) break;
+        job->counts_out[i] = tiktoken_count(job->encoding, job->texts[i], job->text_lens[i]);
+        if (job->counts_out[i] < 0) {
+            atomic_store(&job->failed, true);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Count tokens in many strings on a pool of threads.
+ *
+ * @param encoding Encoding handle, shared by all threads.
+ * @param texts Strings to count.
+ * @param text_lens Length of each string.
+ * @param count Number of strings.
+ * @param counts_out Receives the token count of each string, -1 on failure.
+ * @param threads Number of threads (1 counts on the calling thread).
+ * @return int 0 if every string was counted, -1 otherwise.
+ */
+int tiktoken_count_batch(tiktoken_t encoding, const char* const* texts, const size_t* text_lens,
+                         size_t count, int* counts_out, int threads) {
+    if (encoding == NULL || (count > 0 && (texts == NULL || text_lens == NULL || counts_out == NULL))) {
+        return -1;
+    }
+    
+    CountBatchJob job;
+    job.encoding = encoding;
+    job.texts = texts;
+    job.text_lens = text_lens;
+    job.count = count;
+    job.counts_out = counts_out;
+    atomic_init(&job.next, 0);
+    atomic_init(&job.failed, false);
+    
+    if (threads < 1) threads = 1;
+    if ((size_t)threads > count) threads = count > 0 ? (int)count : 1;
+    pthread_t* tids = NULL;
+    int started = 0;
+    if (threads > 1) {
+        tids = (pthread_t*)malloc((threads - 1) * sizeof(pthread_t));
+        for (int i = 0; tids && i < threads - 1; i++) {
+            if (pthread_create(&tids[i], NULL, count_batch_worker, &job) != 0) break;
+            started++;
+        }
+    }
+    count_batch_worker(&job);
+    for (int i = 0; i < started; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    free(tids);
+    
+    return atomic_load(&job.failed) ? -1 : 0;
+}
+
+/**
+ * @brief Start counting text that arrives in chunks.
+ *
+ * @param encoding Encoding handle.
+ * @return tiktoken_stream_t Stream handle or NULL on error.
+ */
+tiktoken_stream_t tiktoken_stream_begin(tiktoken_t encoding) {
+    if (encoding == NULL) {
+        return NULL;
+    }
+    
+    return (tiktoken_stream_t)tiktoken_cpp_stream_begin((TiktokenWrapper*)encoding);
+}
+
+/**
+ * @brief Feed the next chunk of text to a stream.
+ *
+ * @param stream Stream handle.
+ * @param text Next chunk of text.
+ * @param text_len Length of the chunk.
+ * @return int 0 on success or -1 on error.
+ */
+int tiktoken_stream_feed(tiktoken_stream_t stream, const char* text, size_t text_len) {
+    if (stream == NULL || (text == NULL && text_len > 0)) {
+        return -1;
+    }
+    
+    return tiktoken_cpp_stream_feed((TiktokenStream*)stream, text, text_len);
+}
+
+/**
+ * @brief Let a stream count large chunks on several threads.
+ *
+ * @param stream Stream handle.
+ * @param threads Maximum number of threads.
+ */
+void tiktoken_stream_set_threads(tiktoken_stream_t stream, int threads) {
+    if (stream != NULL) {
+        tiktoken_cpp_stream_set_threads((TiktokenStream*)stream, threads);
+    }
+}
+
+/**
+ * @brief Count the remaining text of a stream and free it.
+ *
+ * @param stream Stream handle.
+ * @return int Number of tokens in all text fed, or -1 on error.
+ */
+int tiktoken_stream_finish(tiktoken_stream_t stream) {
+    if (stream == NULL) {
+        return -1;
+    }
+    
+    return tiktoken_cpp_stream_finish((TiktokenStream*)stream);
+}
+
+/**
+ * @brief Report lookups and hits of the piece count cache.
+ *
+ * @param encoding Encoding handle.
+ * @param lookups Output for the number of cache lookups.
+ * @param hits Output for the number of cache hits.
+ * @return int 0 on success or -1 on error.
+ */
+int tiktoken_cache_stats(tiktoken_t encoding, size_t* lookups, size_t* hits) {
+    if (encoding == NULL || lookups == NULL || hits == NULL) {
+        return -1;
+    }
+    
+    return tiktoken_cpp_cache_stats((TiktokenWrapper*)encoding, lookups, hits);
+}
+
+/**
+ * @brief Fingerprint of the vocabulary compiled into this build.
+ *
+ * @return uint64_t Hash of the encoder name, vocabulary and special tokens.
+ */
+uint64_t tiktoken_vocab_fingerprint(void) {
+    return tiktoken_cpp_vocab_fingerprint();
+}
+
 /**
  * @brief Free an encoding instance.
  *
@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -10,6 +11,7 @@ extern "C" {
 
 typedef void* tiktoken_t;
 typedef int tiktoken_token_t;
+typedef void* tiktoken_stream_t;
 
 /**
  * Initialize the tiktoken library
@@ -18,10 +20,12 @@ typedef int tiktoken_token_t;
 bool tiktoken_init(void);
 
 /**
- * Get a tiktoken encoding by name
+ * Get the built-in tiktoken encoding
  * 
- * @param encoding_name The name of the encoding (e.g., "cl100k_base" for GPT-4 encoding)
- * @return A tiktoken encoding object, or NULL if the encoding is not found
+ * @param encoding_name The name of the encoding (e.g., "cl100k_base"). It is not used to
+ *        pick a vocabulary: the one the build generated tiktoken_data.h from
+ *        (TIKTOKEN_ENCODER_NAME in the Makefile) is always returned.
+ * @return A tiktoken encoding object, or NULL if tiktoken cannot be initialized
  */
 tiktoken_t tiktoken_get_encoding(const char* encoding_name);
 
@@ -46,6 +50,107 @@ int tiktoken_encode(tiktoken_t encoding, const char* text, size_t text_len, tikt
  */
 int tiktoken_count(tiktoken_t encoding, const char* text, size_t text_len);
 
+/**
+ * Count tokens in one large string on several threads
+ * 
+ * The string is cut into one segment per thread at line starts where
+ * pre-tokenization is guaranteed to restart, the segments are counted
+ * concurrently and their counts summed. The result equals tiktoken_count().
+ * Strings too short to be worth splitting are counted on the calling thread.
+ * 
+ * @param encoding The tiktoken encoding to use
+ * @param text The text to count tokens for
+ * @param text_len Length of the text
+ * @param threads Maximum number of threads to count with
+ * @return The number of tokens, or -1 on error
+ */
+int tiktoken_count_parallel(tiktoken_t encoding, const char* text, size_t text_len, int threads);
+
+/**
+ * Count tokens in many strings, spread over a pool of threads
+ * 
+ * Encodings are immutable and may be shared between threads; every thread
+ * counts with scratch state of its own. The results equal calling
+ * tiktoken_count() on each string.
+ * 
+ * @param encoding The tiktoken encoding to use
+ * @param texts The strings to count
+ * @param text_lens Length of each string
+ * @param count Number of strings
+ * @param counts_out Output: the number of tokens of each string, or -1 where counting failed
+ * @param threads Number of threads to count with (1 counts on the calling thread)
+ * @return 0 if every string was counted, or -1 on error
+ */
+int tiktoken_count_batch(tiktoken_t encoding, const char* const* texts, const size_t* text_lens,
+                         size_t count, int* counts_out, int threads);
+
+/**
+ * Start counting the tokens of text that arrives in chunks, e.g. a file read
+ * in fixed-size blocks. The chunks may cut the text anywhere, even inside a
+ * UTF-8 sequence; the total equals tiktoken_count() on the whole text.
+ * 
+ * @param encoding The tiktoken encoding to use
+ * @return A stream to feed, or NULL on error
+ */
+tiktoken_stream_t tiktoken_stream_begin(tiktoken_t encoding);
+
+/**
+ * Feed the next chunk of text to a stream
+ * 
+ * Text up to the last line start in the chunk is counted right away; the
+ * rest is kept until the next chunk shows how its pieces end.
+ * 
+ * @param stream Stream from tiktoken_stream_begin()
+ * @param text The next chunk of text
+ * @param text_len Length of the chunk
+ * @return 0 on success, or -1 on error
+ */
+int tiktoken_stream_feed(tiktoken_stream_t stream, const char* text, size_t text_len);
+
+/**
+ * Let a stream count large chunks on several threads
+ * 
+ * Each chunk fed afterwards is counted as tiktoken_count_parallel() would,
+ * so feeding chunks of several megabytes keeps the threads busy.
+ * 
+ * @param stream Stream from tiktoken_stream_begin()
+ * @param threads Maximum number of threads (1, the default, counts on the calling thread)
+ */
+void tiktoken_stream_set_threads(tiktoken_stream_t stream, int threads);
+
+/**
+ * Count the remaining text of a stream and free it
+ * 
+ * @param stream Stream from tiktoken_stream_begin()
+ * @return The number of tokens in all text fed, or -1 on error
+ */
+int tiktoken_stream_finish(tiktoken_stream_t stream);
+
+/**
+ * Report how well the piece count cache works
+ * 
+ * Counting remembers the token count of every piece it had to merge, so
+ * repeated identifiers and keywords are merged only once. Pieces that are
+ * tokens themselves never reach the cache. Every thread has a cache of its
+ * own; the statistics are totals over all threads.
+ * 
+ * @param encoding The tiktoken encoding
+ * @param lookups Output: number of pieces looked up in the cache
+ * @param hits Output: number of those found there
+ * @return 0 on success, or -1 on error
+ */
+int tiktoken_cache_stats(tiktoken_t encoding, size_t* lookups, size_t* hits);
+
+/**
+ * Fingerprint of the vocabulary compiled into this build
+ * 
+ * Token counts are only comparable between builds with the same
+ * fingerprint; the encoder is a build-time choice (see the Makefile).
+ * 
+ * @return Hash of the encoder name, vocabulary and special tokens
+ */
+uint64_t tiktoken_vocab_fingerprint(void);
+
 /**
  * Free a tiktoken encoding
  * 
@@ -1,8 +1,6 @@
 #include <stdio.h>
 #include <vector>
 #include <string>
-#include <unordered_map>
-#include <map>
 #include <algorithm>
 #include <memory>
 #include <cstring>
@@ -11,185 +9,326 @@
 #include <fstream>
 #include <iostream>
 #include <utility>
-#include <regex>
+#include <queue>
 #include <stdexcept>
 #include <climits>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <system_error>
 
 // Include the generated tiktoken data
 #include "tiktoken_data.h"
 
-// For Base64 decoding
-#include "base64.h"
+// Perfect hash over the vocabulary
+#include "tiktoken_hash.h"
+
+// Splits text into pieces with the encoding's regex pattern
+#include "pretokenize.h"
 
 namespace tiktoken {
 
-// Pair of byte strings
-typedef std::pair<std::string, std::string> BytesPair;
+// Token counts of merged pieces. Source code repeats identifiers, keywords
+// and indentation constantly, so most pieces that need merging were merged
+// before. Open addressing over a fixed number of slots keyed by a 64-bit hash
+// of the piece: a lookup probes up to PIECE_CACHE_PROBES slots from the home
+// slot, and when all are taken the home slot is overwritten. Keys are not
+// verified against the bytes; two pieces sharing a 64-bit hash is too
+// unlikely to matter for counting.
+struct PieceCacheEntry {
+    uint64_t key;    // piece hash, 0 for an empty slot
+    uint32_t count;  // tokens the piece merges into
+};
+static const size_t PIECE_CACHE_SLOTS = 1 << 14;
+static const size_t PIECE_CACHE_PROBES = 4;
 
-// Custom hash function for BytesPair
-struct BytesPairHash {
-    std::size_t operator()(const BytesPair& p) const {
-        return std::hash<std::string>()(p.first) ^ std::hash<std::string>()(p.second);
-    }
+// Everything counting writes to. The encoder is immutable once constructed
+// and shared by all threads; each thread counts with its own scratch.
+struct CountScratch {
+    std::vector<PieceCacheEntry> piece_cache;
+    size_t lookups;  // cache lookups not yet added to the process totals
+    size_t hits;     // cache hits not yet added to the process totals
+    
+    CountScratch() : piece_cache(PIECE_CACHE_SLOTS), lookups(0), hits(0) {}
 };
 
+// The tables are static data and the members are set by the constructor;
+// no method modifies the encoder, so any number of threads may use one.
 class BpeEncoder {
 private:
-    // Token vocabulary: maps byte sequences to token IDs
-    std::unordered_map<std::string, int> token_vocab;
+    // True when every single byte is a token, which byte-level BPE needs.
+    bool byte_level;
     
-    // Special tokens (like <|endoftext|>)
-    std::unordered_map<std::string, int> special_tokens;
+    // Split pattern of the encoding the vocabulary belongs to
+    PretokenizePattern pattern;
     
-    // BPE merge ranks: lower rank = higher priority
-    std::unordered_map<BytesPair, int, BytesPairHash> bpe_ranks;
-    
-    // Pre-computed regex patterns
-    std::regex pat_split;
     bool initialized;
     
-    // Initialize the encoder with tiktoken data
+    // Pieces up to this length are merged without allocating (merge_short)
+    static const size_t SHORT_PIECE_BYTES = 64;
+    
+    // The vocabulary is static data from tiktoken_data.h, laid out by the
+    // generator as a perfect hash table, so there is nothing to load.
     void initialize() {
-        // Load special tokens from the data
-        for (size_t i = 0; i < TIKTOKEN_NUM_SPECIAL_TOKENS; i++) {
-            const tiktoken_special_token_t& special_token = tiktoken_special_tokens[i];
-            std::string token_bytes = base64_decode(special_token.token_b64);
-            special_tokens[token_bytes] = special_token.id;
+        byte_level = true;
+        for (int c = 0; c < 256 && byte_level; c++) {
+            byte_level = tiktoken_byte_ranks[c] >= 0;
+        }
+        if (!byte_level) {
+            fprintf(stderr, "Warning: Vocabulary lacks single-byte tokens; token counts are estimated.\n");
         }
         
-        // Load vocabulary from the data
-        for (size_t i = 0; i < TIKTOKEN_VOCAB_SIZE; i++) {
-            const tiktoken_vocab_entry_t& vocab_entry = tiktoken_vocab[i];
-            try {
-                std::string token_bytes = base64_decode(vocab_entry.token_b64);
-                token_vocab[token_bytes] = vocab_entry.id;
-            } catch (const std::exception& e) {
-                fprintf(stderr, "Warning: Failed to decode token %zu: %s\n", i, e.what());
+        initialized = true;
+    }
+    
+    // Rank (= ID) of a byte range, or INT_MAX if the range is not a token.
+    // The perfect hash names the only slot the range can be in; comparing the
+    // bytes there tells whether it is.
+    int rank_of(const char* bytes, size_t len) const {
+        if (len == 1) {
+            int rank = tiktoken_byte_ranks[(unsigned char)bytes[0]];
+            return rank < 0 ? INT_MAX : rank;
+        }
+        if (len == 0 || len > TIKTOKEN_MAX_TOKEN_BYTES) {
+            return INT_MAX;
+        }
+        tiktoken_hash_t h = tiktoken_hash(bytes, len, TIKTOKEN_HASH_BUCKETS, TIKTOKEN_VOCAB_SIZE);
+        uint32_t slot = tiktoken_hash_slot(h, tiktoken_hash_d0[h.bucket], tiktoken_hash_d1[h.bucket], TIKTOKEN_VOCAB_SIZE);
+        uint32_t offset = tiktoken_token_offsets[slot];
+        if (tiktoken_token_offsets[slot + 1] - offset != len ||
+            memcmp(tiktoken_token_bytes + offset, bytes, len) != 0) {
+            return INT_MAX;
+        }
+        return tiktoken_token_ids[slot];
+    }
+    
+    // ID of a special token spelled exactly by text, or -1
+    int special_token_id(const char* text, size_t len) const {
+        for (size_t i = 0; i < TIKTOKEN_NUM_SPECIAL_TOKENS; i++) {
+            const tiktoken_special_token_t& special = tiktoken_special_tokens[i];
+            if (special.len == len && memcmp(special.bytes, text, len) == 0) {
+                return special.id;
             }
         }
-        
-        // Load BPE merges from the data - safely handle if we have none
-        if (TIKTOKEN_NUM_MERGES > 0) {
-            for (size_t i = 0; i < TIKTOKEN_NUM_MERGES; i++) {
-                try {
-                    const tiktoken_bpe_merge_t& merge = tiktoken_bpe_merges[i];
-                    std::string first = base64_decode(merge.first_b64);
-                    std::string second = base64_decode(merge.second_b64);
-                    bpe_ranks[{first, second}] = merge.rank;
-                } catch (const std::exception& e) {
-                    fprintf(stderr, "Warning: Failed to decode merge %zu: %s\n", i, e.what());
-                }
+        return -1;
+    }
+    
+    // Hash of a piece for the count cache, never 0
+    static uint64_t piece_hash(const char* bytes, size_t len) {
+        uint64_t h = tiktoken_hash_mix(len + 0x9e3779b97f4a7c15ULL);
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8) {
+            uint64_t word;
+            memcpy(&word, bytes + i, 8);
+            h = tiktoken_hash_mix(h ^ word);
+        }
+        if (i < len) {
+            uint64_t word = 0;
+            memcpy(&word, bytes + i, len - i);
+            h = tiktoken_hash_mix(h ^ word);
+        }
+        return h != 0 ? h : 1;
+    }
+    
+    // Number of tokens a piece that is not a token itself merges into,
+    // served from the scratch's cache when the piece was merged before
+    size_t merged_count(const char* bytes, size_t n, CountScratch& scratch) const {
+        std::vector<PieceCacheEntry>& piece_cache = scratch.piece_cache;
+        uint64_t key = piece_hash(bytes, n);
+        size_t home = (size_t)key & (PIECE_CACHE_SLOTS - 1);
+        size_t slot = home;
+        scratch.lookups++;
+        for (size_t probe = 0; probe < PIECE_CACHE_PROBES; probe++) {
+            size_t s = (home + probe) & (PIECE_CACHE_SLOTS - 1);
+            if (piece_cache[s].key == key) {
+                scratch.hits++;
+                return piece_cache[s].count;
+            }
+            if (piece_cache[s].key == 0) {
+                slot = s;
+                break;
             }
         }
-        
-        // Use a simple whitespace/punctuation split pattern for basic tokenization
-        pat_split = std::regex("\\s+|[[:punct:]]");
-        
-        initialized = true;
+        size_t count = byte_pair_merge(bytes, n, nullptr);
+        piece_cache[slot].key = key;
+        piece_cache[slot].count = (uint32_t)count;
+        return count;
+    }
+    
+    // tiktoken's byte_pair_merge: start from single bytes and repeatedly merge
+    // the adjacent pair whose concatenation has the lowest rank (leftmost on
+    // ties) until no adjacent pair is a token. Returns the number of tokens
+    // and appends their IDs to out unless it is null.
+    size_t byte_pair_merge(const char* bytes, size_t n, std::vector<int>* out) const {
+        return n <= SHORT_PIECE_BYTES ? merge_short(bytes, n, out) : merge_long(bytes, n, out);
     }
     
-    // Get pairs of consecutive bytes from token
-    std::vector<BytesPair> get_pairs(const std::vector<std::string>& word_pieces) {
-        std::vector<BytesPair> pairs;
-        if (word_pieces.size() < 2) return pairs;
+    // Merge for short pieces, which are nearly all of them: the parts live in
+    // stack arrays and every round rescans the pair ranks for the minimum,
+    // as tiktoken itself does. Nothing is allocated.
+    size_t merge_short(const char* bytes, size_t n, std::vector<int>* out) const {
+        // Part i covers bytes [start[i], start[i + 1]); rank[i] is the rank of
+        // part i merged with part i + 1, INT_MAX for the last part.
+        unsigned char start[SHORT_PIECE_BYTES + 1];
+        int rank[SHORT_PIECE_BYTES];
+        size_t parts = n;
+        for (size_t i = 0; i <= n; i++) {
+            start[i] = (unsigned char)i;
+        }
+        for (size_t i = 0; i + 1 < n; i++) {
+            rank[i] = rank_of(bytes + i, 2);
+        }
+        rank[n - 1] = INT_MAX;
         
-        for (size_t i = 0; i < word_pieces.size() - 1; i++) {
-            pairs.push_back({word_pieces[i], word_pieces[i+1]});
+        while (parts > 1) {
+            size_t best = 0;
+            int best_rank = INT_MAX;
+            for (size_t i = 0; i + 1 < parts; i++) {
+                if (rank[i] < best_rank) {
+                    best_rank = rank[i];
+                    best = i;
+                }
+            }
+            if (best_rank == INT_MAX) break;
+            
+            // Merge part best + 1 into part best
+            memmove(&start[best + 1], &start[best + 2], (parts - best - 1) * sizeof(start[0]));
+            memmove(&rank[best + 1], &rank[best + 2], (parts - best - 2) * sizeof(rank[0]));
+            parts--;
+            rank[best] = best + 1 < parts ? rank_of(bytes + start[best], start[best + 2] - start[best]) : INT_MAX;
+            if (best > 0) {
+                rank[best - 1] = rank_of(bytes + start[best - 1], start[best + 1] - start[best - 1]);
+            }
         }
         
-        return pairs;
+        if (out != nullptr) {
+            for (size_t i = 0; i < parts; i++) {
+                out->push_back(rank_of(bytes + start[i], start[i + 1] - start[i]));
+            }
+        }
+        return parts;
     }
     
-    // Apply BPE to a token
-    std::vector<std::string> bpe(const std::string& token) {
-        // Initialize with individual bytes
-        std::vector<std::string> word;
-        for (unsigned char c : token) {
-            word.push_back(std::string(1, c));
+    // Merge for long pieces: the parts form a linked list and candidate
+    // merges sit in a min-heap; entries whose rank went stale after a
+    // neighbouring merge are skipped when popped, so a piece of n bytes takes
+    // O(n log n) lookups instead of rescanning every pair.
+    size_t merge_long(const char* bytes, size_t n, std::vector<int>* out) const {
+        const size_t none = (size_t)-1;
+        
+        // Part i covers bytes [i, next[i]); rank[i] is the rank of part i
+        // merged with its successor, or -1 once part i is merged away.
+        std::vector<size_t> next(n), prev(n);
+        std::vector<int> rank(n);
+        for (size_t i = 0; i < n; i++) {
+            next[i] = i + 1;
+            prev[i] = i == 0 ? none : i - 1;
         }
+        auto pair_rank = [&](size_t i) {
+            size_t j = next[i];
+            return j >= n ? INT_MAX : rank_of(bytes + i, next[j] - i);
+        };
         
-        // Apply merges until no more can be applied
-        std::vector<BytesPair> pairs = get_pairs(word);
-        if (pairs.empty()) {
-            return word;
+        typedef std::pair<int, size_t> Candidate;
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate> > heap;
+        for (size_t i = 0; i < n; i++) {
+            rank[i] = pair_rank(i);
+            if (rank[i] != INT_MAX) heap.push(Candidate(rank[i], i));
         }
         
-        while (true) {
-            // Find the pair with the lowest rank (highest priority)
-            int best_rank = INT_MAX;
-            BytesPair best_pair;
-            bool found = false;
-            
-            for (const auto& pair : pairs) {
-                auto it = bpe_ranks.find(pair);
-                if (it != bpe_ranks.end() && it->second < best_rank) {
-                    best_rank = it->second;
-                    best_pair = pair;
-                    found = true;
-                }
-            }
+        while (!heap.empty()) {
+            Candidate top = heap.top();
+            heap.pop();
+            size_t i = top.second;
+            if (rank[i] != top.first) continue;
             
-            if (!found) break;
+            // Merge part i with its successor j
+            size_t j = next[i];
+            next[i] = next[j];
+            if (next[j] < n) prev[next[j]] = i;
+            rank[j] = -1;
             
-            // Apply the merge
-            std::vector<std::string> new_word;
-            for (size_t i = 0; i < word.size();) {
-                // Try to find a match for the best pair
-                if (i < word.size() - 1 && word[i] == best_pair.first && word[i+1] == best_pair.second) {
-                    new_word.push_back(best_pair.first + best_pair.second);
-                    i += 2;  // Skip both parts of the pair
-                } else {
-                    new_word.push_back(word[i]);
-                    i += 1;
-                }
+            rank[i] = pair_rank(i);
+            if (rank[i] != INT_MAX) heap.push(Candidate(rank[i], i));
+            if (prev[i] != none) {
+                size_t p = prev[i];
+                rank[p] = pair_rank(p);
+                if (rank[p] != INT_MAX) heap.push(Candidate(rank[p], p));
             }
-            
-            // Update word and get new pairs
-            word = std::move(new_word);
-            pairs = get_pairs(word);
-            if (pairs.empty()) break;
         }
         
-        return word;
+        size_t parts = 0;
+        for (size_t i = 0; i < n; i = next[i]) {
+            if (out != nullptr) out->push_back(rank_of(bytes + i, next[i] - i));
+            parts++;
+        }
+        return parts;
     }
-
-    // Simple tokenization function - split text into tokens
-    std::vector<std::string> basic_tokenize(const std::string& text) {
-        std::vector<std::string> tokens;
-        
-        // First check if the entire string is a special token
-        auto it = special_tokens.find(text);
-        if (it != special_tokens.end()) {
-            tokens.push_back(text);
-            return tokens;
+    
+    // Length-based chunking used before real merges existed. It only serves
+    // vocabularies without byte tokens, where BPE cannot start from bytes,
+    // and as the baseline for tools/bench_tiktoken.
+    void heuristic_pieces(const std::string& token, std::vector<int>& out) const {
+        std::vector<std::string> bpe_tokens;
+        bool is_ascii = true;
+        for (unsigned char c : token) {
+            if (c > 127) {
+                is_ascii = false;
+                break;
+            }
         }
         
-        // Simple tokenization approach - split on whitespace and punctuation
-        size_t start = 0;
-        for (size_t i = 0; i < text.size(); i++) {
-            char c = text[i];
-            if (isspace(c) || ispunct(c)) {
-                // Add accumulated token if any
-                if (i > start) {
-                    tokens.push_back(text.substr(start, i - start));
+        if (is_ascii) {
+            // For ASCII tokens
+            if (token.length() <= 4) {
+                // Very short ASCII tokens
+                bpe_tokens.push_back(token);
+            } else if (ispunct(token[0]) || isdigit(token[0])) {
+                // Punctuation and numbers often need special handling
+                for (char c : token) {
+                    bpe_tokens.push_back(std::string(1, c));
+                }
+            } else {
+                // Split into smaller chunks based on length
+                // GPT models often split words into subwords of ~2-4 bytes
+                size_t chunk_size;
+                if (token.length() <= 8) {
+                    chunk_size = 4;  // Short words use ~4 char chunks
+                } else if (token.length() <= 16) {
+                    chunk_size = 3;  // Medium words use ~3 char chunks
+                } else {
+                    chunk_size = 2;  // Long words use ~2 char chunks
                 }
                 
-                // Add the whitespace or punctuation as a separate token
-                tokens.push_back(text.substr(i, 1));
-                start = i + 1;
+                for (size_t i = 0; i < token.length(); i += chunk_size) {
+                    bpe_tokens.push_back(token.substr(i, std::min(chunk_size, token.length() - i)));
+                }
+            }
+        } else {
+            // For non-ASCII, tokenize bytewise (Unicode is usually 1 token per char)
+            for (unsigned char c : token) {
+                bpe_tokens.push_back(std::string(1, c));
             }
         }
         
-        // Add the final token if any
-        if (start < text.size()) {
-            tokens.push_back(text.substr(start));
+        // Convert each piece to a token ID
+        for (const auto& bpe_token : bpe_tokens) {
+            int rank = rank_of(bpe_token.data(), bpe_token.size());
+            if (rank != INT_MAX) {
+                out.push_back(rank);
+            } else {
+                // For unknown tokens, try byte-level encoding
+                for (unsigned char c : bpe_token) {
+                    if (tiktoken_byte_ranks[c] >= 0) {
+                        out.push_back(tiktoken_byte_ranks[c]);
+                    }
+                }
+            }
         }
-        
-        return tokens;
     }
 
 public:
-    BpeEncoder() : initialized(false) {
+    BpeEncoder() : byte_level(false), pattern(pretokenize_pattern(TIKTOKEN_ENCODER_NAME)), initialized(false) {
         initialize();
     }
     
@@ -197,108 +336,80 @@ public:
         return initialized;
     }
     
-    // Encode text into tokens
-    std::vector<int> encode(const std::string& text) {
+    // Whether text spells a special token, which encodes as that one token
+    bool isSpecialToken(const char* text, size_t len) const {
+        return special_token_id(text, len) >= 0;
+    }
+    
+    // Encode text into tokens. With use_heuristic the pieces are chunked by
+    // length instead of merged (see heuristic_pieces).
+    std::vector<int> encode(const char* text, size_t len, bool use_heuristic = false) const {
         // Check if the text matches a special token exactly
-        auto special_it = special_tokens.find(text);
-        if (special_it != special_tokens.end()) {
-            return {special_it->second};
+        int special_id = special_token_id(text, len);
+        if (special_id >= 0) {
+            return {special_id};
         }
         
         std::vector<int> encoded_tokens;
-
-        // First pass: basic tokenization
-        std::vector<std::string> raw_tokens = basic_tokenize(text);
-        
-        // Second pass: BPE on each piece
-        for (const auto& token : raw_tokens) {
-            // Special token check for each piece
-            special_it = special_tokens.find(token);
-            if (special_it != special_tokens.end()) {
-                encoded_tokens.push_back(special_it->second);
+        encode_ordinary(text, len, use_heuristic, encoded_tokens);
+        return encoded_tokens;
+    }
+    
+    // Encode text as ordinary text, without checking whether it spells a
+    // special token, appending the IDs to out.
+    void encode_ordinary(const char* text, size_t len, bool use_heuristic, std::vector<int>& out) const {
+        // Split into pieces with the encoding's pattern, then run BPE on each
+        for (size_t pos = 0; pos < len;) {
+            size_t end = pretokenize_next(text, len, pos, pattern);
+            const char* piece = text + pos;
+            size_t piece_len = end - pos;
+            pos = end;
+            
+            // A piece that is a token by itself needs no merging
+            int rank = rank_of(piece, piece_len);
+            if (rank != INT_MAX) {
+                out.push_back(rank);
                 continue;
             }
             
-            // Apply BPE to get subtoken pieces
-            std::vector<std::string> bpe_tokens;
-            
-            if (bpe_ranks.empty()) {
-                // Tokenization approach using our embedded vocabulary data
-                // This is a simplified version but works well for common English text
-                
-                // First check if the token is in the vocabulary as-is
-                auto vocab_it = token_vocab.find(token);
-                if (vocab_it != token_vocab.end()) {
-                    encoded_tokens.push_back(vocab_it->second);
-                    continue;
-                }
-                
-                // We already checked this token in the vocabulary
-                
-                // Otherwise use a fallback approach
-                bool is_ascii = true;
-                for (unsigned char c : token) {
-                    if (c > 127) {
-                        is_ascii = false;
-                        break;
-                    }
-                }
-                
-                if (is_ascii) {
-                    // For ASCII tokens
-                    if (token.length() <= 4) {
-                        // Very short ASCII tokens
-                        bpe_tokens.push_back(token);
-                    } else if (ispunct(token[0]) || isdigit(token[0])) {
-                        // Punctuation and numbers often need special handling
-                        for (char c : token) {
-                            bpe_tokens.push_back(std::string(1, c));
-                        }
-                    } else {
-                        // Split into smaller chunks based on length
-                        // GPT models often split words into subwords of ~2-4 bytes
-                        size_t chunk_size;
-                        if (token.length() <= 8) {
-                            chunk_size = 4;  // Short words use ~4 char chunks
-                        } else if (token.length() <= 16) {
-                            chunk_size = 3;  // Medium words use ~3 char chunks
-                        } else {
-                            chunk_size = 2;  // Long words use ~2 char chunks
-                        }
-                        
-                        for (size_t i = 0; i < token.length(); i += chunk_size) {
-                            bpe_tokens.push_back(token.substr(i, std::min(chunk_size, token.length() - i)));
-                        }
-                    }
-                } else {
-                    // For non-ASCII, tokenize bytewise (Unicode is usually 1 token per char)
-                    for (unsigned char c : token) {
-                        bpe_tokens.push_back(std::string(1, c));
-                    }
-                }
+            if (byte_level && !use_heuristic) {
+                byte_pair_merge(piece, piece_len, &out);
             } else {
-                bpe_tokens = bpe(token);
-            }
-            
-            // Convert each piece to a token ID
-            for (const auto& bpe_token : bpe_tokens) {
-                auto vocab_it = token_vocab.find(bpe_token);
-                if (vocab_it != token_vocab.end()) {
-                    encoded_tokens.push_back(vocab_it->second);
-                } else {
-                    // For unknown tokens, try byte-level encoding
-                    for (unsigned char c : bpe_token) {
-                        std::string byte_token(1, c);
-                        auto byte_it = token_vocab.find(byte_token);
-                        if (byte_it != token_vocab.end()) {
-                            encoded_tokens.push_back(byte_it->second);
-                        }
-                    }
-                }
+                heuristic_pieces(std::string(piece, piece_len), out);
             }
         }
+    }
+    
+    // Count the tokens of text without producing them: same result as
+    // encode(text, len).size(), but pieces are looked up in place and no
+    // token IDs are stored.
+    size_t count(const char* text, size_t len, CountScratch& scratch) const {
+        if (special_token_id(text, len) >= 0) {
+            return 1;
+        }
+        return count_ordinary(text, len, scratch);
+    }
+    
+    // count() without the special token check. Counts of text cut at
+    // pretokenize_next_boundary() positions add up to the count of the whole.
+    size_t count_ordinary(const char* text, size_t len, CountScratch& scratch) const {
+        if (!byte_level) {
+            std::vector<int> tokens;
+            encode_ordinary(text, len, false, tokens);
+            return tokens.size();
+        }
         
-        return encoded_tokens;
+        size_t tokens = 0;
+        for (size_t pos = 0; pos < len;) {
+            size_t end = pretokenize_next(text, len, pos, pattern);
+            if (rank_of(text + pos, end - pos) != INT_MAX) {
+                tokens++;
+            } else {
+                tokens += merged_count(text + pos, end - pos, scratch);
+            }
+            pos = end;
+        }
+        return tokens;
     }
 };
 
@@ -310,27 +421,141 @@ public:
 // This struct holds the C++ encoder object
 extern "C" {
 struct TiktokenWrapper {
-    tiktoken::BpeEncoder* encoder;
+    const tiktoken::BpeEncoder* encoder;
     bool initialized;
 };
 
-// Global tiktoken instance for simple API
-static TiktokenWrapper* g_default_tiktoken = nullptr;
+// Token count of text fed in chunks. Text up to the last restart position
+// (see pretokenize_next_boundary) is counted as soon as it arrives; the rest
+// is held back, because the pieces at its end may continue in the next chunk.
+// Text without line breaks is therefore held until finish.
+struct TiktokenStream {
+    const tiktoken::BpeEncoder* encoder;
+    std::string pending;  // text after the last restart position
+    size_t tokens;        // tokens of the text before it
+    bool cut;             // whether any text was counted yet
+    int threads;          // threads to count large chunks with
+};
+
+// Global tiktoken instance for simple API. It is created once under
+// g_init_mutex and never changes afterwards, so readers only load the pointer.
+static std::atomic<TiktokenWrapper*> g_default_tiktoken(nullptr);
+static std::mutex g_init_mutex;
+
+// Piece cache statistics of all threads
+static std::atomic<size_t> g_cache_lookups(0);
+static std::atomic<size_t> g_cache_hits(0);
+
+/**
+ * @brief Scratch of the calling thread, created on its first count.
+ *
+ * @return tiktoken::CountScratch& The thread's scratch.
+ */
+static tiktoken::CountScratch& thread_scratch() {
+    static thread_local tiktoken::CountScratch scratch;
+    return scratch;
+}
+
+/**
+ * @brief Add a scratch's cache statistics to the process totals.
+ *
+ * @param scratch Scratch whose counters are moved into the totals.
+ */
+static void publish_cache_stats(tiktoken::CountScratch& scratch) {
+    g_cache_lookups.fetch_add(scratch.lookups, std::memory_order_relaxed);
+    g_cache_hits.fetch_add(scratch.hits, std::memory_order_relaxed);
+    scratch.lookups = 0;
+    scratch.hits = 0;
+}
+
+// Text is split over threads only into segments of at least this size:
+// below it, starting a thread and warming its piece cache costs more than
+// the thread saves.
+static const size_t PARALLEL_MIN_SEGMENT = 1 << 20;
+
+/**
+ * @brief Count text as ordinary text on up to the given number of threads.
+ *
+ * The text is cut into one segment per thread at the restart positions
+ * (see pretokenize_next_boundary) nearest above equal fractions of its
+ * length. Each segment splits into the same pieces as it does within the
+ * whole text, so the segment counts add up to the count of the whole. The
+ * calling thread counts the first segment.
+ *
+ * @param encoder Encoder, shared by all threads.
+ * @param text Text to count.
+ * @param len Length of text.
+ * @param threads Maximum number of threads.
+ * @return size_t Number of tokens, as count_ordinary() would return.
+ */
+static size_t count_ordinary_parallel(const tiktoken::BpeEncoder& encoder, const char* text, size_t len, int threads) {
+    size_t segments = threads > 1 ? std::min((size_t)threads, len / PARALLEL_MIN_SEGMENT) : 1;
+    std::vector<size_t> cuts(1, 0);
+    for (size_t i = 1; i < segments; i++) {
+        size_t cut = pretokenize_next_boundary(text, len, std::max(i * (len / segments), cuts.back() + 1));
+        if (cut >= len) break;
+        cuts.push_back(cut);
+    }
+    cuts.push_back(len);
+    
+    size_t count = cuts.size() - 1;
+    std::vector<size_t> tokens(count, 0);
+    std::atomic<bool> failed(false);
+    auto count_segment = [&](size_t i) {
+        try {
+            tiktoken::CountScratch& scratch = thread_scratch();
+            tokens[i] = encoder.count_ordinary(text + cuts[i], cuts[i + 1] - cuts[i], scratch);
+            publish_cache_stats(scratch);
+        } catch (...) {
+            failed = true;
+        }
+    };
+    
+    // Segments a thread could not be started for are counted here as well
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < count; i++) {
+        try {
+            workers.emplace_back(count_segment, i);
+        } catch (const std::system_error&) {
+            break;
+        }
+    }
+    count_segment(0);
+    for (size_t i = workers.size() + 1; i < count; i++) {
+        count_segment(i);
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    
+    if (failed) {
+        throw std::runtime_error("counting a segment failed");
+    }
+    size_t total = 0;
+    for (size_t n : tokens) {
+        total += n;
+    }
+    return total;
+}
 
 // Initialize the default tiktoken instance
 extern "C" bool tiktoken_cpp_init() {
-    if (g_default_tiktoken != nullptr && g_default_tiktoken->initialized) {
-        return true;
+    TiktokenWrapper* instance = g_default_tiktoken.load(std::memory_order_acquire);
+    if (instance != nullptr) {
+        return instance->initialized;
     }
     
     try {
-        if (g_default_tiktoken == nullptr) {
-            g_default_tiktoken = new TiktokenWrapper();
-            g_default_tiktoken->encoder = new tiktoken::BpeEncoder();
-            g_default_tiktoken->initialized = g_default_tiktoken->encoder->isInitialized();
+        std::lock_guard<std::mutex> lock(g_init_mutex);
+        instance = g_default_tiktoken.load(std::memory_order_relaxed);
+        if (instance == nullptr) {
+            instance = new TiktokenWrapper();
+            instance->encoder = new tiktoken::BpeEncoder();
+            instance->initialized = instance->encoder->isInitialized();
+            g_default_tiktoken.store(instance, std::memory_order_release);
         }
         
-        return g_default_tiktoken->initialized;
+        return instance->initialized;
     } catch (const std::exception& e) {
         fprintf(stderr, "Failed to initialize tiktoken: %s\n", e.what());
         return false;
@@ -340,18 +565,14 @@ extern "C" bool tiktoken_cpp_init() {
     }
 }
 
-// Get an encoding by name (only cl100k_base is supported)
+// Get the built-in encoding. Only the vocabulary tiktoken_data.h was generated
+// from (TIKTOKEN_ENCODER_NAME) is compiled in, so the name does not select one.
 extern "C" TiktokenWrapper* tiktoken_cpp_get_encoding(const char* encoding_name) {
+    (void)encoding_name;
     try {
-        // We only support cl100k_base for now
-        if (strcmp(encoding_name, "cl100k_base") != 0) {
-            fprintf(stderr, "Warning: Only cl100k_base encoding is supported, using it instead of %s\n", 
-                    encoding_name);
-        }
-        
         // Initialize or return the default instance
         if (tiktoken_cpp_init()) {
-            return g_default_tiktoken;
+            return g_default_tiktoken.load(std::memory_order_acquire);
         }
         return nullptr;
     } catch (const std::exception& e) {
@@ -368,23 +589,24 @@ extern "C" int tiktoken_cpp_encode(TiktokenWrapper* wrapper, const char* text, s
             return -1;
         }
 
-        // Create a string from the text
-        std::string text_str;
-        if (text != nullptr && text_len > 0) {
-            text_str.assign(text, text_len);
+        if (text == nullptr) {
+            text_len = 0;
         }
         
         // Encode the text using the BPE algorithm
-        std::vector<int> tokens = wrapper->encoder->encode(text_str);
+        std::vector<int> tokens = wrapper->encoder->encode(text, text_len);
         
-        // Allocate memory for the result
-        *tokens_out = (tiktoken_token_t*)malloc(tokens.size() * sizeof(tiktoken_token_t));
+        // Allocate memory for the result (at least one element, so an empty
+        // result is still a valid pointer for the caller to free)
+        *tokens_out = (tiktoken_token_t*)malloc(std::max<size_t>(tokens.size(), 1) * sizeof(tiktoken_token_t));
         if (*tokens_out == nullptr) {
             return -1;
         }
         
         // Copy the tokens
-        std::memcpy(*tokens_out, tokens.data(), tokens.size() * sizeof(tiktoken_token_t));
+        if (!tokens.empty()) {
+            std::memcpy(*tokens_out, tokens.data(), tokens.size() * sizeof(tiktoken_token_t));
+        }
         
         return static_cast<int>(tokens.size());
     } catch (const std::exception& e) {
@@ -400,41 +622,198 @@ extern "C" int tiktoken_cpp_count(TiktokenWrapper* wrapper, const char* text, si
             return -1;
         }
 
-        // Create a string from the text
-        std::string text_str;
-        if (text != nullptr && text_len > 0) {
-            text_str.assign(text, text_len);
+        if (text == nullptr) {
+            return 0;
         }
         
-        // Encode and return the count
-        std::vector<int> tokens = wrapper->encoder->encode(text_str);
-        return static_cast<int>(tokens.size());
+        // Count in place: no copy of the text and no token IDs
+        tiktoken::CountScratch& scratch = thread_scratch();
+        size_t tokens = wrapper->encoder->count(text, text_len, scratch);
+        publish_cache_stats(scratch);
+        return static_cast<int>(tokens);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Exception in token counting: %s\n", e.what());
+        return -1;
+    }
+}
+
+// Count tokens of one large text on several threads
+extern "C" int tiktoken_cpp_count_parallel(TiktokenWrapper* wrapper, const char* text, size_t text_len, int threads) {
+    try {
+        if (wrapper == nullptr || wrapper->encoder == nullptr || !wrapper->initialized) {
+            return -1;
+        }
+        
+        if (text == nullptr) {
+            return 0;
+        }
+        
+        if (wrapper->encoder->isSpecialToken(text, text_len)) {
+            return 1;
+        }
+        return static_cast<int>(count_ordinary_parallel(*wrapper->encoder, text, text_len, threads));
     } catch (const std::exception& e) {
         fprintf(stderr, "Exception in token counting: %s\n", e.what());
         return -1;
     }
 }
 
+// Count tokens with the old length-based chunking instead of BPE merges.
+// Only tools/bench_tiktoken uses this, as the baseline it compares against.
+extern "C" int tiktoken_cpp_count_heuristic(TiktokenWrapper* wrapper, const char* text, size_t text_len) {
+    try {
+        if (wrapper == nullptr || wrapper->encoder == nullptr || !wrapper->initialized) {
+            return -1;
+        }
+        if (text == nullptr) {
+            return 0;
+        }
+        return static_cast<int>(wrapper->encoder->encode(text, text_len, true).size());
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Exception in token counting: %s\n", e.what());
+        return -1;
+    }
+}
+
+// Start counting text that arrives in chunks
+extern "C" TiktokenStream* tiktoken_cpp_stream_begin(TiktokenWrapper* wrapper) {
+    try {
+        if (wrapper == nullptr || wrapper->encoder == nullptr || !wrapper->initialized) {
+            return nullptr;
+        }
+        return new TiktokenStream{wrapper->encoder, std::string(), 0, false, 1};
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Exception starting token stream: %s\n", e.what());
+        return nullptr;
+    }
+}
+
+// Count the complete part of the text fed so far and keep the rest
+extern "C" int tiktoken_cpp_stream_feed(TiktokenStream* stream, const char* text, size_t text_len) {
+    try {
+        if (text_len == 0) {
+            return 0;
+        }
+        
+        // The first restart position, which may fall on the chunk's first
+        // byte when the held back text ends with a line feed
+        size_t first;
+        char seam[2] = {stream->pending.empty() ? '\0' : stream->pending.back(), text[0]};
+        if (pretokenize_next_boundary(seam, 2, 1) == 1) {
+            first = 0;
+        } else {
+            first = pretokenize_next_boundary(text, text_len, 1);
+        }
+        if (first == text_len) {
+            stream->pending.append(text, text_len);
+            return 0;
+        }
+        
+        // Complete the held back text, then count this chunk in place up to
+        // its last restart position
+        size_t last = first;
+        for (size_t next = pretokenize_next_boundary(text, text_len, first + 1); next < text_len;
+             next = pretokenize_next_boundary(text, text_len, next + 1)) {
+            last = next;
+        }
+        tiktoken::CountScratch& scratch = thread_scratch();
+        stream->pending.append(text, first);
+        stream->tokens += stream->encoder->count_ordinary(stream->pending.data(), stream->pending.size(), scratch);
+        publish_cache_stats(scratch);
+        stream->tokens += count_ordinary_parallel(*stream->encoder, text + first, last - first, stream->threads);
+        stream->pending.assign(text + last, text_len - last);
+        stream->cut = true;
+        return 0;
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Exception in token counting: %s\n", e.what());
+        return -1;
+    }
+}
+
+// Let a stream count large chunks on several threads
+extern "C" void tiktoken_cpp_stream_set_threads(TiktokenStream* stream, int threads) {
+    stream->threads = threads < 1 ? 1 : threads;
+}
+
+// Count the held back text, free the stream and return the total
+extern "C" int tiktoken_cpp_stream_finish(TiktokenStream* stream) {
+    int result;
+    try {
+        const char* rest = stream->pending.data();
+        size_t rest_len = stream->pending.size();
+        // Only text that was never cut can be a special token as a whole
+        tiktoken::CountScratch& scratch = thread_scratch();
+        size_t tokens = stream->cut ? stream->encoder->count_ordinary(rest, rest_len, scratch)
+                                    : stream->encoder->count(rest, rest_len, scratch);
+        publish_cache_stats(scratch);
+        result = static_cast<int>(stream->tokens + tokens);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Exception in token counting: %s\n", e.what());
+        result = -1;
+    }
+    delete stream;
+    return result;
+}
+
+// Report how often counting found a piece in the cache
+extern "C" int tiktoken_cpp_cache_stats(TiktokenWrapper* wrapper, size_t* lookups, size_t* hits) {
+    if (wrapper == nullptr || wrapper->encoder == nullptr || !wrapper->initialized) {
+        return -1;
+    }
+    *lookups = g_cache_lookups.load(std::memory_order_relaxed);
+    *hits = g_cache_hits.load(std::memory_order_relaxed);
+    return 0;
+}
+
+/**
+ * @brief FNV-1a over bytes, continuing from a previous hash.
+ *
+ * @param h Hash so far.
+ * @param data Bytes to add.
+ * @param len Number of bytes.
+ * @return uint64_t The new hash.
+ */
+static uint64_t fingerprint_bytes(uint64_t h, const void* data, size_t len) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < len; i++) {
+        h = (h ^ p[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+// Fingerprint of the compiled-in encoding: its name, vocabulary and special tokens
+extern "C" uint64_t tiktoken_cpp_vocab_fingerprint() {
+    static const uint64_t fingerprint = [] {
+        uint64_t h = 0xcbf29ce484222325ULL;
+        h = fingerprint_bytes(h, TIKTOKEN_ENCODER_NAME, sizeof(TIKTOKEN_ENCODER_NAME));
+        h = fingerprint_bytes(h, &TIKTOKEN_VOCAB_SIZE, sizeof(TIKTOKEN_VOCAB_SIZE));
+        h = fingerprint_bytes(h, tiktoken_token_bytes, sizeof(tiktoken_token_bytes));
+        h = fingerprint_bytes(h, tiktoken_token_offsets, sizeof(tiktoken_token_offsets));
+        h = fingerprint_bytes(h, tiktoken_token_ids, sizeof(tiktoken_token_ids));
+        for (size_t i = 0; i < TIKTOKEN_NUM_SPECIAL_TOKENS; i++) {
+            h = fingerprint_bytes(h, tiktoken_special_tokens[i].bytes, tiktoken_special_tokens[i].len);
+            h = fingerprint_bytes(h, &tiktoken_special_tokens[i].id, sizeof(int));
+        }
+        return h;
+    }();
+    return fingerprint;
+}
+
 // Free a tiktoken encoding
 extern "C" void tiktoken_cpp_free(TiktokenWrapper* wrapper) {
-    if (wrapper != nullptr && wrapper != g_default_tiktoken) {
-        if (wrapper->encoder != nullptr) {
-            delete wrapper->encoder;
-            wrapper->encoder = nullptr;
-        }
+    if (wrapper != nullptr && wrapper != g_default_tiktoken.load(std::memory_order_acquire)) {
+        delete wrapper->encoder;
         delete wrapper;
     }
 }
 
 // Clean up global resources on program exit
 extern "C" void tiktoken_cleanup() {
-    if (g_default_tiktoken != nullptr) {
-        if (g_default_tiktoken->encoder != nullptr) {
-            delete g_default_tiktoken->encoder;
-            g_default_tiktoken->encoder = nullptr;
-        }
-        delete g_default_tiktoken;
-        g_default_tiktoken = nullptr;
+    std::lock_guard<std::mutex> lock(g_init_mutex);
+    TiktokenWrapper* instance = g_default_tiktoken.exchange(nullptr);
+    if (instance != nullptr) {
+        delete instance->encoder;
+        delete instance;
     }
 }
 
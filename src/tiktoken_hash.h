@@ -0,0 +1,81 @@
+#ifndef TIKTOKEN_HASH_H
+#define TIKTOKEN_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Minimal perfect hash over the token vocabulary (CHD: compress, hash and
+ * displace). tools/generate_tiktoken_data assigns every token a distinct slot
+ * in [0, vocab_size) and stores, per bucket of keys, the displacement pair
+ * (d0, d1) that places all keys of the bucket:
+ *
+ *     slot = (f1 + d0 * f2 + d1) mod vocab_size
+ *
+ * The generator and the encoder must hash identically, so both use the
+ * functions below.
+ */
+
+// Hash values of one key
+typedef struct {
+    uint32_t bucket; // selects the displacement pair
+    uint32_t f1;
+    uint32_t f2;     // never 0 modulo the slot count
+} tiktoken_hash_t;
+
+/**
+ * @brief Final avalanche step of MurmurHash3.
+ *
+ * @param h Value to mix.
+ * @return uint64_t Mixed value.
+ */
+static inline uint64_t tiktoken_hash_mix(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief Hash a token's bytes for the CHD table.
+ *
+ * @param bytes Token bytes.
+ * @param len Number of bytes.
+ * @param buckets Number of displacement buckets.
+ * @param slots Number of slots (the vocabulary size).
+ * @return tiktoken_hash_t Bucket and the two slot hash values.
+ */
+static inline tiktoken_hash_t tiktoken_hash(const void *bytes, size_t len, uint32_t buckets, uint32_t slots) {
+    // FNV-1a: tokens are short, so a byte loop is fast enough
+    const unsigned char *p = (const unsigned char *)bytes;
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+    uint64_t h1 = tiktoken_hash_mix(h);
+    uint64_t h2 = tiktoken_hash_mix(h1 ^ 0x9e3779b97f4a7c15ULL);
+
+    tiktoken_hash_t r;
+    r.bucket = (uint32_t)((h1 >> 32) % buckets);
+    r.f1 = (uint32_t)(h1 % slots);
+    r.f2 = slots > 1 ? (uint32_t)(h2 % (slots - 1)) + 1 : 1;
+    return r;
+}
+
+/**
+ * @brief Slot of a key given its bucket's displacement pair.
+ *
+ * @param h Hash values of the key.
+ * @param d0 Multiplier displacement of the key's bucket.
+ * @param d1 Additive displacement of the key's bucket.
+ * @param slots Number of slots.
+ * @return uint32_t Slot in [0, slots).
+ */
+static inline uint32_t tiktoken_hash_slot(tiktoken_hash_t h, uint32_t d0, uint32_t d1, uint32_t slots) {
+    return (uint32_t)(((uint64_t)h.f1 + (uint64_t)d0 * h.f2 + d1) % slots);
+}
+
+#endif // TIKTOKEN_HASH_H
@@ -0,0 +1,3138 @@
+/*
+ * Generated by tools/generate_unicode_classes.py
+ * Source: Unicode 14.0.0 character database
+ * DO NOT EDIT MANUALLY!
+ */
+
+#ifndef UNICODE_CLASSES_H
+#define UNICODE_CLASSES_H
+
+#include <stddef.h> // For size_t
+
+// Character classes, one bit each so sets of them can be tested with a mask
+#define UC_OTHER   0x01 // anything not listed below
+#define UC_UPPER   0x02 // Lu, Lt
+#define UC_LOWER   0x04 // Ll
+#define UC_LETTER  0x08 // Lm, Lo
+#define UC_MARK    0x10 // Mn, Mc, Me
+#define UC_NUMBER  0x20 // Nd, Nl, No
+#define UC_SPACE   0x40 // White_Space except CR and LF
+#define UC_NEWLINE 0x80 // CR, LF
+
+// Class of every ASCII character
+static const unsigned char unicode_ascii_class[128] = {
+    UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER,
+    UC_OTHER, UC_SPACE, UC_NEWLINE, UC_SPACE, UC_SPACE, UC_NEWLINE, UC_OTHER, UC_OTHER,
+    UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER,
+    UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER,
+    UC_SPACE, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER,
+    UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER,
+    UC_NUMBER, UC_NUMBER, UC_NUMBER, UC_NUMBER, UC_NUMBER, UC_NUMBER, UC_NUMBER, UC_NUMBER,
+    UC_NUMBER, UC_NUMBER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER,
+    UC_OTHER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER,
+    UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER,
+    UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER, UC_UPPER,
+    UC_UPPER, UC_UPPER, UC_UPPER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER,
+    UC_OTHER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER,
+    UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER,
+    UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER, UC_LOWER,
+    UC_LOWER, UC_LOWER, UC_LOWER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER, UC_OTHER,
+};
+
+// Code points from `first` up to the next entry's `first` share a class
+typedef struct {
+    unsigned int first;
+    unsigned char cls;
+} unicode_class_range_t;
+
+static const unicode_class_range_t unicode_class_ranges[] = {
+    {0x0000, UC_OTHER},
+    {0x0009, UC_SPACE},
+    {0x000A, UC_NEWLINE},
+    {0x000B, UC_SPACE},
+    {0x000D, UC_NEWLINE},
+    {0x000E, UC_OTHER},
+    {0x0020, UC_SPACE},
+    {0x0021, UC_OTHER},
+    {0x0030, UC_NUMBER},
+    {0x003A, UC_OTHER},
+    {0x0041, UC_UPPER},
+    {0x005B, UC_OTHER},
+    {0x0061, UC_LOWER},
+    {0x007B, UC_OTHER},
+    {0x0085, UC_SPACE},
+    {0x0086, UC_OTHER},
+    {0x00A0, UC_SPACE},
+    {0x00A1, UC_OTHER},
+    {0x00AA, UC_LETTER},
+    {0x00AB, UC_OTHER},
+    {0x00B2, UC_NUMBER},
+    {0x00B4, UC_OTHER},
+    {0x00B5, UC_LOWER},
+    {0x00B6, UC_OTHER},
+    {0x00B9, UC_NUMBER},
+    {0x00BA, UC_LETTER},
+    {0x00BB, UC_OTHER},
+    {0x00BC, UC_NUMBER},
+    {0x00BF, UC_OTHER},
+    {0x00C0, UC_UPPER},
+    {0x00D7, UC_OTHER},
+    {0x00D8, UC_UPPER},
+    {0x00DF, UC_LOWER},
+    {0x00F7, UC_OTHER},
+    {0x00F8, UC_LOWER},
+    {0x0100, UC_UPPER},
+    {0x0101, UC_LOWER},
+    {0x0102, UC_UPPER},
+    {0x0103, UC_LOWER},
+    {0x0104, UC_UPPER},
+    {0x0105, UC_LOWER},
+    {0x0106, UC_UPPER},
+    {0x0107, UC_LOWER},
+    {0x0108, UC_UPPER},
+    {0x0109, UC_LOWER},
+    {0x010A, UC_UPPER},
+    {0x010B, UC_LOWER},
+    {0x010C, UC_UPPER},
+    {0x010D, UC_LOWER},
+    {0x010E, UC_UPPER},
+    {0x010F, UC_LOWER},
+    {0x0110, UC_UPPER},
+    {0x0111, UC_LOWER},
+    {0x0112, UC_UPPER},
+    {0x0113, UC_LOWER},
+    {0x0114, UC_UPPER},
+    {0x0115, UC_LOWER},
+    {0x0116, UC_UPPER},
+    {0x0117, UC_LOWER},
+    {0x0118, UC_UPPER},
+    {0x0119, UC_LOWER},
+    {0x011A, UC_UPPER},
+    {0x011B, UC_LOWER},
+    {0x011C, UC_UPPER},
+    {0x011D, UC_LOWER},
+    {0x011E, UC_UPPER},
+    {0x011F, UC_LOWER},
+    {0x0120, UC_UPPER},
+    {0x0121, UC_LOWER},
+    {0x0122, UC_UPPER},
+    {0x0123, UC_LOWER},
+    {0x0124, UC_UPPER},
+    {0x0125, UC_LOWER},
+    {0x0126, UC_UPPER},
+    {0x0127, UC_LOWER},
+    {0x0128, UC_UPPER},
+    {0x0129, UC_LOWER},
+    {0x012A, UC_UPPER},
+    {0x012B, UC_LOWER},
+    {0x012C, UC_UPPER},
+    {0x012D, UC_LOWER},
+    {0x012E, UC_UPPER},
+    {0x012F, UC_LOWER},
+    {0x0130, UC_UPPER},
+    {0x0131, UC_LOWER},
+    {0x0132, UC_UPPER},
+    {0x0133, UC_LOWER},
+    {0x0134, UC_UPPER},
+    {0x0135, UC_LOWER},
+    {0x0136, UC_UPPER},
+    {0x0137, UC_LOWER},
+    {0x0139, UC_UPPER},
+    {0x013A, UC_LOWER},
+    {0x013B, UC_UPPER},
+    {0x013C, UC_LOWER},
+    {0x013D, UC_UPPER},
+    {0x013E, UC_LOWER},
+    {0x013F, UC_UPPER},
+    {0x0140, UC_LOWER},
+    {0x0141, UC_UPPER},
+    {0x0142, UC_LOWER},
+    {0x0143, UC_UPPER},
+    {0x0144, UC_LOWER},
+    {0x0145, UC_UPPER},
+    {0x0146, UC_LOWER},
+    {0x0147, UC_UPPER},
+    {0x0148, UC_LOWER},
+    {0x014A, UC_UPPER},
+    {0x014B, UC_LOWER},
+    {0x014C, UC_UPPER},
+    {0x014D, UC_LOWER},
+    {0x014E, UC_UPPER},
+    {0x014F, UC_LOWER},
+    {0x0150, UC_UPPER},
+    {0x0151, UC_LOWER},
+    {0x0152, UC_UPPER},
+    {0x0153, UC_LOWER},
+    {0x0154, UC_UPPER},
+    {0x0155, UC_LOWER},
+    {0x0156, UC_UPPER},
+    {0x0157, UC_LOWER},
+    {0x0158, UC_UPPER},
+    {0x0159, UC_LOWER},
+    {0x015A, UC_UPPER},
+    {0x015B, UC_LOWER},
+    {0x015C, UC_UPPER},
+    {0x015D, UC_LOWER},
+    {0x015E, UC_UPPER},
+    {0x015F, UC_LOWER},
+    {0x0160, UC_UPPER},
+    {0x0161, UC_LOWER},
+    {0x0162, UC_UPPER},
+    {0x0163, UC_LOWER},
+    {0x0164, UC_UPPER},
+    {0x0165, UC_LOWER},
+    {0x0166, UC_UPPER},
+    {0x0167, UC_LOWER},
+    {0x0168, UC_UPPER},
+    {0x0169, UC_LOWER},
+    {0x016A, UC_UPPER},
+    {0x016B, UC_LOWER},
+    {0x016C, UC_UPPER},
+    {0x016D, UC_LOWER},
+    {0x016E, UC_UPPER},
+    {0x016F, UC_LOWER},
+    {0x0170, UC_UPPER},
+    {0x0171, UC_LOWER},
+    {0x0172, UC_UPPER},
+    {0x0173, UC_LOWER},
+    {0x0174, UC_UPPER},
+    {0x0175, UC_LOWER},
+    {0x0176, UC_UPPER},
+    {0x0177, UC_LOWER},
+    {0x0178, UC_UPPER},
+    {0x017A, UC_LOWER},
+    {0x017B, UC_UPPER},
+    {0x017C, UC_LOWER},
+    {0x017D, UC_UPPER},
+    {0x017E, UC_LOWER},
+    {0x0181, UC_UPPER},
+    {0x0183, UC_LOWER},
+    {0x0184, UC_UPPER},
+    {0x0185, UC_LOWER},
+    {0x0186, UC_UPPER},
+    {0x0188, UC_LOWER},
+    {0x0189, UC_UPPER},
+    {0x018C, UC_LOWER},
+    {0x018E, UC_UPPER},
+    {0x0192, UC_LOWER},
+    {0x0193, UC_UPPER},
+    {0x0195, UC_LOWER},
+    {0x0196, UC_UPPER},
+    {0x0199, UC_LOWER},
+    {0x019C, UC_UPPER},
+    {0x019E, UC_LOWER},
+    {0x019F, UC_UPPER},
+    {0x01A1, UC_LOWER},
+    {0x01A2, UC_UPPER},
+    {0x01A3, UC_LOWER},
+    {0x01A4, UC_UPPER},
+    {0x01A5, UC_LOWER},
+    {0x01A6, UC_UPPER},
+    {0x01A8, UC_LOWER},
+    {0x01A9, UC_UPPER},
+    {0x01AA, UC_LOWER},
+    {0x01AC, UC_UPPER},
+    {0x01AD, UC_LOWER},
+    {0x01AE, UC_UPPER},
+    {0x01B0, UC_LOWER},
+    {0x01B1, UC_UPPER},
+    {0x01B4, UC_LOWER},
+    {0x01B5, UC_UPPER},
+    {0x01B6, UC_LOWER},
+    {0x01B7, UC_UPPER},
+    {0x01B9, UC_LOWER},
+    {0x01BB, UC_LETTER},
+    {0x01BC, UC_UPPER},
+    {0x01BD, UC_LOWER},
+    {0x01C0, UC_LETTER},
+    {0x01C4, UC_UPPER},
+    {0x01C6, UC_LOWER},
+    {0x01C7, UC_UPPER},
+    {0x01C9, UC_LOWER},
+    {0x01CA, UC_UPPER},
+    {0x01CC, UC_LOWER},
+    {0x01CD, UC_UPPER},
+    {0x01CE, UC_LOWER},
+    {0x01CF, UC_UPPER},
+    {0x01D0, UC_LOWER},
+    {0x01D1, UC_UPPER},
+    {0x01D2, UC_LOWER},
+    {0x01D3, UC_UPPER},
+    {0x01D4, UC_LOWER},
+    {0x01D5, UC_UPPER},
+    {0x01D6, UC_LOWER},
+    {0x01D7, UC_UPPER},
+    {0x01D8, UC_LOWER},
+    {0x01D9, UC_UPPER},
+    {0x01DA, UC_LOWER},
+    {0x01DB, UC_UPPER},
+    {0x01DC, UC_LOWER},
+    {0x01DE, UC_UPPER},
+    {0x01DF, UC_LOWER},
+    {0x01E0, UC_UPPER},
+    {0x01E1, UC_LOWER},
+    {0x01E2, UC_UPPER},
+    {0x01E3, UC_LOWER},
+    {0x01E4, UC_UPPER},
+    {0x01E5, UC_LOWER},
+    {0x01E6, UC_UPPER},
+    {0x01E7, UC_LOWER},
+    {0x01E8, UC_UPPER},
+    {0x01E9, UC_LOWER},
+    {0x01EA, UC_UPPER},
+    {0x01EB, UC_LOWER},
+    {0x01EC, UC_UPPER},
+    {0x01ED, UC_LOWER},
+    {0x01EE, UC_UPPER},
+    {0x01EF, UC_LOWER},
+    {0x01F1, UC_UPPER},
+    {0x01F3, UC_LOWER},
+    {0x01F4, UC_UPPER},
+    {0x01F5, UC_LOWER},
+    {0x01F6, UC_UPPER},
+    {0x01F9, UC_LOWER},
+    {0x01FA, UC_UPPER},
+    {0x01FB, UC_LOWER},
+    {0x01FC, UC_UPPER},
+    {0x01FD, UC_LOWER},
+    {0x01FE, UC_UPPER},
+    {0x01FF, UC_LOWER},
+    {0x0200, UC_UPPER},
+    {0x0201, UC_LOWER},
+    {0x0202, UC_UPPER},
+    {0x0203, UC_LOWER},
+    {0x0204, UC_UPPER},
+    {0x0205, UC_LOWER},
+    {0x0206, UC_UPPER},
+    {0x0207, UC_LOWER},
+    {0x0208, UC_UPPER},
+    {0x0209, UC_LOWER},
+    {0x020A, UC_UPPER},
+    {0x020B, UC_LOWER},
+    {0x020C, UC_UPPER},
+    {0x020D, UC_LOWER},
+    {0x020E, UC_UPPER},
+    {0x020F, UC_LOWER},
+    {0x0210, UC_UPPER},
+    {0x0211, UC_LOWER},
+    {0x0212, UC_UPPER},
+    {0x0213, UC_LOWER},
+    {0x0214, UC_UPPER},
+    {0x0215, UC_LOWER},
+    {0x0216, UC_UPPER},
+    {0x0217, UC_LOWER},
+    {0x0218, UC_UPPER},
+    {0x0219, UC_LOWER},
+    {0x021A, UC_UPPER},
+    {0x021B, UC_LOWER},
+    {0x021C, UC_UPPER},
+    {0x021D, UC_LOWER},
+    {0x021E, UC_UPPER},
+    {0x021F, UC_LOWER},
+    {0x0220, UC_UPPER},
+    {0x0221, UC_LOWER},
+    {0x0222, UC_UPPER},
+    {0x0223, UC_LOWER},
+    {0x0224, UC_UPPER},
+    {0x0225, UC_LOWER},
+    {0x0226, UC_UPPER},
+    {0x0227, UC_LOWER},
+    {0x0228, UC_UPPER},
+    {0x0229, UC_LOWER},
+    {0x022A, UC_UPPER},
+    {0x022B, UC_LOWER},
+    {0x022C, UC_UPPER},
+    {0x022D, UC_LOWER},
+    {0x022E, UC_UPPER},
+    {0x022F, UC_LOWER},
+    {0x0230, UC_UPPER},
+    {0x0231, UC_LOWER},
+    {0x0232, UC_UPPER},
+    {0x0233, UC_LOWER},
+    {0x023A, UC_UPPER},
+    {0x023C, UC_LOWER},
+    {0x023D, UC_UPPER},
+    {0x023F, UC_LOWER},
+    {0x0241, UC_UPPER},
+    {0x0242, UC_LOWER},
+    {0x0243, UC_UPPER},
+    {0x0247, UC_LOWER},
+    {0x0248, UC_UPPER},
+    {0x0249, UC_LOWER},
+    {0x024A, UC_UPPER},
+    {0x024B, UC_LOWER},
+    {0x024C, UC_UPPER},
+    {0x024D, UC_LOWER},
+    {0x024E, UC_UPPER},
+    {0x024F, UC_LOWER},
+    {0x0294, UC_LETTER},
+    {0x0295, UC_LOWER},
+    {0x02B0, UC_LETTER},
+    {0x02C2, UC_OTHER},
+    {0x02C6, UC_LETTER},
+    {0x02D2, UC_OTHER},
+    {0x02E0, UC_LETTER},
+    {0x02E5, UC_OTHER},
+    {0x02EC, UC_LETTER},
+    {0x02ED, UC_OTHER},
+    {0x02EE, UC_LETTER},
+    {0x02EF, UC_OTHER},
+    {0x0300, UC_MARK},
+    {0x0370, UC_UPPER},
+    {0x0371, UC_LOWER},
+    {0x0372, UC_UPPER},
+    {0x0373, UC_LOWER},
+    {0x0374, UC_LETTER},
+    {0x0375, UC_OTHER},
+    {0x0376, UC_UPPER},
+    {0x0377, UC_LOWER},
+    {0x0378, UC_OTHER},
+    {0x037A, UC_LETTER},
+    {0x037B, UC_LOWER},
+    {0x037E, UC_OTHER},
+    {0x037F, UC_UPPER},
+    {0x0380, UC_OTHER},
+    {0x0386, UC_UPPER},
+    {0x0387, UC_OTHER},
+    {0x0388, UC_UPPER},
+    {0x038B, UC_OTHER},
+    {0x038C, UC_UPPER},
+    {0x038D, UC_OTHER},
+    {0x038E, UC_UPPER},
+    {0x0390, UC_LOWER},
+    {0x0391, UC_UPPER},
+    {0x03A2, UC_OTHER},
+    {0x03A3, UC_UPPER},
+    {0x03AC, UC_LOWER},
+    {0x03CF, UC_UPPER},
+    {0x03D0, UC_LOWER},
+    {0x03D2, UC_UPPER},
+    {0x03D5, UC_LOWER},
+    {0x03D8, UC_UPPER},
+    {0x03D9, UC_LOWER},
+    {0x03DA, UC_UPPER},
+    {0x03DB, UC_LOWER},
+    {0x03DC, UC_UPPER},
+    {0x03DD, UC_LOWER},
+    {0x03DE, UC_UPPER},
+    {0x03DF, UC_LOWER},
+    {0x03E0, UC_UPPER},
+    {0x03E1, UC_LOWER},
+    {0x03E2, UC_UPPER},
+    {0x03E3, UC_LOWER},
+    {0x03E4, UC_UPPER},
+    {0x03E5, UC_LOWER},
+    {0x03E6, UC_UPPER},
+    {0x03E7, UC_LOWER},
+    {0x03E8, UC_UPPER},
+    {0x03E9, UC_LOWER},
+    {0x03EA, UC_UPPER},
+    {0x03EB, UC_LOWER},
+    {0x03EC, UC_UPPER},
+    {0x03ED, UC_LOWER},
+    {0x03EE, UC_UPPER},
+    {0x03EF, UC_LOWER},
+    {0x03F4, UC_UPPER},
+    {0x03F5, UC_LOWER},
+    {0x03F6, UC_OTHER},
+    {0x03F7, UC_UPPER},
+    {0x03F8, UC_LOWER},
+    {0x03F9, UC_UPPER},
+    {0x03FB, UC_LOWER},
+    {0x03FD, UC_UPPER},
+    {0x0430, UC_LOWER},
+    {0x0460, UC_UPPER},
+    {0x0461, UC_LOWER},
+    {0x0462, UC_UPPER},
+    {0x0463, UC_LOWER},
+    {0x0464, UC_UPPER},
+    {0x0465, UC_LOWER},
+    {0x0466, UC_UPPER},
+    {0x0467, UC_LOWER},
+    {0x0468, UC_UPPER},
+    {0x0469, UC_LOWER},
+    {0x046A, UC_UPPER},
+    {0x046B, UC_LOWER},
+    {0x046C, UC_UPPER},
+    {0x046D, UC_LOWER},
+    {0x046E, UC_UPPER},
+    {0x046F, UC_LOWER},
+    {0x0470, UC_UPPER},
+    {0x0471, UC_LOWER},
+    {0x0472, UC_UPPER},
+    {0x0473, UC_LOWER},
+    {0x0474, UC_UPPER},
+    {0x0475, UC_LOWER},
+    {0x0476, UC_UPPER},
+    {0x0477, UC_LOWER},
+    {0x0478, UC_UPPER},
+    {0x0479, UC_LOWER},
+    {0x047A, UC_UPPER},
+    {0x047B, UC_LOWER},
+    {0x047C, UC_UPPER},
+    {0x047D, UC_LOWER},
+    {0x047E, UC_UPPER},
+    {0x047F, UC_LOWER},
+    {0x0480, UC_UPPER},
+    {0x0481, UC_LOWER},
+    {0x0482, UC_OTHER},
+    {0x0483, UC_MARK},
+    {0x048A, UC_UPPER},
+    {0x048B, UC_LOWER},
+    {0x048C, UC_UPPER},
+    {0x048D, UC_LOWER},
+    {0x048E, UC_UPPER},
+    {0x048F, UC_LOWER},
+    {0x0490, UC_UPPER},
+    {0x0491, UC_LOWER},
+    {0x0492, UC_UPPER},
+    {0x0493, UC_LOWER},
+    {0x0494, UC_UPPER},
+    {0x0495, UC_LOWER},
+    {0x0496, UC_UPPER},
+    {0x0497, UC_LOWER},
+    {0x0498, UC_UPPER},
+    {0x0499, UC_LOWER},
+    {0x049A, UC_UPPER},
+    {0x049B, UC_LOWER},
+    {0x049C, UC_UPPER},
+    {0x049D, UC_LOWER},
+    {0x049E, UC_UPPER},
+    {0x049F, UC_LOWER},
+    {0x04A0, UC_UPPER},
+    {0x04A1, UC_LOWER},
+    {0x04A2, UC_UPPER},
+    {0x04A3, UC_LOWER},
+    {0x04A4, UC_UPPER},
+    {0x04A5, UC_LOWER},
+    {0x04A6, UC_UPPER},
+    {0x04A7, UC_LOWER},
+    {0x04A8, UC_UPPER},
+    {0x04A9, UC_LOWER},
+    {0x04AA, UC_UPPER},
+    {0x04AB, UC_LOWER},
+    {0x04AC, UC_UPPER},
+    {0x04AD, UC_LOWER},
+    {0x04AE, UC_UPPER},
+    {0x04AF, UC_LOWER},
+    {0x04B0, UC_UPPER},
+    {0x04B1, UC_LOWER},
+    {0x04B2, UC_UPPER},
+    {0x04B3, UC_LOWER},
+    {0x04B4, UC_UPPER},
+    {0x04B5, UC_LOWER},
+    {0x04B6, UC_UPPER},
+    {0x04B7, UC_LOWER},
+    {0x04B8, UC_UPPER},
+    {0x04B9, UC_LOWER},
+    {0x04BA, UC_UPPER},
+    {0x04BB, UC_LOWER},
+    {0x04BC, UC_UPPER},
+    {0x04BD, UC_LOWER},
+    {0x04BE, UC_UPPER},
+    {0x04BF, UC_LOWER},
+    {0x04C0, UC_UPPER},
+    {0x04C2, UC_LOWER},
+    {0x04C3, UC_UPPER},
+    {0x04C4, UC_LOWER},
+    {0x04C5, UC_UPPER},
+    {0x04C6, UC_LOWER},
+    {0x04C7, UC_UPPER},
+    {0x04C8, UC_LOWER},
+    {0x04C9, UC_UPPER},
+    {0x04CA, UC_LOWER},
+    {0x04CB, UC_UPPER},
+    {0x04CC, UC_LOWER},
+    {0x04CD, UC_UPPER},
+    {0x04CE, UC_LOWER},
+    {0x04D0, UC_UPPER},
+    {0x04D1, UC_LOWER},
+    {0x04D2, UC_UPPER},
+    {0x04D3, UC_LOWER},
+    {0x04D4, UC_UPPER},
+    {0x04D5, UC_LOWER},
+    {0x04D6, UC_UPPER},
+    {0x04D7, UC_LOWER},
+    {0x04D8, UC_UPPER},
+    {0x04D9, UC_LOWER},
+    {0x04DA, UC_UPPER},
+    {0x04DB, UC_LOWER},
+    {0x04DC, UC_UPPER},
+    {0x04DD, UC_LOWER},
+    {0x04DE, UC_UPPER},
+    {0x04DF, UC_LOWER},
+    {0x04E0, UC_UPPER},
+    {0x04E1, UC_LOWER},
+    {0x04E2, UC_UPPER},
+    {0x04E3, UC_LOWER},
+    {0x04E4, UC_UPPER},
+    {0x04E5, UC_LOWER},
+    {0x04E6, UC_UPPER},
+    {0x04E7, UC_LOWER},
+    {0x04E8, UC_UPPER},
+    {0x04E9, UC_LOWER},
+    {0x04EA, UC_UPPER},
+    {0x04EB, UC_LOWER},
+    {0x04EC, UC_UPPER},
+    {0x04ED, UC_LOWER},
+    {0x04EE, UC_UPPER},
+    {0x04EF, UC_LOWER},
+    {0x04F0, UC_UPPER},
+    {0x04F1, UC_LOWER},
+    {0x04F2, UC_UPPER},
+    {0x04F3, UC_LOWER},
+    {0x04F4, UC_UPPER},
+    {0x04F5, UC_LOWER},
+    {0x04F6, UC_UPPER},
+    {0x04F7, UC_LOWER},
+    {0x04F8, UC_UPPER},
+    {0x04F9, UC_LOWER},
+    {0x04FA, UC_UPPER},
+    {0x04FB, UC_LOWER},
+    {0x04FC, UC_UPPER},
+    {0x04FD, UC_LOWER},
+    {0x04FE, UC_UPPER},
+    {0x04FF, UC_LOWER},
+    {0x0500, UC_UPPER},
+    {0x0501, UC_LOWER},
+    {0x0502, UC_UPPER},
+    {0x0503, UC_LOWER},
+    {0x0504, UC_UPPER},
+    {0x0505, UC_LOWER},
+    {0x0506, UC_UPPER},
+    {0x0507, UC_LOWER},
+    {0x0508, UC_UPPER},
+    {0x0509, UC_LOWER},
+    {0x050A, UC_UPPER},
+    {0x050B, UC_LOWER},
+    {0x050C, UC_UPPER},
+    {0x050D, UC_LOWER},
+    {0x050E, UC_UPPER},
+    {0x050F, UC_LOWER},
+    {0x0510, UC_UPPER},
+    {0x0511, UC_LOWER},
+    {0x0512, UC_UPPER},
+    {0x0513, UC_LOWER},
+    {0x0514, UC_UPPER},
+    {0x0515, UC_LOWER},
+    {0x0516, UC_UPPER},
+    {0x0517, UC_LOWER},
+    {0x0518, UC_UPPER},
+    {0x0519, UC_LOWER},
+    {0x051A, UC_UPPER},
+    {0x051B, UC_LOWER},
+    {0x051C, UC_UPPER},
+    {0x051D, UC_LOWER},
+    {0x051E, UC_UPPER},
+    {0x051F, UC_LOWER},
+    {0x0520, UC_UPPER},
+    {0x0521, UC_LOWER},
+    {0x0522, UC_UPPER},
+    {0x0523, UC_LOWER},
+    {0x0524, UC_UPPER},
+    {0x0525, UC_LOWER},
+    {0x0526, UC_UPPER},
+    {0x0527, UC_LOWER},
+    {0x0528, UC_UPPER},
+    {0x0529, UC_LOWER},
+    {0x052A, UC_UPPER},
+    {0x052B, UC_LOWER},
+    {0x052C, UC_UPPER},
+    {0x052D, UC_LOWER},
+    {0x052E, UC_UPPER},
+    {0x052F, UC_LOWER},
+    {0x0530, UC_OTHER},
+    {0x0531, UC_UPPER},
+    {0x0557, UC_OTHER},
+    {0x0559, UC_LETTER},
+    {0x055A, UC_OTHER},
+    {0x0560, UC_LOWER},
+    {0x0589, UC_OTHER},
+    {0x0591, UC_MARK},
+    {0x05BE, UC_OTHER},
+    {0x05BF, UC_MARK},
+    {0x05C0, UC_OTHER},
+    {0x05C1, UC_MARK},
+    {0x05C3, UC_OTHER},
+    {0x05C4, UC_MARK},
+    {0x05C6, UC_OTHER},
+    {0x05C7, UC_MARK},
+    {0x05C8, UC_OTHER},
+    {0x05D0, UC_LETTER},
+    {0x05EB, UC_OTHER},
+    {0x05EF, UC_LETTER},
+    {0x05F3, UC_OTHER},
+    {0x0610, UC_MARK},
+    {0x061B, UC_OTHER},
+    {0x0620, UC_LETTER},
+    {0x064B, UC_MARK},
+    {0x0660, UC_NUMBER},
+    {0x066A, UC_OTHER},
+    {0x066E, UC_LETTER},
+    {0x0670, UC_MARK},
+    {0x0671, UC_LETTER},
+    {0x06D4, UC_OTHER},
+    {0x06D5, UC_LETTER},
+    {0x06D6, UC_MARK},
+    {0x06DD, UC_OTHER},
+    {0x06DF, UC_MARK},
+    {0x06E5, UC_LETTER},
+    {0x06E7, UC_MARK},
+    {0x06E9, UC_OTHER},
+    {0x06EA, UC_MARK},
+    {0x06EE, UC_LETTER},
+    {0x06F0, UC_NUMBER},
+    {0x06FA, UC_LETTER},
+    {0x06FD, UC_OTHER},
+    {0x06FF, UC_LETTER},
+    {0x0700, UC_OTHER},
+    {0x0710, UC_LETTER},
+    {0x0711, UC_MARK},
+    {0x0712, UC_LETTER},
+    {0x0730, UC_MARK},
+    {0x074B, UC_OTHER},
+    {0x074D, UC_LETTER},
+    {0x07A6, UC_MARK},
+    {0x07B1, UC_LETTER},
+    {0x07B2, UC_OTHER},
+    {0x07C0, UC_NUMBER},
+    {0x07CA, UC_LETTER},
+    {0x07EB, UC_MARK},
+    {0x07F4, UC_LETTER},
+    {0x07F6, UC_OTHER},
+    {0x07FA, UC_LETTER},
+    {0x07FB, UC_OTHER},
+    {0x07FD, UC_MARK},
+    {0x07FE, UC_OTHER},
+    {0x0800, UC_LETTER},
+    {0x0816, UC_MARK},
+    {0x081A, UC_LETTER},
+    {0x081B, UC_MARK},
+    {0x0824, UC_LETTER},
+    {0x0825, UC_MARK},
+    {0x0828, UC_LETTER},
+    {0x0829, UC_MARK},
+    {0x082E, UC_OTHER},
+    {0x0840, UC_LETTER},
+    {0x0859, UC_MARK},
+    {0x085C, UC_OTHER},
+    {0x0860, UC_LETTER},
+    {0x086B, UC_OTHER},
+    {0x0870, UC_LETTER},
+    {0x0888, UC_OTHER},
+    {0x0889, UC_LETTER},
+    {0x088F, UC_OTHER},
+    {0x0898, UC_MARK},
+    {0x08A0, UC_LETTER},
+    {0x08CA, UC_MARK},
+    {0x08E2, UC_OTHER},
+    {0x08E3, UC_MARK},
+    {0x0904, UC_LETTER},
+    {0x093A, UC_MARK},
+    {0x093D, UC_LETTER},
+    {0x093E, UC_MARK},
+    {0x0950, UC_LETTER},
+    {0x0951, UC_MARK},
+    {0x0958, UC_LETTER},
+    {0x0962, UC_MARK},
+    {0x0964, UC_OTHER},
+    {0x0966, UC_NUMBER},
+    {0x0970, UC_OTHER},
+    {0x0971, UC_LETTER},
+    {0x0981, UC_MARK},
+    {0x0984, UC_OTHER},
+    {0x0985, UC_LETTER},
+    {0x098D, UC_OTHER},
+    {0x098F, UC_LETTER},
+    {0x0991, UC_OTHER},
+    {0x0993, UC_LETTER},
+    {0x09A9, UC_OTHER},
+    {0x09AA, UC_LETTER},
+    {0x09B1, UC_OTHER},
+    {0x09B2, UC_LETTER},
+    {0x09B3, UC_OTHER},
+    {0x09B6, UC_LETTER},
+    {0x09BA, UC_OTHER},
+    {0x09BC, UC_MARK},
+    {0x09BD, UC_LETTER},
+    {0x09BE, UC_MARK},
+    {0x09C5, UC_OTHER},
+    {0x09C7, UC_MARK},
+    {0x09C9, UC_OTHER},
+    {0x09CB, UC_MARK},
+    {0x09CE, UC_LETTER},
+    {0x09CF, UC_OTHER},
+    {0x09D7, UC_MARK},
+    {0x09D8, UC_OTHER},
+    {0x09DC, UC_LETTER},
+    {0x09DE, UC_OTHER},
+    {0x09DF, UC_LETTER},
+    {0x09E2, UC_MARK},
+    {0x09E4, UC_OTHER},
+    {0x09E6, UC_NUMBER},
+    {0x09F0, UC_LETTER},
+    {0x09F2, UC_OTHER},
+    {0x09F4, UC_NUMBER},
+    {0x09FA, UC_OTHER},
+    {0x09FC, UC_LETTER},
+    {0x09FD, UC_OTHER},
+    {0x09FE, UC_MARK},
+    {0x09FF, UC_OTHER},
+    {0x0A01, UC_MARK},
+    {0x0A04, UC_OTHER},
+    {0x0A05, UC_LETTER},
+    {0x0A0B, UC_OTHER},
+    {0x0A0F, UC_LETTER},
+    {0x0A11, UC_OTHER},
+    {0x0A13, UC_LETTER},
+    {0x0A29, UC_OTHER},
+    {0x0A2A, UC_LETTER},
+    {0x0A31, UC_OTHER},
+    {0x0A32, UC_LETTER},
+    {0x0A34, UC_OTHER},
+    {0x0A35, UC_LETTER},
+    {0x0A37, UC_OTHER},
+    {0x0A38, UC_LETTER},
+    {0x0A3A, UC_OTHER},
+    {0x0A3C, UC_MARK},
+    {0x0A3D, UC_OTHER},
+    {0x0A3E, UC_MARK},
+    {0x0A43, UC_OTHER},
+    {0x0A47, UC_MARK},
+    {0x0A49, UC_OTHER},
+    {0x0A4B, UC_MARK},
+    {0x0A4E, UC_OTHER},
+    {0x0A51, UC_MARK},
+    {0x0A52, UC_OTHER},
+    {0x0A59, UC_LETTER},
+    {0x0A5D, UC_OTHER},
+    {0x0A5E, UC_LETTER},
+    {0x0A5F, UC_OTHER},
+    {0x0A66, UC_NUMBER},
+    {0x0A70, UC_MARK},
+    {0x0A72, UC_LETTER},
+    {0x0A75, UC_MARK},
+    {0x0A76, UC_OTHER},
+    {0x0A81, UC_MARK},
+    {0x0A84, UC_OTHER},
+    {0x0A85, UC_LETTER},
+    {0x0A8E, UC_OTHER},
+    {0x0A8F, UC_LETTER},
+    {0x0A92, UC_OTHER},
+    {0x0A93, UC_LETTER},
+    {0x0AA9, UC_OTHER},
+    {0x0AAA, UC_LETTER},
+    {0x0AB1, UC_OTHER},
+    {0x0AB2, UC_LETTER},
+    {0x0AB4, UC_OTHER},
+    {0x0AB5, UC_LETTER},
+    {0x0ABA, UC_OTHER},
+    {0x0ABC, UC_MARK},
+    {0x0ABD, UC_LETTER},
+    {0x0ABE, UC_MARK},
+    {0x0AC6, UC_OTHER},
+    {0x0AC7, UC_MARK},
+    {0x0ACA, UC_OTHER},
+    {0x0ACB, UC_MARK},
+    {0x0ACE, UC_OTHER},
+    {0x0AD0, UC_LETTER},
+    {0x0AD1, UC_OTHER},
+    {0x0AE0, UC_LETTER},
+    {0x0AE2, UC_MARK},
+    {0x0AE4, UC_OTHER},
+    {0x0AE6, UC_NUMBER},
+    {0x0AF0, UC_OTHER},
+    {0x0AF9, UC_LETTER},
+    {0x0AFA, UC_MARK},
+    {0x0B00, UC_OTHER},
+    {0x0B01, UC_MARK},
+    {0x0B04, UC_OTHER},
+    {0x0B05, UC_LETTER},
+    {0x0B0D, UC_OTHER},
+    {0x0B0F, UC_LETTER},
+    {0x0B11, UC_OTHER},
+    {0x0B13, UC_LETTER},
+    {0x0B29, UC_OTHER},
+    {0x0B2A, UC_LETTER},
+    {0x0B31, UC_OTHER},
+    {0x0B32, UC_LETTER},
+    {0x0B34, UC_OTHER},
+    {0x0B35, UC_LETTER},
+    {0x0B3A, UC_OTHER},
+    {0x0B3C, UC_MARK},
+    {0x0B3D, UC_LETTER},
+    {0x0B3E, UC_MARK},
+    {0x0B45, UC_OTHER},
+    {0x0B47, UC_MARK},
+    {0x0B49, UC_OTHER},
+    {0x0B4B, UC_MARK},
+    {0x0B4E, UC_OTHER},
+    {0x0B55, UC_MARK},
+    {0x0B58, UC_OTHER},
+    {0x0B5C, UC_LETTER},
+    {0x0B5E, UC_OTHER},
+    {0x0B5F, UC_LETTER},
+    {0x0B62, UC_MARK},
+    {0x0B64, UC_OTHER},
+    {0x0B66, UC_NUMBER},
+    {0x0B70, UC_OTHER},
+    {0x0B71, UC_LETTER},
+    {0x0B72, UC_NUMBER},
+    {0x0B78, UC_OTHER},
+    {0x0B82, UC_MARK},
+    {0x0B83, UC_LETTER},
+    {0x0B84, UC_OTHER},
+    {0x0B85, UC_LETTER},
+    {0x0B8B, UC_OTHER},
+    {0x0B8E, UC_LETTER},
+    {0x0B91, UC_OTHER},
+    {0x0B92, UC_LETTER},
+    {0x0B96, UC_OTHER},
+    {0x0B99, UC_LETTER},
+    {0x0B9B, UC_OTHER},
+    {0x0B9C, UC_LETTER},
+    {0x0B9D, UC_OTHER},
+    {0x0B9E, UC_LETTER},
+    {0x0BA0, UC_OTHER},
+    {0x0BA3, UC_LETTER},
+    {0x0BA5, UC_OTHER},
+    {0x0BA8, UC_LETTER},
+    {0x0BAB, UC_OTHER},
+    {0x0BAE, UC_LETTER},
+    {0x0BBA, UC_OTHER},
+    {0x0BBE, UC_MARK},
+    {0x0BC3, UC_OTHER},
+    {0x0BC6, UC_MARK},
+    {0x0BC9, UC_OTHER},
+    {0x0BCA, UC_MARK},
+    {0x0BCE, UC_OTHER},
+    {0x0BD0, UC_LETTER},
+    {0x0BD1, UC_OTHER},
+    {0x0BD7, UC_MARK},
+    {0x0BD8, UC_OTHER},
+    {0x0BE6, UC_NUMBER},
+    {0x0BF3, UC_OTHER},
+    {0x0C00, UC_MARK},
+    {0x0C05, UC_LETTER},
+    {0x0C0D, UC_OTHER},
+    {0x0C0E, UC_LETTER},
+    {0x0C11, UC_OTHER},
+    {0x0C12, UC_LETTER},
+    {0x0C29, UC_OTHER},
+    {0x0C2A, UC_LETTER},
+    {0x0C3A, UC_OTHER},
+    {0x0C3C, UC_MARK},
+    {0x0C3D, UC_LETTER},
+    {0x0C3E, UC_MARK},
+    {0x0C45, UC_OTHER},
+    {0x0C46, UC_MARK},
+    {0x0C49, UC_OTHER},
+    {0x0C4A, UC_MARK},
+    {0x0C4E, UC_OTHER},
+    {0x0C55, UC_MARK},
+    {0x0C57, UC_OTHER},
+    {0x0C58, UC_LETTER},
+    {0x0C5B, UC_OTHER},
+    {0x0C5D, UC_LETTER},
+    {0x0C5E, UC_OTHER},
+    {0x0C60, UC_LETTER},
+    {0x0C62, UC_MARK},
+    {0x0C64, UC_OTHER},
+    {0x0C66, UC_NUMBER},
+    {0x0C70, UC_OTHER},
+    {0x0C78, UC_NUMBER},
+    {0x0C7F, UC_OTHER},
+    {0x0C80, UC_LETTER},
+    {0x0C81, UC_MARK},
+    {0x0C84, UC_OTHER},
+    {0x0C85, UC_LETTER},
+    {0x0C8D, UC_OTHER},
+    {0x0C8E, UC_LETTER},
+    {0x0C91, UC_OTHER},
+    {0x0C92, UC_LETTER},
+    {0x0CA9, UC_OTHER},
+    {0x0CAA, UC_LETTER},
+    {0x0CB4, UC_OTHER},
+    {0x0CB5, UC_LETTER},
+    {0x0CBA, UC_OTHER},
+    {0x0CBC, UC_MARK},
+    {0x0CBD, UC_LETTER},
+    {0x0CBE, UC_MARK},
+    {0x0CC5, UC_OTHER},
+    {0x0CC6, UC_MARK},
+    {0x0CC9, UC_OTHER},
+    {0x0CCA, UC_MARK},
+    {0x0CCE, UC_OTHER},
+    {0x0CD5, UC_MARK},
+    {0x0CD7, UC_OTHER},
+    {0x0CDD, UC_LETTER},
+    {0x0CDF, UC_OTHER},
+    {0x0CE0, UC_LETTER},
+    {0x0CE2, UC_MARK},
+    {0x0CE4, UC_OTHER},
+    {0x0CE6, UC_NUMBER},
+    {0x0CF0, UC_OTHER},
+    {0x0CF1, UC_LETTER},
+    {0x0CF3, UC_OTHER},
+    {0x0D00, UC_MARK},
+    {0x0D04, UC_LETTER},
+    {0x0D0D, UC_OTHER},
+    {0x0D0E, UC_LETTER},
+    {0x0D11, UC_OTHER},
+    {0x0D12, UC_LETTER},
+    {0x0D3B, UC_MARK},
+    {0x0D3D, UC_LETTER},
+    {0x0D3E, UC_MARK},
+    {0x0D45, UC_OTHER},
+    {0x0D46, UC_MARK},
+    {0x0D49, UC_OTHER},
+    {0x0D4A, UC_MARK},
+    {0x0D4E, UC_LETTER},
+    {0x0D4F, UC_OTHER},
+    {0x0D54, UC_LETTER},
+    {0x0D57, UC_MARK},
+    {0x0D58, UC_NUMBER},
+    {0x0D5F, UC_LETTER},
+    {0x0D62, UC_MARK},
+    {0x0D64, UC_OTHER},
+    {0x0D66, UC_NUMBER},
+    {0x0D79, UC_OTHER},
+    {0x0D7A, UC_LETTER},
+    {0x0D80, UC_OTHER},
+    {0x0D81, UC_MARK},
+    {0x0D84, UC_OTHER},
+    {0x0D85, UC_LETTER},
+    {0x0D97, UC_OTHER},
+    {0x0D9A, UC_LETTER},
+    {0x0DB2, UC_OTHER},
+    {0x0DB3, UC_LETTER},
+    {0x0DBC, UC_OTHER},
+    {0x0DBD, UC_LETTER},
+    {0x0DBE, UC_OTHER},
+    {0x0DC0, UC_LETTER},
+    {0x0DC7, UC_OTHER},
+    {0x0DCA, UC_MARK},
+    {0x0DCB, UC_OTHER},
+    {0x0DCF, UC_MARK},
+    {0x0DD5, UC_OTHER},
+    {0x0DD6, UC_MARK},
+    {0x0DD7, UC_OTHER},
+    {0x0DD8, UC_MARK},
+    {0x0DE0, UC_OTHER},
+    {0x0DE6, UC_NUMBER},
+    {0x0DF0, UC_OTHER},
+    {0x0DF2, UC_MARK},
+    {0x0DF4, UC_OTHER},
+    {0x0E01, UC_LETTER},
+    {0x0E31, UC_MARK},
+    {0x0E32, UC_LETTER},
+    {0x0E34, UC_MARK},
+    {0x0E3B, UC_OTHER},
+    {0x0E40, UC_LETTER},
+    {0x0E47, UC_MARK},
+    {0x0E4F, UC_OTHER},
+    {0x0E50, UC_NUMBER},
+    {0x0E5A, UC_OTHER},
+    {0x0E81, UC_LETTER},
+    {0x0E83, UC_OTHER},
+    {0x0E84, UC_LETTER},
+    {0x0E85, UC_OTHER},
+    {0x0E86, UC_LETTER},
+    {0x0E8B, UC_OTHER},
+    {0x0E8C, UC_LETTER},
+    {0x0EA4, UC_OTHER},
+    {0x0EA5, UC_LETTER},
+    {0x0EA6, UC_OTHER},
+    {0x0EA7, UC_LETTER},
+    {0x0EB1, UC_MARK},
+    {0x0EB2, UC_LETTER},
+    {0x0EB4, UC_MARK},
+    {0x0EBD, UC_LETTER},
+    {0x0EBE, UC_OTHER},
+    {0x0EC0, UC_LETTER},
+    {0x0EC5, UC_OTHER},
+    {0x0EC6, UC_LETTER},
+    {0x0EC7, UC_OTHER},
+    {0x0EC8, UC_MARK},
+    {0x0ECE, UC_OTHER},
+    {0x0ED0, UC_NUMBER},
+    {0x0EDA, UC_OTHER},
+    {0x0EDC, UC_LETTER},
+    {0x0EE0, UC_OTHER},
+    {0x0F00, UC_LETTER},
+    {0x0F01, UC_OTHER},
+    {0x0F18, UC_MARK},
+    {0x0F1A, UC_OTHER},
+    {0x0F20, UC_NUMBER},
+    {0x0F34, UC_OTHER},
+    {0x0F35, UC_MARK},
+    {0x0F36, UC_OTHER},
+    {0x0F37, UC_MARK},
+    {0x0F38, UC_OTHER},
+    {0x0F39, UC_MARK},
+    {0x0F3A, UC_OTHER},
+    {0x0F3E, UC_MARK},
+    {0x0F40, UC_LETTER},
+    {0x0F48, UC_OTHER},
+    {0x0F49, UC_LETTER},
+    {0x0F6D, UC_OTHER},
+    {0x0F71, UC_MARK},
+    {0x0F85, UC_OTHER},
+    {0x0F86, UC_MARK},
+    {0x0F88, UC_LETTER},
+    {0x0F8D, UC_MARK},
+    {0x0F98, UC_OTHER},
+    {0x0F99, UC_MARK},
+    {0x0FBD, UC_OTHER},
+    {0x0FC6, UC_MARK},
+    {0x0FC7, UC_OTHER},
+    {0x1000, UC_LETTER},
+    {0x102B, UC_MARK},
+    {0x103F, UC_LETTER},
+    {0x1040, UC_NUMBER},
+    {0x104A, UC_OTHER},
+    {0x1050, UC_LETTER},
+    {0x1056, UC_MARK},
+    {0x105A, UC_LETTER},
+    {0x105E, UC_MARK},
+    {0x1061, UC_LETTER},
+    {0x1062, UC_MARK},
+    {0x1065, UC_LETTER},
+    {0x1067, UC_MARK},
+    {0x106E, UC_LETTER},
+    {0x1071, UC_MARK},
+    {0x1075, UC_LETTER},
+    {0x1082, UC_MARK},
+    {0x108E, UC_LETTER},
+    {0x108F, UC_MARK},
+    {0x1090, UC_NUMBER},
+    {0x109A, UC_MARK},
+    {0x109E, UC_OTHER},
+    {0x10A0, UC_UPPER},
+    {0x10C6, UC_OTHER},
+    {0x10C7, UC_UPPER},
+    {0x10C8, UC_OTHER},
+    {0x10CD, UC_UPPER},
+    {0x10CE, UC_OTHER},
+    {0x10D0, UC_LOWER},
+    {0x10FB, UC_OTHER},
+    {0x10FC, UC_LETTER},
+    {0x10FD, UC_LOWER},
+    {0x1100, UC_LETTER},
+    {0x1249, UC_OTHER},
+    {0x124A, UC_LETTER},
+    {0x124E, UC_OTHER},
+    {0x1250, UC_LETTER},
+    {0x1257, UC_OTHER},
+    {0x1258, UC_LETTER},
+    {0x1259, UC_OTHER},
+    {0x125A, UC_LETTER},
+    {0x125E, UC_OTHER},
+    {0x1260, UC_LETTER},
+    {0x1289, UC_OTHER},
+    {0x128A, UC_LETTER},
+    {0x128E, UC_OTHER},
+    {0x1290, UC_LETTER},
+    {0x12B1, UC_OTHER},
+    {0x12B2, UC_LETTER},
+    {0x12B6, UC_OTHER},
+    {0x12B8, UC_LETTER},
+    {0x12BF, UC_OTHER},
+    {0x12C0, UC_LETTER},
+    {0x12C1, UC_OTHER},
+    {0x12C2, UC_LETTER},
+    {0x12C6, UC_OTHER},
+    {0x12C8, UC_LETTER},
+    {0x12D7, UC_OTHER},
+    {0x12D8, UC_LETTER},
+    {0x1311, UC_OTHER},
+    {0x1312, UC_LETTER},
+    {0x1316, UC_OTHER},
+    {0x1318, UC_LETTER},
+    {0x135B, UC_OTHER},
+    {0x135D, UC_MARK},
+    {0x1360, UC_OTHER},
+    {0x1369, UC_NUMBER},
+    {0x137D, UC_OTHER},
+    {0x1380, UC_LETTER},
+    {0x1390, UC_OTHER},
+    {0x13A0, UC_UPPER},
+    {0x13F6, UC_OTHER},
+    {0x13F8, UC_LOWER},
+    {0x13FE, UC_OTHER},
+    {0x1401, UC_LETTER},
+    {0x166D, UC_OTHER},
+    {0x166F, UC_LETTER},
+    {0x1680, UC_SPACE},
+    {0x1681, UC_LETTER},
+    {0x169B, UC_OTHER},
+    {0x16A0, UC_LETTER},
+    {0x16EB, UC_OTHER},
+    {0x16EE, UC_NUMBER},
+    {0x16F1, UC_LETTER},
+    {0x16F9, UC_OTHER},
+    {0x1700, UC_LETTER},
+    {0x1712, UC_MARK},
+    {0x1716, UC_OTHER},
+    {0x171F, UC_LETTER},
+    {0x1732, UC_MARK},
+    {0x1735, UC_OTHER},
+    {0x1740, UC_LETTER},
+    {0x1752, UC_MARK},
+    {0x1754, UC_OTHER},
+    {0x1760, UC_LETTER},
+    {0x176D, UC_OTHER},
+    {0x176E, UC_LETTER},
+    {0x1771, UC_OTHER},
+    {0x1772, UC_MARK},
+    {0x1774, UC_OTHER},
+    {0x1780, UC_LETTER},
+    {0x17B4, UC_MARK},
+    {0x17D4, UC_OTHER},
+    {0x17D7, UC_LETTER},
+    {0x17D8, UC_OTHER},
+    {0x17DC, UC_LETTER},
+    {0x17DD, UC_MARK},
+    {0x17DE, UC_OTHER},
+    {0x17E0, UC_NUMBER},
+    {0x17EA, UC_OTHER},
+    {0x17F0, UC_NUMBER},
+    {0x17FA, UC_OTHER},
+    {0x180B, UC_MARK},
+    {0x180E, UC_OTHER},
+    {0x180F, UC_MARK},
+    {0x1810, UC_NUMBER},
+    {0x181A, UC_OTHER},
+    {0x1820, UC_LETTER},
+    {0x1879, UC_OTHER},
+    {0x1880, UC_LETTER},
+    {0x1885, UC_MARK},
+    {0x1887, UC_LETTER},
+    {0x18A9, UC_MARK},
+    {0x18AA, UC_LETTER},
+    {0x18AB, UC_OTHER},
+    {0x18B0, UC_LETTER},
+    {0x18F6, UC_OTHER},
+    {0x1900, UC_LETTER},
+    {0x191F, UC_OTHER},
+    {0x1920, UC_MARK},
+    {0x192C, UC_OTHER},
+    {0x1930, UC_MARK},
+    {0x193C, UC_OTHER},
+    {0x1946, UC_NUMBER},
+    {0x1950, UC_LETTER},
+    {0x196E, UC_OTHER},
+    {0x1970, UC_LETTER},
+    {0x1975, UC_OTHER},
+    {0x1980, UC_LETTER},
+    {0x19AC, UC_OTHER},
+    {0x19B0, UC_LETTER},
+    {0x19CA, UC_OTHER},
+    {0x19D0, UC_NUMBER},
+    {0x19DB, UC_OTHER},
+    {0x1A00, UC_LETTER},
+    {0x1A17, UC_MARK},
+    {0x1A1C, UC_OTHER},
+    {0x1A20, UC_LETTER},
+    {0x1A55, UC_MARK},
+    {0x1A5F, UC_OTHER},
+    {0x1A60, UC_MARK},
+    {0x1A7D, UC_OTHER},
+    {0x1A7F, UC_MARK},
+    {0x1A80, UC_NUMBER},
+    {0x1A8A, UC_OTHER},
+    {0x1A90, UC_NUMBER},
+    {0x1A9A, UC_OTHER},
+    {0x1AA7, UC_LETTER},
+    {0x1AA8, UC_OTHER},
+    {0x1AB0, UC_MARK},
+    {0x1ACF, UC_OTHER},
+    {0x1B00, UC_MARK},
+    {0x1B05, UC_LETTER},
+    {0x1B34, UC_MARK},
+    {0x1B45, UC_LETTER},
+    {0x1B4D, UC_OTHER},
+    {0x1B50, UC_NUMBER},
+    {0x1B5A, UC_OTHER},
+    {0x1B6B, UC_MARK},
+    {0x1B74, UC_OTHER},
+    {0x1B80, UC_MARK},
+    {0x1B83, UC_LETTER},
+    {0x1BA1, UC_MARK},
+    {0x1BAE, UC_LETTER},
+    {0x1BB0, UC_NUMBER},
+    {0x1BBA, UC_LETTER},
+    {0x1BE6, UC_MARK},
+    {0x1BF4, UC_OTHER},
+    {0x1C00, UC_LETTER},
+    {0x1C24, UC_MARK},
+    {0x1C38, UC_OTHER},
+    {0x1C40, UC_NUMBER},
+    {0x1C4A, UC_OTHER},
+    {0x1C4D, UC_LETTER},
+    {0x1C50, UC_NUMBER},
+    {0x1C5A, UC_LETTER},
+    {0x1C7E, UC_OTHER},
+    {0x1C80, UC_LOWER},
+    {0x1C89, UC_OTHER},
+    {0x1C90, UC_UPPER},
+    {0x1CBB, UC_OTHER},
+    {0x1CBD, UC_UPPER},
+    {0x1CC0, UC_OTHER},
+    {0x1CD0, UC_MARK},
+    {0x1CD3, UC_OTHER},
+    {0x1CD4, UC_MARK},
+    {0x1CE9, UC_LETTER},
+    {0x1CED, UC_MARK},
+    {0x1CEE, UC_LETTER},
+    {0x1CF4, UC_MARK},
+    {0x1CF5, UC_LETTER},
+    {0x1CF7, UC_MARK},
+    {0x1CFA, UC_LETTER},
+    {0x1CFB, UC_OTHER},
+    {0x1D00, UC_LOWER},
+    {0x1D2C, UC_LETTER},
+    {0x1D6B, UC_LOWER},
+    {0x1D78, UC_LETTER},
+    {0x1D79, UC_LOWER},
+    {0x1D9B, UC_LETTER},
+    {0x1DC0, UC_MARK},
+    {0x1E00, UC_UPPER},
+    {0x1E01, UC_LOWER},
+    {0x1E02, UC_UPPER},
+    {0x1E03, UC_LOWER},
+    {0x1E04, UC_UPPER},
+    {0x1E05, UC_LOWER},
+    {0x1E06, UC_UPPER},
+    {0x1E07, UC_LOWER},
+    {0x1E08, UC_UPPER},
+    {0x1E09, UC_LOWER},
+    {0x1E0A, UC_UPPER},
+    {0x1E0B, UC_LOWER},
+    {0x1E0C, UC_UPPER},
+    {0x1E0D, UC_LOWER},
+    {0x1E0E, UC_UPPER},
+    {0x1E0F, UC_LOWER},
+    {0x1E10, UC_UPPER},
+    {0x1E11, UC_LOWER},
+    {0x1E12, UC_UPPER},
+    {0x1E13, UC_LOWER},
+    {0x1E14, UC_UPPER},
+    {0x1E15, UC_LOWER},
+    {0x1E16, UC_UPPER},
+    {0x1E17, UC_LOWER},
+    {0x1E18, UC_UPPER},
+    {0x1E19, UC_LOWER},
+    {0x1E1A, UC_UPPER},
+    {0x1E1B, UC_LOWER},
+    {0x1E1C, UC_UPPER},
+    {0x1E1D, UC_LOWER},
+    {0x1E1E, UC_UPPER},
+    {0x1E1F, UC_LOWER},
+    {0x1E20, UC_UPPER},
+    {0x1E21, UC_LOWER},
+    {0x1E22, UC_UPPER},
+    {0x1E23, UC_LOWER},
+    {0x1E24, UC_UPPER},
+    {0x1E25, UC_LOWER},
+    {0x1E26, UC_UPPER},
+    {0x1E27, UC_LOWER},
+    {0x1E28, UC_UPPER},
+    {0x1E29, UC_LOWER},
+    {0x1E2A, UC_UPPER},
+    {0x1E2B, UC_LOWER},
+    {0x1E2C, UC_UPPER},
+    {0x1E2D, UC_LOWER},
+    {0x1E2E, UC_UPPER},
+    {0x1E2F, UC_LOWER},
+    {0x1E30, UC_UPPER},
+    {0x1E31, UC_LOWER},
+    {0x1E32, UC_UPPER},
+    {0x1E33, UC_LOWER},
+    {0x1E34, UC_UPPER},
+    {0x1E35, UC_LOWER},
+    {0x1E36, UC_UPPER},
+    {0x1E37, UC_LOWER},
+    {0x1E38, UC_UPPER},
+    {0x1E39, UC_LOWER},
+    {0x1E3A, UC_UPPER},
+    {0x1E3B, UC_LOWER},
+    {0x1E3C, UC_UPPER},
+    {0x1E3D, UC_LOWER},
+    {0x1E3E, UC_UPPER},
+    {0x1E3F, UC_LOWER},
+    {0x1E40, UC_UPPER},
+    {0x1E41, UC_LOWER},
+    {0x1E42, UC_UPPER},
+    {0x1E43, UC_LOWER},
+    {0x1E44, UC_UPPER},
+    {0x1E45, UC_LOWER},
+    {0x1E46, UC_UPPER},
+    {0x1E47, UC_LOWER},
+    {0x1E48, UC_UPPER},
+    {0x1E49, UC_LOWER},
+    {0x1E4A, UC_UPPER},
+    {0x1E4B, UC_LOWER},
+    {0x1E4C, UC_UPPER},
+    {0x1E4D, UC_LOWER},
+    {0x1E4E, UC_UPPER},
+    {0x1E4F, UC_LOWER},
+    {0x1E50, UC_UPPER},
+    {0x1E51, UC_LOWER},
+    {0x1E52, UC_UPPER},
+    {0x1E53, UC_LOWER},
+    {0x1E54, UC_UPPER},
+    {0x1E55, UC_LOWER},
+    {0x1E56, UC_UPPER},
+    {0x1E57, UC_LOWER},
+    {0x1E58, UC_UPPER},
+    {0x1E59, UC_LOWER},
+    {0x1E5A, UC_UPPER},
+    {0x1E5B, UC_LOWER},
+    {0x1E5C, UC_UPPER},
+    {0x1E5D, UC_LOWER},
+    {0x1E5E, UC_UPPER},
+    {0x1E5F, UC_LOWER},
+    {0x1E60, UC_UPPER},
+    {0x1E61, UC_LOWER},
+    {0x1E62, UC_UPPER},
+    {0x1E63, UC_LOWER},
+    {0x1E64, UC_UPPER},
+    {0x1E65, UC_LOWER},
+    {0x1E66, UC_UPPER},
+    {0x1E67, UC_LOWER},
+    {0x1E68, UC_UPPER},
+    {0x1E69, UC_LOWER},
+    {0x1E6A, UC_UPPER},
+    {0x1E6B, UC_LOWER},
+    {0x1E6C, UC_UPPER},
+    {0x1E6D, UC_LOWER},
+    {0x1E6E, UC_UPPER},
+    {0x1E6F, UC_LOWER},
+    {0x1E70, UC_UPPER},
+    {0x1E71, UC_LOWER},
+    {0x1E72, UC_UPPER},
+    {0x1E73, UC_LOWER},
+    {0x1E74, UC_UPPER},
+    {0x1E75, UC_LOWER},
+    {0x1E76, UC_UPPER},
+    {0x1E77, UC_LOWER},
+    {0x1E78, UC_UPPER},
+    {0x1E79, UC_LOWER},
+    {0x1E7A, UC_UPPER},
+    {0x1E7B, UC_LOWER},
+    {0x1E7C, UC_UPPER},
+    {0x1E7D, UC_LOWER},
+    {0x1E7E, UC_UPPER},
+    {0x1E7F, UC_LOWER},
+    {0x1E80, UC_UPPER},
+    {0x1E81, UC_LOWER},
+    {0x1E82, UC_UPPER},
+    {0x1E83, UC_LOWER},
+    {0x1E84, UC_UPPER},
+    {0x1E85, UC_LOWER},
+    {0x1E86, UC_UPPER},
+    {0x1E87, UC_LOWER},
+    {0x1E88, UC_UPPER},
+    {0x1E89, UC_LOWER},
+    {0x1E8A, UC_UPPER},
+    {0x1E8B, UC_LOWER},
+    {0x1E8C, UC_UPPER},
+    {0x1E8D, UC_LOWER},
+    {0x1E8E, UC_UPPER},
+    {0x1E8F, UC_LOWER},
+    {0x1E90, UC_UPPER},
+    {0x1E91, UC_LOWER},
+    {0x1E92, UC_UPPER},
+    {0x1E93, UC_LOWER},
+    {0x1E94, UC_UPPER},
+    {0x1E95, UC_LOWER},
+    {0x1E9E, UC_UPPER},
+    {0x1E9F, UC_LOWER},
+    {0x1EA0, UC_UPPER},
+    {0x1EA1, UC_LOWER},
+    {0x1EA2, UC_UPPER},
+    {0x1EA3, UC_LOWER},
+    {0x1EA4, UC_UPPER},
+    {0x1EA5, UC_LOWER},
+    {0x1EA6, UC_UPPER},
+    {0x1EA7, UC_LOWER},
+    {0x1EA8, UC_UPPER},
+    {0x1EA9, UC_LOWER},
+    {0x1EAA, UC_UPPER},
+    {0x1EAB, UC_LOWER},
+    {0x1EAC, UC_UPPER},
+    {0x1EAD, UC_LOWER},
+    {0x1EAE, UC_UPPER},
+    {0x1EAF, UC_LOWER},
+    {0x1EB0, UC_UPPER},
+    {0x1EB1, UC_LOWER},
+    {0x1EB2, UC_UPPER},
+    {0x1EB3, UC_LOWER},
+    {0x1EB4, UC_UPPER},
+    {0x1EB5, UC_LOWER},
+    {0x1EB6, UC_UPPER},
+    {0x1EB7, UC_LOWER},
+    {0x1EB8, UC_UPPER},
+    {0x1EB9, UC_LOWER},
+    {0x1EBA, UC_UPPER},
+    {0x1EBB, UC_LOWER},
+    {0x1EBC, UC_UPPER},
+    {0x1EBD, UC_LOWER},
+    {0x1EBE, UC_UPPER},
+    {0x1EBF, UC_LOWER},
+    {0x1EC0, UC_UPPER},
+    {0x1EC1, UC_LOWER},
+    {0x1EC2, UC_UPPER},
+    {0x1EC3, UC_LOWER},
+    {0x1EC4, UC_UPPER},
+    {0x1EC5, UC_LOWER},
+    {0x1EC6, UC_UPPER},
+    {0x1EC7, UC_LOWER},
+    {0x1EC8, UC_UPPER},
+    {0x1EC9, UC_LOWER},
+    {0x1ECA, UC_UPPER},
+    {0x1ECB, UC_LOWER},
+    {0x1ECC, UC_UPPER},
+    {0x1ECD, UC_LOWER},
+    {0x1ECE, UC_UPPER},
+    {0x1ECF, UC_LOWER},
+    {0x1ED0, UC_UPPER},
+    {0x1ED1, UC_LOWER},
+    {0x1ED2, UC_UPPER},
+    {0x1ED3, UC_LOWER},
+    {0x1ED4, UC_UPPER},
+    {0x1ED5, UC_LOWER},
+    {0x1ED6, UC_UPPER},
+    {0x1ED7, UC_LOWER},
+    {0x1ED8, UC_UPPER},
+    {0x1ED9, UC_LOWER},
+    {0x1EDA, UC_UPPER},
+    {0x1EDB, UC_LOWER},
+    {0x1EDC, UC_UPPER},
+    {0x1EDD, UC_LOWER},
+    {0x1EDE, UC_UPPER},
+    {0x1EDF, UC_LOWER},
+    {0x1EE0, UC_UPPER},
+    {0x1EE1, UC_LOWER},
+    {0x1EE2, UC_UPPER},
+    {0x1EE3, UC_LOWER},
+    {0x1EE4, UC_UPPER},
+    {0x1EE5, UC_LOWER},
+    {0x1EE6, UC_UPPER},
+    {0x1EE7, UC_LOWER},
+    {0x1EE8, UC_UPPER},
+    {0x1EE9, UC_LOWER},
+    {0x1EEA, UC_UPPER},
+    {0x1EEB, UC_LOWER},
+    {0x1EEC, UC_UPPER},
+    {0x1EED, UC_LOWER},
+    {0x1EEE, UC_UPPER},
+    {0x1EEF, UC_LOWER},
+    {0x1EF0, UC_UPPER},
+    {0x1EF1, UC_LOWER},
+    {0x1EF2, UC_UPPER},
+    {0x1EF3, UC_LOWER},
+    {0x1EF4, UC_UPPER},
+    {0x1EF5, UC_LOWER},
+    {0x1EF6, UC_UPPER},
+    {0x1EF7, UC_LOWER},
+    {0x1EF8, UC_UPPER},
+    {0x1EF9, UC_LOWER},
+    {0x1EFA, UC_UPPER},
+    {0x1EFB, UC_LOWER},
+    {0x1EFC, UC_UPPER},
+    {0x1EFD, UC_LOWER},
+    {0x1EFE, UC_UPPER},
+    {0x1EFF, UC_LOWER},
+    {0x1F08, UC_UPPER},
+    {0x1F10, UC_LOWER},
+    {0x1F16, UC_OTHER},
+    {0x1F18, UC_UPPER},
+    {0x1F1E, UC_OTHER},
+    {0x1F20, UC_LOWER},
+    {0x1F28, UC_UPPER},
+    {0x1F30, UC_LOWER},
+    {0x1F38, UC_UPPER},
+    {0x1F40, UC_LOWER},
+    {0x1F46, UC_OTHER},
+    {0x1F48, UC_UPPER},
+    {0x1F4E, UC_OTHER},
+    {0x1F50, UC_LOWER},
+    {0x1F58, UC_OTHER},
+    {0x1F59, UC_UPPER},
+    {0x1F5A, UC_OTHER},
+    {0x1F5B, UC_UPPER},
+    {0x1F5C, UC_OTHER},
+    {0x1F5D, UC_UPPER},
+    {0x1F5E, UC_OTHER},
+    {0x1F5F, UC_UPPER},
+    {0x1F60, UC_LOWER},
+    {0x1F68, UC_UPPER},
+    {0x1F70, UC_LOWER},
+    {0x1F7E, UC_OTHER},
+    {0x1F80, UC_LOWER},
+    {0x1F88, UC_UPPER},
+    {0x1F90, UC_LOWER},
+    {0x1F98, UC_UPPER},
+    {0x1FA0, UC_LOWER},
+    {0x1FA8, UC_UPPER},
+    {0x1FB0, UC_LOWER},
+    {0x1FB5, UC_OTHER},
+    {0x1FB6, UC_LOWER},
+    {0x1FB8, UC_UPPER},
+    {0x1FBD, UC_OTHER},
+    {0x1FBE, UC_LOWER},
+    {0x1FBF, UC_OTHER},
+    {0x1FC2, UC_LOWER},
+    {0x1FC5, UC_OTHER},
+    {0x1FC6, UC_LOWER},
+    {0x1FC8, UC_UPPER},
+    {0x1FCD, UC_OTHER},
+    {0x1FD0, UC_LOWER},
+    {0x1FD4, UC_OTHER},
+    {0x1FD6, UC_LOWER},
+    {0x1FD8, UC_UPPER},
+    {0x1FDC, UC_OTHER},
+    {0x1FE0, UC_LOWER},
+    {0x1FE8, UC_UPPER},
+    {0x1FED, UC_OTHER},
+    {0x1FF2, UC_LOWER},
+    {0x1FF5, UC_OTHER},
+    {0x1FF6, UC_LOWER},
+    {0x1FF8, UC_UPPER},
+    {0x1FFD, UC_OTHER},
+    {0x2000, UC_SPACE},
+    {0x200B, UC_OTHER},
+    {0x2028, UC_SPACE},
+    {0x202A, UC_OTHER},
+    {0x202F, UC_SPACE},
+    {0x2030, UC_OTHER},
+    {0x205F, UC_SPACE},
+    {0x2060, UC_OTHER},
+    {0x2070, UC_NUMBER},
+    {0x2071, UC_LETTER},
+    {0x2072, UC_OTHER},
+    {0x2074, UC_NUMBER},
+    {0x207A, UC_OTHER},
+    {0x207F, UC_LETTER},
+    {0x2080, UC_NUMBER},
+    {0x208A, UC_OTHER},
+    {0x2090, UC_LETTER},
+    {0x209D, UC_OTHER},
+    {0x20D0, UC_MARK},
+    {0x20F1, UC_OTHER},
+    {0x2102, UC_UPPER},
+    {0x2103, UC_OTHER},
+    {0x2107, UC_UPPER},
+    {0x2108, UC_OTHER},
+    {0x210A, UC_LOWER},
+    {0x210B, UC_UPPER},
+    {0x210E, UC_LOWER},
+    {0x2110, UC_UPPER},
+    {0x2113, UC_LOWER},
+    {0x2114, UC_OTHER},
+    {0x2115, UC_UPPER},
+    {0x2116, UC_OTHER},
+    {0x2119, UC_UPPER},
+    {0x211E, UC_OTHER},
+    {0x2124, UC_UPPER},
+    {0x2125, UC_OTHER},
+    {0x2126, UC_UPPER},
+    {0x2127, UC_OTHER},
+    {0x2128, UC_UPPER},
+    {0x2129, UC_OTHER},
+    {0x212A, UC_UPPER},
+    {0x212E, UC_OTHER},
+    {0x212F, UC_LOWER},
+    {0x2130, UC_UPPER},
+    {0x2134, UC_LOWER},
+    {0x2135, UC_LETTER},
+    {0x2139, UC_LOWER},
+    {0x213A, UC_OTHER},
+    {0x213C, UC_LOWER},
+    {0x213E, UC_UPPER},
+    {0x2140, UC_OTHER},
+    {0x2145, UC_UPPER},
+    {0x2146, UC_LOWER},
+    {0x214A, UC_OTHER},
+    {0x214E, UC_LOWER},
+    {0x214F, UC_OTHER},
+    {0x2150, UC_NUMBER},
+    {0x2183, UC_UPPER},
+    {0x2184, UC_LOWER},
+    {0x2185, UC_NUMBER},
+    {0x218A, UC_OTHER},
+    {0x2460, UC_NUMBER},
+    {0x249C, UC_OTHER},
+    {0x24EA, UC_NUMBER},
+    {0x2500, UC_OTHER},
+    {0x2776, UC_NUMBER},
+    {0x2794, UC_OTHER},
+    {0x2C00, UC_UPPER},
+    {0x2C30, UC_LOWER},
+    {0x2C60, UC_UPPER},
+    {0x2C61, UC_LOWER},
+    {0x2C62, UC_UPPER},
+    {0x2C65, UC_LOWER},
+    {0x2C67, UC_UPPER},
+    {0x2C68, UC_LOWER},
+    {0x2C69, UC_UPPER},
+    {0x2C6A, UC_LOWER},
+    {0x2C6B, UC_UPPER},
+    {0x2C6C, UC_LOWER},
+    {0x2C6D, UC_UPPER},
+    {0x2C71, UC_LOWER},
+    {0x2C72, UC_UPPER},
+    {0x2C73, UC_LOWER},
+    {0x2C75, UC_UPPER},
+    {0x2C76, UC_LOWER},
+    {0x2C7C, UC_LETTER},
+    {0x2C7E, UC_UPPER},
+    {0x2C81, UC_LOWER},
+    {0x2C82, UC_UPPER},
+    {0x2C83, UC_LOWER},
+    {0x2C84, UC_UPPER},
+    {0x2C85, UC_LOWER},
+    {0x2C86, UC_UPPER},
+    {0x2C87, UC_LOWER},
+    {0x2C88, UC_UPPER},
+    {0x2C89, UC_LOWER},
+    {0x2C8A, UC_UPPER},
+    {0x2C8B, UC_LOWER},
+    {0x2C8C, UC_UPPER},
+    {0x2C8D, UC_LOWER},
+    {0x2C8E, UC_UPPER},
+    {0x2C8F, UC_LOWER},
+    {0x2C90, UC_UPPER},
+    {0x2C91, UC_LOWER},
+    {0x2C92, UC_UPPER},
+    {0x2C93, UC_LOWER},
+    {0x2C94, UC_UPPER},
+    {0x2C95, UC_LOWER},
+    {0x2C96, UC_UPPER},
+    {0x2C97, UC_LOWER},
+    {0x2C98, UC_UPPER},
+    {0x2C99, UC_LOWER},
+    {0x2C9A, UC_UPPER},
+    {0x2C9B, UC_LOWER},
+    {0x2C9C, UC_UPPER},
+    {0x2C9D, UC_LOWER},
+    {0x2C9E, UC_UPPER},
+    {0x2C9F, UC_LOWER},
+    {0x2CA0, UC_UPPER},
+    {0x2CA1, UC_LOWER},
+    {0x2CA2, UC_UPPER},
+    {0x2CA3, UC_LOWER},
+    {0x2CA4, UC_UPPER},
+    {0x2CA5, UC_LOWER},
+    {0x2CA6, UC_UPPER},
+    {0x2CA7, UC_LOWER},
+    {0x2CA8, UC_UPPER},
+    {0x2CA9, UC_LOWER},
+    {0x2CAA, UC_UPPER},
+    {0x2CAB, UC_LOWER},
+    {0x2CAC, UC_UPPER},
+    {0x2CAD, UC_LOWER},
+    {0x2CAE, UC_UPPER},
+    {0x2CAF, UC_LOWER},
+    {0x2CB0, UC_UPPER},
+    {0x2CB1, UC_LOWER},
+    {0x2CB2, UC_UPPER},
+    {0x2CB3, UC_LOWER},
+    {0x2CB4, UC_UPPER},
+    {0x2CB5, UC_LOWER},
+    {0x2CB6, UC_UPPER},
+    {0x2CB7, UC_LOWER},
+    {0x2CB8, UC_UPPER},
+    {0x2CB9, UC_LOWER},
+    {0x2CBA, UC_UPPER},
+    {0x2CBB, UC_LOWER},
+    {0x2CBC, UC_UPPER},
+    {0x2CBD, UC_LOWER},
+    {0x2CBE, UC_UPPER},
+    {0x2CBF, UC_LOWER},
+    {0x2CC0, UC_UPPER},
+    {0x2CC1, UC_LOWER},
+    {0x2CC2, UC_UPPER},
+    {0x2CC3, UC_LOWER},
+    {0x2CC4, UC_UPPER},
+    {0x2CC5, UC_LOWER},
+    {0x2CC6, UC_UPPER},
+    {0x2CC7, UC_LOWER},
+    {0x2CC8, UC_UPPER},
+    {0x2CC9, UC_LOWER},
+    {0x2CCA, UC_UPPER},
+    {0x2CCB, UC_LOWER},
+    {0x2CCC, UC_UPPER},
+    {0x2CCD, UC_LOWER},
+    {0x2CCE, UC_UPPER},
+    {0x2CCF, UC_LOWER},
+    {0x2CD0, UC_UPPER},
+    {0x2CD1, UC_LOWER},
+    {0x2CD2, UC_UPPER},
+    {0x2CD3, UC_LOWER},
+    {0x2CD4, UC_UPPER},
+    {0x2CD5, UC_LOWER},
+    {0x2CD6, UC_UPPER},
+    {0x2CD7, UC_LOWER},
+    {0x2CD8, UC_UPPER},
+    {0x2CD9, UC_LOWER},
+    {0x2CDA, UC_UPPER},
+    {0x2CDB, UC_LOWER},
+    {0x2CDC, UC_UPPER},
+    {0x2CDD, UC_LOWER},
+    {0x2CDE, UC_UPPER},
+    {0x2CDF, UC_LOWER},
+    {0x2CE0, UC_UPPER},
+    {0x2CE1, UC_LOWER},
+    {0x2CE2, UC_UPPER},
+    {0x2CE3, UC_LOWER},
+    {0x2CE5, UC_OTHER},
+    {0x2CEB, UC_UPPER},
+    {0x2CEC, UC_LOWER},
+    {0x2CED, UC_UPPER},
+    {0x2CEE, UC_LOWER},
+    {0x2CEF, UC_MARK},
+    {0x2CF2, UC_UPPER},
+    {0x2CF3, UC_LOWER},
+    {0x2CF4, UC_OTHER},
+    {0x2CFD, UC_NUMBER},
+    {0x2CFE, UC_OTHER},
+    {0x2D00, UC_LOWER},
+    {0x2D26, UC_OTHER},
+    {0x2D27, UC_LOWER},
+    {0x2D28, UC_OTHER},
+    {0x2D2D, UC_LOWER},
+    {0x2D2E, UC_OTHER},
+    {0x2D30, UC_LETTER},
+    {0x2D68, UC_OTHER},
+    {0x2D6F, UC_LETTER},
+    {0x2D70, UC_OTHER},
+    {0x2D7F, UC_MARK},
+    {0x2D80, UC_LETTER},
+    {0x2D97, UC_OTHER},
+    {0x2DA0, UC_LETTER},
+    {0x2DA7, UC_OTHER},
+    {0x2DA8, UC_LETTER},
+    {0x2DAF, UC_OTHER},
+    {0x2DB0, UC_LETTER},
+    {0x2DB7, UC_OTHER},
+    {0x2DB8, UC_LETTER},
+    {0x2DBF, UC_OTHER},
+    {0x2DC0, UC_LETTER},
+    {0x2DC7, UC_OTHER},
+    {0x2DC8, UC_LETTER},
+    {0x2DCF, UC_OTHER},
+    {0x2DD0, UC_LETTER},
+    {0x2DD7, UC_OTHER},
+    {0x2DD8, UC_LETTER},
+    {0x2DDF, UC_OTHER},
+    {0x2DE0, UC_MARK},
+    {0x2E00, UC_OTHER},
+    {0x2E2F, UC_LETTER},
+    {0x2E30, UC_OTHER},
+    {0x3000, UC_SPACE},
+    {0x3001, UC_OTHER},
+    {0x3005, UC_LETTER},
+    {0x3007, UC_NUMBER},
+    {0x3008, UC_OTHER},
+    {0x3021, UC_NUMBER},
+    {0x302A, UC_MARK},
+    {0x3030, UC_OTHER},
+    {0x3031, UC_LETTER},
+    {0x3036, UC_OTHER},
+    {0x3038, UC_NUMBER},
+    {0x303B, UC_LETTER},
+    {0x303D, UC_OTHER},
+    {0x3041, UC_LETTER},
+    {0x3097, UC_OTHER},
+    {0x3099, UC_MARK},
+    {0x309B, UC_OTHER},
+    {0x309D, UC_LETTER},
+    {0x30A0, UC_OTHER},
+    {0x30A1, UC_LETTER},
+    {0x30FB, UC_OTHER},
+    {0x30FC, UC_LETTER},
+    {0x3100, UC_OTHER},
+    {0x3105, UC_LETTER},
+    {0x3130, UC_OTHER},
+    {0x3131, UC_LETTER},
+    {0x318F, UC_OTHER},
+    {0x3192, UC_NUMBER},
+    {0x3196, UC_OTHER},
+    {0x31A0, UC_LETTER},
+    {0x31C0, UC_OTHER},
+    {0x31F0, UC_LETTER},
+    {0x3200, UC_OTHER},
+    {0x3220, UC_NUMBER},
+    {0x322A, UC_OTHER},
+    {0x3248, UC_NUMBER},
+    {0x3250, UC_OTHER},
+    {0x3251, UC_NUMBER},
+    {0x3260, UC_OTHER},
+    {0x3280, UC_NUMBER},
+    {0x328A, UC_OTHER},
+    {0x32B1, UC_NUMBER},
+    {0x32C0, UC_OTHER},
+    {0x3400, UC_LETTER},
+    {0x4DC0, UC_OTHER},
+    {0x4E00, UC_LETTER},
+    {0xA48D, UC_OTHER},
+    {0xA4D0, UC_LETTER},
+    {0xA4FE, UC_OTHER},
+    {0xA500, UC_LETTER},
+    {0xA60D, UC_OTHER},
+    {0xA610, UC_LETTER},
+    {0xA620, UC_NUMBER},
+    {0xA62A, UC_LETTER},
+    {0xA62C, UC_OTHER},
+    {0xA640, UC_UPPER},
+    {0xA641, UC_LOWER},
+    {0xA642, UC_UPPER},
+    {0xA643, UC_LOWER},
+    {0xA644, UC_UPPER},
+    {0xA645, UC_LOWER},
+    {0xA646, UC_UPPER},
+    {0xA647, UC_LOWER},
+    {0xA648, UC_UPPER},
+    {0xA649, UC_LOWER},
+    {0xA64A, UC_UPPER},
+    {0xA64B, UC_LOWER},
+    {0xA64C, UC_UPPER},
+    {0xA64D, UC_LOWER},
+    {0xA64E, UC_UPPER},
+    {0xA64F, UC_LOWER},
+    {0xA650, UC_UPPER},
+    {0xA651, UC_LOWER},
+    {0xA652, UC_UPPER},
+    {0xA653, UC_LOWER},
+    {0xA654, UC_UPPER},
+    {0xA655, UC_LOWER},
+    {0xA656, UC_UPPER},
+    {0xA657, UC_LOWER},
+    {0xA658, UC_UPPER},
+    {0xA659, UC_LOWER},
+    {0xA65A, UC_UPPER},
+    {0xA65B, UC_LOWER},
+    {0xA65C, UC_UPPER},
+    {0xA65D, UC_LOWER},
+    {0xA65E, UC_UPPER},
+    {0xA65F, UC_LOWER},
+    {0xA660, UC_UPPER},
+    {0xA661, UC_LOWER},
+    {0xA662, UC_UPPER},
+    {0xA663, UC_LOWER},
+    {0xA664, UC_UPPER},
+    {0xA665, UC_LOWER},
+    {0xA666, UC_UPPER},
+    {0xA667, UC_LOWER},
+    {0xA668, UC_UPPER},
+    {0xA669, UC_LOWER},
+    {0xA66A, UC_UPPER},
+    {0xA66B, UC_LOWER},
+    {0xA66C, UC_UPPER},
+    {0xA66D, UC_LOWER},
+    {0xA66E, UC_LETTER},
+    {0xA66F, UC_MARK},
+    {0xA673, UC_OTHER},
+    {0xA674, UC_MARK},
+    {0xA67E, UC_OTHER},
+    {0xA67F, UC_LETTER},
+    {0xA680, UC_UPPER},
+    {0xA681, UC_LOWER},
+    {0xA682, UC_UPPER},
+    {0xA683, UC_LOWER},
+    {0xA684, UC_UPPER},
+    {0xA685, UC_LOWER},
+    {0xA686, UC_UPPER},
+    {0xA687, UC_LOWER},
+    {0xA688, UC_UPPER},
+    {0xA689, UC_LOWER},
+    {0xA68A, UC_UPPER},
+    {0xA68B, UC_LOWER},
+    {0xA68C, UC_UPPER},
+    {0xA68D, UC_LOWER},
+    {0xA68E, UC_UPPER},
+    {0xA68F, UC_LOWER},
+    {0xA690, UC_UPPER},
+    {0xA691, UC_LOWER},
+    {0xA692, UC_UPPER},
+    {0xA693, UC_LOWER},
+    {0xA694, UC_UPPER},
+    {0xA695, UC_LOWER},
+    {0xA696, UC_UPPER},
+    {0xA697, UC_LOWER},
+    {0xA698, UC_UPPER},
+    {0xA699, UC_LOWER},
+    {0xA69A, UC_UPPER},
+    {0xA69B, UC_LOWER},
+    {0xA69C, UC_LETTER},
+    {0xA69E, UC_MARK},
+    {0xA6A0, UC_LETTER},
+    {0xA6E6, UC_NUMBER},
+    {0xA6F0, UC_MARK},
+    {0xA6F2, UC_OTHER},
+    {0xA717, UC_LETTER},
+    {0xA720, UC_OTHER},
+    {0xA722, UC_UPPER},
+    {0xA723, UC_LOWER},
+    {0xA724, UC_UPPER},
+    {0xA725, UC_LOWER},
+    {0xA726, UC_UPPER},
+    {0xA727, UC_LOWER},
+    {0xA728, UC_UPPER},
+    {0xA729, UC_LOWER},
+    {0xA72A, UC_UPPER},
+    {0xA72B, UC_LOWER},
+    {0xA72C, UC_UPPER},
+    {0xA72D, UC_LOWER},
+    {0xA72E, UC_UPPER},
+    {0xA72F, UC_LOWER},
+    {0xA732, UC_UPPER},
+    {0xA733, UC_LOWER},
+    {0xA734, UC_UPPER},
+    {0xA735, UC_LOWER},
+    {0xA736, UC_UPPER},
+    {0xA737, UC_LOWER},
+    {0xA738, UC_UPPER},
+    {0xA739, UC_LOWER},
+    {0xA73A, UC_UPPER},
+    {0xA73B, UC_LOWER},
+    {0xA73C, UC_UPPER},
+    {0xA73D, UC_LOWER},
+    {0xA73E, UC_UPPER},
+    {0xA73F, UC_LOWER},
+    {0xA740, UC_UPPER},
+    {0xA741, UC_LOWER},
+    {0xA742, UC_UPPER},
+    {0xA743, UC_LOWER},
+    {0xA744, UC_UPPER},
+    {0xA745, UC_LOWER},
+    {0xA746, UC_UPPER},
+    {0xA747, UC_LOWER},
+    {0xA748, UC_UPPER},
+    {0xA749, UC_LOWER},
+    {0xA74A, UC_UPPER},
+    {0xA74B, UC_LOWER},
+    {0xA74C, UC_UPPER},
+    {0xA74D, UC_LOWER},
+    {0xA74E, UC_UPPER},
+    {0xA74F, UC_LOWER},
+    {0xA750, UC_UPPER},
+    {0xA751, UC_LOWER},
+    {0xA752, UC_UPPER},
+    {0xA753, UC_LOWER},
+    {0xA754, UC_UPPER},
+    {0xA755, UC_LOWER},
+    {0xA756, UC_UPPER},
+    {0xA757, UC_LOWER},
+    {0xA758, UC_UPPER},
+    {0xA759, UC_LOWER},
+    {0xA75A, UC_UPPER},
+    {0xA75B, UC_LOWER},
+    {0xA75C, UC_UPPER},
+    {0xA75D, UC_LOWER},
+    {0xA75E, UC_UPPER},
+    {0xA75F, UC_LOWER},
+    {0xA760, UC_UPPER},
+    {0xA761, UC_LOWER},
+    {0xA762, UC_UPPER},
+    {0xA763, UC_LOWER},
+    {0xA764, UC_UPPER},
+    {0xA765, UC_LOWER},
+    {0xA766, UC_UPPER},
+    {0xA767, UC_LOWER},
+    {0xA768, UC_UPPER},
+    {0xA769, UC_LOWER},
+    {0xA76A, UC_UPPER},
+    {0xA76B, UC_LOWER},
+    {0xA76C, UC_UPPER},
+    {0xA76D, UC_LOWER},
+    {0xA76E, UC_UPPER},
+    {0xA76F, UC_LOWER},
+    {0xA770, UC_LETTER},
+    {0xA771, UC_LOWER},
+    {0xA779, UC_UPPER},
+    {0xA77A, UC_LOWER},
+    {0xA77B, UC_UPPER},
+    {0xA77C, UC_LOWER},
+    {0xA77D, UC_UPPER},
+    {0xA77F, UC_LOWER},
+    {0xA780, UC_UPPER},
+    {0xA781, UC_LOWER},
+    {0xA782, UC_UPPER},
+    {0xA783, UC_LOWER},
+    {0xA784, UC_UPPER},
+    {0xA785, UC_LOWER},
+    {0xA786, UC_UPPER},
+    {0xA787, UC_LOWER},
+    {0xA788, UC_LETTER},
+    {0xA789, UC_OTHER},
+    {0xA78B, UC_UPPER},
+    {0xA78C, UC_LOWER},
+    {0xA78D, UC_UPPER},
+    {0xA78E, UC_LOWER},
+    {0xA78F, UC_LETTER},
+    {0xA790, UC_UPPER},
+    {0xA791, UC_LOWER},
+    {0xA792, UC_UPPER},
+    {0xA793, UC_LOWER},
+    {0xA796, UC_UPPER},
+    {0xA797, UC_LOWER},
+    {0xA798, UC_UPPER},
+    {0xA799, UC_LOWER},
+    {0xA79A, UC_UPPER},
+    {0xA79B, UC_LOWER},
+    {0xA79C, UC_UPPER},
+    {0xA79D, UC_LOWER},
+    {0xA79E, UC_UPPER},
+    {0xA79F, UC_LOWER},
+    {0xA7A0, UC_UPPER},
+    {0xA7A1, UC_LOWER},
+    {0xA7A2, UC_UPPER},
+    {0xA7A3, UC_LOWER},
+    {0xA7A4, UC_UPPER},
+    {0xA7A5, UC_LOWER},
+    {0xA7A6, UC_UPPER},
+    {0xA7A7, UC_LOWER},
+    {0xA7A8, UC_UPPER},
+    {0xA7A9, UC_LOWER},
+    {0xA7AA, UC_UPPER},
+    {0xA7AF, UC_LOWER},
+    {0xA7B0, UC_UPPER},
+    {0xA7B5, UC_LOWER},
+    {0xA7B6, UC_UPPER},
+    {0xA7B7, UC_LOWER},
+    {0xA7B8, UC_UPPER},
+    {0xA7B9, UC_LOWER},
+    {0xA7BA, UC_UPPER},
+    {0xA7BB, UC_LOWER},
+    {0xA7BC, UC_UPPER},
+    {0xA7BD, UC_LOWER},
+    {0xA7BE, UC_UPPER},
+    {0xA7BF, UC_LOWER},
+    {0xA7C0, UC_UPPER},
+    {0xA7C1, UC_LOWER},
+    {0xA7C2, UC_UPPER},
+    {0xA7C3, UC_LOWER},
+    {0xA7C4, UC_UPPER},
+    {0xA7C8, UC_LOWER},
+    {0xA7C9, UC_UPPER},
+    {0xA7CA, UC_LOWER},
+    {0xA7CB, UC_OTHER},
+    {0xA7D0, UC_UPPER},
+    {0xA7D1, UC_LOWER},
+    {0xA7D2, UC_OTHER},
+    {0xA7D3, UC_LOWER},
+    {0xA7D4, UC_OTHER},
+    {0xA7D5, UC_LOWER},
+    {0xA7D6, UC_UPPER},
+    {0xA7D7, UC_LOWER},
+    {0xA7D8, UC_UPPER},
+    {0xA7D9, UC_LOWER},
+    {0xA7DA, UC_OTHER},
+    {0xA7F2, UC_LETTER},
+    {0xA7F5, UC_UPPER},
+    {0xA7F6, UC_LOWER},
+    {0xA7F7, UC_LETTER},
+    {0xA7FA, UC_LOWER},
+    {0xA7FB, UC_LETTER},
+    {0xA802, UC_MARK},
+    {0xA803, UC_LETTER},
+    {0xA806, UC_MARK},
+    {0xA807, UC_LETTER},
+    {0xA80B, UC_MARK},
+    {0xA80C, UC_LETTER},
+    {0xA823, UC_MARK},
+    {0xA828, UC_OTHER},
+    {0xA82C, UC_MARK},
+    {0xA82D, UC_OTHER},
+    {0xA830, UC_NUMBER},
+    {0xA836, UC_OTHER},
+    {0xA840, UC_LETTER},
+    {0xA874, UC_OTHER},
+    {0xA880, UC_MARK},
+    {0xA882, UC_LETTER},
+    {0xA8B4, UC_MARK},
+    {0xA8C6, UC_OTHER},
+    {0xA8D0, UC_NUMBER},
+    {0xA8DA, UC_OTHER},
+    {0xA8E0, UC_MARK},
+    {0xA8F2, UC_LETTER},
+    {0xA8F8, UC_OTHER},
+    {0xA8FB, UC_LETTER},
+    {0xA8FC, UC_OTHER},
+    {0xA8FD, UC_LETTER},
+    {0xA8FF, UC_MARK},
+    {0xA900, UC_NUMBER},
+    {0xA90A, UC_LETTER},
+    {0xA926, UC_MARK},
+    {0xA92E, UC_OTHER},
+    {0xA930, UC_LETTER},
+    {0xA947, UC_MARK},
+    {0xA954, UC_OTHER},
+    {0xA960, UC_LETTER},
+    {0xA97D, UC_OTHER},
+    {0xA980, UC_MARK},
+    {0xA984, UC_LETTER},
+    {0xA9B3, UC_MARK},
+    {0xA9C1, UC_OTHER},
+    {0xA9CF, UC_LETTER},
+    {0xA9D0, UC_NUMBER},
+    {0xA9DA, UC_OTHER},
+    {0xA9E0, UC_LETTER},
+    {0xA9E5, UC_MARK},
+    {0xA9E6, UC_LETTER},
+    {0xA9F0, UC_NUMBER},
+    {0xA9FA, UC_LETTER},
+    {0xA9FF, UC_OTHER},
+    {0xAA00, UC_LETTER},
+    {0xAA29, UC_MARK},
+    {0xAA37, UC_OTHER},
+    {0xAA40, UC_LETTER},
+    {0xAA43, UC_MARK},
+    {0xAA44, UC_LETTER},
+    {0xAA4C, UC_MARK},
+    {0xAA4E, UC_OTHER},
+    {0xAA50, UC_NUMBER},
+    {0xAA5A, UC_OTHER},
+    {0xAA60, UC_LETTER},
+    {0xAA77, UC_OTHER},
+    {0xAA7A, UC_LETTER},
+    {0xAA7B, UC_MARK},
+    {0xAA7E, UC_LETTER},
+    {0xAAB0, UC_MARK},
+    {0xAAB1, UC_LETTER},
+    {0xAAB2, UC_MARK},
+    {0xAAB5, UC_LETTER},
+    {0xAAB7, UC_MARK},
+    {0xAAB9, UC_LETTER},
+    {0xAABE, UC_MARK},
+    {0xAAC0, UC_LETTER},
+    {0xAAC1, UC_MARK},
+    {0xAAC2, UC_LETTER},
+    {0xAAC3, UC_OTHER},
+    {0xAADB, UC_LETTER},
+    {0xAADE, UC_OTHER},
+    {0xAAE0, UC_LETTER},
+    {0xAAEB, UC_MARK},
+    {0xAAF0, UC_OTHER},
+    {0xAAF2, UC_LETTER},
+    {0xAAF5, UC_MARK},
+    {0xAAF7, UC_OTHER},
+    {0xAB01, UC_LETTER},
+    {0xAB07, UC_OTHER},
+    {0xAB09, UC_LETTER},
+    {0xAB0F, UC_OTHER},
+    {0xAB11, UC_LETTER},
+    {0xAB17, UC_OTHER},
+    {0xAB20, UC_LETTER},
+    {0xAB27, UC_OTHER},
+    {0xAB28, UC_LETTER},
+    {0xAB2F, UC_OTHER},
+    {0xAB30, UC_LOWER},
+    {0xAB5B, UC_OTHER},
+    {0xAB5C, UC_LETTER},
+    {0xAB60, UC_LOWER},
+    {0xAB69, UC_LETTER},
+    {0xAB6A, UC_OTHER},
+    {0xAB70, UC_LOWER},
+    {0xABC0, UC_LETTER},
+    {0xABE3, UC_MARK},
+    {0xABEB, UC_OTHER},
+    {0xABEC, UC_MARK},
+    {0xABEE, UC_OTHER},
+    {0xABF0, UC_NUMBER},
+    {0xABFA, UC_OTHER},
+    {0xAC00, UC_LETTER},
+    {0xD7A4, UC_OTHER},
+    {0xD7B0, UC_LETTER},
+    {0xD7C7, UC_OTHER},
+    {0xD7CB, UC_LETTER},
+    {0xD7FC, UC_OTHER},
+    {0xF900, UC_LETTER},
+    {0xFA6E, UC_OTHER},
+    {0xFA70, UC_LETTER},
+    {0xFADA, UC_OTHER},
+    {0xFB00, UC_LOWER},
+    {0xFB07, UC_OTHER},
+    {0xFB13, UC_LOWER},
+    {0xFB18, UC_OTHER},
+    {0xFB1D, UC_LETTER},
+    {0xFB1E, UC_MARK},
+    {0xFB1F, UC_LETTER},
+    {0xFB29, UC_OTHER},
+    {0xFB2A, UC_LETTER},
+    {0xFB37, UC_OTHER},
+    {0xFB38, UC_LETTER},
+    {0xFB3D, UC_OTHER},
+    {0xFB3E, UC_LETTER},
+    {0xFB3F, UC_OTHER},
+    {0xFB40, UC_LETTER},
+    {0xFB42, UC_OTHER},
+    {0xFB43, UC_LETTER},
+    {0xFB45, UC_OTHER},
+    {0xFB46, UC_LETTER},
+    {0xFBB2, UC_OTHER},
+    {0xFBD3, UC_LETTER},
+    {0xFD3E, UC_OTHER},
+    {0xFD50, UC_LETTER},
+    {0xFD90, UC_OTHER},
+    {0xFD92, UC_LETTER},
+    {0xFDC8, UC_OTHER},
+    {0xFDF0, UC_LETTER},
+    {0xFDFC, UC_OTHER},
+    {0xFE00, UC_MARK},
+    {0xFE10, UC_OTHER},
+    {0xFE20, UC_MARK},
+    {0xFE30, UC_OTHER},
+    {0xFE70, UC_LETTER},
+    {0xFE75, UC_OTHER},
+    {0xFE76, UC_LETTER},
+    {0xFEFD, UC_OTHER},
+    {0xFF10, UC_NUMBER},
+    {0xFF1A, UC_OTHER},
+    {0xFF21, UC_UPPER},
+    {0xFF3B, UC_OTHER},
+    {0xFF41, UC_LOWER},
+    {0xFF5B, UC_OTHER},
+    {0xFF66, UC_LETTER},
+    {0xFFBF, UC_OTHER},
+    {0xFFC2, UC_LETTER},
+    {0xFFC8, UC_OTHER},
+    {0xFFCA, UC_LETTER},
+    {0xFFD0, UC_OTHER},
+    {0xFFD2, UC_LETTER},
+    {0xFFD8, UC_OTHER},
+    {0xFFDA, UC_LETTER},
+    {0xFFDD, UC_OTHER},
+    {0x10000, UC_LETTER},
+    {0x1000C, UC_OTHER},
+    {0x1000D, UC_LETTER},
+    {0x10027, UC_OTHER},
+    {0x10028, UC_LETTER},
+    {0x1003B, UC_OTHER},
+    {0x1003C, UC_LETTER},
+    {0x1003E, UC_OTHER},
+    {0x1003F, UC_LETTER},
+    {0x1004E, UC_OTHER},
+    {0x10050, UC_LETTER},
+    {0x1005E, UC_OTHER},
+    {0x10080, UC_LETTER},
+    {0x100FB, UC_OTHER},
+    {0x10107, UC_NUMBER},
+    {0x10134, UC_OTHER},
+    {0x10140, UC_NUMBER},
+    {0x10179, UC_OTHER},
+    {0x1018A, UC_NUMBER},
+    {0x1018C, UC_OTHER},
+    {0x101FD, UC_MARK},
+    {0x101FE, UC_OTHER},
+    {0x10280, UC_LETTER},
+    {0x1029D, UC_OTHER},
+    {0x102A0, UC_LETTER},
+    {0x102D1, UC_OTHER},
+    {0x102E0, UC_MARK},
+    {0x102E1, UC_NUMBER},
+    {0x102FC, UC_OTHER},
+    {0x10300, UC_LETTER},
+    {0x10320, UC_NUMBER},
+    {0x10324, UC_OTHER},
+    {0x1032D, UC_LETTER},
+    {0x10341, UC_NUMBER},
+    {0x10342, UC_LETTER},
+    {0x1034A, UC_NUMBER},
+    {0x1034B, UC_OTHER},
+    {0x10350, UC_LETTER},
+    {0x10376, UC_MARK},
+    {0x1037B, UC_OTHER},
+    {0x10380, UC_LETTER},
+    {0x1039E, UC_OTHER},
+    {0x103A0, UC_LETTER},
+    {0x103C4, UC_OTHER},
+    {0x103C8, UC_LETTER},
+    {0x103D0, UC_OTHER},
+    {0x103D1, UC_NUMBER},
+    {0x103D6, UC_OTHER},
+    {0x10400, UC_UPPER},
+    {0x10428, UC_LOWER},
+    {0x10450, UC_LETTER},
+    {0x1049E, UC_OTHER},
+    {0x104A0, UC_NUMBER},
+    {0x104AA, UC_OTHER},
+    {0x104B0, UC_UPPER},
+    {0x104D4, UC_OTHER},
+    {0x104D8, UC_LOWER},
+    {0x104FC, UC_OTHER},
+    {0x10500, UC_LETTER},
+    {0x10528, UC_OTHER},
+    {0x10530, UC_LETTER},
+    {0x10564, UC_OTHER},
+    {0x10570, UC_UPPER},
+    {0x1057B, UC_OTHER},
+    {0x1057C, UC_UPPER},
+    {0x1058B, UC_OTHER},
+    {0x1058C, UC_UPPER},
+    {0x10593, UC_OTHER},
+    {0x10594, UC_UPPER},
+    {0x10596, UC_OTHER},
+    {0x10597, UC_LOWER},
+    {0x105A2, UC_OTHER},
+    {0x105A3, UC_LOWER},
+    {0x105B2, UC_OTHER},
+    {0x105B3, UC_LOWER},
+    {0x105BA, UC_OTHER},
+    {0x105BB, UC_LOWER},
+    {0x105BD, UC_OTHER},
+    {0x10600, UC_LETTER},
+    {0x10737, UC_OTHER},
+    {0x10740, UC_LETTER},
+    {0x10756, UC_OTHER},
+    {0x10760, UC_LETTER},
+    {0x10768, UC_OTHER},
+    {0x10780, UC_LETTER},
+    {0x10786, UC_OTHER},
+    {0x10787, UC_LETTER},
+    {0x107B1, UC_OTHER},
+    {0x107B2, UC_LETTER},
+    {0x107BB, UC_OTHER},
+    {0x10800, UC_LETTER},
+    {0x10806, UC_OTHER},
+    {0x10808, UC_LETTER},
+    {0x10809, UC_OTHER},
+    {0x1080A, UC_LETTER},
+    {0x10836, UC_OTHER},
+    {0x10837, UC_LETTER},
+    {0x10839, UC_OTHER},
+    {0x1083C, UC_LETTER},
+    {0x1083D, UC_OTHER},
+    {0x1083F, UC_LETTER},
+    {0x10856, UC_OTHER},
+    {0x10858, UC_NUMBER},
+    {0x10860, UC_LETTER},
+    {0x10877, UC_OTHER},
+    {0x10879, UC_NUMBER},
+    {0x10880, UC_LETTER},
+    {0x1089F, UC_OTHER},
+    {0x108A7, UC_NUMBER},
+    {0x108B0, UC_OTHER},
+    {0x108E0, UC_LETTER},
+    {0x108F3, UC_OTHER},
+    {0x108F4, UC_LETTER},
+    {0x108F6, UC_OTHER},
+    {0x108FB, UC_NUMBER},
+    {0x10900, UC_LETTER},
+    {0x10916, UC_NUMBER},
+    {0x1091C, UC_OTHER},
+    {0x10920, UC_LETTER},
+    {0x1093A, UC_OTHER},
+    {0x10980, UC_LETTER},
+    {0x109B8, UC_OTHER},
+    {0x109BC, UC_NUMBER},
+    {0x109BE, UC_LETTER},
+    {0x109C0, UC_NUMBER},
+    {0x109D0, UC_OTHER},
+    {0x109D2, UC_NUMBER},
+    {0x10A00, UC_LETTER},
+    {0x10A01, UC_MARK},
+    {0x10A04, UC_OTHER},
+    {0x10A05, UC_MARK},
+    {0x10A07, UC_OTHER},
+    {0x10A0C, UC_MARK},
+    {0x10A10, UC_LETTER},
+    {0x10A14, UC_OTHER},
+    {0x10A15, UC_LETTER},
+    {0x10A18, UC_OTHER},
+    {0x10A19, UC_LETTER},
+    {0x10A36, UC_OTHER},
+    {0x10A38, UC_MARK},
+    {0x10A3B, UC_OTHER},
+    {0x10A3F, UC_MARK},
+    {0x10A40, UC_NUMBER},
+    {0x10A49, UC_OTHER},
+    {0x10A60, UC_LETTER},
+    {0x10A7D, UC_NUMBER},
+    {0x10A7F, UC_OTHER},
+    {0x10A80, UC_LETTER},
+    {0x10A9D, UC_NUMBER},
+    {0x10AA0, UC_OTHER},
+    {0x10AC0, UC_LETTER},
+    {0x10AC8, UC_OTHER},
+    {0x10AC9, UC_LETTER},
+    {0x10AE5, UC_MARK},
+    {0x10AE7, UC_OTHER},
+    {0x10AEB, UC_NUMBER},
+    {0x10AF0, UC_OTHER},
+    {0x10B00, UC_LETTER},
+    {0x10B36, UC_OTHER},
+    {0x10B40, UC_LETTER},
+    {0x10B56, UC_OTHER},
+    {0x10B58, UC_NUMBER},
+    {0x10B60, UC_LETTER},
+    {0x10B73, UC_OTHER},
+    {0x10B78, UC_NUMBER},
+    {0x10B80, UC_LETTER},
+    {0x10B92, UC_OTHER},
+    {0x10BA9, UC_NUMBER},
+    {0x10BB0, UC_OTHER},
+    {0x10C00, UC_LETTER},
+    {0x10C49, UC_OTHER},
+    {0x10C80, UC_UPPER},
+    {0x10CB3, UC_OTHER},
+    {0x10CC0, UC_LOWER},
+    {0x10CF3, UC_OTHER},
+    {0x10CFA, UC_NUMBER},
+    {0x10D00, UC_LETTER},
+    {0x10D24, UC_MARK},
+    {0x10D28, UC_OTHER},
+    {0x10D30, UC_NUMBER},
+    {0x10D3A, UC_OTHER},
+    {0x10E60, UC_NUMBER},
+    {0x10E7F, UC_OTHER},
+    {0x10E80, UC_LETTER},
+    {0x10EAA, UC_OTHER},
+    {0x10EAB, UC_MARK},
+    {0x10EAD, UC_OTHER},
+    {0x10EB0, UC_LETTER},
+    {0x10EB2, UC_OTHER},
+    {0x10F00, UC_LETTER},
+    {0x10F1D, UC_NUMBER},
+    {0x10F27, UC_LETTER},
+    {0x10F28, UC_OTHER},
+    {0x10F30, UC_LETTER},
+    {0x10F46, UC_MARK},
+    {0x10F51, UC_NUMBER},
+    {0x10F55, UC_OTHER},
+    {0x10F70, UC_LETTER},
+    {0x10F82, UC_MARK},
+    {0x10F86, UC_OTHER},
+    {0x10FB0, UC_LETTER},
+    {0x10FC5, UC_NUMBER},
+    {0x10FCC, UC_OTHER},
+    {0x10FE0, UC_LETTER},
+    {0x10FF7, UC_OTHER},
+    {0x11000, UC_MARK},
+    {0x11003, UC_LETTER},
+    {0x11038, UC_MARK},
+    {0x11047, UC_OTHER},
+    {0x11052, UC_NUMBER},
+    {0x11070, UC_MARK},
+    {0x11071, UC_LETTER},
+    {0x11073, UC_MARK},
+    {0x11075, UC_LETTER},
+    {0x11076, UC_OTHER},
+    {0x1107F, UC_MARK},
+    {0x11083, UC_LETTER},
+    {0x110B0, UC_MARK},
+    {0x110BB, UC_OTHER},
+    {0x110C2, UC_MARK},
+    {0x110C3, UC_OTHER},
+    {0x110D0, UC_LETTER},
+    {0x110E9, UC_OTHER},
+    {0x110F0, UC_NUMBER},
+    {0x110FA, UC_OTHER},
+    {0x11100, UC_MARK},
+    {0x11103, UC_LETTER},
+    {0x11127, UC_MARK},
+    {0x11135, UC_OTHER},
+    {0x11136, UC_NUMBER},
+    {0x11140, UC_OTHER},
+    {0x11144, UC_LETTER},
+    {0x11145, UC_MARK},
+    {0x11147, UC_LETTER},
+    {0x11148, UC_OTHER},
+    {0x11150, UC_LETTER},
+    {0x11173, UC_MARK},
+    {0x11174, UC_OTHER},
+    {0x11176, UC_LETTER},
+    {0x11177, UC_OTHER},
+    {0x11180, UC_MARK},
+    {0x11183, UC_LETTER},
+    {0x111B3, UC_MARK},
+    {0x111C1, UC_LETTER},
+    {0x111C5, UC_OTHER},
+    {0x111C9, UC_MARK},
+    {0x111CD, UC_OTHER},
+    {0x111CE, UC_MARK},
+    {0x111D0, UC_NUMBER},
+    {0x111DA, UC_LETTER},
+    {0x111DB, UC_OTHER},
+    {0x111DC, UC_LETTER},
+    {0x111DD, UC_OTHER},
+    {0x111E1, UC_NUMBER},
+    {0x111F5, UC_OTHER},
+    {0x11200, UC_LETTER},
+    {0x11212, UC_OTHER},
+    {0x11213, UC_LETTER},
+    {0x1122C, UC_MARK},
+    {0x11238, UC_OTHER},
+    {0x1123E, UC_MARK},
+    {0x1123F, UC_OTHER},
+    {0x11280, UC_LETTER},
+    {0x11287, UC_OTHER},
+    {0x11288, UC_LETTER},
+    {0x11289, UC_OTHER},
+    {0x1128A, UC_LETTER},
+    {0x1128E, UC_OTHER},
+    {0x1128F, UC_LETTER},
+    {0x1129E, UC_OTHER},
+    {0x1129F, UC_LETTER},
+    {0x112A9, UC_OTHER},
+    {0x112B0, UC_LETTER},
+    {0x112DF, UC_MARK},
+    {0x112EB, UC_OTHER},
+    {0x112F0, UC_NUMBER},
+    {0x112FA, UC_OTHER},
+    {0x11300, UC_MARK},
+    {0x11304, UC_OTHER},
+    {0x11305, UC_LETTER},
+    {0x1130D, UC_OTHER},
+    {0x1130F, UC_LETTER},
+    {0x11311, UC_OTHER},
+    {0x11313, UC_LETTER},
+    {0x11329, UC_OTHER},
+    {0x1132A, UC_LETTER},
+    {0x11331, UC_OTHER},
+    {0x11332, UC_LETTER},
+    {0x11334, UC_OTHER},
+    {0x11335, UC_LETTER},
+    {0x1133A, UC_OTHER},
+    {0x1133B, UC_MARK},
+    {0x1133D, UC_LETTER},
+    {0x1133E, UC_MARK},
+    {0x11345, UC_OTHER},
+    {0x11347, UC_MARK},
+    {0x11349, UC_OTHER},
+    {0x1134B, UC_MARK},
+    {0x1134E, UC_OTHER},
+    {0x11350, UC_LETTER},
+    {0x11351, UC_OTHER},
+    {0x11357, UC_MARK},
+    {0x11358, UC_OTHER},
+    {0x1135D, UC_LETTER},
+    {0x11362, UC_MARK},
+    {0x11364, UC_OTHER},
+    {0x11366, UC_MARK},
+    {0x1136D, UC_OTHER},
+    {0x11370, UC_MARK},
+    {0x11375, UC_OTHER},
+    {0x11400, UC_LETTER},
+    {0x11435, UC_MARK},
+    {0x11447, UC_LETTER},
+    {0x1144B, UC_OTHER},
+    {0x11450, UC_NUMBER},
+    {0x1145A, UC_OTHER},
+    {0x1145E, UC_MARK},
+    {0x1145F, UC_LETTER},
+    {0x11462, UC_OTHER},
+    {0x11480, UC_LETTER},
+    {0x114B0, UC_MARK},
+    {0x114C4, UC_LETTER},
+    {0x114C6, UC_OTHER},
+    {0x114C7, UC_LETTER},
+    {0x114C8, UC_OTHER},
+    {0x114D0, UC_NUMBER},
+    {0x114DA, UC_OTHER},
+    {0x11580, UC_LETTER},
+    {0x115AF, UC_MARK},
+    {0x115B6, UC_OTHER},
+    {0x115B8, UC_MARK},
+    {0x115C1, UC_OTHER},
+    {0x115D8, UC_LETTER},
+    {0x115DC, UC_MARK},
+    {0x115DE, UC_OTHER},
+    {0x11600, UC_LETTER},
+    {0x11630, UC_MARK},
+    {0x11641, UC_OTHER},
+    {0x11644, UC_LETTER},
+    {0x11645, UC_OTHER},
+    {0x11650, UC_NUMBER},
+    {0x1165A, UC_OTHER},
+    {0x11680, UC_LETTER},
+    {0x116AB, UC_MARK},
+    {0x116B8, UC_LETTER},
+    {0x116B9, UC_OTHER},
+    {0x116C0, UC_NUMBER},
+    {0x116CA, UC_OTHER},
+    {0x11700, UC_LETTER},
+    {0x1171B, UC_OTHER},
+    {0x1171D, UC_MARK},
+    {0x1172C, UC_OTHER},
+    {0x11730, UC_NUMBER},
+    {0x1173C, UC_OTHER},
+    {0x11740, UC_LETTER},
+    {0x11747, UC_OTHER},
+    {0x11800, UC_LETTER},
+    {0x1182C, UC_MARK},
+    {0x1183B, UC_OTHER},
+    {0x118A0, UC_UPPER},
+    {0x118C0, UC_LOWER},
+    {0x118E0, UC_NUMBER},
+    {0x118F3, UC_OTHER},
+    {0x118FF, UC_LETTER},
+    {0x11907, UC_OTHER},
+    {0x11909, UC_LETTER},
+    {0x1190A, UC_OTHER},
+    {0x1190C, UC_LETTER},
+    {0x11914, UC_OTHER},
+    {0x11915, UC_LETTER},
+    {0x11917, UC_OTHER},
+    {0x11918, UC_LETTER},
+    {0x11930, UC_MARK},
+    {0x11936, UC_OTHER},
+    {0x11937, UC_MARK},
+    {0x11939, UC_OTHER},
+    {0x1193B, UC_MARK},
+    {0x1193F, UC_LETTER},
+    {0x11940, UC_MARK},
+    {0x11941, UC_LETTER},
+    {0x11942, UC_MARK},
+    {0x11944, UC_OTHER},
+    {0x11950, UC_NUMBER},
+    {0x1195A, UC_OTHER},
+    {0x119A0, UC_LETTER},
+    {0x119A8, UC_OTHER},
+    {0x119AA, UC_LETTER},
+    {0x119D1, UC_MARK},
+    {0x119D8, UC_OTHER},
+    {0x119DA, UC_MARK},
+    {0x119E1, UC_LETTER},
+    {0x119E2, UC_OTHER},
+    {0x119E3, UC_LETTER},
+    {0x119E4, UC_MARK},
+    {0x119E5, UC_OTHER},
+    {0x11A00, UC_LETTER},
+    {0x11A01, UC_MARK},
+    {0x11A0B, UC_LETTER},
+    {0x11A33, UC_MARK},
+    {0x11A3A, UC_LETTER},
+    {0x11A3B, UC_MARK},
+    {0x11A3F, UC_OTHER},
+    {0x11A47, UC_MARK},
+    {0x11A48, UC_OTHER},
+    {0x11A50, UC_LETTER},
+    {0x11A51, UC_MARK},
+    {0x11A5C, UC_LETTER},
+    {0x11A8A, UC_MARK},
+    {0x11A9A, UC_OTHER},
+    {0x11A9D, UC_LETTER},
+    {0x11A9E, UC_OTHER},
+    {0x11AB0, UC_LETTER},
+    {0x11AF9, UC_OTHER},
+    {0x11C00, UC_LETTER},
+    {0x11C09, UC_OTHER},
+    {0x11C0A, UC_LETTER},
+    {0x11C2F, UC_MARK},
+    {0x11C37, UC_OTHER},
+    {0x11C38, UC_MARK},
+    {0x11C40, UC_LETTER},
+    {0x11C41, UC_OTHER},
+    {0x11C50, UC_NUMBER},
+    {0x11C6D, UC_OTHER},
+    {0x11C72, UC_LETTER},
+    {0x11C90, UC_OTHER},
+    {0x11C92, UC_MARK},
+    {0x11CA8, UC_OTHER},
+    {0x11CA9, UC_MARK},
+    {0x11CB7, UC_OTHER},
+    {0x11D00, UC_LETTER},
+    {0x11D07, UC_OTHER},
+    {0x11D08, UC_LETTER},
+    {0x11D0A, UC_OTHER},
+    {0x11D0B, UC_LETTER},
+    {0x11D31, UC_MARK},
+    {0x11D37, UC_OTHER},
+    {0x11D3A, UC_MARK},
+    {0x11D3B, UC_OTHER},
+    {0x11D3C, UC_MARK},
+    {0x11D3E, UC_OTHER},
+    {0x11D3F, UC_MARK},
+    {0x11D46, UC_LETTER},
+    {0x11D47, UC_MARK},
+    {0x11D48, UC_OTHER},
+    {0x11D50, UC_NUMBER},
+    {0x11D5A, UC_OTHER},
+    {0x11D60, UC_LETTER},
+    {0x11D66, UC_OTHER},
+    {0x11D67, UC_LETTER},
+    {0x11D69, UC_OTHER},
+    {0x11D6A, UC_LETTER},
+    {0x11D8A, UC_MARK},
+    {0x11D8F, UC_OTHER},
+    {0x11D90, UC_MARK},
+    {0x11D92, UC_OTHER},
+    {0x11D93, UC_MARK},
+    {0x11D98, UC_LETTER},
+    {0x11D99, UC_OTHER},
+    {0x11DA0, UC_NUMBER},
+    {0x11DAA, UC_OTHER},
+    {0x11EE0, UC_LETTER},
+    {0x11EF3, UC_MARK},
+    {0x11EF7, UC_OTHER},
+    {0x11FB0, UC_LETTER},
+    {0x11FB1, UC_OTHER},
+    {0x11FC0, UC_NUMBER},
+    {0x11FD5, UC_OTHER},
+    {0x12000, UC_LETTER},
+    {0x1239A, UC_OTHER},
+    {0x12400, UC_NUMBER},
+    {0x1246F, UC_OTHER},
+    {0x12480, UC_LETTER},
+    {0x12544, UC_OTHER},
+    {0x12F90, UC_LETTER},
+    {0x12FF1, UC_OTHER},
+    {0x13000, UC_LETTER},
+    {0x1342F, UC_OTHER},
+    {0x14400, UC_LETTER},
+    {0x14647, UC_OTHER},
+    {0x16800, UC_LETTER},
+    {0x16A39, UC_OTHER},
+    {0x16A40, UC_LETTER},
+    {0x16A5F, UC_OTHER},
+    {0x16A60, UC_NUMBER},
+    {0x16A6A, UC_OTHER},
+    {0x16A70, UC_LETTER},
+    {0x16ABF, UC_OTHER},
+    {0x16AC0, UC_NUMBER},
+    {0x16ACA, UC_OTHER},
+    {0x16AD0, UC_LETTER},
+    {0x16AEE, UC_OTHER},
+    {0x16AF0, UC_MARK},
+    {0x16AF5, UC_OTHER},
+    {0x16B00, UC_LETTER},
+    {0x16B30, UC_MARK},
+    {0x16B37, UC_OTHER},
+    {0x16B40, UC_LETTER},
+    {0x16B44, UC_OTHER},
+    {0x16B50, UC_NUMBER},
+    {0x16B5A, UC_OTHER},
+    {0x16B5B, UC_NUMBER},
+    {0x16B62, UC_OTHER},
+    {0x16B63, UC_LETTER},
+    {0x16B78, UC_OTHER},
+    {0x16B7D, UC_LETTER},
+    {0x16B90, UC_OTHER},
+    {0x16E40, UC_UPPER},
+    {0x16E60, UC_LOWER},
+    {0x16E80, UC_NUMBER},
+    {0x16E97, UC_OTHER},
+    {0x16F00, UC_LETTER},
+    {0x16F4B, UC_OTHER},
+    {0x16F4F, UC_MARK},
+    {0x16F50, UC_LETTER},
+    {0x16F51, UC_MARK},
+    {0x16F88, UC_OTHER},
+    {0x16F8F, UC_MARK},
+    {0x16F93, UC_LETTER},
+    {0x16FA0, UC_OTHER},
+    {0x16FE0, UC_LETTER},
+    {0x16FE2, UC_OTHER},
+    {0x16FE3, UC_LETTER},
+    {0x16FE4, UC_MARK},
+    {0x16FE5, UC_OTHER},
+    {0x16FF0, UC_MARK},
+    {0x16FF2, UC_OTHER},
+    {0x17000, UC_LETTER},
+    {0x187F8, UC_OTHER},
+    {0x18800, UC_LETTER},
+    {0x18CD6, UC_OTHER},
+    {0x18D00, UC_LETTER},
+    {0x18D09, UC_OTHER},
+    {0x1AFF0, UC_LETTER},
+    {0x1AFF4, UC_OTHER},
+    {0x1AFF5, UC_LETTER},
+    {0x1AFFC, UC_OTHER},
+    {0x1AFFD, UC_LETTER},
+    {0x1AFFF, UC_OTHER},
+    {0x1B000, UC_LETTER},
+    {0x1B123, UC_OTHER},
+    {0x1B150, UC_LETTER},
+    {0x1B153, UC_OTHER},
+    {0x1B164, UC_LETTER},
+    {0x1B168, UC_OTHER},
+    {0x1B170, UC_LETTER},
+    {0x1B2FC, UC_OTHER},
+    {0x1BC00, UC_LETTER},
+    {0x1BC6B, UC_OTHER},
+    {0x1BC70, UC_LETTER},
+    {0x1BC7D, UC_OTHER},
+    {0x1BC80, UC_LETTER},
+    {0x1BC89, UC_OTHER},
+    {0x1BC90, UC_LETTER},
+    {0x1BC9A, UC_OTHER},
+    {0x1BC9D, UC_MARK},
+    {0x1BC9F, UC_OTHER},
+    {0x1CF00, UC_MARK},
+    {0x1CF2E, UC_OTHER},
+    {0x1CF30, UC_MARK},
+    {0x1CF47, UC_OTHER},
+    {0x1D165, UC_MARK},
+    {0x1D16A, UC_OTHER},
+    {0x1D16D, UC_MARK},
+    {0x1D173, UC_OTHER},
+    {0x1D17B, UC_MARK},
+    {0x1D183, UC_OTHER},
+    {0x1D185, UC_MARK},
+    {0x1D18C, UC_OTHER},
+    {0x1D1AA, UC_MARK},
+    {0x1D1AE, UC_OTHER},
+    {0x1D242, UC_MARK},
+    {0x1D245, UC_OTHER},
+    {0x1D2E0, UC_NUMBER},
+    {0x1D2F4, UC_OTHER},
+    {0x1D360, UC_NUMBER},
+    {0x1D379, UC_OTHER},
+    {0x1D400, UC_UPPER},
+    {0x1D41A, UC_LOWER},
+    {0x1D434, UC_UPPER},
+    {0x1D44E, UC_LOWER},
+    {0x1D455, UC_OTHER},
+    {0x1D456, UC_LOWER},
+    {0x1D468, UC_UPPER},
+    {0x1D482, UC_LOWER},
+    {0x1D49C, UC_UPPER},
+    {0x1D49D, UC_OTHER},
+    {0x1D49E, UC_UPPER},
+    {0x1D4A0, UC_OTHER},
+    {0x1D4A2, UC_UPPER},
+    {0x1D4A3, UC_OTHER},
+    {0x1D4A5, UC_UPPER},
+    {0x1D4A7, UC_OTHER},
+    {0x1D4A9, UC_UPPER},
+    {0x1D4AD, UC_OTHER},
+    {0x1D4AE, UC_UPPER},
+    {0x1D4B6, UC_LOWER},
+    {0x1D4BA, UC_OTHER},
+    {0x1D4BB, UC_LOWER},
+    {0x1D4BC, UC_OTHER},
+    {0x1D4BD, UC_LOWER},
+    {0x1D4C4, UC_OTHER},
+    {0x1D4C5, UC_LOWER},
+    {0x1D4D0, UC_UPPER},
+    {0x1D4EA, UC_LOWER},
+    {0x1D504, UC_UPPER},
+    {0x1D506, UC_OTHER},
+    {0x1D507, UC_UPPER},
+    {0x1D50B, UC_OTHER},
+    {0x1D50D, UC_UPPER},
+    {0x1D515, UC_OTHER},
+    {0x1D516, UC_UPPER},
+    {0x1D51D, UC_OTHER},
+    {0x1D51E, UC_LOWER},
+    {0x1D538, UC_UPPER},
+    {0x1D53A, UC_OTHER},
+    {0x1D53B, UC_UPPER},
+    {0x1D53F, UC_OTHER},
+    {0x1D540, UC_UPPER},
+    {0x1D545, UC_OTHER},
+    {0x1D546, UC_UPPER},
+    {0x1D547, UC_OTHER},
+    {0x1D54A, UC_UPPER},
+    {0x1D551, UC_OTHER},
+    {0x1D552, UC_LOWER},
+    {0x1D56C, UC_UPPER},
+    {0x1D586, UC_LOWER},
+    {0x1D5A0, UC_UPPER},
+    {0x1D5BA, UC_LOWER},
+    {0x1D5D4, UC_UPPER},
+    {0x1D5EE, UC_LOWER},
+    {0x1D608, UC_UPPER},
+    {0x1D622, UC_LOWER},
+    {0x1D63C, UC_UPPER},
+    {0x1D656, UC_LOWER},
+    {0x1D670, UC_UPPER},
+    {0x1D68A, UC_LOWER},
+    {0x1D6A6, UC_OTHER},
+    {0x1D6A8, UC_UPPER},
+    {0x1D6C1, UC_OTHER},
+    {0x1D6C2, UC_LOWER},
+    {0x1D6DB, UC_OTHER},
+    {0x1D6DC, UC_LOWER},
+    {0x1D6E2, UC_UPPER},
+    {0x1D6FB, UC_OTHER},
+    {0x1D6FC, UC_LOWER},
+    {0x1D715, UC_OTHER},
+    {0x1D716, UC_LOWER},
+    {0x1D71C, UC_UPPER},
+    {0x1D735, UC_OTHER},
+    {0x1D736, UC_LOWER},
+    {0x1D74F, UC_OTHER},
+    {0x1D750, UC_LOWER},
+    {0x1D756, UC_UPPER},
+    {0x1D76F, UC_OTHER},
+    {0x1D770, UC_LOWER},
+    {0x1D789, UC_OTHER},
+    {0x1D78A, UC_LOWER},
+    {0x1D790, UC_UPPER},
+    {0x1D7A9, UC_OTHER},
+    {0x1D7AA, UC_LOWER},
+    {0x1D7C3, UC_OTHER},
+    {0x1D7C4, UC_LOWER},
+    {0x1D7CA, UC_UPPER},
+    {0x1D7CB, UC_LOWER},
+    {0x1D7CC, UC_OTHER},
+    {0x1D7CE, UC_NUMBER},
+    {0x1D800, UC_OTHER},
+    {0x1DA00, UC_MARK},
+    {0x1DA37, UC_OTHER},
+    {0x1DA3B, UC_MARK},
+    {0x1DA6D, UC_OTHER},
+    {0x1DA75, UC_MARK},
+    {0x1DA76, UC_OTHER},
+    {0x1DA84, UC_MARK},
+    {0x1DA85, UC_OTHER},
+    {0x1DA9B, UC_MARK},
+    {0x1DAA0, UC_OTHER},
+    {0x1DAA1, UC_MARK},
+    {0x1DAB0, UC_OTHER},
+    {0x1DF00, UC_LOWER},
+    {0x1DF0A, UC_LETTER},
+    {0x1DF0B, UC_LOWER},
+    {0x1DF1F, UC_OTHER},
+    {0x1E000, UC_MARK},
+    {0x1E007, UC_OTHER},
+    {0x1E008, UC_MARK},
+    {0x1E019, UC_OTHER},
+    {0x1E01B, UC_MARK},
+    {0x1E022, UC_OTHER},
+    {0x1E023, UC_MARK},
+    {0x1E025, UC_OTHER},
+    {0x1E026, UC_MARK},
+    {0x1E02B, UC_OTHER},
+    {0x1E100, UC_LETTER},
+    {0x1E12D, UC_OTHER},
+    {0x1E130, UC_MARK},
+    {0x1E137, UC_LETTER},
+    {0x1E13E, UC_OTHER},
+    {0x1E140, UC_NUMBER},
+    {0x1E14A, UC_OTHER},
+    {0x1E14E, UC_LETTER},
+    {0x1E14F, UC_OTHER},
+    {0x1E290, UC_LETTER},
+    {0x1E2AE, UC_MARK},
+    {0x1E2AF, UC_OTHER},
+    {0x1E2C0, UC_LETTER},
+    {0x1E2EC, UC_MARK},
+    {0x1E2F0, UC_NUMBER},
+    {0x1E2FA, UC_OTHER},
+    {0x1E7E0, UC_LETTER},
+    {0x1E7E7, UC_OTHER},
+    {0x1E7E8, UC_LETTER},
+    {0x1E7EC, UC_OTHER},
+    {0x1E7ED, UC_LETTER},
+    {0x1E7EF, UC_OTHER},
+    {0x1E7F0, UC_LETTER},
+    {0x1E7FF, UC_OTHER},
+    {0x1E800, UC_LETTER},
+    {0x1E8C5, UC_OTHER},
+    {0x1E8C7, UC_NUMBER},
+    {0x1E8D0, UC_MARK},
+    {0x1E8D7, UC_OTHER},
+    {0x1E900, UC_UPPER},
+    {0x1E922, UC_LOWER},
+    {0x1E944, UC_MARK},
+    {0x1E94B, UC_LETTER},
+    {0x1E94C, UC_OTHER},
+    {0x1E950, UC_NUMBER},
+    {0x1E95A, UC_OTHER},
+    {0x1EC71, UC_NUMBER},
+    {0x1ECAC, UC_OTHER},
+    {0x1ECAD, UC_NUMBER},
+    {0x1ECB0, UC_OTHER},
+    {0x1ECB1, UC_NUMBER},
+    {0x1ECB5, UC_OTHER},
+    {0x1ED01, UC_NUMBER},
+    {0x1ED2E, UC_OTHER},
+    {0x1ED2F, UC_NUMBER},
+    {0x1ED3E, UC_OTHER},
+    {0x1EE00, UC_LETTER},
+    {0x1EE04, UC_OTHER},
+    {0x1EE05, UC_LETTER},
+    {0x1EE20, UC_OTHER},
+    {0x1EE21, UC_LETTER},
+    {0x1EE23, UC_OTHER},
+    {0x1EE24, UC_LETTER},
+    {0x1EE25, UC_OTHER},
+    {0x1EE27, UC_LETTER},
+    {0x1EE28, UC_OTHER},
+    {0x1EE29, UC_LETTER},
+    {0x1EE33, UC_OTHER},
+    {0x1EE34, UC_LETTER},
+    {0x1EE38, UC_OTHER},
+    {0x1EE39, UC_LETTER},
+    {0x1EE3A, UC_OTHER},
+    {0x1EE3B, UC_LETTER},
+    {0x1EE3C, UC_OTHER},
+    {0x1EE42, UC_LETTER},
+    {0x1EE43, UC_OTHER},
+    {0x1EE47, UC_LETTER},
+    {0x1EE48, UC_OTHER},
+    {0x1EE49, UC_LETTER},
+    {0x1EE4A, UC_OTHER},
+    {0x1EE4B, UC_LETTER},
+    {0x1EE4C, UC_OTHER},
+    {0x1EE4D, UC_LETTER},
+    {0x1EE50, UC_OTHER},
+    {0x1EE51, UC_LETTER},
+    {0x1EE53, UC_OTHER},
+    {0x1EE54, UC_LETTER},
+    {0x1EE55, UC_OTHER},
+    {0x1EE57, UC_LETTER},
+    {0x1EE58, UC_OTHER},
+    {0x1EE59, UC_LETTER},
+    {0x1EE5A, UC_OTHER},
+    {0x1EE5B, UC_LETTER},
+    {0x1EE5C, UC_OTHER},
+    {0x1EE5D, UC_LETTER},
+    {0x1EE5E, UC_OTHER},
+    {0x1EE5F, UC_LETTER},
+    {0x1EE60, UC_OTHER},
+    {0x1EE61, UC_LETTER},
+    {0x1EE63, UC_OTHER},
+    {0x1EE64, UC_LETTER},
+    {0x1EE65, UC_OTHER},
+    {0x1EE67, UC_LETTER},
+    {0x1EE6B, UC_OTHER},
+    {0x1EE6C, UC_LETTER},
+    {0x1EE73, UC_OTHER},
+    {0x1EE74, UC_LETTER},
+    {0x1EE78, UC_OTHER},
+    {0x1EE79, UC_LETTER},
+    {0x1EE7D, UC_OTHER},
+    {0x1EE7E, UC_LETTER},
+    {0x1EE7F, UC_OTHER},
+    {0x1EE80, UC_LETTER},
+    {0x1EE8A, UC_OTHER},
+    {0x1EE8B, UC_LETTER},
+    {0x1EE9C, UC_OTHER},
+    {0x1EEA1, UC_LETTER},
+    {0x1EEA4, UC_OTHER},
+    {0x1EEA5, UC_LETTER},
+    {0x1EEAA, UC_OTHER},
+    {0x1EEAB, UC_LETTER},
+    {0x1EEBC, UC_OTHER},
+    {0x1F100, UC_NUMBER},
+    {0x1F10D, UC_OTHER},
+    {0x1FBF0, UC_NUMBER},
+    {0x1FBFA, UC_OTHER},
+    {0x20000, UC_LETTER},
+    {0x2A6E0, UC_OTHER},
+    {0x2A700, UC_LETTER},
+    {0x2B739, UC_OTHER},
+    {0x2B740, UC_LETTER},
+    {0x2B81E, UC_OTHER},
+    {0x2B820, UC_LETTER},
+    {0x2CEA2, UC_OTHER},
+    {0x2CEB0, UC_LETTER},
+    {0x2EBE1, UC_OTHER},
+    {0x2F800, UC_LETTER},
+    {0x2FA1E, UC_OTHER},
+    {0x30000, UC_LETTER},
+    {0x3134B, UC_OTHER},
+    {0xE0100, UC_MARK},
+    {0xE01F0, UC_OTHER},
+};
+static const size_t UNICODE_CLASS_RANGE_COUNT = 3086;
+
+#endif // UNICODE_CLASSES_H
@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "update.h"
+#include "writer.h"
+#include "split.h"
+#include "dirdoc.h"
+
+static const char doc_title[] = "# Documentation Summary\n\n";
+static const char doc_split_note[] = "Note: This document has been split";
+static const char doc_heading[] = "\n# Directory Documentation: ";
+static const char doc_contents[] = "\n## Contents\n\n";
+static const char section_marker[] = SPLIT_SECTION_MARKER " ";
+
+/**
+ * @brief Finds a byte string (memmem() is not available everywhere).
+ *
+ * @param hay Bytes to search.
+ * @param hay_len Number of bytes.
+ * @param needle String to find; not empty.
+ * @param needle_len Length of the string.
+ * @return const char* First occurrence, or NULL.
+ */
+static const char *find_bytes(const char *hay, size_t hay_len, const char *needle, size_t needle_len) {
+    const char *end = hay + hay_len;
+    while ((size_t)(end - hay) >= needle_len) {
+        const char *p = memchr(hay, needle[0], (size_t)(end - hay) - needle_len + 1);
+        if (!p) {
+            return NULL;
+        }
+        if (memcmp(p, needle, needle_len) == 0) {
+            return p;
+        }
+        hay = p + 1;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Parses the file section that starts at pos.
+ *
+ * A fenced body ends at the first line that holds exactly as many backticks
+ * as the opening fence: the writer makes the fence longer than any backtick
+ * run in the text, so no such line occurs inside it.
+ *
+ * @param data Document.
+ * @param size Document size.
+ * @param pos Start of the section heading.
+ * @param section Section to fill.
+ * @return bool false if the bytes at pos are not a section as the writer writes it.
+ */
+static bool parse_section(const char *data, size_t size, size_t pos, DocSection *section) {
+    size_t marker = sizeof(section_marker) - 1;
+    if (size - pos < marker || memcmp(data + pos, section_marker, marker) != 0) {
+        return false;
+    }
+    const char *eol = memchr(data + pos, '\n', size - pos);
+    if (!eol || (size_t)(eol - data) + 1 >= size || eol[1] != '\n') {
+        return false;
+    }
+    section->offset = pos;
+    section->path = data + pos + marker;
+    section->path_len = (size_t)(eol - section->path);
+    size_t body = (size_t)(eol - data) + 2;
+
+    int fence = 0;
+    while (body + fence < size && data[body + fence] == '`') {
+        fence++;
+    }
+    if (fence < 3) {
+        // Binary or error note, then the blank line
+        const char *end = find_bytes(data + body, size - body, "\n\n", 2);
+        if (!end) {
+            return false;
+        }
+        section->fence = 0;
+        section->text_offset = 0;
+        section->text_length = 0;
+        section->text_last = '\n';
+        section->length = (size_t)(end - data) + 2 - pos;
+        return true;
+    }
+    const char *fence_eol = memchr(data + body, '\n', size - body);
+    if (!fence_eol) {
+        return false;
+    }
+    size_t text = (size_t)(fence_eol - data) + 1;
+
+    // "\n" + fence + "\n": the line feed before the closing fence ends the
+    // opening fence line when the text is empty
+    char *closing = malloc((size_t)fence + 2);
+    if (!closing) {
+        return false;
+    }
+    closing[0] = '\n';
+    memset(closing + 1, '`', (size_t)fence);
+    closing[fence + 1] = '\n';
+    const char *close = find_bytes(data + text - 1, size - (text - 1), closing, (size_t)fence + 2);
+    free(closing);
+    size_t end = close ? (size_t)(close - data) + (size_t)fence + 2 : size;
+    if (end >= size || data[end] != '\n') {
+        return false;
+    }
+    section->fence = fence;
+    section->text_offset = text;
+    section->text_length = (size_t)(close - data) + 1 - text;
+    section->text_last = section->text_length ? data[text + section->text_length - 1] : '\n';
+    section->length = end + 1 - pos;
+    return true;
+}
+
+/**
+ * @brief Orders sections by path.
+ *
+ * @param a First DocSection.
+ * @param b Second DocSection.
+ * @return int Comparison result, as for strcmp().
+ */
+static int compare_sections(const void *a, const void *b) {
+    const DocSection *x = (const DocSection*)a;
+    const DocSection *y = (const DocSection*)b;
+    size_t n = x->path_len < y->path_len ? x->path_len : y->path_len;
+    int c = memcmp(x->path, y->path, n);
+    if (c != 0) {
+        return c;
+    }
+    return (x->path_len > y->path_len) - (x->path_len < y->path_len);
+}
+
+/**
+ * @brief Maps a single-part dirdoc document and indexes its file sections.
+ *
+ * @param index Index to fill.
+ * @param md_path Document to read.
+ * @return bool false if the file cannot be read, was split into parts, or
+ *         does not have the structure dirdoc writes.
+ */
+bool doc_index_open(DocIndex *index, const char *md_path) {
+    memset(index, 0, sizeof(*index));
+    int fd = open(md_path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+    index->data = (const char*)map;
+    index->size = (size_t)st.st_size;
+
+    // The summary header, without a split note, then the structure and contents
+    const char *data = index->data;
+    size_t size = index->size;
+    const char *heading = find_bytes(data, size, doc_heading, sizeof(doc_heading) - 1);
+    const char *contents = heading ? find_bytes(heading, size - (size_t)(heading - data), doc_contents, sizeof(doc_contents) - 1) : NULL;
+    bool ok = contents && size >= sizeof(doc_title) - 1 && memcmp(data, doc_title, sizeof(doc_title) - 1) == 0 &&
+              !find_bytes(data, (size_t)(heading - data), doc_split_note, sizeof(doc_split_note) - 1);
+
+    size_t pos = ok ? (size_t)(contents - data) + sizeof(doc_contents) - 1 : size;
+    size_t capacity = 0;
+    while (ok && pos < size) {
+        if (index->count == capacity) {
+            capacity = capacity ? 2 * capacity : 256;
+            DocSection *sections = realloc(index->sections, capacity * sizeof(DocSection));
+            if (!sections) {
+                ok = false;
+                break;
+            }
+            index->sections = sections;
+        }
+        DocSection *section = &index->sections[index->count];
+        ok = parse_section(data, size, pos, section);
+        if (ok) {
+            pos += section->length;
+            index->count++;
+        }
+    }
+    if (!ok) {
+        doc_index_close(index);
+        return false;
+    }
+    qsort(index->sections, index->count, sizeof(DocSection), compare_sections);
+    return true;
+}
+
+/**
+ * @brief Finds the section of a file.
+ *
+ * @param index Document index.
+ * @param path File path relative to the documented directory.
+ * @return const DocSection* The section, or NULL if the document has none.
+ */
+const DocSection *doc_index_find(const DocIndex *index, const char *path) {
+    DocSection key;
+    key.path = path;
+    key.path_len = strlen(path);
+    return (const DocSection*)bsearch(&key, index->sections, index->count, sizeof(DocSection), compare_sections);
+}
+
+/**
+ * @brief Unmaps the document and frees the index.
+ *
+ * @param index Index to release.
+ */
+void doc_index_close(DocIndex *index) {
+    if (index->data) {
+        munmap((void*)index->data, index->size);
+    }
+    free(index->sections);
+    memset(index, 0, sizeof(*index));
+}
+
+/**
+ * @brief Writes the old document back after a failed update.
+ *
+ * @param md_path Document path.
+ * @param index Index holding the old document.
+ */
+static void restore_document(const char *md_path, const DocIndex *index) {
+    FILE *f = fopen(md_path, "wb");
+    if (!f || fwrite(index->data, 1, index->size, f) != index->size) {
+        fprintf(stderr, "Error: Could not restore '%s'\n", md_path);
+    }
+    if (f) {
+        fclose(f);
+    }
+}
+
+/**
+ * @brief Regenerates an existing document, reusing the sections of unchanged files.
+ *
+ * The old document stays mapped while the new one is written under its
+ * name, so it is neither scanned as part of the directory nor lost: if the
+ * run fails, it is written back.
+ *
+ * @param md_path Existing document, overwritten with the new one.
+ * @param input_dir Directory the document describes.
+ * @param flags Option flags, as for document_directory().
+ * @return int 0 on success, non-zero on failure.
+ */
+int update_document(const char *md_path, const char *input_dir, int flags) {
+    DocIndex index;
+    if (!doc_index_open(&index, md_path)) {
+        fprintf(stderr, "Error: '%s' is not a single-part dirdoc document\n", md_path);
+        return 1;
+    }
+    fprintf(stderr, "📚 Indexed %zu file sections of '%s'\n", index.count, md_path);
+
+    set_update_source(&index);
+    int result = document_directory(input_dir, md_path, flags);
+    set_update_source(NULL);
+    if (result != 0) {
+        restore_document(md_path, &index);
+    }
+    doc_index_close(&index);
+    return result;
+}
@@ -0,0 +1,79 @@
+#ifndef UPDATE_H
+#define UPDATE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * In-place update of an existing dirdoc document (--update). The document
+ * is regenerated from the directory, but the section of every file that is
+ * unchanged since it was last written is copied from the old document
+ * instead of being read, scanned and token counted again.
+ *
+ * A file counts as unchanged when its size and modification time still match
+ * its entry in the file cache (see cache.h) and the old section has the shape
+ * and content hash of that entry. The cache supplies the token count and line statistics
+ * of the copied text, so the header totals come out as a full run would
+ * write them. Files without a matching cache entry are rendered as usual.
+ */
+
+// One file section of the old document
+typedef struct {
+    const char *path;     // file path inside the mapping, not NUL-terminated
+    size_t path_len;
+    size_t offset;        // start of the section heading
+    size_t length;        // heading, body and the blank line after it
+    int fence;            // backticks of the code fence, 0 for a binary or error note
+    size_t text_offset;   // start of the text after the opening fence line
+    size_t text_length;   // bytes between the fence lines
+    char text_last;       // last byte between the fence lines, '\n' if there are none
+} DocSection;
+
+// Sections of a mapped document, sorted by path
+typedef struct {
+    const char *data;
+    size_t size;
+    DocSection *sections;
+    size_t count;
+} DocIndex;
+
+/**
+ * @brief Map a single-part dirdoc document and index its file sections.
+ *
+ * @param index Index to fill.
+ * @param md_path Document to read.
+ * @return bool false if the file cannot be read, was split into parts, or
+ *         does not have the structure dirdoc writes.
+ */
+bool doc_index_open(DocIndex *index, const char *md_path);
+
+/**
+ * @brief Find the section of a file.
+ *
+ * @param index Document index.
+ * @param path File path relative to the documented directory.
+ * @return const DocSection* The section, or NULL if the document has none.
+ */
+const DocSection *doc_index_find(const DocIndex *index, const char *path);
+
+/**
+ * @brief Unmap the document and free the index.
+ *
+ * @param index Index to release.
+ */
+void doc_index_close(DocIndex *index);
+
+/**
+ * @brief Regenerate an existing document, reusing the sections of unchanged files.
+ *
+ * The old document is kept in memory while the new one is written under its
+ * name, and written back if the run fails.
+ *
+ * @param md_path Existing document, overwritten with the new one.
+ * @param input_dir Directory the document describes.
+ * @param flags Option flags, as for document_directory().
+ * @return int 0 on success, non-zero on failure.
+ */
+int update_document(const char *md_path, const char *input_dir, int flags);
+
+#endif // UPDATE_H
@@ -6,19 +6,50 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <sys/mman.h>
 
 #include "writer.h"
 #include "scanner.h"
 #include "stats.h"
 #include "gitignore.h"
+#include "prefetch.h"
+#include "gitindex.h"
+#include "gitobject.h"
+#include "split.h"
 #include "dirdoc.h"
+#include "content.h"
+#include "pipeline.h"
+#include "cache.h"
+#include "update.h"
+
+// File contents are copied to the output and token counted in blocks of this size.
+// Regular files at least this large are mapped instead, and text at least
+// this large bypasses the output stream's buffer.
+#define TEXT_BLOCK_SIZE (64 * 1024)
+
+// With several threads, files of at least this size are read in blocks of
+// this size per thread, and the tokens of each block are counted in parallel.
+#define PARALLEL_TEXT_BLOCK_SIZE (4 * 1024 * 1024)
 
 // Declare static variables for split output options.
 static int split_enabled = 0;
 static size_t split_limit_bytes = 18 * 1024 * 1024; // default 18 MB
-#define MAX_SPLITS 100
-size_t find_split_points(const char *content, size_t limit, size_t *split_points, size_t max_splits);
-char* get_split_filename(const char *original_path, size_t part_number);
+static size_t split_token_limit = 0;  // per-part token budget, 0 = none
+static size_t split_part_count = 0;   // balance the output over this many parts, 0 = off
+
+// Number of worker threads used by parallel stages (1 = fully serial).
+static int g_thread_count = 1;
+
+// Commit-ish to document instead of the working tree (NULL = working tree).
+static char *g_source_rev = NULL;
+
+// Whether file results are cached across runs, and in which file (NULL = default location).
+static int g_cache_enabled = 1;
+static char *g_cache_path = NULL;
+
+// Document being updated, whose sections of unchanged files are reused (NULL = none).
+static const DocIndex *g_update_source = NULL;
 
 // Global variables to hold extra ignore patterns from the command line.
 static char **g_extra_ignore_patterns = NULL;
@@ -35,6 +66,71 @@ void set_split_options(int enabled, double limit_mb) {
     split_limit_bytes = (size_t)(limit_mb * 1024 * 1024);
 }
 
+/**
+ * @brief Sets a token budget for each part of a split output.
+ *
+ * Parts are cut on the token counts the writer already tracks per file
+ * section, so nothing is tokenized twice. The byte limit still applies.
+ *
+ * @param max_tokens Maximum tokens per part, or 0 to split by size only.
+ */
+void set_split_tokens(size_t max_tokens) {
+    split_token_limit = max_tokens;
+}
+
+/**
+ * @brief Sets the number of parts to balance the output over.
+ *
+ * Whole file sections are distributed so the parts carry about the same
+ * number of tokens. Takes precedence over size and token limits.
+ *
+ * @param parts Number of parts, or 0 to disable.
+ */
+void set_split_parts(size_t parts) {
+    split_part_count = parts;
+}
+
+/**
+ * @brief Sets the number of worker threads used by parallel stages.
+ *
+ * @param threads Number of threads; values below 1 select serial processing.
+ */
+void set_thread_count(int threads) {
+    g_thread_count = threads < 1 ? 1 : threads;
+    set_token_threads(g_thread_count);
+}
+
+/**
+ * @brief Configures the cache of per-file results kept across runs.
+ *
+ * @param enabled Non-zero to use the cache.
+ * @param path Cache file, or NULL for the default location.
+ */
+void set_file_cache(int enabled, const char *path) {
+    g_cache_enabled = enabled;
+    free(g_cache_path);
+    g_cache_path = path ? strdup(path) : NULL;
+}
+
+/**
+ * @brief Sets the document whose sections of unchanged files are reused.
+ *
+ * @param index Indexed old document, or NULL to render every file.
+ */
+void set_update_source(const DocIndex *index) {
+    g_update_source = index;
+}
+
+/**
+ * @brief Selects a git revision to document instead of the working tree.
+ *
+ * @param rev Commit-ish (branch, tag, object id, ...), or NULL for the working tree.
+ */
+void set_source_revision(const char *rev) {
+    free(g_source_rev);
+    g_source_rev = rev ? strdup(rev) : NULL;
+}
+
 /**
  * @brief Sets extra ignore patterns to be applied during directory scanning.
  *
@@ -76,8 +172,8 @@ void set_split_options(int enabled, double limit_mb) {
 /**
  * @brief Adds extra ignore patterns to the provided GitignoreList.
  *
- * For each extra pattern, uses the shared parse_gitignore_pattern_string function
- * to parse the pattern and add it to the GitignoreList.
+ * Each pattern is added as a command-line exclude, which is parsed like a
+ * .gitignore line but cannot be re-included by a nested .gitignore.
  *
  * @param gitignore Pointer to the GitignoreList.
  * @param patterns Array of extra ignore pattern strings.
@@ -90,8 +186,105 @@ static void add_extra_ignore_patterns(GitignoreList *gitignore, char **patterns,
     // Process each pattern using the shared function
     for (int i = 0; i < count; i++) {
         if (!patterns[i]) continue;  // Skip NULL patterns
-        parse_gitignore_pattern_string(patterns[i], gitignore);
+        add_gitignore_exclude(patterns[i], gitignore);
+    }
+}
+
+/**
+ * @brief Merges a sorted FileList into another sorted FileList.
+ *
+ * Entries present in both lists are kept once. The source list is emptied.
+ *
+ * @param dest Sorted destination list.
+ * @param src Sorted list to merge in.
+ */
+static void merge_file_lists(FileList *dest, FileList *src) {
+    size_t total = dest->count + src->count;
+    FileEntry *merged = (FileEntry*)malloc((total ? total : 1) * sizeof(FileEntry));
+    size_t i = 0, j = 0, n = 0;
+    while (i < dest->count || j < src->count) {
+        int cmp = (i == dest->count) ? 1 :
+                  (j == src->count) ? -1 : compare_entries(&dest->entries[i], &src->entries[j]);
+        if (cmp < 0) {
+            merged[n++] = dest->entries[i++];
+        } else if (cmp > 0) {
+            merged[n++] = src->entries[j++];
+        } else {
+            merged[n++] = dest->entries[i++];
+            free(src->entries[j++].path);
+        }
+    }
+    free(dest->entries);
+    dest->entries = merged;
+    dest->count = n;
+    dest->capacity = total ? total : 1;
+    src->count = 0;
+}
+
+/**
+ * @brief Collects the entries of a git checkout from its index.
+ *
+ * Tracked files are listed regardless of .gitignore, as git does; only the
+ * extra --ignore patterns filter them. With INCLUDE_UNTRACKED the worktree is
+ * also scanned with the usual ignore rules and the results are merged.
+ *
+ * @param input_dir Root of the checkout.
+ * @param files Output list, sorted with compare_entries().
+ * @param gitignore Ignore rules for the untracked scan.
+ * @param flags Documentation flags.
+ * @return int 0 on success, -1 if the index cannot be read.
+ */
+static int collect_git_index_entries(const char *input_dir, FileList *files, const GitignoreList *gitignore, int flags) {
+    GitignoreList extra = {0};
+    add_extra_ignore_patterns(&extra, g_extra_ignore_patterns, g_extra_ignore_count);
+    bool ok = read_git_index(input_dir, files, extra.count > 0 ? &extra : NULL);
+    free_gitignore(&extra);
+    if (!ok) {
+        return -1;
     }
+    
+    if (flags & INCLUDE_UNTRACKED) {
+        FileList worktree;
+        init_file_list(&worktree);
+        if (g_thread_count > 1) {
+            scan_directory_parallel(input_dir, &worktree, gitignore, flags, g_thread_count);
+        } else {
+            scan_directory(input_dir, NULL, &worktree, 0, gitignore, flags);
+            qsort(worktree.entries, worktree.count, sizeof(FileEntry), compare_entries);
+        }
+        merge_file_lists(files, &worktree);
+        free_file_list(&worktree);
+    }
+    return 0;
+}
+
+/**
+ * @brief Lists the files of the selected git revision.
+ *
+ * Like the index, a revision holds tracked files only, so .gitignore rules
+ * do not apply; the extra --ignore patterns still prune the tree walk.
+ *
+ * @param input_dir Root of the checkout.
+ * @param files Output list, sorted with compare_entries().
+ * @return GitObjectStore* Store to read blob contents from, or NULL on error.
+ */
+static GitObjectStore *collect_git_revision_entries(const char *input_dir, FileList *files) {
+    GitObjectStore *store = git_store_open(input_dir);
+    if (!store) {
+        return NULL;
+    }
+    
+    GitignoreList extra = {0};
+    add_extra_ignore_patterns(&extra, g_extra_ignore_patterns, g_extra_ignore_count);
+    unsigned char tree[GIT_MAX_OID_SIZE];
+    bool ok = git_resolve_tree(store, g_source_rev, tree) &&
+              git_list_tree(store, tree, files, extra.count > 0 ? &extra : NULL);
+    free_gitignore(&extra);
+    if (!ok) {
+        git_store_close(store);
+        return NULL;
+    }
+    return store;
 }
 
 /**
@@ -108,6 +301,13 @@ static void print_terminal_stats(const char *output_path, const DocumentInfo *in
     printf("📊 Stats:\n");
     printf("   - Total Tokens: %zu\n", info->total_tokens);
     printf("   - Total Size: %.2f MB\n", (double)info->total_size / (1024 * 1024));
+    printf("   - Total Lines: %zu\n", info->total_lines);
+    if (info->invalid_utf8_files > 0) {
+        printf("   - Files with invalid UTF-8: %zu\n", info->invalid_utf8_files);
+    }
+    if (info->cache_lookups > 0) {
+        printf("   - Cached Files: %zu of %zu\n", info->cache_hits, info->cache_lookups);
+    }
 }
 
 /**
@@ -150,136 +350,713 @@ void write_tree_structure(FILE *out, FileList *list, DocumentInfo *info) {
 }
 
 /**
- * @brief Writes the content of a file into the output stream using fenced code blocks.
+ * @brief Writes the placeholder used instead of a binary file's contents.
  *
- * Checks whether the file is binary or text, then writes the file content along with language annotation,
- * and updates the token statistics.
+ * @param out The output file stream.
+ * @param size_str Human-readable file size.
+ * @param info Pointer to the DocumentInfo structure for updating statistics.
+ */
+static void write_binary_note(FILE *out, const char *size_str, DocumentInfo *info) {
+    const char *binary_text = "*Binary file*\n";
+    fprintf(out, "%s", binary_text);
+    calculate_token_stats(binary_text, info);
+    
+    char size_text[100];
+    snprintf(size_text, sizeof(size_text), "- Size: %s\n", size_str);
+    fprintf(out, "%s", size_text);
+    calculate_token_stats(size_text, info);
+}
+
+/**
+ * @brief Writes a code fence, with the language annotation when opening.
+ *
+ * @param out The output file stream.
+ * @param fence_count Number of backticks in the fence.
+ * @param lang Language annotation, or NULL for a closing fence.
+ */
+static void write_fence(FILE *out, int fence_count, const char *lang) {
+    for (int i = 0; i < fence_count; i++) {
+        fputc('`', out);
+    }
+    // No extra space before the language annotation.
+    if (lang && strlen(lang) > 0) {
+        fprintf(out, "%s", lang);
+    }
+    fputc('\n', out);
+}
+
+/**
+ * @brief Returns the fence length for text with the given longest backtick run.
+ *
+ * @param max_ticks Longest run of backticks in the text.
+ * @return int Number of backticks in the fence.
+ */
+static int fence_length(int max_ticks) {
+    return (max_ticks < 3) ? 3 : (max_ticks + 1);
+}
+
+/**
+ * @brief Adds the line and UTF-8 statistics of a scanned text to info.
+ *
+ * @param scan Finished scan of the text.
+ * @param info Pointer to the DocumentInfo structure for updating statistics.
+ */
+static void record_content_stats(const ContentScan *scan, DocumentInfo *info) {
+    info->total_lines += content_scan_lines(scan);
+    if (!scan->valid_utf8) {
+        info->invalid_utf8_files++;
+    }
+}
+
+/**
+ * @brief Writes text to the output stream, handing large text to the kernel directly.
+ *
+ * Text of at least TEXT_BLOCK_SIZE bytes is not copied through the stream's
+ * buffer: the buffer is flushed and the text written from where it lies
+ * (usually a file mapping) to the stream's descriptor, after which the stream
+ * is moved to the new end so ftell() stays right. Smaller text, and streams
+ * without a descriptor such as memory streams, go through fwrite().
+ *
+ * @param out The output file stream.
+ * @param data The text.
+ * @param len Length of the text.
+ */
+static void write_direct(FILE *out, const char *data, size_t len) {
+    int fd = fileno(out);
+    if (len < TEXT_BLOCK_SIZE || fd < 0 || fflush(out) != 0) {
+        fwrite(data, 1, len, out);
+        return;
+    }
+    off_t pos = ftello(out);
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        data += n;
+        len -= (size_t)n;
+        if (pos >= 0) {
+            pos += n;
+        }
+    }
+    if (pos >= 0) {
+        fseeko(out, pos, SEEK_SET);
+    }
+    // Whatever the kernel did not take goes through the stream, which then
+    // records the error
+    if (len > 0) {
+        fwrite(data, 1, len, out);
+    }
+}
+
+/**
+ * @brief Writes text content as a fenced code block.
+ *
+ * The fence is made longer than any backtick run inside the content, and the
+ * language annotation is derived from the path's extension.
+ *
+ * @param out The output file stream.
+ * @param path Path used to pick the language annotation.
+ * @param content The text.
+ * @param scan Finished scan of the text.
+ * @param known_tokens Token count of the text if already known, or NULL to count it.
+ * @param info Pointer to the DocumentInfo structure for updating statistics.
+ * @return bool true if the token count is exact rather than approximated.
+ */
+static bool write_text_block(FILE *out, const char *path, const char *content, const ContentScan *scan,
+                             const size_t *known_tokens, DocumentInfo *info) {
+    int fence_count = fence_length(scan->max_backticks);
+    write_fence(out, fence_count, get_language_from_extension(path));
+    
+    write_direct(out, content, scan->length);
+    bool exact = true;
+    if (known_tokens) {
+        info->total_size += scan->length;
+        info->total_tokens += *known_tokens;
+    } else {
+        TokenStream tokens;
+        token_stream_begin(&tokens);
+        token_stream_feed(&tokens, content, scan->length);
+        exact = token_stream_finish(&tokens, info);
+    }
+    record_content_stats(scan, info);
+    
+    if (scan->last != '\n') {
+        fprintf(out, "\n");
+    }
+    
+    write_fence(out, fence_count, NULL);
+    return exact;
+}
+
+/**
+ * @brief Builds the cache key of a file from its status, without the hash.
+ *
+ * @param key Key to fill.
+ * @param st Status of the file.
+ */
+static void make_cache_key(FileCacheKey *key, const struct stat *st) {
+    key->dev = (uint64_t)st->st_dev;
+    key->ino = (uint64_t)st->st_ino;
+    key->size = (uint64_t)st->st_size;
+    key->mtime_ns = (int64_t)st->st_mtim.tv_sec * 1000000000 + st->st_mtim.tv_nsec;
+    key->hash = 0;
+}
+
+/**
+ * @brief Rebuilds the finished scan of a text from its cached results.
+ *
+ * @param value Cached results of a text file.
+ * @param scan Scan to fill.
+ */
+static void scan_from_cache(const FileCacheValue *value, ContentScan *scan) {
+    content_scan_init(scan);
+    scan->length = (size_t)value->length;
+    scan->newlines = (size_t)value->newlines;
+    scan->max_backticks = (int)value->max_backticks;
+    scan->last = (char)value->last;
+    scan->valid_utf8 = value->valid_utf8;
+}
+
+/**
+ * @brief Writes the content of a file held in memory in full.
+ *
+ * With an open cache and the file's status at hand, a file seen before in
+ * the same version is written from its cached scan results and token count
+ * without being scanned or counted; otherwise the results are stored for the
+ * next run. Without a cache hit the binary probe runs first, so a binary
+ * file is not scanned any further.
+ *
+ * @param out The output file stream.
+ * @param path Path used to pick the language annotation.
+ * @param data The file contents, mapped or read.
+ * @param len Size of the file.
+ * @param check_binary Whether the probe decides if the file is binary.
+ * @param id Cache key of the file without its hash, or NULL to bypass the cache.
+ * @param info Pointer to the DocumentInfo structure for updating statistics.
+ */
+static void write_loaded_body(FILE *out, const char *path, const char *data, size_t len, bool check_binary,
+                              const FileCacheKey *id, DocumentInfo *info) {
+    char size_buf[32];
+    FileCacheKey key;
+    FileCacheValue value;
+    bool cacheable = id && file_cache_active();
+    if (cacheable) {
+        key = *id;
+        key.hash = file_cache_hash(data, len);
+        if (file_cache_lookup(&key, &value) && (check_binary || !value.binary)) {
+            if (value.binary) {
+                write_binary_note(out, format_file_size((long long)len, size_buf, sizeof(size_buf)), info);
+                return;
+            }
+            ContentScan scan;
+            scan_from_cache(&value, &scan);
+            size_t tokens = (size_t)value.tokens;
+            write_text_block(out, path, data, &scan, &tokens, info);
+            return;
+        }
+    }
+    
+    memset(&value, 0, sizeof(value));
+    ContentScan scan;
+    content_scan_init(&scan);
+    size_t probe = len < BINARY_PROBE_SIZE ? len : BINARY_PROBE_SIZE;
+    content_scan_update(&scan, data, probe);
+    if (check_binary && content_scan_binary(&scan)) {
+        if (cacheable) {
+            value.binary = 1;
+            file_cache_store(&key, &value);
+        }
+        write_binary_note(out, format_file_size((long long)len, size_buf, sizeof(size_buf)), info);
+        return;
+    }
+    content_scan_update(&scan, data + probe, len - probe);
+    content_scan_finish(&scan);
+    size_t tokens_before = info->total_tokens;
+    if (write_text_block(out, path, data, &scan, NULL, info) && cacheable) {
+        value.length = scan.length;
+        value.newlines = scan.newlines;
+        value.tokens = info->total_tokens - tokens_before;
+        value.max_backticks = (uint32_t)scan.max_backticks;
+        value.last = (uint8_t)scan.last;
+        value.valid_utf8 = scan.valid_utf8;
+        file_cache_store(&key, &value);
+    }
+}
+
+/**
+ * @brief Writes the content of a file, using prefetched metadata when available.
+ *
+ * When meta carries results from the prefetch stage, the binary verdict and
+ * file size come from it and binary files are not opened, nor are text files
+ * whose whole contents it kept; otherwise the verdict comes from the content
+ * scan. Regular files of at least
+ * TEXT_BLOCK_SIZE bytes are mapped, smaller ones read in one go, and both
+ * written by write_loaded_body(), which consults the cache. Other files,
+ * and files that cannot be mapped, are read in blocks: the first pass runs the
+ * content scan, which sizes the fence, and when the file did not fit in one
+ * block a second pass copies the text out while its tokens are counted, so
+ * memory use does not grow with the file. Large files get blocks big enough
+ * to split over the worker threads for counting.
  *
  * @param out The output file stream.
  * @param path The path to the file whose content is to be written.
+ * @param meta Prefetched entry metadata, or NULL.
  * @param info Pointer to the DocumentInfo structure for updating statistics.
  */
-void write_file_content(FILE *out, const char *path, DocumentInfo *info) {
+static void write_file_body(FILE *out, const char *path, const FileEntry *meta, DocumentInfo *info) {
+    bool have_meta = meta && meta->has_meta;
+
     // If file is detected as binary OR its extension indicates a binary file, do not print its contents.
-    if (is_binary_file(path) || !is_text_file_by_extension(path)) {
-        const char *binary_text = "*Binary file*\n";
-        fprintf(out, "%s", binary_text);
-        calculate_token_stats(binary_text, info);
-        
-        char size_text[100];
-        snprintf(size_text, sizeof(size_text), "- Size: %s\n", get_file_size(path));
-        fprintf(out, "%s", size_text);
-        calculate_token_stats(size_text, info);
+    if ((have_meta && meta->is_binary) || !is_text_file_by_extension(path)) {
+        char size_buf[32];
+        write_binary_note(out, have_meta ? format_file_size(meta->size, size_buf, sizeof(size_buf)) : get_file_size(path), info);
         return;
     }
     
-    FILE *f = fopen(path, "r");
-    if (!f) {
+    if (have_meta && meta->head) {
+        // The prefetch stage read the whole file
+        FileCacheKey id;
+        id.dev = meta->dev;
+        id.ino = meta->ino;
+        id.size = (uint64_t)meta->size;
+        id.mtime_ns = meta->mtime_ns;
+        id.hash = 0;
+        write_loaded_body(out, path, meta->head, (size_t)meta->size, false, &id, info);
+        return;
+    }
+    
+    FILE *f = fopen(path, "rb");
+    if (!f && !have_meta) {
+        // Unreadable files count as binary, as in is_binary_file()
+        write_binary_note(out, get_file_size(path), info);
+        return;
+    }
+    struct stat st;
+    bool have_stat = f && fstat(fileno(f), &st) == 0;
+    if (have_stat && S_ISREG(st.st_mode) && st.st_size >= TEXT_BLOCK_SIZE) {
+        void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+        if (map != MAP_FAILED) {
+            madvise(map, (size_t)st.st_size, MADV_SEQUENTIAL);
+            fclose(f);
+            FileCacheKey id;
+            make_cache_key(&id, &st);
+            write_loaded_body(out, path, (const char*)map, (size_t)st.st_size, !have_meta, &id, info);
+            munmap(map, (size_t)st.st_size);
+            return;
+        }
+    } else if (have_stat && S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t len = (size_t)st.st_size;
+        char *data = malloc(len);
+        size_t got = data ? fread(data, 1, len, f) : 0;
+        if (got > 0) {
+            fclose(f);
+            // A file that shrank since fstat() is written but not cached
+            FileCacheKey id;
+            make_cache_key(&id, &st);
+            write_loaded_body(out, path, data, got, !have_meta, got == len ? &id : NULL, info);
+            free(data);
+            return;
+        }
+        free(data);
+        rewind(f);
+    }
+    long long size = have_meta ? meta->size : (have_stat ? (long long)st.st_size : -1);
+    size_t block_size = TEXT_BLOCK_SIZE;
+    if (g_thread_count > 1 && size >= PARALLEL_TEXT_BLOCK_SIZE) {
+        block_size = (size_t)g_thread_count * PARALLEL_TEXT_BLOCK_SIZE;
+        if ((unsigned long long)size < block_size) {
+            block_size = (size_t)size;
+        }
+    }
+    char *block = f ? malloc(block_size) : NULL;
+    if (!block) {
+        if (f) fclose(f);
         const char *error_text = "*Error reading file*\n";
         fprintf(out, "%s", error_text);
         calculate_token_stats(error_text, info);
         return;
     }
     
-    char *content = malloc(BUFFER_SIZE);
-    size_t content_size = 0;
-    size_t capacity = BUFFER_SIZE;
-    
-    char buffer[1024];
-    while (fgets(buffer, sizeof(buffer), f)) {
-        size_t len = strlen(buffer);
-        if (content_size + len >= capacity) {
-            capacity *= 2;
-            content = realloc(content, capacity);
+    // First pass: scan the text; without prefetched metadata this also
+    // decides whether the file is binary
+    ContentScan scan;
+    content_scan_init(&scan);
+    size_t n;
+    int blocks = 0;
+    while ((n = fread(block, 1, block_size, f)) > 0) {
+        blocks++;
+        content_scan_update(&scan, block, n);
+        if (!have_meta && content_scan_probed(&scan) && content_scan_binary(&scan)) {
+            break;
         }
-        strcpy(content + content_size, buffer);
-        content_size += len;
     }
-    fclose(f);
-    
-    int max_ticks = count_max_backticks(content);
-    int fence_count = (max_ticks < 3) ? 3 : (max_ticks + 1);
-    const char *lang = get_language_from_extension(path);
-    
-    // Write opening fence without an extra space before the language annotation.
-    for (int i = 0; i < fence_count; i++) {
-        fputc('`', out);
+    content_scan_finish(&scan);
+    if (!have_meta && content_scan_binary(&scan)) {
+        fclose(f);
+        free(block);
+        char size_buf[32];
+        write_binary_note(out, format_file_size(size, size_buf, sizeof(size_buf)), info);
+        return;
     }
-    if (strlen(lang) > 0) {
-        fprintf(out, "%s", lang);
+    if (blocks <= 1 && feof(f)) {
+        // The whole text is still in the block
+        fclose(f);
+        write_text_block(out, path, block, &scan, NULL, info);
+        free(block);
+        return;
     }
-    fputc('\n', out);
+    int fence_count = fence_length(scan.max_backticks);
+    write_fence(out, fence_count, get_language_from_extension(path));
     
-    fprintf(out, "%s", content);
-    calculate_token_stats(content, info);
+    // Second pass: copy the text out and count its tokens block by block
+    rewind(f);
+    size_t remaining = scan.length;
+    TokenStream tokens;
+    token_stream_begin(&tokens);
+    while (remaining > 0 && (n = fread(block, 1, remaining < block_size ? remaining : block_size, f)) > 0) {
+        fwrite(block, 1, n, out);
+        token_stream_feed(&tokens, block, n);
+        remaining -= n;
+    }
+    token_stream_finish(&tokens, info);
+    record_content_stats(&scan, info);
+    fclose(f);
+    free(block);
     
-    if (content_size > 0 && content[content_size - 1] != '\n') {
+    if (scan.last != '\n') {
         fprintf(out, "\n");
     }
-    
-    // Write closing fence.
-    for (int i = 0; i < fence_count; i++) {
-        fputc('`', out);
+    write_fence(out, fence_count, NULL);
+}
+
+/**
+ * @brief Writes the content of a blob read from the git object database.
+ *
+ * Applies the same binary detection as for files on disk, using the first
+ * BINARY_PROBE_SIZE bytes of the blob.
+ *
+ * @param out The output file stream.
+ * @param store Object store holding the blob.
+ * @param entry File entry carrying the path and blob id.
+ * @param info Pointer to the DocumentInfo structure for updating statistics.
+ */
+static void write_blob_body(FILE *out, GitObjectStore *store, const FileEntry *entry, DocumentInfo *info) {
+    GitObjectType type;
+    size_t size = 0;
+    unsigned char *data = git_read_object(store, entry->oid, &type, &size);
+    if (!data || type != GIT_OBJ_BLOB) {
+        const char *error_text = "*Error reading file*\n";
+        fprintf(out, "%s", error_text);
+        calculate_token_stats(error_text, info);
+        free(data);
+        return;
     }
-    fprintf(out, "\n");
     
-    free(content);
+    // One scan yields the binary verdict and everything the fence needs
+    ContentScan scan;
+    content_scan_init(&scan);
+    content_scan_update(&scan, (const char*)data, size);
+    content_scan_finish(&scan);
+    if (content_scan_binary(&scan) || !is_text_file_by_extension(entry->path)) {
+        char size_buf[32];
+        write_binary_note(out, format_file_size((long long)size, size_buf, sizeof(size_buf)), info);
+    } else {
+        write_text_block(out, entry->path, (const char*)data, &scan, NULL, info);
+    }
+    free(data);
 }
 
-    
 /**
- * @brief Finalizes the output file by prepending a header and handling file splitting if required.
+ * @brief Writes the content of a file into the output stream using fenced code blocks.
  *
- * Reads back the generated content, prepends a documentation summary header with token statistics,
- * and if splitting is enabled and necessary, splits the file into multiple parts.
+ * Checks whether the file is binary or text, then writes the file content along with language annotation,
+ * and updates the token statistics.
  *
- * @param out_path The output file path.
+ * @param out The output file stream.
+ * @param path The path to the file whose content is to be written.
+ * @param info Pointer to the DocumentInfo structure for updating statistics.
+ */
+void write_file_content(FILE *out, const char *path, DocumentInfo *info) {
+    write_file_body(out, path, NULL, info);
+}
+
+
+// The summary header is written before the body with a blank, fixed-width
+// token field, which finalize_output() patches in place once the total is known.
+#define TOKEN_FIELD_WIDTH 20
+static const char summary_intro[] =
+    "# Documentation Summary\n\n"
+    "The output is a Markdown document summarizing a directory’s structure and file contents. It begins with token and size statistics, followed by a hierarchical view of the directory layout. For each file (unless omitted in structure-only mode), its contents are included in fenced code blocks with optional language annotations and metadata like file size, forming a complete, self-contained reference.\n\n";
+static const char split_note[] =
+    "Note: This document has been split into multiple parts due to size limitations.\n\n";
+static const char token_label[] = "Token Size: ";
+
+/**
+ * @brief Writes the documentation summary header with a blank token field.
+ *
+ * @param out The output file stream, positioned at the start of the file.
+ * @param split Whether the document is written as multiple parts.
+ */
+static void write_summary_header(FILE *out, bool split) {
+    fprintf(out, "%s%s%s%*s\n\n", summary_intro, split ? split_note : "", token_label, TOKEN_FIELD_WIDTH, "");
+}
+
+/**
+ * @brief Fills the blank token field of a header written by write_summary_header().
+ *
+ * @param fd Descriptor of the file holding the header.
+ * @param split Whether the header carries the split note.
+ * @param tokens Total token count.
+ * @return bool true on success.
+ */
+static bool write_token_field(int fd, bool split, size_t tokens) {
+    char field[TOKEN_FIELD_WIDTH + 1];
+    snprintf(field, sizeof(field), "%-*zu", TOKEN_FIELD_WIDTH, tokens);
+    off_t field_offset = (off_t)(strlen(summary_intro) + (split ? strlen(split_note) : 0) + strlen(token_label));
+    return pwrite(fd, field, TOKEN_FIELD_WIDTH, field_offset) == TOKEN_FIELD_WIDTH;
+}
+
+/**
+ * @brief Fills in the token count of the first part and reports the split.
+ *
+ * @param out_path The unsplit output file path.
  * @param info Pointer to the DocumentInfo structure with computed statistics.
  * @return int 0 on success, non-zero on failure.
  */
-int finalize_output(const char *out_path, DocumentInfo *info) {
+static int finish_split_parts(const char *out_path, const DocumentInfo *info) {
+    char *first_part = get_split_filename(out_path, 1);
+    int fd = first_part ? open(first_part, O_RDWR | O_CLOEXEC) : -1;
+    if (fd < 0 || !write_token_field(fd, true, info->total_tokens)) {
+        fprintf(stderr, "Error: Writing split file '%s'\n", first_part ? first_part : out_path);
+        if (fd >= 0) close(fd);
+        free(first_part);
+        return 1;
+    }
+    close(fd);
+    free(first_part);
+    printf("✅ Output successfully split into %zu parts.\n", info->split_parts);
+    return 0;
+}
+
+/**
+ * @brief Splits an already written output file into parts.
+ *
+ * Used when splitting is chosen only after the document turned out too large.
+ * The file is streamed through a SplitSink, so it is never held in memory.
+ *
+ * @param out_path The output file path.
+ * @param info Pointer to the DocumentInfo structure; receives the part count.
+ * @return int 0 on success, non-zero on failure.
+ */
+static int split_output_file(const char *out_path, DocumentInfo *info) {
     FILE *in = fopen(out_path, "r");
     if (!in) {
         fprintf(stderr, "Error: Cannot reopen output file '%s' for reading\n", out_path);
         return 1;
     }
-    fseek(in, 0, SEEK_END);
-    long fsize = ftell(in);
-    fseek(in, 0, SEEK_SET);
-    char *file_content = malloc(fsize + 1);
-    if (fread(file_content, 1, fsize, in) != (size_t)fsize) {
-        fprintf(stderr, "Error: Reading output file '%s'\n", out_path);
-        free(file_content);
+    SplitSink sink;
+    if (!split_sink_open(&sink, out_path, split_limit_bytes, 0)) {
         fclose(in);
         return 1;
     }
-    file_content[fsize] = '\0';
+    write_summary_header(sink.stream, true);
+    size_t header_len = strlen(summary_intro) + strlen(token_label) + TOKEN_FIELD_WIDTH + 2;
+    bool ok = fseek(in, (long)header_len, SEEK_SET) == 0 && split_sink_copy_sections(&sink, in);
     fclose(in);
-    
-    // Prepend documentation summary header to the content
-    char header[1024];
-    if (split_enabled) {
-        snprintf(header, sizeof(header),
-            "# Documentation Summary\n\n"
-            "The output is a Markdown document summarizing a directory’s structure and file contents. It begins with token and size statistics, followed by a hierarchical view of the directory layout. For each file (unless omitted in structure-only mode), its contents are included in fenced code blocks with optional language annotations and metadata like file size, forming a complete, self-contained reference.\n\n"
-            "Note: This document has been split into multiple parts due to size limitations.\n\n"
-            "Token Size: %zu\n\n", info->total_tokens);
-    } else {
-        snprintf(header, sizeof(header),
-            "# Documentation Summary\n\n"
-            "The output is a Markdown document summarizing a directory’s structure and file contents. It begins with token and size statistics, followed by a hierarchical view of the directory layout. For each file (unless omitted in structure-only mode), its contents are included in fenced code blocks with optional language annotations and metadata like file size, forming a complete, self-contained reference.\n\n"
-            "Token Size: %zu\n\n", info->total_tokens);
+    info->split_parts = split_sink_close(&sink, 0);
+    if (!ok || info->split_parts == 0) {
+        fprintf(stderr, "Error: Splitting output file '%s'\n", out_path);
+        return 1;
+    }
+    // Remove the original unsplit output file.
+    remove(out_path);
+    return finish_split_parts(out_path, info);
+}
+
+// Byte offset and token count of every section of an unsplit output, for
+// balancing it over a fixed number of parts afterwards.
+typedef struct {
+    size_t *offsets;
+    size_t *tokens;
+    size_t count;
+    size_t capacity;
+} SectionIndex;
+
+/**
+ * @brief Closes the last recorded section and starts a new one.
+ *
+ * @param index Section index.
+ * @param offset Output offset where the new section starts.
+ * @param prev_tokens Token count of the section that ends here.
+ * @return bool true on success, false if out of memory.
+ */
+static bool add_section(SectionIndex *index, size_t offset, size_t prev_tokens) {
+    if (index->count > 0) {
+        index->tokens[index->count - 1] = prev_tokens;
+    }
+    if (index->count == index->capacity) {
+        size_t capacity = index->capacity ? index->capacity * 2 : 256;
+        size_t *offsets = realloc(index->offsets, capacity * sizeof(size_t));
+        if (offsets) index->offsets = offsets;
+        size_t *tokens = realloc(index->tokens, capacity * sizeof(size_t));
+        if (tokens) index->tokens = tokens;
+        if (!offsets || !tokens) return false;
+        index->capacity = capacity;
+    }
+    index->offsets[index->count] = offset;
+    index->tokens[index->count] = 0;
+    index->count++;
+    return true;
+}
+
+/**
+ * @brief Copies a byte range of a file to a stream.
+ *
+ * @param fd Source file descriptor.
+ * @param offset Start of the range.
+ * @param len Length of the range.
+ * @param out Destination stream.
+ * @return bool true on success.
+ */
+static bool copy_file_range_to(int fd, size_t offset, size_t len, FILE *out) {
+    char buffer[65536];
+    while (len > 0) {
+        size_t chunk = len < sizeof(buffer) ? len : sizeof(buffer);
+        ssize_t got = pread(fd, buffer, chunk, (off_t)offset);
+        if (got <= 0 || fwrite(buffer, 1, (size_t)got, out) != (size_t)got) {
+            return false;
+        }
+        offset += (size_t)got;
+        len -= (size_t)got;
+    }
+    return true;
+}
+
+/**
+ * @brief Redistributes a finished output over a fixed number of balanced parts.
+ *
+ * Sections are assigned by split_pack_sections() and copied into the parts in
+ * document order; every part after the first starts with a continuation
+ * notice and its token count. The unsplit file is removed afterwards.
+ *
+ * @param out_path The unsplit output file path.
+ * @param index Sections of the output (section 0 holds the header and structure).
+ * @param part_token_offset Offset of the blank per-part token field in section 0.
+ * @return size_t Number of parts written, or 0 on failure.
+ */
+static size_t write_balanced_parts(const char *out_path, const SectionIndex *index, long part_token_offset) {
+    size_t n = index->count;
+    size_t *part_of = malloc(n * sizeof(size_t));
+    size_t *order = malloc(n * sizeof(size_t));
+    size_t *first = calloc(split_part_count + 1, sizeof(size_t));
+    size_t *part_tokens = calloc(split_part_count, sizeof(size_t));
+    int fd = open(out_path, O_RDWR | O_CLOEXEC);
+    struct stat st;
+    if (!part_of || !order || !first || !part_tokens || fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "Error: Cannot split output file '%s'\n", out_path);
+        if (fd >= 0) close(fd);
+        free(part_of); free(order); free(first); free(part_tokens);
+        return 0;
+    }
+    size_t parts = split_pack_sections(index->tokens, n, split_part_count, part_of);
+    if (parts < split_part_count) {
+        fprintf(stderr, "Warning: Only %zu sections to distribute; writing %zu parts instead of %zu.\n",
+                n, parts, split_part_count);
+    }
+
+    // Group the sections by part, keeping document order inside each part.
+    for (size_t i = 0; i < n; i++) {
+        part_tokens[part_of[i]] += index->tokens[i];
+        first[part_of[i] + 1]++;
+    }
+    for (size_t p = 0; p < parts; p++) {
+        first[p + 1] += first[p];
+    }
+    for (size_t i = 0; i < n; i++) {
+        order[first[part_of[i]]++] = i;
+    }
+    for (size_t p = parts; p > 0; p--) {
+        first[p] = first[p - 1];
+    }
+    first[0] = 0;
+
+    char field[SPLIT_PART_TOKEN_WIDTH + 1];
+    snprintf(field, sizeof(field), "%-*zu", SPLIT_PART_TOKEN_WIDTH, part_tokens[0]);
+    bool ok = pwrite(fd, field, SPLIT_PART_TOKEN_WIDTH, (off_t)part_token_offset) == SPLIT_PART_TOKEN_WIDTH;
+    for (size_t p = 0; ok && p < parts; p++) {
+        char *part_path = get_split_filename(out_path, p + 1);
+        FILE *part = part_path ? fopen(part_path, "w") : NULL;
+        if (!part) {
+            fprintf(stderr, "Error: Cannot create split file '%s'\n", part_path ? part_path : out_path);
+            free(part_path);
+            ok = false;
+            break;
+        }
+        if (p > 0) {
+            fprintf(part, "---\n**Continued from part %zu**\n\n", p);
+            fprintf(part, "%s%-*zu\n\n", SPLIT_PART_TOKEN_LABEL, SPLIT_PART_TOKEN_WIDTH, part_tokens[p]);
+        }
+        for (size_t k = first[p]; ok && k < first[p + 1]; k++) {
+            size_t i = order[k];
+            size_t end = i + 1 < n ? index->offsets[i + 1] : (size_t)st.st_size;
+            ok = copy_file_range_to(fd, index->offsets[i], end - index->offsets[i], part);
+        }
+        if (p + 1 < parts) {
+            fprintf(part, "\n\n---\n**Continued in part %zu**\n", p + 2);
+        }
+        if (fclose(part) != 0) {
+            ok = false;
+        }
+        free(part_path);
+    }
+    close(fd);
+    free(part_of); free(order); free(first); free(part_tokens);
+    if (!ok) {
+        fprintf(stderr, "Error: Writing split files for '%s'\n", out_path);
+        return 0;
+    }
+    remove(out_path);
+    return parts;
+}
+
+/**
+ * @brief Finalizes the output file by filling in the header's token count and handling file splitting if required.
+ *
+ * The count is written into the field reserved by write_summary_header(), so
+ * the document is not read back and memory use does not grow with its size.
+ * When the parts were already cut during generation only the first part's
+ * header is patched.
+ *
+ * @param out_path The output file path.
+ * @param info Pointer to the DocumentInfo structure with computed statistics.
+ * @return int 0 on success, non-zero on failure.
+ */
+int finalize_output(const char *out_path, DocumentInfo *info) {
+    if (info->split_parts > 0) {
+        return finish_split_parts(out_path, info);
+    }
+
+    int fd = open(out_path, O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot reopen output file '%s' for writing\n", out_path);
+        return 1;
     }
     
-    size_t header_len = strlen(header);
-    size_t new_size = header_len + strlen(file_content) + 1;
-    char *new_content = malloc(new_size);
-    strcpy(new_content, header);
-    strcat(new_content, file_content);
-    free(file_content);
+    struct stat st;
+    if (!write_token_field(fd, false, info->total_tokens) || fstat(fd, &st) != 0) {
+        fprintf(stderr, "Error: Writing output file '%s'\n", out_path);
+        close(fd);
+        return 1;
+    }
+    size_t new_size = (size_t)st.st_size;
     
     // If split was not explicitly requested and the content is large, prompt interactively.
-    if (!split_enabled && new_size > split_limit_bytes) {
+    // An update keeps the document whole, as it was accepted when first written
+    if (!split_enabled && !g_update_source && new_size > split_limit_bytes) {
         double size_mb = new_size / (1024.0 * 1024.0);
         printf("⏳ The generated documentation is estimated to be %.2f MB.\n", size_mb);
         printf("Choose an option:\n");
@@ -292,7 +1069,7 @@ int finalize_output(const char *out_path, DocumentInfo *info) {
         
         char choice[16];
         if (!fgets(choice, sizeof(choice), stdin)) {
-            free(new_content);
+            close(fd);
             return 1;
         }
         
@@ -319,9 +1096,7 @@ int finalize_output(const char *out_path, DocumentInfo *info) {
             split_enabled = 1;
         } else if (choice[0] == 'B' || choice[0] == 'b') {
             // Build structure only: remove file contents by truncating at "## Contents"
-            char *contents_pos = strstr(new_content, "\n## Contents");
-            if (contents_pos) {
-                *contents_pos = '\0';
+            if (info->contents_offset > 0 && ftruncate(fd, (off_t)info->contents_offset) == 0) {
                 printf("✅ Building structure only. File contents will be omitted.\n");
             } else {
                 printf("Structure only marker not found. Proceeding without changes.\n");
@@ -333,7 +1108,7 @@ int finalize_output(const char *out_path, DocumentInfo *info) {
         } else if (choice[0] == 'Q' || choice[0] == 'q') {
             // Quit creation
             printf("Creation cancelled by user.\n");
-            free(new_content);
+            close(fd);
             remove(out_path);
             return 1;
         } else {
@@ -341,176 +1116,185 @@ int finalize_output(const char *out_path, DocumentInfo *info) {
             split_enabled = 0;
         }
     }
-    
-    // Write back to the original output file (temporary)
-    FILE *out_final = fopen(out_path, "w");
-    if (!out_final) {
-        fprintf(stderr, "Error: Cannot reopen output file '%s' for writing\n", out_path);
-        free(new_content);
-        return 1;
-    }
-    fputs(new_content, out_final);
-    fclose(out_final);
+    close(fd);
 
-    // If splitting is enabled, split new_content into multiple files based on split_limit_bytes.
-    // Smart splitting logic: ensure documented files are not split
     if (split_enabled) {
-        size_t split_points[MAX_SPLITS];
-        size_t num_splits = find_split_points(new_content, split_limit_bytes, split_points, MAX_SPLITS);
-        size_t start = 0;
-        for (size_t i = 0; i < num_splits; i++) {
-            size_t end = split_points[i];
-            // Write to split file from start to end
-            char *part_filename = get_split_filename(out_path, i + 1);
-            FILE *part_file = fopen(part_filename, "w");
-            if (part_file) {
-                // Add a continuation notice if this isn't the first part
-                if (i > 0) {
-                    fprintf(part_file, "---\n**Continued from part %zu**\n\n", i);
-                }
-            
-                fwrite(new_content + start, 1, end - start, part_file);
-            
-                // Add a continuation notice if this isn't the last part
-                if (i < num_splits - 1) {
-                    fprintf(part_file, "\n\n---\n**Continued in part %zu**\n", i + 2);
-                }
-            
-                fclose(part_file);
-            }
-            free(part_filename);
-            start = end;
-        }
-        // Write the remaining content
-        char *part_filename = get_split_filename(out_path, num_splits + 1);
-        FILE *part_file = fopen(part_filename, "w");
-        if (part_file) {
-            // Add a continuation notice if this isn't the first part
-            if (num_splits > 0) {
-                fprintf(part_file, "---\n**Continued from part %zu**\n\n", num_splits);
-            }
-            
-            fwrite(new_content + start, 1, strlen(new_content) - start, part_file);
-            fclose(part_file);
-        }
-        free(part_filename);
-        printf("✅ Output successfully split into %zu parts.\n", num_splits + 1);
-        // Remove the original unsplit output file.
-        remove(out_path);
+        return split_output_file(out_path, info);
     }
-    
-    free(new_content);
     return 0;
-    }
+}
+
+// With several threads, pipeline workers render files below this size ahead
+// of the writer. Larger files are left to the writer, which sends them to the
+// output without buffering them and counts their tokens on all threads.
+#define PIPELINE_MAX_RENDERED (1024 * 1024)
+
+// Files the workers may render ahead of the writer, per thread.
+#define PIPELINE_WINDOW_PER_THREAD 4
+
+// State of the contents section shared by the pipeline steps.
+typedef struct {
+    FILE *out;
+    FileList *files;
+    const char *input_dir;
+    GitObjectStore *store;      // object store to read blobs from, or NULL
+    DocumentInfo *info;
+    SplitSink *sink;            // sink when splitting while writing, or NULL
+    SectionIndex *sections;     // section index when balancing parts, or NULL
+    bool indexed;               // whether sections still holds every section
+    size_t section_start_tokens; // total tokens where the current section began
+} ContentsWriter;
 
 /**
- * @brief Finds appropriate split points to ensure documented files are not split.
+ * @brief Adds the statistics of a rendered text to the document totals.
  *
- * @param content The full content to be split.
- * @param limit The maximum size per split in bytes.
- * @param split_points Array to store split indices.
- * @param max_splits The maximum number of splits.
- * @return size_t Number of split points found.
+ * @param total Document statistics.
+ * @param part Statistics of the rendered text.
  */
-size_t find_split_points(const char *content, size_t limit, size_t *split_points, size_t max_splits) {
-    size_t content_length = strlen(content);
-    size_t current = 0;
-    size_t found_splits = 0;
-    size_t marker_len = strlen("\n### 📄");
+static void add_document_stats(DocumentInfo *total, const DocumentInfo *part) {
+    total->total_size += part->total_size;
+    total->total_tokens += part->total_tokens;
+    total->total_lines += part->total_lines;
+    total->invalid_utf8_files += part->invalid_utf8_files;
+}
 
-    while (current + limit < content_length && found_splits < max_splits) {
-        // Start looking for a split point well before the limit to ensure we don't split a file
-        size_t search_start = current + (limit / 2);
-        
-        // Find the next occurrence of "### 📄" which indicates the start of a file
-        const char *file_marker = NULL;
-        for (size_t i = search_start; i < current + limit && i < content_length; i++) {
-            if (i + marker_len < content_length &&
-                strncmp(content + i, "\n### 📄", marker_len) == 0) {
-                file_marker = content + i;
-                break;
-            }
-        }
+/**
+ * @brief Copies a file's section from the document being updated, if the file
+ *        is unchanged.
+ *
+ * The file must still have the size and modification time of its cache
+ * entry, and the old section must have the fence width the entry implies
+ * and hold text with the entry's length and content hash. That ties the
+ * section to the file version the cache saw, which may be newer than the
+ * document; the entry then also supplies the statistics of the text.
+ *
+ * @param out The output stream.
+ * @param w Contents state, for the input directory.
+ * @param entry File to write.
+ * @param heading Section heading of the file.
+ * @param info Statistics to update.
+ * @return bool false if the file must be rendered.
+ */
+static bool write_reused_section(FILE *out, const ContentsWriter *w, const FileEntry *entry,
+                                 const char *heading, DocumentInfo *info) {
+    if (!g_update_source || w->store || !entry->has_meta || entry->is_binary || !is_text_file_by_extension(entry->path)) {
+        return false;
+    }
+    const DocSection *section = doc_index_find(g_update_source, entry->path);
+    if (!section || section->fence == 0) {
+        return false;
+    }
+    char full_path[MAX_PATH_LEN];
+    snprintf(full_path, sizeof(full_path), "%s/%s", w->input_dir, entry->path);
+    struct stat st;
+    if (stat(full_path, &st) != 0 || !S_ISREG(st.st_mode)) {
+        return false;
+    }
+    FileCacheKey key;
+    make_cache_key(&key, &st);
+    FileCacheValue value;
+    if (!file_cache_lookup_stat(&key, &value) || value.binary) {
+        return false;
+    }
+    // The writer adds a line feed to text that lacks one
+    size_t text_length = (size_t)value.length + (value.last != '\n');
+    if (section->fence != fence_length((int)value.max_backticks) || section->text_length != text_length ||
+        section->text_last != '\n' ||
+        file_cache_hash(g_update_source->data + section->text_offset, (size_t)value.length) != key.hash) {
+        return false;
+    }
+    
+    write_direct(out, g_update_source->data + section->offset, section->length);
+    calculate_token_stats(heading, info);
+    ContentScan scan;
+    scan_from_cache(&value, &scan);
+    info->total_size += scan.length;
+    info->total_tokens += (size_t)value.tokens;
+    record_content_stats(&scan, info);
+    return true;
+}
+
+/**
+ * @brief Writes the section of one file: its heading, body and a blank line.
+ *
+ * The file's prefetched contents are released afterwards, so they are held
+ * only until the file is written.
+ *
+ * @param out The output stream.
+ * @param w Contents state, for the input directory and object store.
+ * @param entry File to write.
+ * @param info Statistics to update.
+ */
+static void write_entry(FILE *out, const ContentsWriter *w, FileEntry *entry, DocumentInfo *info) {
+    char heading[MAX_PATH_LEN + 16];
+    snprintf(heading, sizeof(heading), SPLIT_SECTION_MARKER " %s\n\n", entry->path);
+    if (!write_reused_section(out, w, entry, heading, info)) {
+        fprintf(out, "%s", heading);
+        calculate_token_stats(heading, info);
         
-        if (file_marker) {
-            // Found a file marker before the limit - split right before it to keep the file intact
-            split_points[found_splits++] = file_marker - content + 1; // +1 to include the newline
-            current = file_marker - content + 1;
+        if (w->store) {
+            write_blob_body(out, w->store, entry, info);
         } else {
-            // No file marker found before limit, look for any reasonable split point
-            const char *split = NULL;
-            
-            // Try to find a paragraph break or section header
-            for (size_t i = current + limit; i > search_start; i--) {
-                if (i + 2 < content_length && 
-                    content[i] == '\n' && content[i+1] == '\n') {
-                    // Found a paragraph break
-                    split = content + i + 1;
-                    break;
-                }
-                
-                if (i + 5 < content_length && 
-                    strncmp(content + i, "\n## ", 4) == 0) {
-                    // Found a section header
-                    split = content + i + 1;
-                    break;
-                }
-            }
-            
-            if (split) {
-                split_points[found_splits++] = split - content;
-                current = split - content;
-            } else {
-                // No good split point found, force split at a newline near the limit
-                const char *force_split = NULL;
-                for (size_t i = current + limit; i > current + limit - 200 && i > current; i--) {
-                    if (content[i] == '\n') {
-                        force_split = content + i + 1;
-                        break;
-                    }
-                }
-                
-                if (force_split) {
-                    split_points[found_splits++] = force_split - content;
-                    current = force_split - content;
-                } else {
-                    // Last resort: hard split at the limit
-                    split_points[found_splits++] = current + limit;
-                    current += limit;
-                }
-            }
+            char full_path[MAX_PATH_LEN];
+            snprintf(full_path, sizeof(full_path), "%s/%s", w->input_dir, entry->path);
+            write_file_body(out, full_path, entry, info);
         }
+        fprintf(out, "\n");
     }
-
-    return found_splits;
+    free(entry->head);
+    entry->head = NULL;
 }
 
 /**
- * @brief Generates a split filename based on the original output path and part number.
+ * @brief Pipeline render step: renders the section of a small file.
+ *
+ * Only files with prefetched metadata are rendered, so workers never touch
+ * the per-file fallbacks that share static buffers.
  *
- * @param original_path The original output file path.
- * @param part_number The part number for the split file.
- * @return char* The generated split filename. The caller is responsible for freeing the memory.
+ * @param ctx The ContentsWriter.
+ * @param index Entry index in the file list.
+ * @param out Memory stream to render into.
+ * @param info Statistics of the rendered section.
+ * @return bool false for directories and for files left to the writer.
  */
-char* get_split_filename(const char *original_path, size_t part_number) {
-    char *dot = strrchr(original_path, '.');
-    size_t basename_length = dot ? (size_t)(dot - original_path) : strlen(original_path);
-    size_t ext_length = dot ? strlen(dot) : 0;
-
-    char part_suffix[32];
-    snprintf(part_suffix, sizeof(part_suffix), "_part%zu", part_number);
-
-    size_t new_length = basename_length + strlen(part_suffix) + ext_length + 1;
-    char *new_filename = malloc(new_length);
-    if (!new_filename) return NULL;
+static bool render_entry(void *ctx, size_t index, FILE *out, DocumentInfo *info) {
+    const ContentsWriter *w = (const ContentsWriter*)ctx;
+    FileEntry *entry = &w->files->entries[index];
+    if (entry->is_dir || !entry->has_meta || entry->size < 0 || entry->size >= PIPELINE_MAX_RENDERED) {
+        return false;
+    }
+    write_entry(out, w, entry, info);
+    return true;
+}
 
-    if (dot) {
-        snprintf(new_filename, new_length, "%.*s%s%s", (int)basename_length, original_path, part_suffix, dot);
+/**
+ * @brief Pipeline write step: starts a new section and writes one file into it.
+ *
+ * @param ctx The ContentsWriter.
+ * @param index Entry index in the file list.
+ * @param data Rendered section, or NULL to write the file here.
+ * @param len Length of the rendered section.
+ * @param rendered Statistics of the rendered section.
+ */
+static void write_entry_section(void *ctx, size_t index, const char *data, size_t len, const DocumentInfo *rendered) {
+    ContentsWriter *w = (ContentsWriter*)ctx;
+    FileEntry *entry = &w->files->entries[index];
+    if (entry->is_dir) {
+        return;
+    }
+    
+    if (w->sink) {
+        split_sink_boundary(w->sink, w->info->total_tokens - w->section_start_tokens);
+    } else if (w->sections && w->indexed) {
+        w->indexed = add_section(w->sections, (size_t)ftell(w->out), w->info->total_tokens - w->section_start_tokens);
+    }
+    w->section_start_tokens = w->info->total_tokens;
+    if (data) {
+        fwrite(data, 1, len, w->out);
+        add_document_stats(w->info, rendered);
     } else {
-        snprintf(new_filename, new_length, "%s%s", original_path, part_suffix);
+        write_entry(w->out, w, entry, w->info);
     }
-
-    return new_filename;
 }
 
 /**
@@ -553,11 +1337,44 @@ int document_directory(const char *input_dir, const char *output_file, int flags
         }
     }
     
-    fprintf(stderr, "⏳ Scanning directory '%s'...\n", input_dir);
+    if (g_source_rev) {
+        fprintf(stderr, "⏳ Reading revision '%s' of '%s'...\n", g_source_rev, input_dir);
+    } else if (flags & GIT_INDEX) {
+        fprintf(stderr, "⏳ Reading git index of '%s'...\n", input_dir);
+    } else {
+        fprintf(stderr, "⏳ Scanning directory '%s'...\n", input_dir);
+    }
     FileList files;
     init_file_list(&files);
     
-    bool success = scan_directory(input_dir, NULL, &files, 0, &gitignore, flags);
+    bool success;
+    GitObjectStore *store = NULL;
+    if (g_source_rev) {
+        store = collect_git_revision_entries(input_dir, &files);
+        if (!store) {
+            free_file_list(&files);
+            free_gitignore(&gitignore);
+            if (!output_file) {
+                free(out_path);
+            }
+            return 1;
+        }
+        success = files.count > 0;
+    } else if (flags & GIT_INDEX) {
+        if (collect_git_index_entries(input_dir, &files, &gitignore, flags) != 0) {
+            free_file_list(&files);
+            free_gitignore(&gitignore);
+            if (!output_file) {
+                free(out_path);
+            }
+            return 1;
+        }
+        success = files.count > 0;
+    } else if (g_thread_count > 1) {
+        success = scan_directory_parallel(input_dir, &files, &gitignore, flags, g_thread_count);
+    } else {
+        success = scan_directory(input_dir, NULL, &files, 0, &gitignore, flags);
+    }
     /* 
      * If scanning did not add any files but the directory itself is non-empty,
      * warn the user that all files have been ignored.
@@ -580,21 +1397,51 @@ int document_directory(const char *input_dir, const char *output_file, int flags
             fprintf(stderr, "Error: No files or folders found in directory '%s'\n", input_dir);
             free_file_list(&files);
             free_gitignore(&gitignore);
+            git_store_close(store);
             return 1;
         }
     }
     
     fprintf(stderr, "✅ Directory scan complete. Found %zu entries.\n", files.count);
     
-    FILE *out = fopen(out_path, "w");
+    // With splitting requested up front, parts are cut while the document is
+    // produced: text is buffered one file section at a time and rolled over
+    // into the next _partN file when the current one is full.
+    // With --parts the output is written unsplit while the offset and token
+    // count of every file section are recorded; the sections are balanced
+    // over the parts once all counts are known.
+    bool balanced = split_part_count > 0;
+    bool streaming = split_enabled && !balanced;
+    SectionIndex sections = {0};
+    SplitSink sink;
+    FILE *out = NULL;
+    if (streaming) {
+        if (split_sink_open(&sink, out_path, split_limit_bytes, split_token_limit)) {
+            out = sink.stream;
+        }
+    } else {
+        out = fopen(out_path, "w");
+    }
     if (!out) {
         fprintf(stderr, "Error: Cannot create output file '%s'\n", out_path);
         free_file_list(&files);
         free_gitignore(&gitignore);
+        git_store_close(store);
         return 1;
     }
     
     DocumentInfo info = {0};
+    write_summary_header(out, streaming || balanced);
+    long part_token_offset = -1;
+    if ((streaming && split_token_limit > 0) || balanced) {
+        part_token_offset = ftell(out) + (long)strlen(SPLIT_PART_TOKEN_LABEL);
+        fprintf(out, "%s%*s\n\n", SPLIT_PART_TOKEN_LABEL, SPLIT_PART_TOKEN_WIDTH, "");
+    }
+    if (streaming) {
+        sink.first_token_offset = part_token_offset;
+    }
+    bool indexed = !balanced || add_section(&sections, 0, 0);
+    size_t section_start_tokens = 0;
     
     const char *header = "# Directory Documentation: ";
     fprintf(out, "%s%s\n\n", header,
@@ -612,32 +1459,57 @@ int document_directory(const char *input_dir, const char *output_file, int flags
     
     if (!(flags & STRUCTURE_ONLY)) {
         const char *contents_header = "\n## Contents\n\n";
+        if (!streaming) {
+            info.contents_offset = (size_t)ftell(out);
+        }
         fprintf(out, "%s", contents_header);
         calculate_token_stats(contents_header, &info);
         fprintf(stderr, "⏳ Adding file contents...\n");
+        if (!store) {
+            prefetch_file_metadata(input_dir, &files, g_thread_count);
+        }
+        bool cached = !store && g_cache_enabled && file_cache_open(g_cache_path, tiktoken_vocab_fingerprint());
         
-        for (size_t i = 0; i < files.count; i++) {
-            FileEntry *entry = &files.entries[i];
-            if (!entry->is_dir) {
-                char full_path[MAX_PATH_LEN];
-                snprintf(full_path, sizeof(full_path), "%s/%s", input_dir, entry->path);
-                
-                char heading[MAX_PATH_LEN + 16];
-                snprintf(heading, sizeof(heading), "### 📄 %s\n\n", entry->path);
-                fprintf(out, "%s", heading);
-                calculate_token_stats(heading, &info);
-                
-                write_file_content(out, full_path, &info);
-                fprintf(out, "\n");
-            }
+        ContentsWriter writer = {
+            .out = out, .files = &files, .input_dir = input_dir, .store = store, .info = &info,
+            .sink = streaming ? &sink : NULL, .sections = balanced ? &sections : NULL,
+            .indexed = indexed, .section_start_tokens = section_start_tokens,
+        };
+        // Files in the git object store are read by the writer alone
+        int workers = (g_thread_count > 1 && !store) ? g_thread_count : 0;
+        pipeline_run(files.count, workers, (size_t)g_thread_count * PIPELINE_WINDOW_PER_THREAD,
+                     render_entry, write_entry_section, &writer);
+        indexed = writer.indexed;
+        section_start_tokens = writer.section_start_tokens;
+        if (cached) {
+            file_cache_stats(&info.cache_lookups, &info.cache_hits);
+            file_cache_close();
         }
     }
     
-    fclose(out);
+    bool written;
+    if (streaming) {
+        info.split_parts = split_sink_close(&sink, info.total_tokens - section_start_tokens);
+        written = info.split_parts > 0;
+    } else {
+        written = fclose(out) == 0 && indexed;
+        if (written && balanced) {
+            sections.tokens[sections.count - 1] = info.total_tokens - section_start_tokens;
+            info.split_parts = write_balanced_parts(out_path, &sections, part_token_offset);
+            written = info.split_parts > 0;
+        }
+    }
+    free(sections.offsets);
+    free(sections.tokens);
     free_file_list(&files);
     free_gitignore(&gitignore);
     free_extra_ignore_patterns();
+    git_store_close(store);
     
+    if (!written) {
+        fprintf(stderr, "Error: Writing output file '%s'\n", out_path);
+        return 1;
+    }
     if (finalize_output(out_path, &info) != 0) {
         return 1;
     }
@@ -6,6 +6,7 @@
 #include "scanner.h"
 #include "stats.h"
 #include "gitignore.h"
+#include "update.h"
 
 /**
  * @brief Write the directory tree structure to a file stream.
@@ -42,6 +43,56 @@ int finalize_output(const char *out_path, DocumentInfo *info);
  */
 void set_split_options(int enabled, double limit_mb);
 
+/**
+ * @brief Configure a per-part token budget for split output.
+ *
+ * @param max_tokens Maximum tokens per part, or 0 to split by size only.
+ */
+void set_split_tokens(size_t max_tokens);
+
+/**
+ * @brief Balance the output over a fixed number of parts by token count.
+ *
+ * @param parts Number of parts, or 0 to disable.
+ */
+void set_split_parts(size_t parts);
+
+/**
+ * @brief Configure the number of worker threads used by parallel stages.
+ *
+ * @param threads Number of threads; 1 keeps everything serial.
+ */
+void set_thread_count(int threads);
+
+/**
+ * @brief Configure the cache of per-file results kept across runs.
+ *
+ * Cached files are written without being scanned or token counted again.
+ *
+ * @param enabled Non-zero to use the cache (the default).
+ * @param path Cache file, or NULL for ~/.cache/dirdoc/files.cache.
+ */
+void set_file_cache(int enabled, const char *path);
+
+/**
+ * @brief Reuse the sections of unchanged files from an existing document.
+ *
+ * Used by update_document() around document_directory().
+ *
+ * @param index Indexed old document, or NULL to render every file.
+ */
+void set_update_source(const DocIndex *index);
+
+/**
+ * @brief Document a git revision instead of the working tree.
+ *
+ * The file list and contents are read from the repository's objects; nothing
+ * is checked out.
+ *
+ * @param rev Commit-ish to document, or NULL for the working tree.
+ */
+void set_source_revision(const char *rev);
+
 /**
  * @brief Set additional ignore patterns for directory scanning.
  *
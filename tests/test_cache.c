@@ -0,0 +1,132 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "cache.h"
+
+/* Functions from test_dirdoc.c */
+char *create_temp_dir();
+int remove_directory_recursive(const char *path);
+
+static FileCacheKey make_key(uint64_t ino, uint64_t size, int64_t mtime_ns, const char *text) {
+    FileCacheKey key = {0};
+    key.dev = 42;
+    key.ino = ino;
+    key.size = size;
+    key.mtime_ns = mtime_ns;
+    key.hash = file_cache_hash(text, strlen(text));
+    return key;
+}
+
+void test_file_cache_hash() {
+    char a[100], b[100];
+    memset(a, 'x', sizeof(a));
+    memcpy(b, a, sizeof(b));
+    assert(file_cache_hash(a, sizeof(a)) == file_cache_hash(b, sizeof(b)));
+    // A change in a full round, in the tail, or in the length changes the hash
+    b[5] ^= 1;
+    assert(file_cache_hash(a, sizeof(a)) != file_cache_hash(b, sizeof(b)));
+    b[5] ^= 1;
+    b[98] ^= 1;
+    assert(file_cache_hash(a, sizeof(a)) != file_cache_hash(b, sizeof(b)));
+    assert(file_cache_hash(a, 64) != file_cache_hash(a, 65));
+    assert(file_cache_hash(a, 0) != file_cache_hash(a, 1));
+    printf("✔ test_file_cache_hash passed\n");
+}
+
+void test_file_cache_roundtrip() {
+    char *temp_dir = create_temp_dir();
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/sub/dir/files.cache", temp_dir);
+
+    assert(file_cache_open(path, 1));
+    assert(file_cache_active());
+    FileCacheKey k1 = make_key(1, 10, 1000, "version 1");
+    FileCacheKey k2 = make_key(2, 20, 2000, "other file");
+    FileCacheValue v1 = {0}, v2 = {0}, got;
+    v1.length = 10; v1.tokens = 3; v1.max_backticks = 4; v1.last = '\n'; v1.valid_utf8 = 1;
+    v2.binary = 1;
+    assert(!file_cache_lookup(&k1, &got));
+    file_cache_store(&k1, &v1);
+    file_cache_store(&k2, &v2);
+    assert(file_cache_lookup(&k1, &got) && got.tokens == 3 && got.max_backticks == 4);
+    file_cache_close();
+    assert(!file_cache_active());
+
+    // The records survive a reload, and any change to the version misses
+    assert(file_cache_open(path, 1));
+    assert(file_cache_lookup(&k1, &got) && got.length == 10 && got.last == '\n' && got.valid_utf8);
+    assert(file_cache_lookup(&k2, &got) && got.binary);
+    FileCacheKey changed = k1;
+    changed.mtime_ns++;
+    assert(!file_cache_lookup(&changed, &got));
+    changed = make_key(1, 10, 1000, "version 2");
+    assert(!file_cache_lookup(&changed, &got));
+
+    // A new version of the same file replaces the old one
+    v1.tokens = 7;
+    file_cache_store(&changed, &v1);
+    assert(file_cache_lookup(&changed, &got) && got.tokens == 7);
+    assert(!file_cache_lookup(&k1, &got));
+    size_t lookups, hits;
+    file_cache_stats(&lookups, &hits);
+    assert(lookups == 6 && hits == 3);
+    file_cache_close();
+
+    // A build counting with another vocabulary does not see the records
+    assert(file_cache_open(path, 2));
+    assert(!file_cache_lookup(&changed, &got));
+    file_cache_close();
+    assert(file_cache_open(path, 1));
+    assert(file_cache_lookup(&changed, &got) && got.tokens == 7);
+    file_cache_close();
+
+    // A damaged cache file gives an empty cache
+    FILE *f = fopen(path, "r+b");
+    assert(f != NULL);
+    fputc('X', f);
+    fclose(f);
+    assert(file_cache_open(path, 1));
+    assert(!file_cache_lookup(&changed, &got));
+    file_cache_close();
+
+    remove_directory_recursive(temp_dir);
+    free(temp_dir);
+    printf("✔ test_file_cache_roundtrip passed\n");
+}
+
+void test_file_cache_many() {
+    char *temp_dir = create_temp_dir();
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/files.cache", temp_dir);
+
+    // Enough records to grow the index several times
+    assert(file_cache_open(path, 1));
+    FileCacheValue value = {0}, got;
+    for (uint64_t i = 0; i < 5000; i++) {
+        FileCacheKey key = make_key(i, i, (int64_t)i, "text");
+        value.tokens = i * 3;
+        file_cache_store(&key, &value);
+    }
+    file_cache_close();
+    assert(file_cache_open(path, 1));
+    for (uint64_t i = 0; i < 5000; i++) {
+        FileCacheKey key = make_key(i, i, (int64_t)i, "text");
+        assert(file_cache_lookup(&key, &got) && got.tokens == i * 3);
+    }
+    file_cache_close();
+
+    remove_directory_recursive(temp_dir);
+    free(temp_dir);
+    printf("✔ test_file_cache_many passed\n");
+}
+
+void run_cache_tests() {
+    printf("Running file cache tests...\n");
+    test_file_cache_hash();
+    test_file_cache_roundtrip();
+    test_file_cache_many();
+    printf("All file cache tests passed!\n");
+}
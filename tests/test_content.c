@@ -0,0 +1,150 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "content.h"
+#include "stats.h"
+
+/* Results of a byte-by-byte reference scan. */
+typedef struct {
+    size_t length;
+    size_t newlines;
+    int max_backticks;
+    char last;
+    bool valid_utf8;
+    bool binary;
+} Expected;
+
+/* Checks UTF-8 validity by decoding: rejects overlong forms, surrogates,
+ * code points above U+10FFFF and truncated sequences. */
+static bool reference_utf8(const unsigned char *s, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        unsigned char c = s[i];
+        size_t need;
+        unsigned int cp, min;
+        if (c < 0x80) { i++; continue; }
+        if ((c & 0xE0) == 0xC0) { need = 1; cp = c & 0x1F; min = 0x80; }
+        else if ((c & 0xF0) == 0xE0) { need = 2; cp = c & 0x0F; min = 0x800; }
+        else if ((c & 0xF8) == 0xF0) { need = 3; cp = c & 0x07; min = 0x10000; }
+        else return false;
+        for (size_t k = 1; k <= need; k++) {
+            if (i + k >= len || (s[i + k] & 0xC0) != 0x80) return false;
+            cp = (cp << 6) | (s[i + k] & 0x3F);
+        }
+        if (cp < min || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return false;
+        i += need + 1;
+    }
+    return true;
+}
+
+static Expected reference_scan(const unsigned char *data, size_t len) {
+    Expected e = {0};
+    e.length = len;
+    e.last = e.length ? (char)data[e.length - 1] : '\n';
+    int run = 0;
+    for (size_t i = 0; i < e.length; i++) {
+        if (data[i] == '\n') e.newlines++;
+        run = data[i] == '`' ? run + 1 : 0;
+        if (run > e.max_backticks) e.max_backticks = run;
+    }
+    e.valid_utf8 = reference_utf8(data, e.length);
+    e.binary = is_binary_buffer(data, len < BINARY_PROBE_SIZE ? len : BINARY_PROBE_SIZE);
+    return e;
+}
+
+/* Scans data in blocks of the given size and compares with the reference. */
+static void check_scan(const unsigned char *data, size_t len, size_t block) {
+    Expected e = reference_scan(data, len);
+    ContentScan scan;
+    content_scan_init(&scan);
+    for (size_t pos = 0; pos < len; pos += block) {
+        size_t n = len - pos < block ? len - pos : block;
+        content_scan_update(&scan, (const char *)data + pos, n);
+    }
+    content_scan_finish(&scan);
+
+    assert(scan.length == e.length);
+    assert(scan.newlines == e.newlines);
+    assert(scan.max_backticks == e.max_backticks);
+    assert(scan.last == e.last);
+    assert(scan.valid_utf8 == e.valid_utf8);
+    assert(content_scan_binary(&scan) == e.binary);
+    assert(content_scan_lines(&scan) == e.newlines + (e.last != '\n'));
+}
+
+void test_content_scan_examples() {
+    const char *texts[] = {
+        "",
+        "int main() {\n    return 0;\n}\n",
+        "no trailing newline",
+        "```` fence `x` ``````````````````````````````````````` long run\n",
+        "caf\xc3\xa9 \xe6\x97\xa5\xe6\x9c\xac \xf0\x9f\x91\x8d\n",
+        "overlong \xc0\xaf and more text to fill a vector\n",
+        "surrogate \xed\xa0\x80 here\n",
+        "truncated at the end \xe2\x82",
+        "above U+10FFFF \xf4\x90\x80\x80\n",
+    };
+    for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+        size_t len = strlen(texts[i]);
+        for (size_t block = 1; block <= 64; block *= 2) {
+            check_scan((const unsigned char *)texts[i], len, block);
+        }
+        check_scan((const unsigned char *)texts[i], len, len + 1);
+    }
+
+    // NULs are part of the text and count against it in the binary probe
+    char with_nul[2048];
+    memset(with_nul, 'a', sizeof(with_nul));
+    memcpy(with_nul, "head`` \n", 8);
+    with_nul[100] = '\0';
+    check_scan((const unsigned char *)with_nul, sizeof(with_nul), 4096);
+    check_scan((const unsigned char *)with_nul, sizeof(with_nul), 7);
+    memset(with_nul + 200, 0, 400);
+    check_scan((const unsigned char *)with_nul, sizeof(with_nul), 4096);
+    check_scan((const unsigned char *)with_nul, sizeof(with_nul), 33);
+    printf("✔ test_content_scan_examples passed\n");
+}
+
+void test_content_scan_random() {
+    // Random mixes of the bytes the scan cares about, in random blocks
+    static const unsigned char alphabet[] = {
+        'a', ' ', '\n', '\r', '\t', '`', '`', '`', 0x7f, 0x01,
+        0xc3, 0xa9, 0xe2, 0x82, 0xac, 0xf0, 0x9f, 0x80, 0xbf, 0xed, 0xff,
+    };
+    unsigned int seed = 12345;
+    unsigned char data[3000];
+    for (int round = 0; round < 300; round++) {
+        size_t len = 0;
+        seed = seed * 1103515245u + 12345u;
+        size_t target = (seed >> 8) % sizeof(data);
+        while (len < target) {
+            seed = seed * 1103515245u + 12345u;
+            unsigned int r = seed >> 8;
+            if (r % 7 == 0) {
+                // A valid multi-byte character
+                const char *ch = (r & 8) ? "\xe6\x97\xa5" : "\xc3\xa9";
+                size_t n = strlen(ch);
+                if (len + n > target) break;
+                memcpy(data + len, ch, n);
+                len += n;
+            } else {
+                // Every other round stays ASCII, and so valid UTF-8
+                size_t choices = round % 2 ? sizeof(alphabet) : 10;
+                data[len++] = (r % 41 == 0 && round % 3 == 0) ? 0 : alphabet[r % choices];
+            }
+        }
+        size_t block = 1 + (seed >> 4) % 200;
+        check_scan(data, len, block);
+        check_scan(data, len, len + 1);
+    }
+    printf("✔ test_content_scan_random passed\n");
+}
+
+void run_content_tests() {
+    printf("Running content scan tests...\n");
+    test_content_scan_examples();
+    test_content_scan_random();
+    printf("All content scan tests passed!\n");
+}
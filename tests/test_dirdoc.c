@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <libgen.h>  // Add this line for basename declaration
 #include <ctype.h>   // For isalnum() and isspace()
@@ -16,12 +17,20 @@
 #include "scanner.h"
 #include "stats.h"
 #include "writer.h"
+#include "prefetch.h"
+#include "cache.h"
+#include "update.h"
 
 void test_smart_split();
 void run_tiktoken_tests();
+void run_pretokenize_tests();
+void run_content_tests();
 void run_split_tests();
 int run_file_deletion_tests(void);
 void run_reconstruct_tests();
+void run_gitindex_tests();
+void run_gitobject_tests();
+void run_cache_tests();
 
 #ifndef MAX_PATH_LEN
 #define MAX_PATH_LEN 4096
@@ -274,6 +283,39 @@ void test_gitignore_wildcards() {
     free(temp_dir);
 }
 
+/* Test the combined gitignore matcher:
+ * rules are evaluated together but the last matching rule must still win,
+ * and adding a rule after matching has started must take effect.
+ */
+void test_gitignore_combined_matcher() {
+    GitignoreList gitignore = {0};
+    parse_gitignore_pattern_string("*.o", &gitignore);
+    parse_gitignore_pattern_string("!keep.o", &gitignore);
+    parse_gitignore_pattern_string("docs/**/*.html", &gitignore);
+    parse_gitignore_pattern_string("cache/", &gitignore);
+    parse_gitignore_pattern_string("/v?.txt", &gitignore);
+    
+    assert(match_gitignore("a/b/main.o", &gitignore) == 1);
+    assert(match_gitignore("a/keep.o", &gitignore) == 0);
+    assert(match_gitignore("docs/api/x/index.html", &gitignore) == 1);
+    assert(match_gitignore("docs/readme.md", &gitignore) == 0);
+    assert(match_gitignore("src/cache/data.bin", &gitignore) == 1);
+    assert(match_gitignore("v1.txt", &gitignore) == 1);
+    assert(match_gitignore("sub/v1.txt", &gitignore) == 0);
+    assert(match_gitignore("v12.txt", &gitignore) == 0);
+    // Plain names match whole path components only.
+    assert(match_gitignore("src/cache", &gitignore) == 1);
+    assert(match_gitignore("src/mycache/data.bin", &gitignore) == 0);
+    assert(match_gitignore("archive.tar.o", &gitignore) == 1);
+    
+    // A later rule overrides the earlier negation once the matcher is rebuilt.
+    parse_gitignore_pattern_string("keep.o", &gitignore);
+    assert(match_gitignore("a/keep.o", &gitignore) == 1);
+    
+    free_gitignore(&gitignore);
+    printf("✔ test_gitignore_combined_matcher passed\n");
+}
+
 /* Test for a folder where all files are ignored by .gitignore.
  * This test creates a temporary directory with a .gitignore that ignores all *.txt files.
  * It then creates only .txt files in the directory.
@@ -431,6 +473,127 @@ void test_scan_directory() {
     free(temp_dir);
 }
 
+/* Test the parallel directory scanner:
+ * Build a nested tree, scan it serially (plus qsort, as document_directory does)
+ * and in parallel, and verify both produce identical entries in identical order.
+ */
+void test_scan_directory_parallel() {
+    char *temp_dir = create_temp_dir();
+    const char *dirs[] = {"a", "a/b", "a/b/c", "a.d", "z", "z/y", "m"};
+    for (size_t i = 0; i < sizeof(dirs) / sizeof(dirs[0]); i++) {
+        char path[MAX_PATH_LEN];
+        snprintf(path, sizeof(path), "%s/%s", temp_dir, dirs[i]);
+        if (mkdir(path, 0755) != 0) {
+            perror("mkdir");
+            exit(EXIT_FAILURE);
+        }
+    }
+    const char *files[] = {"root.txt", "a/one.c", "a/b/two.c", "a/b/c/three.c", "a.d/x",
+                           "a.txt", "z/y/deep.md", "z/zz.txt", "m/file"};
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+        create_file(temp_dir, files[i], "content\n");
+    }
+
+    FileList serial;
+    init_file_list(&serial);
+    assert(scan_directory(temp_dir, NULL, &serial, 0, NULL, INCLUDE_GIT));
+    qsort(serial.entries, serial.count, sizeof(FileEntry), compare_entries);
+
+    FileList parallel;
+    init_file_list(&parallel);
+    assert(scan_directory_parallel(temp_dir, &parallel, NULL, INCLUDE_GIT, 4));
+
+    assert(serial.count == parallel.count);
+    for (size_t i = 0; i < serial.count; i++) {
+        assert(strcmp(serial.entries[i].path, parallel.entries[i].path) == 0);
+        assert(serial.entries[i].is_dir == parallel.entries[i].is_dir);
+        assert(serial.entries[i].depth == parallel.entries[i].depth);
+    }
+    free_file_list(&serial);
+    free_file_list(&parallel);
+    printf("✔ test_scan_directory_parallel passed\n");
+
+#ifndef INSPECT_TEMP
+    if (remove_directory_recursive(temp_dir) == 0) {
+        printf("Folder '%s' removed successfully.\n", temp_dir);
+    } else {
+        printf("Failed to remove folder '%s'.\n", temp_dir);
+    }
+#endif
+    free(temp_dir);
+}
+
+/* Test nested .gitignore files:
+ * rules from a subdirectory's .gitignore apply only beneath it and override
+ * the root rules; both scanners must honor them identically.
+ */
+static bool file_list_contains(const FileList *list, const char *path) {
+    for (size_t i = 0; i < list->count; i++) {
+        if (strcmp(list->entries[i].path, path) == 0) return true;
+    }
+    return false;
+}
+
+void test_nested_gitignore() {
+    char *temp_dir = create_temp_dir();
+    const char *dirs[] = {"sub", "sub/deep", "other"};
+    for (size_t i = 0; i < sizeof(dirs) / sizeof(dirs[0]); i++) {
+        char path[MAX_PATH_LEN];
+        snprintf(path, sizeof(path), "%s/%s", temp_dir, dirs[i]);
+        if (mkdir(path, 0755) != 0) {
+            perror("mkdir");
+            exit(EXIT_FAILURE);
+        }
+    }
+    create_file(temp_dir, ".gitignore", "*.log\n");
+    create_file(temp_dir, "sub/.gitignore", "secret.txt\n!keep.log\n/top.txt\n");
+    const char *files[] = {"a.log", "secret.txt", "sub/secret.txt", "sub/keep.log", "sub/b.log",
+                           "sub/top.txt", "sub/deep/top.txt", "sub/deep/secret.txt", "other/secret.txt"};
+    for (size_t i = 0; i < sizeof(files) / sizeof(files[0]); i++) {
+        create_file(temp_dir, files[i], "content\n");
+    }
+
+    GitignoreList gitignore;
+    load_gitignore(temp_dir, &gitignore);
+    for (int threads = 1; threads <= 3; threads += 2) {
+        FileList list;
+        init_file_list(&list);
+        if (threads == 1) {
+            assert(scan_directory(temp_dir, NULL, &list, 0, &gitignore, 0));
+        } else {
+            assert(scan_directory_parallel(temp_dir, &list, &gitignore, 0, threads));
+        }
+        assert(!file_list_contains(&list, "a.log"));
+        assert(file_list_contains(&list, "secret.txt"));
+        assert(!file_list_contains(&list, "sub/secret.txt"));
+        assert(file_list_contains(&list, "sub/keep.log"));
+        assert(!file_list_contains(&list, "sub/b.log"));
+        assert(!file_list_contains(&list, "sub/top.txt"));
+        assert(file_list_contains(&list, "sub/deep/top.txt"));
+        assert(!file_list_contains(&list, "sub/deep/secret.txt"));
+        assert(file_list_contains(&list, "other/secret.txt"));
+        free_file_list(&list);
+    }
+
+    // With IGNORE_GITIGNORE nested files are not consulted either.
+    FileList all;
+    init_file_list(&all);
+    assert(scan_directory(temp_dir, NULL, &all, 0, NULL, IGNORE_GITIGNORE));
+    assert(file_list_contains(&all, "sub/secret.txt"));
+    free_file_list(&all);
+    free_gitignore(&gitignore);
+    printf("✔ test_nested_gitignore passed\n");
+
+#ifndef INSPECT_TEMP
+    if (remove_directory_recursive(temp_dir) == 0) {
+        printf("Folder '%s' removed successfully.\n", temp_dir);
+    } else {
+        printf("Failed to remove folder '%s'.\n", temp_dir);
+    }
+#endif
+    free(temp_dir);
+}
+
 /* Test stats functions by counting tokens and checking backtick counts */
 void test_stats() {
     const char *sample = "Hello, world!\nThis is a test.\n```\n";
@@ -531,6 +694,50 @@ void test_is_binary_file() {
     free(temp_dir);
 }
 
+/* Test the metadata prefetch stage:
+ * Sizes and binary verdicts collected in one pass must match what the
+ * per-file helpers report.
+ */
+void test_prefetch_file_metadata() {
+    char *temp_dir = create_temp_dir();
+    create_file(temp_dir, "text.txt", "Plain text content.\n");
+    char path[MAX_PATH_LEN];
+    snprintf(path, sizeof(path), "%s/%s", temp_dir, "blob.bin");
+    FILE *f = fopen(path, "wb");
+    assert(f != NULL);
+    unsigned char data[2000];
+    memset(data, 0, sizeof(data));
+    fwrite(data, 1, sizeof(data), f);
+    fclose(f);
+
+    FileList list;
+    init_file_list(&list);
+    assert(scan_directory(temp_dir, NULL, &list, 0, NULL, 0));
+    qsort(list.entries, list.count, sizeof(FileEntry), compare_entries);
+    prefetch_file_metadata(temp_dir, &list, 2);
+
+    assert(list.count == 2);
+    assert(strcmp(list.entries[0].path, "blob.bin") == 0);
+    assert(list.entries[0].has_meta && list.entries[0].is_binary);
+    assert(list.entries[0].size == 2000);
+    assert(list.entries[1].has_meta && !list.entries[1].is_binary);
+    assert(list.entries[1].size == (long long)strlen("Plain text content.\n"));
+    // The text file fit in the probed block, so its contents are kept; the binary one is dropped
+    assert(list.entries[0].head == NULL);
+    assert(list.entries[1].head && memcmp(list.entries[1].head, "Plain text content.\n", 20) == 0);
+    free_file_list(&list);
+    printf("✔ test_prefetch_file_metadata passed\n");
+
+#ifndef INSPECT_TEMP
+    if (remove_directory_recursive(temp_dir) == 0) {
+        printf("Folder '%s' removed successfully.\n", temp_dir);
+    } else {
+        printf("Failed to remove folder '%s'.\n", temp_dir);
+    }
+#endif
+    free(temp_dir);
+}
+
 /* Test the extra ignore pattern functionality with the -ngi option.
  * This test creates a temporary directory with a .gitignore that would normally ignore file2.txt.
  * With the -ngi flag, the .gitignore file is ignored, and an extra ignore pattern is provided
@@ -610,6 +817,64 @@ void test_is_binary_file() {
     printf("✔ test_ignore_extra_patterns_with_ngi passed\n");
 }
 
+/* Test that --ignore patterns win over negations in nested .gitignore files.
+ * sub/.gitignore re-includes *.log, which must not bring back the logs that
+ * the extra pattern excludes, with either scanner.
+ */
+void test_ignore_extra_patterns_over_nested_negation() {
+    char *temp_dir = create_temp_dir();
+    char sub_path[MAX_PATH_LEN];
+    snprintf(sub_path, sizeof(sub_path), "%s/sub", temp_dir);
+    if (mkdir(sub_path, 0755) != 0) {
+        perror("mkdir");
+        exit(EXIT_FAILURE);
+    }
+    create_file(temp_dir, ".gitignore", "*.tmp\n");
+    create_file(temp_dir, "sub/.gitignore", "!*.log\n!*.tmp\n");
+    create_file(temp_dir, "sub/app.log", "log line\n");
+    create_file(temp_dir, "sub/scratch.tmp", "scratch\n");
+    create_file(temp_dir, "sub/notes.txt", "notes\n");
+
+    char *patterns[1] = {"*.log"};
+    set_split_options(0, 18.0);   // earlier tests leave splitting enabled
+    for (int threads = 1; threads <= 3; threads += 2) {
+        // document_directory() releases the patterns when it finishes
+        set_extra_ignore_patterns(patterns, 1);
+        char output_file[MAX_PATH_LEN];
+        snprintf(output_file, sizeof(output_file), "%s/out%d.md", temp_dir, threads);
+        set_thread_count(threads);
+        assert(document_directory(temp_dir, output_file, 0) == 0);
+
+        FILE *f = fopen(output_file, "r");
+        assert(f != NULL);
+        fseek(f, 0, SEEK_END);
+        long fsize = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        char *content = malloc(fsize + 1);
+        assert(fread(content, 1, fsize, f) == (size_t)fsize);
+        content[fsize] = '\0';
+        fclose(f);
+
+        assert(strstr(content, "app.log") == NULL);
+        // Negations still override the .gitignore rules themselves
+        assert(strstr(content, "scratch.tmp") != NULL);
+        assert(strstr(content, "notes.txt") != NULL);
+        free(content);
+        remove(output_file);
+    }
+    set_thread_count(1);
+
+#ifndef INSPECT_TEMP
+    if (remove_directory_recursive(temp_dir) == 0) {
+        printf("Folder '%s' removed successfully.\n", temp_dir);
+    } else {
+        printf("Failed to remove folder '%s'.\n", temp_dir);
+    }
+#endif
+    free(temp_dir);
+    printf("✔ test_ignore_extra_patterns_over_nested_negation passed\n");
+}
+
 /* Test that the --ignore option works with directories.
  * This test creates a temporary directory with a subdirectory,
  * then uses extra_ignore_patterns to ignore the subdirectory.
@@ -680,6 +945,422 @@ void test_ignore_directory() {
     printf("✔ test_ignore_directory passed\n");
 }
 
+/* The token count is patched into the header's reserved field after the body is written. */
+void test_summary_header_token_count() {
+    char *temp_dir = create_temp_dir();
+    create_file(temp_dir, "hello.txt", "Hello, world! This is a small file.\n");
+
+    char output_file[MAX_PATH_LEN];
+    snprintf(output_file, sizeof(output_file), "%s/%s", temp_dir, "test_header.md");
+    char *patterns[1] = {"*.md"};
+    set_extra_ignore_patterns(patterns, 1);
+    set_split_options(0, 18.0);   // earlier tests leave splitting enabled
+    assert(document_directory(temp_dir, output_file, 0) == 0);
+
+    FILE *f = fopen(output_file, "r");
+    assert(f != NULL);
+    char content[8192];
+    size_t len = fread(content, 1, sizeof(content) - 1, f);
+    content[len] = '\0';
+    fclose(f);
+
+    assert(strncmp(content, "# Documentation Summary\n\n", 25) == 0);
+    char *field = strstr(content, "Token Size: ");
+    assert(field != NULL);
+    char *end;
+    unsigned long tokens = strtoul(field + strlen("Token Size: "), &end, 10);
+    assert(tokens > 0);
+    while (*end == ' ') end++;
+    assert(strncmp(end, "\n\n# Directory Documentation: ", 29) == 0);
+    assert(strstr(content, "Hello, world!") != NULL);
+
+    remove(output_file);
+#ifndef INSPECT_TEMP
+    remove_directory_recursive(temp_dir);
+#endif
+    free(temp_dir);
+    printf("✔ test_summary_header_token_count passed\n");
+}
+
+/* Writes a file large enough to be mapped and checks that its body lands
+ * between the surrounding stream output, on a file and on a memory stream. */
+void test_write_large_file_content() {
+    char *temp_dir = create_temp_dir();
+    size_t len = 200 * 1024;
+    char *text = malloc(len + 1);
+    assert(text != NULL);
+    for (size_t i = 0; i < len; i++) {
+        text[i] = (i % 64 == 63) ? '\n' : (char)('a' + i % 26);
+    }
+    memcpy(text + 1000, "`````", 5);
+    text[len - 1] = 'z';   // no trailing newline
+    text[len] = '\0';
+    create_file(temp_dir, "large.c", text);
+    char path[MAX_PATH_LEN];
+    snprintf(path, sizeof(path), "%s/large.c", temp_dir);
+
+    char expected[1024];
+    snprintf(expected, sizeof(expected), "before\n``````c\n");
+    size_t head = strlen(expected);
+    const char *tail = "\n``````\nafter\n";
+
+    char out_path[MAX_PATH_LEN];
+    snprintf(out_path, sizeof(out_path), "%s/out.md", temp_dir);
+    FILE *out = fopen(out_path, "w+");
+    assert(out != NULL);
+    DocumentInfo info = {0};
+    fprintf(out, "before\n");
+    write_file_content(out, path, &info);
+    fprintf(out, "after\n");
+    size_t total = head + len + strlen(tail);
+    assert((size_t)ftell(out) == total);
+    assert(info.total_lines == len / 64);   // the last line feed became the z
+
+    rewind(out);
+    char *written = malloc(total + 1);
+    assert(fread(written, 1, total + 1, out) == total);
+    fclose(out);
+    assert(memcmp(written, expected, head) == 0);
+    assert(memcmp(written + head, text, len) == 0);
+    assert(memcmp(written + head + len, tail, strlen(tail)) == 0);
+
+    // A memory stream has no descriptor and gets the same bytes
+    char *mem = NULL;
+    size_t mem_size = 0;
+    FILE *ms = open_memstream(&mem, &mem_size);
+    assert(ms != NULL);
+    DocumentInfo mem_info = {0};
+    fprintf(ms, "before\n");
+    write_file_content(ms, path, &mem_info);
+    fprintf(ms, "after\n");
+    fclose(ms);
+    assert(mem_size == total && memcmp(mem, written, total) == 0);
+    assert(mem_info.total_tokens == info.total_tokens);
+
+    free(mem);
+    free(written);
+    free(text);
+#ifndef INSPECT_TEMP
+    remove_directory_recursive(temp_dir);
+#endif
+    free(temp_dir);
+    printf("✔ test_write_large_file_content passed\n");
+}
+
+void test_write_file_with_nul() {
+    char *temp_dir = create_temp_dir();
+    // NULs past the binary probe, in a file read whole and in a mapped one
+    size_t sizes[2] = {2900, 100 * 1024};
+    for (int k = 0; k < 2; k++) {
+        size_t len = sizes[k];
+        char *text = malloc(len);
+        assert(text != NULL);
+        for (size_t i = 0; i < len; i++) {
+            text[i] = (i % 40 == 39) ? '\n' : (char)('a' + i % 26);
+        }
+        text[2800] = '\0';
+        char path[MAX_PATH_LEN];
+        snprintf(path, sizeof(path), "%s/nul%d.c", temp_dir, k);
+        FILE *f = fopen(path, "wb");
+        assert(f != NULL);
+        fwrite(text, 1, len, f);
+        fclose(f);
+
+        char *mem = NULL;
+        size_t mem_size = 0;
+        FILE *ms = open_memstream(&mem, &mem_size);
+        assert(ms != NULL);
+        DocumentInfo info = {0};
+        write_file_content(ms, path, &info);
+        fclose(ms);
+        const char *head = "```c\n";
+        const char *tail = text[len - 1] == '\n' ? "```\n" : "\n```\n";
+        assert(mem_size == strlen(head) + len + strlen(tail));
+        assert(memcmp(mem, head, strlen(head)) == 0);
+        assert(memcmp(mem + strlen(head), text, len) == 0);
+        assert(info.total_size == len);
+        assert(memcmp(mem + strlen(head) + len, tail, strlen(tail)) == 0);
+        assert(info.total_lines == (len + 39) / 40);
+        free(mem);
+        free(text);
+    }
+#ifndef INSPECT_TEMP
+    remove_directory_recursive(temp_dir);
+#endif
+    free(temp_dir);
+    printf("✔ test_write_file_with_nul passed\n");
+}
+
+/* Reads a whole file into a NUL-terminated buffer. */
+static char *read_whole_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    assert(f != NULL);
+    fseek(f, 0, SEEK_END);
+    *len = (size_t)ftell(f);
+    rewind(f);
+    char *data = malloc(*len + 1);
+    assert(data != NULL && fread(data, 1, *len, f) == *len);
+    data[*len] = '\0';
+    fclose(f);
+    return data;
+}
+
+/* Documents the same tree serially and with the parallel pipeline, which must
+ * give identical output, including a file too large to be rendered ahead. */
+void test_parallel_contents_identical() {
+    char *temp_dir = create_temp_dir();
+    char name[32], text[256];
+    for (int i = 0; i < 40; i++) {
+        snprintf(name, sizeof(name), "file%02d.c", i);
+        snprintf(text, sizeof(text), "int f%d(void) { return %d; }\n``` fence %d\n", i, i * 7, i);
+        create_file(temp_dir, name, text);
+    }
+    create_file(temp_dir, "data.bin", "\x01\x02\x03\x04\x05\x06\x07\x08 binary");
+    size_t big_len = 1536 * 1024;
+    char *big = malloc(big_len + 1);
+    assert(big != NULL);
+    for (size_t i = 0; i < big_len; i++) {
+        big[i] = (i % 80 == 79) ? '\n' : (char)('a' + i % 23);
+    }
+    big[big_len] = '\0';
+    create_file(temp_dir, "zbig.txt", big);
+    free(big);
+
+    char *patterns[1] = {"*.md"};
+    set_extra_ignore_patterns(patterns, 1);
+    set_split_options(0, 18.0);
+    char serial_path[MAX_PATH_LEN], parallel_path[MAX_PATH_LEN];
+    snprintf(serial_path, sizeof(serial_path), "%s/serial.md", temp_dir);
+    snprintf(parallel_path, sizeof(parallel_path), "%s/parallel.md", temp_dir);
+    set_thread_count(1);
+    assert(document_directory(temp_dir, serial_path, 0) == 0);
+    set_extra_ignore_patterns(patterns, 1);   // each run consumes them
+    set_thread_count(4);
+    assert(document_directory(temp_dir, parallel_path, 0) == 0);
+    set_thread_count(1);
+
+    size_t serial_len, parallel_len;
+    char *serial = read_whole_file(serial_path, &serial_len);
+    char *parallel = read_whole_file(parallel_path, &parallel_len);
+    assert(serial_len == parallel_len && memcmp(serial, parallel, serial_len) == 0);
+    assert(strstr(serial, "f39(void)") != NULL);
+
+    free(serial);
+    free(parallel);
+#ifndef INSPECT_TEMP
+    remove_directory_recursive(temp_dir);
+#endif
+    free(temp_dir);
+    printf("✔ test_parallel_contents_identical passed\n");
+}
+
+/* Writes a file's content to a memory stream and returns the text. */
+static char *render_file_content(const char *path, DocumentInfo *info) {
+    char *text = NULL;
+    size_t size = 0;
+    FILE *ms = open_memstream(&text, &size);
+    assert(ms != NULL);
+    write_file_content(ms, path, info);
+    fclose(ms);
+    return text;
+}
+
+/* A second write of an unchanged file comes from the cache with the same
+ * output and statistics; an edit that keeps size and mtime still misses. */
+void test_file_cache_content() {
+    char *temp_dir = create_temp_dir();
+    char cache_path[MAX_PATH_LEN], path[MAX_PATH_LEN];
+    snprintf(cache_path, sizeof(cache_path), "%s/files.cache", temp_dir);
+    snprintf(path, sizeof(path), "%s/code.c", temp_dir);
+    create_file(temp_dir, "code.c", "int main() {\n    return 0; // ```\n}");
+
+    DocumentInfo first = {0}, second = {0}, third = {0};
+    assert(file_cache_open(cache_path, tiktoken_vocab_fingerprint()));
+    char *a = render_file_content(path, &first);
+    char *b = render_file_content(path, &second);
+    size_t lookups, hits;
+    file_cache_stats(&lookups, &hits);
+    assert(lookups == 2 && hits == 1);
+    assert(strcmp(a, b) == 0 && strstr(a, "````c\n") != NULL);
+    assert(first.total_tokens == second.total_tokens && first.total_size == second.total_size);
+    assert(first.total_lines == 3 && second.total_lines == 3);
+
+    // Same size, same modification time, different content
+    struct stat st;
+    assert(stat(path, &st) == 0);
+    create_file(temp_dir, "code.c", "int main() {\n    return 1; // ```\n}");
+    struct timespec times[2] = {st.st_atim, st.st_mtim};
+    assert(utimensat(AT_FDCWD, path, times, 0) == 0);
+    char *c = render_file_content(path, &third);
+    file_cache_stats(&lookups, &hits);
+    assert(lookups == 3 && hits == 1);
+    assert(strstr(c, "return 1;") != NULL);
+    file_cache_close();
+
+    free(a);
+    free(b);
+    free(c);
+#ifndef INSPECT_TEMP
+    remove_directory_recursive(temp_dir);
+#endif
+    free(temp_dir);
+    printf("✔ test_file_cache_content passed\n");
+}
+
+/* Documents a tree without a cache, then twice with one: all three outputs
+ * must be the same. */
+void test_file_cache_document() {
+    char *temp_dir = create_temp_dir();
+    char *cache_dir = create_temp_dir();
+    char cache_path[MAX_PATH_LEN];
+    snprintf(cache_path, sizeof(cache_path), "%s/files.cache", cache_dir);
+    create_file(temp_dir, "a.c", "int a;\n");
+    create_file(temp_dir, "b.py", "print('b')\n");
+    create_file(temp_dir, "c.bin", "\x01\x02\x03\x04\x05\x06\x07");
+    size_t big_len = 100 * 1024;
+    char *big = malloc(big_len + 1);
+    assert(big != NULL);
+    for (size_t i = 0; i < big_len; i++) {
+        big[i] = (i % 50 == 49) ? '\n' : (char)('a' + i % 19);
+    }
+    big[big_len] = '\0';
+    create_file(temp_dir, "big.txt", big);
+    free(big);
+
+    char *patterns[1] = {"*.md"};
+    set_split_options(0, 18.0);
+    char *outputs[3];
+    for (int run = 0; run < 3; run++) {
+        char out_path[MAX_PATH_LEN];
+        snprintf(out_path, sizeof(out_path), "%s/run%d.md", temp_dir, run);
+        set_file_cache(run > 0, cache_path);
+        set_extra_ignore_patterns(patterns, 1);
+        assert(document_directory(temp_dir, out_path, 0) == 0);
+        size_t len;
+        outputs[run] = read_whole_file(out_path, &len);
+        remove(out_path);
+    }
+    set_file_cache(0, NULL);
+    assert(strcmp(outputs[0], outputs[1]) == 0);
+    assert(strcmp(outputs[0], outputs[2]) == 0);
+    struct stat st;
+    assert(stat(cache_path, &st) == 0 && st.st_size > 0);
+
+    for (int run = 0; run < 3; run++) {
+        free(outputs[run]);
+    }
+#ifndef INSPECT_TEMP
+    remove_directory_recursive(temp_dir);
+    remove_directory_recursive(cache_dir);
+#endif
+    free(temp_dir);
+    free(cache_dir);
+    printf("✔ test_file_cache_document passed\n");
+}
+
+void test_update_document() {
+    char *temp_dir = create_temp_dir();
+    char *work_dir = create_temp_dir();
+    char cache_path[MAX_PATH_LEN], doc_path[MAX_PATH_LEN], full_path[MAX_PATH_LEN];
+    snprintf(cache_path, sizeof(cache_path), "%s/files.cache", work_dir);
+    snprintf(doc_path, sizeof(doc_path), "%s/doc.md", work_dir);
+    snprintf(full_path, sizeof(full_path), "%s/full.md", work_dir);
+    create_file(temp_dir, "a.c", "int a;\n");
+    create_file(temp_dir, "b.py", "print('b')\n");
+    create_file(temp_dir, "c.bin", "\x01\x02\x03\x04\x05\x06\x07");
+    create_file(temp_dir, "ticks.txt", "```\ncode\n````\n");
+    create_file(temp_dir, "no_newline.c", "int x;");
+    create_file(temp_dir, "empty.txt", "");
+    create_file(temp_dir, "big.txt", "abcdefghij\nklmnopqrst\n");
+    set_split_options(0, 18.0);
+    set_file_cache(1, cache_path);
+    assert(document_directory(temp_dir, doc_path, 0) == 0);
+
+    // Edit, remove and add files. big.txt changes too, but keeps its size and
+    // times, so the update takes it for unchanged and copies its old section
+    // where a full run reads the new text
+    create_file(temp_dir, "b.py", "print('b2')\n");
+    char removed[MAX_PATH_LEN];
+    snprintf(removed, sizeof(removed), "%s/a.c", temp_dir);
+    remove(removed);
+    create_file(temp_dir, "d.h", "int d;\n");
+    char big_path[MAX_PATH_LEN];
+    snprintf(big_path, sizeof(big_path), "%s/big.txt", temp_dir);
+    struct stat st;
+    assert(stat(big_path, &st) == 0);
+    create_file(temp_dir, "big.txt", "Abcdefghij\nklmnopqrst\n");
+    struct timespec times[2] = {st.st_atim, st.st_mtim};
+    assert(utimensat(AT_FDCWD, big_path, times, 0) == 0);
+
+    assert(update_document(doc_path, temp_dir, 0) == 0);
+    assert(document_directory(temp_dir, full_path, 0) == 0);
+    size_t updated_len, full_len;
+    char *updated = read_whole_file(doc_path, &updated_len);
+    char *full = read_whole_file(full_path, &full_len);
+    assert(updated_len == full_len);
+    assert(strstr(updated, "print('b2')") && strstr(updated, "int d;") && !strstr(updated, "int a;"));
+    // The update matches a full run except for the copied section, and the
+    // token total in the header, which counts the copied text
+    assert(strstr(full, "Abcdefghij") && !strstr(full, "abcdefghij"));
+    char *copied = strstr(updated, "abcdefghij");
+    assert(copied != NULL);
+    *copied = 'A';
+    const char *body = strstr(full, "\n# Directory Documentation");
+    assert(body != NULL);
+    size_t body_at = (size_t)(body - full);
+    assert(memcmp(updated + body_at, full + body_at, full_len - body_at) == 0);
+    free(updated);
+
+    // A document older than the cache entry of a file is not trusted for it:
+    // the section must hold the text the cache saw
+    char stale_path[MAX_PATH_LEN];
+    snprintf(stale_path, sizeof(stale_path), "%s/stale.md", work_dir);
+    assert(document_directory(temp_dir, stale_path, 0) == 0);
+    char b_path[MAX_PATH_LEN];
+    snprintf(b_path, sizeof(b_path), "%s/b.py", temp_dir);
+    assert(stat(b_path, &st) == 0);
+    create_file(temp_dir, "b.py", "print('b3')\n");
+    times[0] = st.st_atim;
+    times[1] = st.st_mtim;
+    times[1].tv_sec += 10;
+    assert(utimensat(AT_FDCWD, b_path, times, 0) == 0);
+    assert(document_directory(temp_dir, full_path, 0) == 0);
+    assert(update_document(stale_path, temp_dir, 0) == 0);
+    free(full);
+    full = read_whole_file(full_path, &full_len);
+    updated = read_whole_file(stale_path, &updated_len);
+    assert(strstr(updated, "print('b3')") && !strstr(updated, "print('b2')"));
+    assert(updated_len == full_len && memcmp(updated, full, full_len) == 0);
+    free(updated);
+
+    // A failed run leaves the old document in place
+    char missing[MAX_PATH_LEN];
+    snprintf(missing, sizeof(missing), "%s/missing", work_dir);
+    assert(update_document(full_path, missing, 0) != 0);
+    updated = read_whole_file(full_path, &updated_len);
+    assert(updated_len == full_len && memcmp(updated, full, full_len) == 0);
+    free(updated);
+    free(full);
+
+    // Files that are not dirdoc documents are refused and left alone
+    create_file(work_dir, "notes.md", "# Notes\n\nhello\n");
+    char notes[MAX_PATH_LEN];
+    snprintf(notes, sizeof(notes), "%s/notes.md", work_dir);
+    assert(update_document(notes, temp_dir, 0) != 0);
+    char *text = read_whole_file(notes, &updated_len);
+    assert(strcmp(text, "# Notes\n\nhello\n") == 0);
+    free(text);
+    set_file_cache(0, NULL);
+
+#ifndef INSPECT_TEMP
+    remove_directory_recursive(temp_dir);
+    remove_directory_recursive(work_dir);
+#endif
+    free(temp_dir);
+    free(work_dir);
+    printf("✔ test_update_document passed\n");
+}
+
 /* Main test runner */
 int main(int argc, char *argv[]) {
     // Check if we should only run tiktoken tests
@@ -689,23 +1370,42 @@ int main(int argc, char *argv[]) {
     }
     
     printf("Running tests for dirdoc...\n");
+    // Keep the tests out of the user's cache
+    set_file_cache(0, NULL);
     test_get_default_output();
     test_get_language_from_extension();
     test_gitignore();
     test_gitignore_wildcards();
+    test_gitignore_combined_matcher();
     test_all_ignored_files();
     test_compare_entries();
     test_scan_directory();
+    test_scan_directory_parallel();
+    test_nested_gitignore();
     test_stats();
     test_is_binary_file();
+    test_prefetch_file_metadata();
     test_ignore_extra_patterns_with_ngi();
+    test_ignore_extra_patterns_over_nested_negation();
     test_ignore_directory();
+    test_summary_header_token_count();
+    test_write_large_file_content();
+    test_write_file_with_nul();
+    test_parallel_contents_identical();
+    test_file_cache_content();
+    test_file_cache_document();
+    test_update_document();
     
     // Run tests from other files
     run_tiktoken_tests();
+    run_pretokenize_tests();
+    run_content_tests();
     run_split_tests();
     run_file_deletion_tests();
     run_reconstruct_tests();
+    run_gitindex_tests();
+    run_gitobject_tests();
+    run_cache_tests();
     
     printf("✅ All tests passed!\n");
 
@@ -0,0 +1,150 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+#include "dirdoc.h"
+#include "gitindex.h"
+#include "gitignore.h"
+#include "scanner.h"
+
+/* Functions from test_dirdoc.c */
+char *create_temp_dir();
+int remove_directory_recursive(const char *path);
+
+typedef struct {
+    const char *path;
+    uint32_t mode;
+    int stage;
+} IndexEntrySpec;
+
+static void put_be32(FILE *f, uint32_t v) {
+    fputc((v >> 24) & 0xff, f);
+    fputc((v >> 16) & 0xff, f);
+    fputc((v >> 8) & 0xff, f);
+    fputc(v & 0xff, f);
+}
+
+static void put_be16(FILE *f, uint16_t v) {
+    fputc((v >> 8) & 0xff, f);
+    fputc(v & 0xff, f);
+}
+
+/* Write a synthetic .git/index (version 2 or 4) with zeroed stat data and ids. */
+static void write_index(const char *repo, int version, const IndexEntrySpec *entries, size_t count) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/.git", repo);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/.git/index", repo);
+    FILE *f = fopen(path, "wb");
+    assert(f != NULL);
+    fwrite("DIRC", 1, 4, f);
+    put_be32(f, (uint32_t)version);
+    put_be32(f, (uint32_t)count);
+
+    const char *prev = "";
+    for (size_t i = 0; i < count; i++) {
+        for (int w = 0; w < 10; w++) {
+            put_be32(f, w == 6 ? entries[i].mode : 0);
+        }
+        for (int b = 0; b < 20; b++) fputc(0, f);
+        size_t len = strlen(entries[i].path);
+        put_be16(f, (uint16_t)((entries[i].stage << 12) | (len < 0xfff ? len : 0xfff)));
+        if (version == 4) {
+            size_t common = 0;
+            while (prev[common] && prev[common] == entries[i].path[common]) common++;
+            fputc((int)(strlen(prev) - common), f); // small values fit one varint byte
+            fwrite(entries[i].path + common, 1, len - common + 1, f);
+            prev = entries[i].path;
+        } else {
+            fwrite(entries[i].path, 1, len, f);
+            size_t padded = (62 + len + 8) & ~(size_t)7;
+            for (size_t p = 62 + len; p < padded; p++) fputc(0, f);
+        }
+    }
+    for (int b = 0; b < 20; b++) fputc(0, f);
+    fclose(f);
+}
+
+static void assert_paths(const FileList *list, const char **expected, size_t count) {
+    assert(list->count == count);
+    for (size_t i = 0; i < count; i++) {
+        assert(strcmp(list->entries[i].path, expected[i]) == 0);
+    }
+}
+
+/* Tracked files come back in tree order with synthesized directories. */
+void test_read_git_index() {
+    const IndexEntrySpec entries[] = {
+        {"a.txt", 0100644, 0},
+        {"a/b/c.txt", 0100644, 0},
+        {"a/d.txt", 0100755, 0},
+        {"m.txt", 0100644, 1},
+        {"m.txt", 0100644, 2},
+        {"sub/mod", 0160000, 0},
+        {"z.txt", 0120000, 0},
+    };
+    const char *expected[] = {"a", "a/b", "a/b/c.txt", "a/d.txt", "a.txt", "m.txt", "z.txt"};
+
+    for (int version = 2; version <= 4; version += 2) {
+        char *repo = create_temp_dir();
+        write_index(repo, version, entries, sizeof(entries) / sizeof(entries[0]));
+
+        FileList list;
+        init_file_list(&list);
+        assert(read_git_index(repo, &list, NULL));
+        assert_paths(&list, expected, sizeof(expected) / sizeof(expected[0]));
+        assert(list.entries[0].is_dir && list.entries[1].is_dir);
+        assert(!list.entries[2].is_dir && list.entries[2].depth == 2);
+        free_file_list(&list);
+
+        remove_directory_recursive(repo);
+        free(repo);
+    }
+    printf("✔ test_read_git_index passed\n");
+}
+
+/* Extra ignore patterns prune whole directories of tracked files. */
+void test_read_git_index_exclude() {
+    const IndexEntrySpec entries[] = {
+        {"a/b/c.txt", 0100644, 0},
+        {"a/b/e/f.txt", 0100644, 0},
+        {"a/d.log", 0100644, 0},
+        {"a/d.txt", 0100644, 0},
+    };
+    char *repo = create_temp_dir();
+    write_index(repo, 2, entries, sizeof(entries) / sizeof(entries[0]));
+
+    GitignoreList exclude = {0};
+    parse_gitignore_pattern_string("b/", &exclude);
+    parse_gitignore_pattern_string("*.log", &exclude);
+    FileList list;
+    init_file_list(&list);
+    assert(read_git_index(repo, &list, &exclude));
+    const char *expected[] = {"a", "a/d.txt"};
+    assert_paths(&list, expected, 2);
+    free_file_list(&list);
+    free_gitignore(&exclude);
+
+    // Without a .git directory the reader refuses.
+    char *plain = create_temp_dir();
+    FileList none;
+    init_file_list(&none);
+    assert(!read_git_index(plain, &none, NULL));
+    free_file_list(&none);
+
+    remove_directory_recursive(plain);
+    free(plain);
+    remove_directory_recursive(repo);
+    free(repo);
+    printf("✔ test_read_git_index_exclude passed\n");
+}
+
+void run_gitindex_tests() {
+    printf("Running git index tests...\n");
+    test_read_git_index();
+    test_read_git_index_exclude();
+    printf("All git index tests passed!\n");
+}
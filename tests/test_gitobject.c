@@ -0,0 +1,283 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sys/stat.h>
+
+#include "dirdoc.h"
+#include "gitobject.h"
+#include "inflate.h"
+#include "scanner.h"
+
+/* Functions from test_dirdoc.c */
+char *create_temp_dir();
+int remove_directory_recursive(const char *path);
+
+static uint32_t test_adler32(const unsigned char *data, size_t len) {
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < len; i++) {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+}
+
+static void put_be32(FILE *f, uint32_t v) {
+    fputc((v >> 24) & 0xff, f);
+    fputc((v >> 16) & 0xff, f);
+    fputc((v >> 8) & 0xff, f);
+    fputc(v & 0xff, f);
+}
+
+/* Write data as a zlib stream made of stored (uncompressed) deflate blocks. */
+static void put_zlib_stored(FILE *f, const unsigned char *data, size_t len) {
+    fputc(0x78, f);
+    fputc(0x01, f);
+    size_t pos = 0;
+    do {
+        size_t chunk = len - pos < 0xffff ? len - pos : 0xffff;
+        fputc(pos + chunk == len ? 1 : 0, f);
+        fputc(chunk & 0xff, f);
+        fputc(chunk >> 8, f);
+        fputc(~chunk & 0xff, f);
+        fputc((~chunk >> 8) & 0xff, f);
+        fwrite(data + pos, 1, chunk, f);
+        pos += chunk;
+    } while (pos < len);
+    put_be32(f, test_adler32(data, len));
+}
+
+static void fake_oid(unsigned char *oid, unsigned char byte) {
+    memset(oid, byte, 20);
+}
+
+static void oid_hex(const unsigned char *oid, char *hex) {
+    for (int i = 0; i < 20; i++) sprintf(hex + 2 * i, "%02x", oid[i]);
+}
+
+/* Store a loose object; ids are arbitrary since the reader does not rehash. */
+static void write_loose(const char *repo, const unsigned char *oid, const char *type,
+                        const unsigned char *body, size_t body_len) {
+    char hex[41], path[512];
+    oid_hex(oid, hex);
+    snprintf(path, sizeof(path), "%s/.git/objects/%.2s", repo, hex);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/.git/objects/%.2s/%s", repo, hex, hex + 2);
+    unsigned char *raw = malloc(body_len + 32);
+    int header = sprintf((char*)raw, "%s %zu", type, body_len) + 1;
+    memcpy(raw + header, body, body_len);
+    FILE *f = fopen(path, "wb");
+    assert(f != NULL);
+    put_zlib_stored(f, raw, header + body_len);
+    fclose(f);
+    free(raw);
+}
+
+static size_t tree_entry(unsigned char *buf, const char *mode, const char *name, const unsigned char *oid) {
+    size_t n = (size_t)sprintf((char*)buf, "%s %s", mode, name) + 1;
+    memcpy(buf + n, oid, 20);
+    return n + 20;
+}
+
+static void write_text_file(const char *repo, const char *name, const char *text) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/.git/%s", repo, name);
+    FILE *f = fopen(path, "w");
+    assert(f != NULL);
+    fputs(text, f);
+    fclose(f);
+}
+
+/* Deflate streams produced by zlib: fixed and dynamic Huffman blocks. */
+void test_zlib_inflate() {
+    static const unsigned char fixed[] = {
+        0x78, 0xda, 0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0x57, 0xc8, 0x40, 0x27, 0xb9, 0x00, 0x70, 0xbe, 0x08, 0xbb
+    };
+    static const unsigned char dynamic[] = {
+        0x78, 0xda, 0x4d, 0x8f, 0x41, 0x4e, 0xc4, 0x30, 0x0c, 0x45, 0xf7, 0x9c, 0xe2, 0x1f, 0xa0, 0x1a,
+        0xa9, 0x1b, 0x40, 0x62, 0x8b, 0x04, 0xd7, 0x70, 0x53, 0x67, 0x62, 0xc6, 0x49, 0x4a, 0xec, 0x4e,
+        0x19, 0x4e, 0x8f, 0x07, 0x09, 0x89, 0xad, 0xff, 0x7f, 0x5f, 0xcf, 0x6f, 0xe2, 0x30, 0xef, 0x83,
+        0x0d, 0xda, 0xbb, 0x31, 0xfa, 0xf2, 0xc1, 0xc9, 0x0d, 0xd4, 0x56, 0x6c, 0x94, 0x2e, 0x59, 0x94,
+        0xc1, 0xcd, 0x87, 0x44, 0x85, 0x0c, 0xdf, 0x2a, 0x4b, 0x10, 0x83, 0xa9, 0xda, 0x09, 0xaf, 0xb7,
+        0x46, 0x55, 0x12, 0x16, 0xed, 0xe9, 0x62, 0x48, 0x34, 0xc6, 0x0d, 0x5e, 0x58, 0x06, 0xfa, 0xd1,
+        0xf0, 0xbe, 0xe7, 0x5c, 0xa9, 0x21, 0xf5, 0x95, 0xa1, 0xdc, 0xce, 0x5e, 0x6c, 0xc2, 0x51, 0x24,
+        0x15, 0xd0, 0xe0, 0x7b, 0xb3, 0x1a, 0xeb, 0x35, 0xa6, 0x53, 0xaf, 0x5b, 0x58, 0x18, 0xaf, 0x38,
+        0xc4, 0x23, 0x86, 0x55, 0x52, 0xfd, 0x8f, 0x82, 0x74, 0x2b, 0xb4, 0xb0, 0xbf, 0x04, 0x28, 0x86,
+        0x6b, 0x88, 0xf6, 0x01, 0xfe, 0xe2, 0x91, 0xc4, 0x62, 0xc3, 0x0b, 0x79, 0x48, 0x7b, 0x99, 0x20,
+        0x2d, 0xe9, 0xbe, 0x4a, 0x3b, 0x63, 0xf0, 0xc6, 0x71, 0xbe, 0xef, 0x18, 0xe6, 0xc7, 0x09, 0xf3,
+        0xd3, 0xef, 0x73, 0xf3, 0x33, 0x72, 0xd0, 0x63, 0x6f, 0x86, 0x9e, 0xc1, 0x9f, 0x3b, 0xe9, 0x9f,
+        0xe3, 0xe9, 0xe1, 0x07, 0x80, 0x8d, 0x64, 0xff
+    };
+    const char *dynamic_text =
+        "Git stores loose objects and packfile entries as zlib streams. Dynamic blocks carry their own "
+        "Huffman code lengths, which are themselves compressed with a small code length alphabet; this "
+        "vector exercises that path, including repeat codes 16, 17 and 18 for runs of equal lengths.\n";
+
+    unsigned char *out = NULL;
+    size_t len = 0;
+    assert(zlib_inflate(fixed, sizeof(fixed), 0, &out, &len));
+    assert(len == 24 && memcmp(out, "hello hello hello hello\n", 24) == 0);
+    free(out);
+
+    assert(zlib_inflate(dynamic, sizeof(dynamic), 16, &out, &len));
+    assert(len == strlen(dynamic_text) && strcmp((char*)out, dynamic_text) == 0);
+    free(out);
+
+    // A damaged checksum or a truncated stream is rejected.
+    unsigned char broken[sizeof(fixed)];
+    memcpy(broken, fixed, sizeof(fixed));
+    broken[sizeof(fixed) - 1] ^= 1;
+    assert(!zlib_inflate(broken, sizeof(broken), 0, &out, &len));
+    assert(!zlib_inflate(dynamic, sizeof(dynamic) / 2, 0, &out, &len));
+    printf("✔ test_zlib_inflate passed\n");
+}
+
+/*
+ * A small repository: two commits on "main" (packed ref), loose commits and
+ * trees, and a pack holding one blob plus an OFS_DELTA against it.
+ */
+void test_git_revision_tree() {
+    char *repo = create_temp_dir();
+    char path[512];
+    snprintf(path, sizeof(path), "%s/.git", repo);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/.git/objects", repo);
+    mkdir(path, 0755);
+    snprintf(path, sizeof(path), "%s/.git/objects/pack", repo);
+    mkdir(path, 0755);
+
+    unsigned char base[20], delta_blob[20], readme[20], src_tree[20], root[20], old_root[20];
+    unsigned char parent[20], head[20];
+    fake_oid(base, 0x11);
+    fake_oid(delta_blob, 0x22);
+    fake_oid(readme, 0x40);
+    fake_oid(src_tree, 0x50);
+    fake_oid(root, 0xa0);
+    fake_oid(old_root, 0xa1);
+    fake_oid(parent, 0xb0);
+    fake_oid(head, 0xc0);
+
+    const char *readme_text = "# readme\n";
+    write_loose(repo, readme, "blob", (const unsigned char*)readme_text, strlen(readme_text));
+
+    unsigned char buf[256];
+    size_t n = tree_entry(buf, "100644", "main.c", delta_blob);
+    n += tree_entry(buf + n, "160000", "vendor", base);     // submodule, left out
+    write_loose(repo, src_tree, "tree", buf, n);
+    n = tree_entry(buf, "100644", "README.md", readme);
+    n += tree_entry(buf + n, "40000", "src", src_tree);
+    write_loose(repo, root, "tree", buf, n);
+    n = tree_entry(buf, "100644", "README.md", readme);
+    write_loose(repo, old_root, "tree", buf, n);
+
+    char hex[41], text[256];
+    oid_hex(old_root, hex);
+    n = (size_t)snprintf(text, sizeof(text), "tree %s\nauthor a <a> 0 +0000\n\nfirst\n", hex);
+    write_loose(repo, parent, "commit", (unsigned char*)text, n);
+    oid_hex(root, hex);
+    n = (size_t)snprintf(text, sizeof(text), "tree %s\nparent ", hex);
+    oid_hex(parent, hex);
+    n += (size_t)snprintf(text + n, sizeof(text) - n, "%s\nauthor a <a> 0 +0000\n\nsecond\n", hex);
+    write_loose(repo, head, "commit", (unsigned char*)text, n);
+
+    // Pack: the base blob, then main.c as "copy 13 bytes of the base, insert 'return 1; }\n'".
+    const char *base_text = "int main() { return 0; }\n";
+    const unsigned char delta[] = {
+        25, 25, 0x80 | 0x01 | 0x10, 0, 13, 12, 'r', 'e', 't', 'u', 'r', 'n', ' ', '1', ';', ' ', '}', '\n'
+    };
+    snprintf(path, sizeof(path), "%s/.git/objects/pack/pack-test.pack", repo);
+    FILE *f = fopen(path, "wb");
+    assert(f != NULL);
+    fwrite("PACK", 1, 4, f);
+    put_be32(f, 2);
+    put_be32(f, 2);
+    long base_offset = ftell(f);
+    fputc(0x80 | (3 << 4) | (25 & 15), f);     // blob, size 25
+    fputc(25 >> 4, f);
+    put_zlib_stored(f, (const unsigned char*)base_text, 25);
+    long delta_offset = ftell(f);
+    fputc(0x80 | (6 << 4) | (sizeof(delta) & 15), f);  // OFS_DELTA, size 18
+
+    fputc(sizeof(delta) >> 4, f);
+    fputc((int)(delta_offset - base_offset), f);
+    put_zlib_stored(f, delta, sizeof(delta));
+    for (int i = 0; i < 20; i++) fputc(0, f);
+    fclose(f);
+
+    snprintf(path, sizeof(path), "%s/.git/objects/pack/pack-test.idx", repo);
+    f = fopen(path, "wb");
+    assert(f != NULL);
+    put_be32(f, 0xff744f63);
+    put_be32(f, 2);
+    for (int i = 0; i < 256; i++) put_be32(f, i < 0x11 ? 0 : i < 0x22 ? 1 : 2);
+    fwrite(base, 1, 20, f);
+    fwrite(delta_blob, 1, 20, f);
+    put_be32(f, 0);
+    put_be32(f, 0);
+    put_be32(f, (uint32_t)base_offset);
+    put_be32(f, (uint32_t)delta_offset);
+    for (int i = 0; i < 40; i++) fputc(0, f);
+    fclose(f);
+
+    write_text_file(repo, "HEAD", "ref: refs/heads/main\n");
+    oid_hex(head, hex);
+    snprintf(text, sizeof(text), "# pack-refs with: peeled fully-peeled sorted\n%s refs/heads/main\n", hex);
+    write_text_file(repo, "packed-refs", text);
+
+    GitObjectStore *store = git_store_open(repo);
+    assert(store != NULL);
+    unsigned char tree[GIT_MAX_OID_SIZE];
+    assert(git_resolve_tree(store, "HEAD", tree) && memcmp(tree, root, 20) == 0);
+    assert(git_resolve_tree(store, "main~1", tree) && memcmp(tree, old_root, 20) == 0);
+    assert(git_resolve_tree(store, "c0c0c0c", tree) && memcmp(tree, root, 20) == 0);
+    assert(!git_resolve_tree(store, "main~2", tree));
+    assert(!git_resolve_tree(store, "no-such-branch", tree));
+
+    FileList list;
+    init_file_list(&list);
+    assert(git_list_tree(store, root, &list, NULL));
+    assert(list.count == 3);
+    assert(strcmp(list.entries[0].path, "README.md") == 0 && !list.entries[0].is_dir);
+    assert(strcmp(list.entries[1].path, "src") == 0 && list.entries[1].is_dir);
+    assert(strcmp(list.entries[2].path, "src/main.c") == 0 && list.entries[2].depth == 1);
+
+    GitObjectType type;
+    size_t size;
+    unsigned char *data = git_read_object(store, list.entries[2].oid, &type, &size);
+    assert(data && type == GIT_OBJ_BLOB);
+    assert(size == 25 && strcmp((char*)data, "int main() { return 1; }\n") == 0);
+    free(data);
+    data = git_read_object(store, list.entries[0].oid, &type, &size);
+    assert(data && type == GIT_OBJ_BLOB && strcmp((char*)data, readme_text) == 0);
+    free(data);
+    free_file_list(&list);
+    git_store_close(store);
+
+    // A fanout entry beyond the object count makes the pack unreadable
+    // instead of sending the lookup past the end of the index
+    snprintf(path, sizeof(path), "%s/.git/objects/pack/pack-test.idx", repo);
+    f = fopen(path, "r+b");
+    assert(f != NULL);
+    fseek(f, 8 + 0x22 * 4, SEEK_SET);
+    put_be32(f, 100000);
+    fclose(f);
+    store = git_store_open(repo);
+    assert(store != NULL);
+    assert(git_read_object(store, delta_blob, &type, &size) == NULL);
+    data = git_read_object(store, readme, &type, &size);
+    assert(data && strcmp((char*)data, readme_text) == 0);
+    free(data);
+    git_store_close(store);
+
+    remove_directory_recursive(repo);
+    free(repo);
+    printf("✔ test_git_revision_tree passed\n");
+}
+
+void run_gitobject_tests() {
+    printf("Running git object tests...\n");
+    test_zlib_inflate();
+    test_git_revision_tree();
+    printf("All git object tests passed!\n");
+}
@@ -0,0 +1,151 @@
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pretokenize.h"
+
+/*
+ * tests/fixtures/pretokenize.txt mixes prose, code, numbers, white space and
+ * many scripts. pretokenize_<pattern>.txt lists the byte length of every
+ * piece, one per line, as split by the encoding's regex in a reference
+ * regex engine.
+ */
+#define FIXTURE_TEXT "tests/fixtures/pretokenize.txt"
+
+static char *read_fixture(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    assert(f != NULL);
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *data = malloc((size_t)size + 1);
+    assert(data != NULL);
+    assert(fread(data, 1, (size_t)size, f) == (size_t)size);
+    data[size] = '\0';
+    fclose(f);
+    *len = (size_t)size;
+    return data;
+}
+
+/* Splits text and returns the pieces joined by '|' for easy comparison. */
+static char *split_joined(const char *text, PretokenizePattern pattern) {
+    size_t len = strlen(text);
+    char *out = malloc(len * 2 + 1);
+    size_t n = 0;
+    for (size_t pos = 0; pos < len;) {
+        size_t end = pretokenize_next(text, len, pos, pattern);
+        assert(end > pos && end <= len);
+        if (pos > 0) out[n++] = '|';
+        memcpy(out + n, text + pos, end - pos);
+        n += end - pos;
+        pos = end;
+    }
+    out[n] = '\0';
+    return out;
+}
+
+static void expect_split(const char *text, PretokenizePattern pattern, const char *expected) {
+    char *got = split_joined(text, pattern);
+    if (strcmp(got, expected) != 0) {
+        fprintf(stderr, "Split of \"%s\": got \"%s\", expected \"%s\"\n", text, got, expected);
+        assert(0);
+    }
+    free(got);
+}
+
+void test_pretokenize_examples() {
+    assert(pretokenize_pattern("o200k_base") == PRETOKENIZE_O200K);
+    assert(pretokenize_pattern("cl100k_base") == PRETOKENIZE_CL100K);
+
+    expect_split("Hello world", PRETOKENIZE_O200K, "Hello| world");
+    expect_split("Hello world", PRETOKENIZE_CL100K, "Hello| world");
+    expect_split("I don't know", PRETOKENIZE_O200K, "I| don't| know");
+    expect_split("I don't know", PRETOKENIZE_CL100K, "I| don|'t| know");
+    expect_split("HTTPServer getHTTPResponse", PRETOKENIZE_O200K, "HTTPServer| get|HTTPResponse");
+    expect_split("12345 x", PRETOKENIZE_O200K, "123|45| x");
+    expect_split("a  b\n\n  c", PRETOKENIZE_CL100K, "a| | b|\n\n| | c");
+    expect_split("x = a/b;\n", PRETOKENIZE_O200K, "x| =| a|/b|;\n");
+    expect_split("end   ", PRETOKENIZE_O200K, "end|   ");
+    expect_split("caf\xc3\xa9 \xe6\x97\xa5\xe6\x9c\xac", PRETOKENIZE_O200K, "caf\xc3\xa9| \xe6\x97\xa5\xe6\x9c\xac");
+    // Invalid UTF-8 bytes are single symbols of their own class
+    expect_split("ab\xff\xfe cd", PRETOKENIZE_CL100K, "ab|\xff\xfe| cd");
+    printf("✔ test_pretokenize_examples passed\n");
+}
+
+static void check_fixture(const char *expected_path, PretokenizePattern pattern) {
+    size_t len;
+    char *text = read_fixture(FIXTURE_TEXT, &len);
+    FILE *expected = fopen(expected_path, "r");
+    assert(expected != NULL);
+
+    size_t pos = 0, piece = 0, want;
+    while (fscanf(expected, "%zu", &want) == 1) {
+        assert(pos < len);
+        size_t end = pretokenize_next(text, len, pos, pattern);
+        if (end - pos != want) {
+            fprintf(stderr, "%s: piece %zu at byte %zu is %zu bytes, expected %zu\n",
+                    expected_path, piece, pos, end - pos, want);
+            assert(0);
+        }
+        pos = end;
+        piece++;
+    }
+    assert(pos == len);
+    fclose(expected);
+    free(text);
+}
+
+void test_pretokenize_fixture() {
+    check_fixture("tests/fixtures/pretokenize_o200k.txt", PRETOKENIZE_O200K);
+    check_fixture("tests/fixtures/pretokenize_cl100k.txt", PRETOKENIZE_CL100K);
+    printf("✔ test_pretokenize_fixture passed\n");
+}
+
+/* Appends the piece ends of text[from, to) to ends, offset to text. */
+static size_t split_range(const char *text, size_t from, size_t to, PretokenizePattern pattern, size_t *ends, size_t n) {
+    for (size_t pos = from; pos < to;) {
+        pos = from + pretokenize_next(text + from, to - from, pos - from, pattern);
+        ends[n++] = pos;
+    }
+    return n;
+}
+
+void test_pretokenize_boundaries() {
+    size_t len;
+    char *text = read_fixture(FIXTURE_TEXT, &len);
+    size_t *whole = malloc(len * sizeof(size_t));
+    size_t *parts = malloc(len * sizeof(size_t));
+    assert(whole != NULL && parts != NULL);
+
+    assert(pretokenize_next_boundary("a\nb", 3, 0) == 2);
+    assert(pretokenize_next_boundary("a\n b\n/c\n\nd", 10, 0) == 9);
+    assert(pretokenize_next_boundary("a\nb", 3, 3) == 3);
+
+    // Splitting the text between consecutive boundaries yields the same pieces
+    for (int p = 0; p < 2; p++) {
+        PretokenizePattern pattern = p ? PRETOKENIZE_O200K : PRETOKENIZE_CL100K;
+        size_t count = split_range(text, 0, len, pattern, whole, 0);
+        size_t n = 0, from = 0, cuts = 0;
+        for (size_t b = pretokenize_next_boundary(text, len, 0); b < len; b = pretokenize_next_boundary(text, len, b + 1)) {
+            n = split_range(text, from, b, pattern, parts, n);
+            from = b;
+            cuts++;
+        }
+        n = split_range(text, from, len, pattern, parts, n);
+        assert(cuts > 10);
+        assert(n == count && memcmp(whole, parts, n * sizeof(size_t)) == 0);
+    }
+    free(whole);
+    free(parts);
+    free(text);
+    printf("✔ test_pretokenize_boundaries passed\n");
+}
+
+void run_pretokenize_tests() {
+    printf("Running pre-tokenizer tests...\n");
+    test_pretokenize_examples();
+    test_pretokenize_fixture();
+    test_pretokenize_boundaries();
+    printf("All pre-tokenizer tests passed!\n");
+}
@@ -10,9 +10,23 @@
 #include "scanner.h"
 #include "gitignore.h"
 #include "stats.h"
+#include "split.h"
 
-// Forward declaration from writer.c for direct unit testing
-size_t find_split_points(const char *content, size_t limit, size_t *split_points, size_t max_splits);
+/**
+ * @brief Read a whole file into a NUL-terminated buffer.
+ */
+static char *read_part(const char *path) {
+    FILE *pf = fopen(path, "r");
+    if (!pf) return NULL;
+    fseek(pf, 0, SEEK_END);
+    long size = ftell(pf);
+    fseek(pf, 0, SEEK_SET);
+    char *content = malloc(size + 1);
+    size_t got = fread(content, 1, size, pf);
+    content[got] = '\0';
+    fclose(pf);
+    return content;
+}
 
 /**
  * @brief Test that verifies smart splitting preserves documented files.
@@ -57,21 +71,14 @@ void test_smart_split() {
 
     bool found = false;
     char part_path[256];
-    for (int i = 1; i <= 60; i++) {
+    int parts = 0;
+    for (int i = 1; ; i++) {
         snprintf(part_path, sizeof(part_path), "%s_part%d.md", output_base, i);
-        if (access(part_path, F_OK) != 0) {
-            continue;
+        char *content = read_part(part_path);
+        if (!content) {
+            break;
         }
-
-        FILE *pf = fopen(part_path, "r");
-        assert(pf != NULL);
-        fseek(pf, 0, SEEK_END);
-        long size = ftell(pf);
-        fseek(pf, 0, SEEK_SET);
-        char *content = malloc(size + 1);
-        fread(content, 1, size, pf);
-        content[size] = '\0';
-        fclose(pf);
+        parts++;
 
         if (strstr(content, "Documented File")) {
             // The documented file should only appear in one part
@@ -84,10 +91,11 @@ void test_smart_split() {
     }
 
     assert(found);
+    assert(parts > 1);
     printf("✓ Documented file content was preserved intact\n");
 
     // Clean up any split files that might have been created
-    for (int i = 1; i <= 60; i++) {
+    for (int i = 1; i <= parts; i++) {
         snprintf(part_path, sizeof(part_path), "%s_part%d.md", output_base, i);
         if (access(part_path, F_OK) == 0) {
             remove(part_path);
@@ -106,31 +114,262 @@ void test_smart_split() {
  * @brief Ensure splitting only triggers on the exact UTF-8 marker.
  */
 void test_split_marker_length() {
-    // Build a long prefix so the false marker is inside the search window
+    const char *doc_path = "tmp/split_marker.md";
     char prefix[70];
     memset(prefix, 'A', sizeof(prefix) - 1);
     prefix[sizeof(prefix) - 1] = '\0';
 
-    char content[512];
-    snprintf(content, sizeof(content),
-             "%s\n### 📝 Wrong marker\nSome filler text to extend length\n\n### 📄 Correct marker\nEnd\n",
-             prefix);
+    FILE *f = fopen(doc_path, "w");
+    assert(f != NULL);
+    fprintf(f, "%s\n### 📝 Wrong marker\nSome filler text to extend length\n\n### 📄 Correct marker\nEnd\n", prefix);
+    fclose(f);
 
-    size_t points[2];
-    size_t splits = find_split_points(content, 120, points, 2);
+    // The limit fits either section but not both, so the parts must break
+    // exactly at the file marker.
+    SplitSink sink;
+    assert(split_sink_open(&sink, doc_path, 140, 0));
+    f = fopen(doc_path, "r");
+    assert(f != NULL);
+    assert(split_sink_copy_sections(&sink, f));
+    fclose(f);
+    assert(split_sink_close(&sink, 0) == 2);
 
-    const char *wrong = strstr(content, "\n### 📝");
-    assert(wrong != NULL);
-    assert(splits == 1);
-    assert(points[0] > (size_t)(wrong - content + 1));
+    char *first = read_part("tmp/split_marker_part1.md");
+    char *second = read_part("tmp/split_marker_part2.md");
+    assert(first && second);
+    assert(strstr(first, "### 📝 Wrong marker\nSome filler") != NULL);
+    assert(strstr(first, "Correct marker") == NULL);
+    assert(strstr(first, "**Continued in part 2**") != NULL);
+    assert(strncmp(second, "---\n**Continued from part 1**\n\n### 📄 Correct marker\n", 52) == 0);
+    free(first);
+    free(second);
 
+    remove("tmp/split_marker_part1.md");
+    remove("tmp/split_marker_part2.md");
+    remove(doc_path);
     printf("✔ test_split_marker_length passed\n");
 }
 
+/**
+ * @brief Ensure the sink keeps rolling over to new parts without an upper bound.
+ */
+void test_split_many_parts() {
+    const char *out_path = "tmp/split_many.md";
+    const int sections = 150;
+
+    SplitSink sink;
+    assert(split_sink_open(&sink, out_path, 64, 0));
+    for (int i = 0; i < sections; i++) {
+        assert(split_sink_boundary(&sink, 0));
+        fprintf(sink.stream, "### 📄 file%03d.txt\n\n```\ncontents of file %03d\n```\n\n", i, i);
+    }
+    assert(split_sink_close(&sink, 0) == (size_t)sections);
+
+    char path[64];
+    for (int i = 1; i <= sections; i++) {
+        snprintf(path, sizeof(path), "tmp/split_many_part%d.md", i);
+        char *content = read_part(path);
+        assert(content != NULL);
+
+        // Every section fits a part on its own and is never cut.
+        char expected[64];
+        snprintf(expected, sizeof(expected), "contents of file %03d\n", i - 1);
+        assert(strstr(content, expected) != NULL);
+
+        char notice[64];
+        snprintf(notice, sizeof(notice), "**Continued in part %d**", i + 1);
+        assert((strstr(content, notice) != NULL) == (i < sections));
+        snprintf(notice, sizeof(notice), "**Continued from part %d**", i - 1);
+        assert((strstr(content, notice) != NULL) == (i > 1));
+        free(content);
+        remove(path);
+    }
+    snprintf(path, sizeof(path), "tmp/split_many_part%d.md", sections + 1);
+    assert(access(path, F_OK) != 0);
+
+    printf("✔ test_split_many_parts passed\n");
+}
+
+/**
+ * @brief Read the number after a header label, or -1 if the label is missing.
+ */
+static long header_count(const char *content, const char *label) {
+    const char *p = strstr(content, label);
+    return p ? atol(p + strlen(label)) : -1;
+}
+
+/**
+ * @brief Ensure --split-tokens keeps every part within the budget and reports its tokens.
+ */
+void test_split_token_budget() {
+    const char *test_dir = "tmp/test_split_tokens";
+    mkdir(test_dir, 0755);
+    char path[256];
+    for (int i = 0; i < 12; i++) {
+        snprintf(path, sizeof(path), "%s/file%02d.txt", test_dir, i);
+        FILE *f = fopen(path, "w");
+        assert(f != NULL);
+        for (int j = 0; j < 10 + i * 5; j++) {
+            fprintf(f, "word%d and some more words on line %d\n", i, j);
+        }
+        fclose(f);
+    }
+
+    const size_t budget = 400;
+    set_split_options(1, 18.0);
+    set_split_tokens(budget);
+    const char *output_path = "tmp/test_split_tokens_documentation.md";
+    assert(document_directory(test_dir, output_path, SPLIT_OUTPUT) == 0);
+    set_split_tokens(0);
+    set_split_options(0, 18.0);
+
+    long total = -1;
+    long sum = 0;
+    int parts = 0;
+    for (int i = 1; ; i++) {
+        snprintf(path, sizeof(path), "tmp/test_split_tokens_documentation_part%d.md", i);
+        char *content = read_part(path);
+        if (!content) {
+            break;
+        }
+        parts++;
+        if (i == 1) {
+            total = header_count(content, "\nToken Size: ");
+        }
+        long part_tokens = header_count(content, "Part Token Size: ");
+        assert(part_tokens > 0 && part_tokens <= (long)budget);
+        sum += part_tokens;
+        free(content);
+        remove(path);
+    }
+    assert(parts > 1);
+    assert(total > (long)budget);
+    assert(sum == total);
+
+    for (int i = 0; i < 12; i++) {
+        snprintf(path, sizeof(path), "%s/file%02d.txt", test_dir, i);
+        remove(path);
+    }
+    rmdir(test_dir);
+    printf("✔ test_split_token_budget passed\n");
+}
+
+/**
+ * @brief Sum the tokens per part and return the largest total.
+ */
+static size_t largest_part(const size_t *tokens, const size_t *part_of, size_t count, size_t parts) {
+    size_t load[8] = {0};
+    size_t max_load = 0;
+    for (size_t i = 0; i < count; i++) {
+        assert(part_of[i] < parts);
+        load[part_of[i]] += tokens[i];
+    }
+    for (size_t p = 0; p < parts; p++) {
+        assert(load[p] > 0);
+        if (load[p] > max_load) max_load = load[p];
+    }
+    return max_load;
+}
+
+/**
+ * @brief Check the balanced packing used by --parts.
+ */
+void test_split_pack_sections() {
+    // Evenly sized files: the contiguous partition is optimal and keeps order.
+    size_t even[21] = {50};
+    for (int i = 1; i < 21; i++) even[i] = 10;
+    size_t part_of[21];
+    assert(split_pack_sections(even, 21, 5, part_of) == 5);
+    assert(largest_part(even, part_of, 21, 5) == 50);
+    assert(part_of[0] == 0);
+    for (int i = 1; i < 21; i++) {
+        assert(part_of[i] >= part_of[i - 1]);
+    }
+
+    // Two large files next to each other: any contiguous split leaves one
+    // part with 60 tokens, packing largest first reaches 50.
+    size_t lumpy[5] = {1, 30, 30, 20, 19};
+    assert(split_pack_sections(lumpy, 5, 2, part_of) == 2);
+    assert(part_of[0] == 0);
+    assert(part_of[1] != part_of[2]);
+    assert(largest_part(lumpy, part_of, 5, 2) == 50);
+
+    // Fewer sections than parts: one section per part.
+    size_t few[2] = {5, 5};
+    assert(split_pack_sections(few, 2, 4, part_of) == 2);
+    assert(part_of[0] == 0 && part_of[1] == 1);
+
+    printf("✔ test_split_pack_sections passed\n");
+}
+
+/**
+ * @brief Ensure --parts writes exactly K parts that hold every file once.
+ */
+void test_split_parts() {
+    const char *test_dir = "tmp/test_split_parts";
+    mkdir(test_dir, 0755);
+    char path[256];
+    for (int i = 0; i < 9; i++) {
+        snprintf(path, sizeof(path), "%s/file%02d.txt", test_dir, i);
+        FILE *f = fopen(path, "w");
+        assert(f != NULL);
+        for (int j = 0; j < 5 + (i % 3) * 20; j++) {
+            fprintf(f, "line %d of file %d\n", j, i);
+        }
+        fclose(f);
+    }
+
+    set_split_options(0, 18.0);
+    set_split_parts(3);
+    const char *output_path = "tmp/test_split_parts_documentation.md";
+    assert(document_directory(test_dir, output_path, 0) == 0);
+    set_split_parts(0);
+    assert(access(output_path, F_OK) != 0);
+
+    int seen[9] = {0};
+    long total = -1;
+    long sum = 0;
+    for (int p = 1; p <= 4; p++) {
+        snprintf(path, sizeof(path), "tmp/test_split_parts_documentation_part%d.md", p);
+        char *content = read_part(path);
+        if (p == 4) {
+            assert(content == NULL);
+            break;
+        }
+        assert(content != NULL);
+        if (p == 1) {
+            total = header_count(content, "\nToken Size: ");
+        }
+        sum += header_count(content, "Part Token Size: ");
+        for (int i = 0; i < 9; i++) {
+            char heading[64];
+            snprintf(heading, sizeof(heading), "### 📄 file%02d.txt\n", i);
+            if (strstr(content, heading)) seen[i]++;
+        }
+        free(content);
+        remove(path);
+    }
+    for (int i = 0; i < 9; i++) {
+        assert(seen[i] == 1);
+    }
+    assert(total > 0 && sum == total);
+
+    for (int i = 0; i < 9; i++) {
+        snprintf(path, sizeof(path), "%s/file%02d.txt", test_dir, i);
+        remove(path);
+    }
+    rmdir(test_dir);
+    printf("✔ test_split_parts passed\n");
+}
+
 // Run function for the split tests
 void run_split_tests() {
     printf("Running split tests...\n");
     test_split_marker_length();
+    test_split_many_parts();
+    test_split_token_budget();
+    test_split_pack_sections();
+    test_split_parts();
     test_smart_split();
     printf("All split tests passed!\n");
 }
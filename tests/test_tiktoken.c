@@ -57,12 +57,236 @@ void test_token_counting() {
     printf("✅ Token counting test passed\n");
 }
 
+void test_bpe_merges() {
+    assert(tiktoken_init());
+    tiktoken_t encoding = tiktoken_get_encoding("cl100k_base");
+    
+    // A whole vocabulary entry is a single token
+    assert(tiktoken_count(encoding, "Hello", 5) == 1);
+    
+    // A word that is not in the vocabulary merges back into multi-byte
+    // tokens instead of staying at one token per byte
+    int count = tiktoken_count(encoding, "HelloHelloHello", 15);
+    assert(count > 0 && count <= 7);
+    
+    printf("✅ BPE merge test passed\n");
+}
+
+void test_vocab_lookup() {
+    assert(tiktoken_init());
+    tiktoken_t encoding = tiktoken_get_encoding("cl100k_base");
+    
+    // Every byte is a token of its own, and the perfect hash finds each one
+    // under a distinct ID
+    static int seen_ids[256];
+    for (int c = 0; c < 256; c++) {
+        char byte = (char)c;
+        tiktoken_token_t *tokens = NULL;
+        assert(tiktoken_encode(encoding, &byte, 1, &tokens) == 1);
+        seen_ids[c] = tokens[0];
+        free(tokens);
+        for (int prev = 0; prev < c; prev++) {
+            assert(seen_ids[prev] != seen_ids[c]);
+        }
+    }
+    
+    printf("✅ Vocabulary lookup test passed\n");
+}
+
+void test_count_matches_encode() {
+    assert(tiktoken_init());
+    tiktoken_t encoding = tiktoken_get_encoding("cl100k_base");
+    
+    // The count-only path must agree with encode, including pieces too long
+    // for the short-piece merge
+    char long_word[201];
+    memset(long_word, 'x', 200);
+    long_word[200] = '\0';
+    const char* texts[] = {
+        "",
+        "int main() { return 0; }\n",
+        "I don't think HTTPServer's 12345 r\xc3\xa9sum\xc3\xa9s   \n\n  end",
+        long_word
+    };
+    for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+        size_t len = strlen(texts[i]);
+        tiktoken_token_t *tokens = NULL;
+        int encoded = tiktoken_encode(encoding, texts[i], len, &tokens);
+        free(tokens);
+        assert(encoded >= 0);
+        assert(tiktoken_count(encoding, texts[i], len) == encoded);
+    }
+    
+    printf("✅ Count-only path test passed\n");
+}
+
+void test_piece_cache() {
+    assert(tiktoken_init());
+    tiktoken_t encoding = tiktoken_get_encoding("cl100k_base");
+    
+    // A word that is not a token itself is merged once, then served from
+    // the cache with the same count
+    const char* text = "unbelievablyxqzt unbelievablyxqzt unbelievablyxqzt";
+    size_t before_lookups, before_hits, lookups, hits;
+    assert(tiktoken_cache_stats(encoding, &before_lookups, &before_hits) == 0);
+    int first = tiktoken_count(encoding, text, strlen(text));
+    int second = tiktoken_count(encoding, text, strlen(text));
+    assert(first > 3 && first == second);
+    assert(tiktoken_cache_stats(encoding, &lookups, &hits) == 0);
+    assert(lookups > before_lookups);
+    assert(hits - before_hits >= (lookups - before_lookups) / 2);
+    assert(tiktoken_cache_stats(NULL, &lookups, &hits) == -1);
+    
+    printf("✅ Piece cache test passed\n");
+}
+
+void test_count_batch() {
+    assert(tiktoken_init());
+    tiktoken_t encoding = tiktoken_get_encoding("cl100k_base");
+    
+    // Many threads share the encoding; each must count as a lone caller would
+    enum { BATCH = 200 };
+    static char buffers[BATCH][128];
+    const char* texts[BATCH];
+    size_t lens[BATCH];
+    int counts[BATCH];
+    for (int i = 0; i < BATCH; i++) {
+        snprintf(buffers[i], sizeof(buffers[i]),
+                 "static int helper_%d(int value) {\n    return value * %d; // r\xc3\xa9sum\xc3\xa9 %x\n}\n",
+                 i % 17, i, i * 7919);
+        texts[i] = buffers[i];
+        lens[i] = strlen(buffers[i]);
+    }
+    const int thread_counts[] = {1, 4, 300};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        memset(counts, 0, sizeof(counts));
+        assert(tiktoken_count_batch(encoding, texts, lens, BATCH, counts, thread_counts[t]) == 0);
+        for (int i = 0; i < BATCH; i++) {
+            assert(counts[i] == tiktoken_count(encoding, texts[i], lens[i]));
+        }
+    }
+    assert(tiktoken_count_batch(encoding, NULL, NULL, 0, NULL, 4) == 0);
+    assert(tiktoken_count_batch(NULL, texts, lens, BATCH, counts, 4) == -1);
+    
+    printf("✅ Batch count test passed\n");
+}
+
+void test_count_parallel() {
+    assert(tiktoken_init());
+    tiktoken_t encoding = tiktoken_get_encoding("cl100k_base");
+    
+    // Large enough for several segments: the fixture repeated, with the
+    // copies joined by varying white space so the cuts land in many contexts
+    FILE* f = fopen("tests/fixtures/pretokenize.txt", "rb");
+    assert(f != NULL);
+    char fixture[1 << 14];
+    size_t fixture_len = fread(fixture, 1, sizeof(fixture), f);
+    fclose(f);
+    const char* joins[] = {"\n", "  \n\n", "\r\n/", " ", "\n\t"};
+    size_t capacity = 6 << 20;
+    char* text = malloc(capacity);
+    assert(text != NULL);
+    size_t len = 0;
+    for (size_t i = 0; len + fixture_len + 8 < capacity; i++) {
+        memcpy(text + len, fixture, fixture_len);
+        len += fixture_len;
+        const char* join = joins[i % (sizeof(joins) / sizeof(joins[0]))];
+        memcpy(text + len, join, strlen(join));
+        len += strlen(join);
+    }
+    
+    int expected = tiktoken_count(encoding, text, len);
+    assert(expected > 0);
+    const int thread_counts[] = {1, 2, 3, 8};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        assert(tiktoken_count_parallel(encoding, text, len, thread_counts[t]) == expected);
+    }
+    
+    // A stream counting multi-megabyte chunks on threads agrees as well
+    tiktoken_stream_t stream = tiktoken_stream_begin(encoding);
+    tiktoken_stream_set_threads(stream, 4);
+    for (size_t pos = 0; pos < len; pos += 2500000) {
+        assert(tiktoken_stream_feed(stream, text + pos, len - pos < 2500000 ? len - pos : 2500000) == 0);
+    }
+    assert(tiktoken_stream_finish(stream) == expected);
+    
+    // Without line breaks there is nowhere to cut, and one thread counts all
+    memset(text, 'a', 3 << 20);
+    expected = tiktoken_count(encoding, text, 3 << 20);
+    assert(tiktoken_count_parallel(encoding, text, 3 << 20, 4) == expected);
+    
+    free(text);
+    printf("✅ Parallel count test passed\n");
+}
+
+// Count text by feeding it to a stream in chunks of the given size
+static int stream_count(tiktoken_t encoding, const char* text, size_t len, size_t chunk) {
+    tiktoken_stream_t stream = tiktoken_stream_begin(encoding);
+    assert(stream != NULL);
+    for (size_t pos = 0; pos < len; pos += chunk) {
+        size_t n = len - pos < chunk ? len - pos : chunk;
+        assert(tiktoken_stream_feed(stream, text + pos, n) == 0);
+    }
+    return tiktoken_stream_finish(stream);
+}
+
+void test_stream_matches_count() {
+    assert(tiktoken_init());
+    tiktoken_t encoding = tiktoken_get_encoding("cl100k_base");
+    
+    // Chunks cut pieces, white space runs and UTF-8 sequences at every offset
+    FILE* f = fopen("tests/fixtures/pretokenize.txt", "rb");
+    assert(f != NULL);
+    static char fixture[1 << 16];
+    size_t fixture_len = fread(fixture, 1, sizeof(fixture) - 1, f);
+    fclose(f);
+    fixture[fixture_len] = '\0';
+    
+    const char* texts[] = {
+        "",
+        "<|endoftext|>",
+        "x\n<|endoftext|>",
+        "  \n\n\t\n  lead/\nfoo\n/bar\n\n",
+        fixture
+    };
+    const size_t chunks[] = {1, 2, 3, 7, 64, 4096, 1 << 16};
+    for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+        size_t len = strlen(texts[i]);
+        int expected = tiktoken_count(encoding, texts[i], len);
+        assert(expected >= 0);
+        for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); c++) {
+            assert(stream_count(encoding, texts[i], len, chunks[c]) == expected);
+        }
+    }
+    
+    // The statistics wrapper agrees with counting the text at once
+    DocumentInfo whole = {0}, streamed = {0};
+    calculate_token_stats(fixture, &whole);
+    TokenStream ts;
+    token_stream_begin(&ts);
+    for (size_t pos = 0; pos < fixture_len; pos += 100) {
+        token_stream_feed(&ts, fixture + pos, fixture_len - pos < 100 ? fixture_len - pos : 100);
+    }
+    token_stream_finish(&ts, &streamed);
+    assert(streamed.total_tokens == whole.total_tokens);
+    assert(streamed.total_size == whole.total_size);
+    
+    printf("✅ Streaming count test passed\n");
+}
+
 // Main function moved to test_dirdoc.c
 void run_tiktoken_tests() {
     printf("Running tiktoken tests...\n");
     
     test_tiktoken_init();
     test_token_counting();
+    test_bpe_merges();
+    test_vocab_lookup();
+    test_count_matches_encode();
+    test_piece_cache();
+    test_count_batch();
+    test_count_parallel();
+    test_stream_matches_count();
     
     printf("All tiktoken tests passed!\n");
 }
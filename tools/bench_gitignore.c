@@ -0,0 +1,250 @@
+/**
+ * @file bench_gitignore.c
+ * @brief Benchmark for gitignore matching.
+ *
+ * Loads a large rule set (tools/bench_data/large.gitignore by default), builds
+ * a synthetic list of repository paths and times match_gitignore() against a
+ * baseline that compiles every rule to its own POSIX regex and tries them in
+ * order, which is how matching worked before the combined automaton. Both
+ * matchers must agree on every path; the tool exits non-zero otherwise.
+ *
+ * Usage: bench_gitignore [gitignore-file] [iterations]
+ */
+#include "gitignore.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <regex.h>
+#include <time.h>
+
+#define DEFAULT_RULES "tools/bench_data/large.gitignore"
+#define DEFAULT_ITERATIONS 20
+#define MAX_PATHS 65536
+
+typedef struct {
+    regex_t regex;
+    bool negation;
+} BaselineRule;
+
+/**
+ * @brief Translate a gitignore pattern to a POSIX regular expression.
+ *
+ * @param pattern Pattern without the '!' prefix or trailing '/'.
+ * @param dir_only Whether the pattern only applies to directories.
+ * @return char* Newly allocated regex string or NULL on failure.
+ */
+static char *baseline_translate(const char *pattern, bool dir_only) {
+    char *regex = (char*)malloc(6 * strlen(pattern) + 16);
+    if (!regex) return NULL;
+    char *dest = regex;
+    *dest++ = '^';
+    if (pattern[0] == '/') {
+        pattern++;
+    } else {
+        dest += sprintf(dest, "(.*/)?");
+    }
+    while (*pattern) {
+        if (pattern[0] == '*' && pattern[1] == '*') {
+            pattern += 2;
+            if (*pattern == '/') {
+                pattern++;
+                dest += sprintf(dest, "(.*/)?");
+            } else {
+                dest += sprintf(dest, ".*");
+            }
+        } else if (*pattern == '*') {
+            pattern++;
+            dest += sprintf(dest, "[^/]*");
+        } else if (*pattern == '?') {
+            pattern++;
+            *dest++ = '.';
+        } else {
+            if (strchr(".^$+?()[]{}|\\", *pattern)) *dest++ = '\\';
+            *dest++ = *pattern++;
+        }
+    }
+    strcpy(dest, dir_only ? "(/.*)?$" : "$");
+    return regex;
+}
+
+/**
+ * @brief Compile every rule of a list into the regex baseline.
+ *
+ * @param list Parsed gitignore rules.
+ * @return BaselineRule* Array of list->count compiled rules, or NULL.
+ */
+static BaselineRule *baseline_compile(const GitignoreList *list) {
+    BaselineRule *rules = (BaselineRule*)calloc(list->count ? list->count : 1, sizeof(BaselineRule));
+    if (!rules) return NULL;
+    for (size_t i = 0; i < list->count; i++) {
+        char *regex = baseline_translate(list->rules[i].pattern, list->rules[i].dir_only);
+        if (!regex || regcomp(&rules[i].regex, regex, REG_EXTENDED | REG_NOSUB) != 0) {
+            fprintf(stderr, "Cannot compile baseline for pattern '%s'\n", list->rules[i].pattern);
+            exit(1);
+        }
+        free(regex);
+        rules[i].negation = list->rules[i].negation;
+    }
+    return rules;
+}
+
+/**
+ * @brief Match a path against the regex baseline (last match wins).
+ *
+ * @param path Relative path.
+ * @param rules Compiled baseline rules.
+ * @param count Number of rules.
+ * @return true if the path is ignored.
+ */
+static bool baseline_match(const char *path, const BaselineRule *rules, size_t count) {
+    bool ignored = false;
+    for (size_t i = 0; i < count; i++) {
+        if (regexec(&rules[i].regex, path, 0, NULL, 0) == 0) {
+            ignored = !rules[i].negation;
+        }
+    }
+    return ignored;
+}
+
+/**
+ * @brief Load gitignore rules from an arbitrary file.
+ *
+ * @param path File with one pattern per line.
+ * @param list List to populate.
+ * @return int 0 on success, -1 if the file cannot be read.
+ */
+static int load_rules(const char *path, GitignoreList *list) {
+    memset(list, 0, sizeof(*list));
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    char line[1024];
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        char *start = line;
+        while (*start && isspace((unsigned char)*start)) start++;
+        if (*start == '\0' || *start == '#') continue;
+        size_t len = strlen(start);
+        while (len > 0 && isspace((unsigned char)start[len - 1])) start[--len] = '\0';
+        parse_gitignore_pattern_string(start, list);
+    }
+    fclose(f);
+    return 0;
+}
+
+/**
+ * @brief Build a deterministic set of repository-like paths.
+ *
+ * @param count Output: number of paths produced.
+ * @return char** Array of newly allocated paths.
+ */
+static char **build_paths(size_t *count) {
+    static const char *dirs[] = {
+        "", "src/", "src/core/", "src/util/", "include/", "lib/", "tests/", "docs/",
+        "build/", "node_modules/react/", "vendor/pkg/", "app/src/main/java/com/example/",
+        "web/static/js/", "tools/scripts/", ".vscode/", "target/debug/", "python/pkg/sub/",
+        "src/build/", "third_party/zlib/contrib/", "out/Release/"
+    };
+    static const char *names[] = {
+        "main", "util", "README", "index", "config", "parser", "test_parser", "setup",
+        "Makefile", "CMakeLists", "server", "client", "model", "view", "controller", "thumbs"
+    };
+    static const char *exts[] = {
+        ".c", ".h", ".cpp", ".o", ".py", ".pyc", ".js", ".ts", ".json", ".md", ".log",
+        ".java", ".class", ".go", ".rs", ".txt", ".so", ".exe", ".swp", ""
+    };
+    size_t nd = sizeof(dirs) / sizeof(dirs[0]);
+    size_t nn = sizeof(names) / sizeof(names[0]);
+    size_t ne = sizeof(exts) / sizeof(exts[0]);
+
+    char **paths = (char**)malloc(MAX_PATHS * sizeof(char*));
+    if (!paths) exit(1);
+    size_t n = 0;
+    for (size_t d = 0; d < nd; d++) {
+        for (size_t i = 0; i < nn; i++) {
+            for (size_t e = 0; e < ne && n < MAX_PATHS; e++) {
+                char buf[256];
+                snprintf(buf, sizeof(buf), "%s%s%s", dirs[d], names[i], exts[e]);
+                paths[n++] = strdup(buf);
+            }
+        }
+    }
+    *count = n;
+    return paths;
+}
+
+/**
+ * @brief Monotonic clock in seconds.
+ *
+ * @return double Current time.
+ */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Entry point for the gitignore benchmark.
+ *
+ * @param argc Argument count.
+ * @param argv Arguments: optional rules file and iteration count.
+ * @return int 0 on success, 1 on mismatch or error.
+ */
+int main(int argc, char **argv) {
+    const char *rules_path = argc > 1 ? argv[1] : DEFAULT_RULES;
+    int iterations = argc > 2 ? atoi(argv[2]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0) iterations = 1;
+
+    GitignoreList list;
+    if (load_rules(rules_path, &list) != 0) {
+        fprintf(stderr, "Cannot read %s\n", rules_path);
+        return 1;
+    }
+    BaselineRule *baseline = baseline_compile(&list);
+    size_t path_count = 0;
+    char **paths = build_paths(&path_count);
+
+    // First pass on a fresh list: includes building the matcher, as in a single scan.
+    double start = now_seconds();
+    volatile size_t sink = 0;
+    for (size_t i = 0; i < path_count; i++) sink += match_gitignore(paths[i], &list);
+    double cold_time = now_seconds() - start;
+
+    // Correctness: both matchers must agree on every path.
+    size_t ignored = 0;
+    for (size_t i = 0; i < path_count; i++) {
+        bool expected = baseline_match(paths[i], baseline, list.count);
+        if (match_gitignore(paths[i], &list) != expected) {
+            fprintf(stderr, "Mismatch on '%s': baseline says %s\n", paths[i], expected ? "ignored" : "kept");
+            return 1;
+        }
+        ignored += expected;
+    }
+
+    start = now_seconds();
+    for (int it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < path_count; i++) sink += baseline_match(paths[i], baseline, list.count);
+    }
+    double baseline_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (int it = 0; it < iterations; it++) {
+        for (size_t i = 0; i < path_count; i++) sink += match_gitignore(paths[i], &list);
+    }
+    double combined_time = now_seconds() - start;
+
+    double lookups = (double)path_count * iterations;
+    printf("Rules: %zu, paths: %zu (%zu ignored), iterations: %d\n", list.count, path_count, ignored, iterations);
+    printf("  per-rule regex:    %8.3f s  %10.0f paths/s\n", baseline_time, lookups / baseline_time);
+    printf("  combined matcher:  %8.3f s  %10.0f paths/s\n", combined_time, lookups / combined_time);
+    printf("  first pass (cold): %8.3f s  %10.0f paths/s\n", cold_time, path_count / cold_time);
+    printf("  speedup:           %8.1fx\n", baseline_time / combined_time);
+
+    for (size_t i = 0; i < list.count; i++) regfree(&baseline[i].regex);
+    free(baseline);
+    for (size_t i = 0; i < path_count; i++) free(paths[i]);
+    free(paths);
+    free_gitignore(&list);
+    return 0;
+}
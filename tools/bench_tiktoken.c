@@ -0,0 +1,187 @@
+/**
+ * @file bench_tiktoken.c
+ * @brief Benchmark for token counting.
+ *
+ * Reads every regular file of a corpus directory (src/ by default) and counts
+ * its tokens file by file, the way the writer does, once with the rank-based
+ * BPE merge and once with the length-based chunking that was used before
+ * real merges existed. Reports throughput of both and how far the old
+ * estimate drifts from the merged count. The pre-tokenizer that splits text
+ * into pieces for both is also timed on its own. With more than one
+ * iteration the piece count cache serves every repeat of the corpus, so run
+ * a single iteration for a realistic cache hit rate. Finally the files are
+ * counted as one batch on a thread per online CPU.
+ *
+ * Usage: bench_tiktoken [corpus-dir] [iterations]
+ */
+#include "tiktoken.h"
+#include "pretokenize.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_CORPUS "src"
+#define DEFAULT_ITERATIONS 5
+#define MAX_FILES 4096
+
+// Baseline counter exported by tiktoken_cpp.cpp for this benchmark.
+extern int tiktoken_cpp_count_heuristic(void *wrapper, const char *text, size_t text_len);
+
+typedef struct {
+    char *data;
+    size_t len;
+} CorpusFile;
+
+/**
+ * @brief Load the regular files of a directory (not recursive).
+ *
+ * @param dir Corpus directory.
+ * @param files Output array with room for MAX_FILES entries.
+ * @return size_t Number of files loaded.
+ */
+static size_t load_corpus(const char *dir, CorpusFile *files) {
+    DIR *d = opendir(dir);
+    if (!d) return 0;
+    size_t count = 0;
+    struct dirent *entry;
+    while ((entry = readdir(d)) != NULL && count < MAX_FILES) {
+        char path[4096];
+        snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+        struct stat st;
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) continue;
+        FILE *f = fopen(path, "rb");
+        if (!f) continue;
+        char *data = (char*)malloc((size_t)st.st_size);
+        if (data && fread(data, 1, (size_t)st.st_size, f) == (size_t)st.st_size) {
+            files[count].data = data;
+            files[count].len = (size_t)st.st_size;
+            count++;
+        } else {
+            free(data);
+        }
+        fclose(f);
+    }
+    closedir(d);
+    return count;
+}
+
+/**
+ * @brief Monotonic clock in seconds.
+ *
+ * @return double Current time.
+ */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * @brief Entry point for the token counting benchmark.
+ *
+ * @param argc Argument count.
+ * @param argv Arguments: optional corpus directory and iteration count.
+ * @return int 0 on success, 1 on error.
+ */
+int main(int argc, char **argv) {
+    const char *corpus = argc > 1 ? argv[1] : DEFAULT_CORPUS;
+    int iterations = argc > 2 ? atoi(argv[2]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0) iterations = 1;
+
+    static CorpusFile files[MAX_FILES];
+    size_t file_count = load_corpus(corpus, files);
+    if (file_count == 0) {
+        fprintf(stderr, "No files found in %s\n", corpus);
+        return 1;
+    }
+    size_t bytes = 0;
+    for (size_t i = 0; i < file_count; i++) bytes += files[i].len;
+
+    double start = now_seconds();
+    if (!tiktoken_init()) {
+        fprintf(stderr, "Cannot initialize tiktoken\n");
+        return 1;
+    }
+    tiktoken_t encoding = tiktoken_get_encoding("cl100k_base");
+    double init_time = now_seconds() - start;
+
+    size_t pieces = 0;
+    start = now_seconds();
+    for (int it = 0; it < iterations; it++) {
+        pieces = 0;
+        for (size_t i = 0; i < file_count; i++) {
+            for (size_t pos = 0; pos < files[i].len; pieces++) {
+                pos = pretokenize_next(files[i].data, files[i].len, pos, PRETOKENIZE_O200K); // Makefile default encoder
+            }
+        }
+    }
+    double split_time = now_seconds() - start;
+
+    size_t merged_tokens = 0, heuristic_tokens = 0;
+    start = now_seconds();
+    for (int it = 0; it < iterations; it++) {
+        merged_tokens = 0;
+        for (size_t i = 0; i < file_count; i++) {
+            merged_tokens += (size_t)tiktoken_count(encoding, files[i].data, files[i].len);
+        }
+    }
+    double merged_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (int it = 0; it < iterations; it++) {
+        heuristic_tokens = 0;
+        for (size_t i = 0; i < file_count; i++) {
+            heuristic_tokens += (size_t)tiktoken_cpp_count_heuristic(encoding, files[i].data, files[i].len);
+        }
+    }
+    double heuristic_time = now_seconds() - start;
+
+    // The cache statistics cover the single-threaded runs only
+    size_t cache_lookups = 0, cache_hits = 0;
+    tiktoken_cache_stats(encoding, &cache_lookups, &cache_hits);
+
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    int threads = cpus > 0 ? (int)cpus : 1;
+    const char **texts = malloc(file_count * sizeof(*texts));
+    size_t *lens = malloc(file_count * sizeof(*lens));
+    int *counts = malloc(file_count * sizeof(*counts));
+    if (!texts || !lens || !counts) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+    for (size_t i = 0; i < file_count; i++) {
+        texts[i] = files[i].data;
+        lens[i] = files[i].len;
+    }
+    size_t batch_tokens = 0;
+    start = now_seconds();
+    for (int it = 0; it < iterations; it++) {
+        tiktoken_count_batch(encoding, texts, lens, file_count, counts, threads);
+        batch_tokens = 0;
+        for (size_t i = 0; i < file_count; i++) batch_tokens += (size_t)counts[i];
+    }
+    double batch_time = now_seconds() - start;
+    free(texts);
+    free(lens);
+    free(counts);
+
+
+    double mb = (double)bytes * iterations / (1024.0 * 1024.0);
+    printf("Corpus: %s, %zu files, %.2f MB, iterations: %d (init %.3f s)\n",
+           corpus, file_count, bytes / (1024.0 * 1024.0), iterations, init_time);
+    printf("  pre-tokenizer:   %8.3f s  %8.2f MB/s  %10zu pieces\n", split_time, mb / split_time, pieces);
+    printf("  chunk heuristic: %8.3f s  %8.2f MB/s  %10zu tokens\n", heuristic_time, mb / heuristic_time, heuristic_tokens);
+    printf("  rank BPE merge:  %8.3f s  %8.2f MB/s  %10zu tokens\n", merged_time, mb / merged_time, merged_tokens);
+    printf("  batch, %2d threads:%7.3f s  %8.2f MB/s  %10zu tokens\n", threads, batch_time, mb / batch_time, batch_tokens);
+    printf("  piece cache:     %8.1f%% hits  %10zu lookups\n",
+           cache_lookups ? 100.0 * (double)cache_hits / (double)cache_lookups : 0.0, cache_lookups);
+    printf("  heuristic drift: %+7.1f%%\n",
+           merged_tokens ? 100.0 * ((double)heuristic_tokens - (double)merged_tokens) / (double)merged_tokens : 0.0);
+
+    for (size_t i = 0; i < file_count; i++) free(files[i].data);
+    return 0;
+}
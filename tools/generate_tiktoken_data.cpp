@@ -6,9 +6,13 @@
 #include <stdexcept>
 #include <algorithm>
 #include <map>
+#include <set>
+#include <cstdint>
 
 // Include base64 functions from the main project source
 #include "base64.h"
+// Hash shared with the encoder for the perfect hash table
+#include "tiktoken_hash.h"
 
 // Define the known special tokens for cl100k_base and their IDs
 // We need their base64 representation to find them in the input file
@@ -38,6 +42,97 @@ std::string escape_c_string(const std::string& s) {
     return escaped;
 }
 
+// Quote raw bytes as a C string literal. Everything outside printable ASCII,
+// and the characters that could form escapes or trigraphs, is written as a
+// three-digit octal escape so no escape can run into the next character.
+std::string c_string_literal(const std::string& bytes) {
+    std::string quoted = "\"";
+    for (unsigned char c : bytes) {
+        if (c >= 0x20 && c < 0x7f && c != '\\' && c != '"' && c != '?') {
+            quoted += (char)c;
+        } else {
+            char escape[5];
+            snprintf(escape, sizeof(escape), "\\%03o", c);
+            quoted += escape;
+        }
+    }
+    return quoted + "\"";
+}
+
+// Write a numeric array, sixteen values per line
+template <typename T>
+void write_array(std::ofstream& out, const char* type, const char* name, const std::vector<T>& values) {
+    out << "static const " << type << " " << name << "[] = {";
+    for (size_t i = 0; i < values.size(); i++) {
+        out << (i % 16 == 0 ? "\n    " : " ") << values[i] << ",";
+    }
+    out << "\n};\n\n";
+}
+
+// Build a CHD minimal perfect hash: assign every key a distinct slot in
+// [0, keys.size()) and find each bucket's displacement pair. Buckets are
+// placed largest first while the table is still empty; single-key buckets
+// come last and go straight into the remaining free slots.
+// Returns false if some bucket cannot be placed.
+bool build_perfect_hash(const std::vector<std::string>& keys, uint32_t buckets,
+                        std::vector<uint32_t>& d0, std::vector<uint32_t>& d1,
+                        std::vector<int32_t>& slot_key) {
+    const uint32_t slots = (uint32_t)keys.size();
+    std::vector<tiktoken_hash_t> hashes(keys.size());
+    std::vector<std::vector<uint32_t>> members(buckets);
+    for (size_t i = 0; i < keys.size(); i++) {
+        hashes[i] = tiktoken_hash(keys[i].data(), keys[i].size(), buckets, slots);
+        members[hashes[i].bucket].push_back((uint32_t)i);
+    }
+
+    std::vector<uint32_t> order(buckets);
+    for (uint32_t b = 0; b < buckets; b++) order[b] = b;
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+        return members[a].size() > members[b].size();
+    });
+
+    d0.assign(buckets, 0);
+    d1.assign(buckets, 0);
+    slot_key.assign(slots, -1);
+    uint32_t free_slot = 0;
+    std::vector<uint32_t> placed;
+    for (uint32_t b : order) {
+        const std::vector<uint32_t>& bucket = members[b];
+        if (bucket.empty()) break;
+
+        if (bucket.size() == 1) {
+            while (slot_key[free_slot] != -1) free_slot++;
+            d1[b] = (uint32_t)(((uint64_t)free_slot + slots - hashes[bucket[0]].f1) % slots);
+            slot_key[free_slot] = (int32_t)bucket[0];
+            continue;
+        }
+
+        bool done = false;
+        for (uint32_t a = 0; a <= UINT16_MAX && !done; a++) {
+            for (uint32_t c = 0; c < slots && !done; c++) {
+                placed.clear();
+                for (uint32_t key : bucket) {
+                    uint32_t slot = tiktoken_hash_slot(hashes[key], a, c, slots);
+                    if (slot_key[slot] != -1 || std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                        break;
+                    }
+                    placed.push_back(slot);
+                }
+                if (placed.size() == bucket.size()) {
+                    for (size_t k = 0; k < bucket.size(); k++) {
+                        slot_key[placed[k]] = (int32_t)bucket[k];
+                    }
+                    d0[b] = a;
+                    d1[b] = c;
+                    done = true;
+                }
+            }
+        }
+        if (!done) return false;
+    }
+    return true;
+}
+
 
 int main(int argc, char* argv[]) {
     if (argc != 4) {
@@ -47,7 +142,7 @@ int main(int argc, char* argv[]) {
 
     std::string input_path = argv[1];
     std::string output_path = argv[2];
-    std::string encoder_name = argv[3]; // Currently unused, but kept for consistency
+    std::string encoder_name = argv[3]; // Selects the pre-tokenizer split pattern
 
     std::ifstream input_file(input_path);
     if (!input_file.is_open()) {
@@ -60,16 +155,13 @@ int main(int argc, char* argv[]) {
     std::string line;
     int line_num = 0;
 
-    // Skip the first line (version)
-    if (!std::getline(input_file, line)) {
-         std::cerr << "Error: Input file is empty or could not read version line: " << input_path << std::endl;
-         return 1;
-    }
-    line_num++;
-
-    // Read token data lines
+    // Read token data lines. A .tiktoken file has no header: the first line
+    // is already token 0, so nothing may be skipped.
     while (std::getline(input_file, line)) {
         line_num++;
+        if (line.empty()) {
+            continue;
+        }
         std::stringstream ss(line);
         std::string segment;
         std::vector<std::string> parts;
@@ -117,6 +209,11 @@ int main(int argc, char* argv[]) {
 
     input_file.close();
 
+    if (vocabulary.empty()) {
+        std::cerr << "Error: No vocabulary entries found in " << input_path << std::endl;
+        return 1;
+    }
+
     // Sort entries by ID for consistency (optional, but matches Python script)
     std::sort(special_tokens.begin(), special_tokens.end(), [](const VocabEntry& a, const VocabEntry& b) {
         return a.id < b.id;
@@ -125,6 +222,45 @@ int main(int argc, char* argv[]) {
         return a.id < b.id;
     });
 
+    // Decode the vocabulary once here so the encoder does no work at startup
+    std::vector<std::string> token_bytes;
+    std::set<std::string> seen;
+    std::vector<int> byte_ranks(256, -1);
+    size_t max_token_bytes = 0;
+    for (const auto& entry : vocabulary) {
+        std::string bytes = base64_decode(entry.token_b64);
+        if (!seen.insert(bytes).second) {
+            std::cerr << "Error: Token " << entry.id << " duplicates an earlier token in " << input_path << std::endl;
+            return 1;
+        }
+        if (bytes.size() == 1) {
+            byte_ranks[(unsigned char)bytes[0]] = entry.id;
+        }
+        max_token_bytes = std::max(max_token_bytes, bytes.size());
+        token_bytes.push_back(bytes);
+    }
+
+    // About four keys per bucket keeps the displacement table small while
+    // the multi-key buckets still find free slots quickly.
+    const uint32_t hash_buckets = std::max<uint32_t>(1, (uint32_t)(token_bytes.size() + 3) / 4);
+    std::vector<uint32_t> hash_d0, hash_d1;
+    std::vector<int32_t> slot_key;
+    if (!build_perfect_hash(token_bytes, hash_buckets, hash_d0, hash_d1, slot_key)) {
+        std::cerr << "Error: Could not build a perfect hash for " << input_path << std::endl;
+        return 1;
+    }
+
+    // Lay the tokens out in slot order so a slot indexes them directly
+    std::string blob;
+    std::vector<uint32_t> offsets;
+    std::vector<int> ids;
+    for (int32_t key : slot_key) {
+        offsets.push_back((uint32_t)blob.size());
+        ids.push_back(vocabulary[key].id);
+        blob += token_bytes[key];
+    }
+    offsets.push_back((uint32_t)blob.size());
+
 
     // Generate the C header file
     std::ofstream output_file(output_path);
@@ -145,54 +281,53 @@ int main(int argc, char* argv[]) {
     output_file << " */\n\n";
     output_file << "#ifndef TIKTOKEN_DATA_H\n";
     output_file << "#define TIKTOKEN_DATA_H\n\n";
-    output_file << "#include <stddef.h> // For size_t\n\n";
+    output_file << "#include <stddef.h> // For size_t\n";
+    output_file << "#include <stdint.h>\n\n";
+    output_file << "// Encoding the vocabulary belongs to; selects the split pattern\n";
+    output_file << "#define TIKTOKEN_ENCODER_NAME \"" << escape_c_string(encoder_name) << "\"\n\n";
 
-    // --- Struct Definitions ---
+    // --- Special Tokens ---
     output_file << "// Structure for special tokens\n";
     output_file << "typedef struct {\n";
-    output_file << "    const char* token_b64;  // Base64 encoded token bytes\n";
+    output_file << "    const char* bytes;      // Token bytes\n";
+    output_file << "    size_t len;             // Number of bytes\n";
     output_file << "    int id;                 // Token ID\n";
     output_file << "} tiktoken_special_token_t;\n\n";
 
-    output_file << "// Structure for vocabulary entries\n";
-    output_file << "typedef struct {\n";
-    output_file << "    const char* token_b64;  // Base64 encoded token bytes\n";
-    output_file << "    int id;                 // Token ID\n";
-    output_file << "} tiktoken_vocab_entry_t;\n\n";
-
-    output_file << "// Structure for BPE merges (rank determines priority)\n";
-    output_file << "typedef struct {\n";
-    output_file << "    const char* first_b64;  // Base64 encoded first part of the pair\n";
-    output_file << "    const char* second_b64; // Base64 encoded second part of the pair\n";
-    output_file << "    int rank;               // Merge rank (lower is higher priority)\n";
-    output_file << "} tiktoken_bpe_merge_t;\n\n";
-
-    // --- Special Tokens ---
     output_file << "// Special Tokens\n";
     output_file << "static const tiktoken_special_token_t tiktoken_special_tokens[] = {\n";
     for (const auto& entry : special_tokens) {
-        output_file << "    {\"" << escape_c_string(entry.token_b64) << "\", " << entry.id << "},\n";
+        std::string bytes = base64_decode(entry.token_b64);
+        output_file << "    {" << c_string_literal(bytes) << ", " << bytes.size() << ", " << entry.id << "},\n";
     }
     output_file << "};\n";
     output_file << "static const size_t TIKTOKEN_NUM_SPECIAL_TOKENS = " << special_tokens.size() << ";\n\n";
 
     // --- Vocabulary ---
-    output_file << "// Vocabulary (Token Bytes -> ID)\n";
-    output_file << "static const tiktoken_vocab_entry_t tiktoken_vocab[] = {\n";
-     for (const auto& entry : vocabulary) {
-        output_file << "    {\"" << escape_c_string(entry.token_b64) << "\", " << entry.id << "},\n";
+    output_file << "// Vocabulary: token i of the perfect hash table (see tiktoken_hash.h) is\n";
+    output_file << "// tiktoken_token_bytes[tiktoken_token_offsets[i] .. tiktoken_token_offsets[i + 1])\n";
+    output_file << "// and has ID tiktoken_token_ids[i]. The ID doubles as the BPE merge rank.\n";
+    output_file << "static const size_t TIKTOKEN_VOCAB_SIZE = " << token_bytes.size() << ";\n";
+    output_file << "static const size_t TIKTOKEN_MAX_TOKEN_BYTES = " << max_token_bytes << ";\n";
+    output_file << "static const size_t TIKTOKEN_HASH_BUCKETS = " << hash_buckets << ";\n\n";
+
+    output_file << "static const char tiktoken_token_bytes[] =";
+    for (size_t i = 0; i < blob.size(); i += 48) {
+        output_file << "\n    " << c_string_literal(blob.substr(i, 48));
     }
-    output_file << "};\n";
-    output_file << "static const size_t TIKTOKEN_VOCAB_SIZE = " << vocabulary.size() << ";\n\n";
-
-    // --- BPE Merges (Empty, matching Python script behavior) ---
-    output_file << "// BPE Merges (First Bytes, Second Bytes -> Rank)\n";
-    output_file << "// NOTE: Extraction of exact merge pairs from tiktoken lib is non-trivial.\n";
-    output_file << "// The C++ code includes a fallback if this list is empty.\n";
-    output_file << "static const tiktoken_bpe_merge_t tiktoken_bpe_merges[] = {\n";
-    output_file << "    // { Base64(first_bytes), Base64(second_bytes), rank }\n";
-    output_file << "};\n";
-    output_file << "static const size_t TIKTOKEN_NUM_MERGES = 0;\n\n"; // Set count to 0
+    if (blob.empty()) {
+        output_file << " \"\"";
+    }
+    output_file << ";\n\n";
+    write_array(output_file, "uint32_t", "tiktoken_token_offsets", offsets);
+    write_array(output_file, "int", "tiktoken_token_ids", ids);
+
+    output_file << "// Displacement pair of every hash bucket\n";
+    write_array(output_file, "uint16_t", "tiktoken_hash_d0", hash_d0);
+    write_array(output_file, "uint32_t", "tiktoken_hash_d1", hash_d1);
+
+    output_file << "// ID of every single-byte token, -1 where a byte is not a token\n";
+    write_array(output_file, "int", "tiktoken_byte_ranks", byte_ranks);
 
     output_file << "#endif // TIKTOKEN_DATA_H\n";
 
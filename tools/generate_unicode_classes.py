@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""Generate src/unicode_classes.h for the pre-tokenizer in src/pretokenize.c.
+
+The tiktoken split patterns only ask a handful of questions about a code
+point: is it an upper/title case letter, a lower case letter, another
+letter, a combining mark, a number, white space or a line break. This
+script folds the Unicode character database into those classes and writes
+them as a sorted table of ranges plus a direct table for ASCII.
+
+Usage: python3 tools/generate_unicode_classes.py > src/unicode_classes.h
+"""
+import sys
+import unicodedata
+
+# White_Space from PropList.txt; this is what \s matches in the regex engines
+# tiktoken runs its patterns on. str.isspace() differs (it includes U+001C..1F).
+WHITE_SPACE = set(range(0x09, 0x0E)) | {
+    0x20, 0x85, 0xA0, 0x1680, 0x2028, 0x2029, 0x202F, 0x205F, 0x3000,
+} | set(range(0x2000, 0x200B))
+
+CLASSES = [
+    ("UC_OTHER", "anything not listed below"),
+    ("UC_UPPER", "Lu, Lt"),
+    ("UC_LOWER", "Ll"),
+    ("UC_LETTER", "Lm, Lo"),
+    ("UC_MARK", "Mn, Mc, Me"),
+    ("UC_NUMBER", "Nd, Nl, No"),
+    ("UC_SPACE", "White_Space except CR and LF"),
+    ("UC_NEWLINE", "CR, LF"),
+]
+
+
+def classify(cp):
+    if cp in (0x0A, 0x0D):
+        return "UC_NEWLINE"
+    if cp in WHITE_SPACE:
+        return "UC_SPACE"
+    cat = unicodedata.category(chr(cp))
+    if cat in ("Lu", "Lt"):
+        return "UC_UPPER"
+    if cat == "Ll":
+        return "UC_LOWER"
+    if cat in ("Lm", "Lo"):
+        return "UC_LETTER"
+    if cat[0] == "M":
+        return "UC_MARK"
+    if cat[0] == "N":
+        return "UC_NUMBER"
+    return "UC_OTHER"
+
+
+def main():
+    out = sys.stdout
+    ranges = []
+    for cp in range(0x110000):
+        cls = classify(cp)
+        if not ranges or ranges[-1][1] != cls:
+            ranges.append((cp, cls))
+
+    out.write("/*\n")
+    out.write(" * Generated by tools/generate_unicode_classes.py\n")
+    out.write(" * Source: Unicode %s character database\n" % unicodedata.unidata_version)
+    out.write(" * DO NOT EDIT MANUALLY!\n")
+    out.write(" */\n\n")
+    out.write("#ifndef UNICODE_CLASSES_H\n")
+    out.write("#define UNICODE_CLASSES_H\n\n")
+    out.write("#include <stddef.h> // For size_t\n\n")
+    out.write("// Character classes, one bit each so sets of them can be tested with a mask\n")
+    for i, (name, desc) in enumerate(CLASSES):
+        out.write("#define %-10s 0x%02x // %s\n" % (name, 1 << i, desc))
+    out.write("\n// Class of every ASCII character\n")
+    out.write("static const unsigned char unicode_ascii_class[128] = {\n")
+    for row in range(0, 128, 8):
+        names = ", ".join(classify(cp) for cp in range(row, row + 8))
+        out.write("    %s,\n" % names)
+    out.write("};\n\n")
+    out.write("// Code points from `first` up to the next entry's `first` share a class\n")
+    out.write("typedef struct {\n")
+    out.write("    unsigned int first;\n")
+    out.write("    unsigned char cls;\n")
+    out.write("} unicode_class_range_t;\n\n")
+    out.write("static const unicode_class_range_t unicode_class_ranges[] = {\n")
+    for first, cls in ranges:
+        out.write("    {0x%04X, %s},\n" % (first, cls))
+    out.write("};\n")
+    out.write("static const size_t UNICODE_CLASS_RANGE_COUNT = %d;\n\n" % len(ranges))
+    out.write("#endif // UNICODE_CLASSES_H\n")
+
+
+if __name__ == "__main__":
+    main()